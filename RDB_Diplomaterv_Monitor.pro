@@ -60,6 +60,16 @@ win32 {
 # The application will be always built
 SUBDIRS += application
 
+# The tools that feed the application with test data and measure its parts, for example the reference producer of the shared memory connection
+# The tools will be built only if explicitely requested
+defined(BUILD_TOOLS, var) {
+    message(Tools will be built!)
+    SUBDIRS += tools
+} else {
+    message("Tools will not be built, if you need them please define the \"BUILD_TOOLS\" variable!")
+    message("Example: \$ qmake BUILD_TOOLS=\"On\" .")
+}
+
 # The tests will be built only if explicitely requested
 defined(BUILD_TESTS, var) {
     message(Tests will be built!)
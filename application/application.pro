@@ -31,6 +31,7 @@ message(===============================)
 QT += core        \
       gui         \
       charts      \
+      network     \
       serialport
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -40,35 +41,79 @@ QMAKE_CXXFLAGS += -std=c++17
 # Source files of the target
 SOURCES +=                                  \
     sources/backend.cpp                     \
+    sources/binary_data_protocol.cpp        \
+    sources/capture_journal.cpp             \
+    sources/chart_series_builder.cpp        \
     sources/configuration.cpp               \
     sources/data_line.cpp                   \
     sources/data_point.cpp                  \
     sources/diagram.cpp                     \
+    sources/diagram_cache.cpp               \
     sources/diagram_container.cpp           \
+    sources/diagram_filter_proxy_model.cpp  \
+    sources/display_update_queue.cpp        \
+    sources/file_replay_connection.cpp      \
     sources/main.cpp                        \
     sources/main_window.cpp                 \
     sources/measurement_data_protocol.cpp   \
     sources/network_handler.cpp             \
-    sources/serial_port.cpp
+    sources/published_diagram_queue.cpp     \
+    sources/received_chunk_queue.cpp        \
+    sources/received_data_buffer.cpp        \
+    sources/received_data_delivery.cpp      \
+    sources/serial_port.cpp                 \
+    sources/socket_address.cpp              \
+    sources/tcp_connection.cpp              \
+    sources/udp_connection.cpp              \
+    sources/worker_pool.cpp
 
 # Header files of the target
 HEADERS +=                                      \
     sources/backend.hpp                         \
     sources/backend_signal_interface.hpp        \
+    sources/binary_data_protocol.hpp            \
+    sources/capture_journal.hpp                 \
+    sources/chart_series_builder.hpp            \
     sources/configuration.hpp                   \
     sources/data_connection_interface.hpp       \
     sources/data_line.hpp                       \
     sources/data_point.hpp                      \
     sources/data_processing_interface.hpp       \
     sources/diagram.hpp                         \
+    sources/diagram_cache.hpp                   \
     sources/diagram_container.hpp               \
+    sources/diagram_filter_proxy_model.hpp      \
+    sources/display_update_queue.hpp            \
+    sources/file_replay_connection.hpp          \
     sources/global.hpp                          \
     sources/gui_signal_interface.hpp            \
+    sources/ingest_queue_counters.hpp           \
+    sources/latency_histogram.hpp               \
     sources/main_window.hpp                     \
     sources/measurement_data_protocol.hpp       \
     sources/network_connection_interface.hpp    \
     sources/network_handler.hpp                 \
-    sources/serial_port.hpp
+    sources/published_diagram_queue.hpp         \
+    sources/received_chunk_queue.hpp            \
+    sources/received_data_buffer.hpp            \
+    sources/received_data_delivery.hpp          \
+    sources/retention_policy.hpp                \
+    sources/search_index.hpp                    \
+    sources/serial_port.hpp                     \
+    sources/socket_address.hpp                  \
+    sources/spsc_ring_buffer.hpp                \
+    sources/tcp_connection.hpp                  \
+    sources/udp_connection.hpp                  \
+    sources/worker_pool.hpp
+
+# The shared memory connection uses the futexes of Linux
+linux {
+    SOURCES += sources/shared_memory_connection.cpp \
+               sources/shared_memory_ring.cpp
+    HEADERS += sources/shared_memory_connection.hpp \
+               sources/shared_memory_ring.hpp
+    LIBS += -lrt
+}
 
 RESOURCES = ../resources.qrc
 
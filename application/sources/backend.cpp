@@ -25,20 +25,64 @@
 #include "main_window.hpp"
 #include "network_handler.hpp"
 #include "serial_port.hpp"
+#include "tcp_connection.hpp"
+#include "udp_connection.hpp"
+#include "file_replay_connection.hpp"
 #include "measurement_data_protocol.hpp"
+#include "binary_data_protocol.hpp"
 
 
 
 Backend::Backend() : QObject(),
-                     serial_port(),
                      measurement_data_protocol(),
-                     serial_network_handler(&serial_port,
-                                            &measurement_data_protocol,
-                                            std::bind(&Backend::StoreNetworkDiagrams, this, std::placeholders::_1, std::placeholders::_2),
-                                            std::bind(&Backend::ReportStatus, this, std::placeholders::_1)),
-                     gui_signal_interface(nullptr)
+                     binary_data_protocol(),
+                     gui_signal_interface(nullptr),
+                     diagram_container(),
+                     diagram_filter_proxy_model(&diagram_container),
+                     parsing_worker_pool(),
+                     display_update_queue(this, std::bind(&Backend::DisplayPublishedDiagrams, this, std::placeholders::_1))
 {
 // #warning "This function needs to be changed when implementing the generic protocol handling"
+
+    // The diagrams that do not fit into the memory budget are moved to a cache file that is unique for every running instance of the program
+    QString cache_file_name = QString("rdb_diplomaterv_monitor_diagram_cache_%1.bin").arg(QCoreApplication::applicationPid());
+    std::string cache_file_path = QDir(QString::fromStdString(configuration.DiagramCacheFolder())).filePath(cache_file_name).toStdString();
+    diagram_container.ConfigureDiagramCache(cache_file_path, (configuration.DiagramMemoryBudgetInMegabytes() * 1024 * 1024));
+
+    // Restoring the last session, only the metadata is loaded, so this is fast even for large snapshots
+    // The loading is queued, so its status message is reported after the GUI has connected to the status messages
+    std::string session_snapshot_file = configuration.SessionSnapshotFile();
+    if((!session_snapshot_file.empty()) && QFileInfo(QString::fromStdString(session_snapshot_file)).exists())
+    {
+        QMetaObject::invokeMethod(this, [this, session_snapshot_file](){LoadSessionSnapshot(session_snapshot_file);}, Qt::QueuedConnection);
+    }
+
+    // The diagrams are published by the parser threads, the container adds them on this thread and reports them afterwards
+    display_update_queue.SetOverloadPolicy(configuration.DisplayOverloadPolicy());
+    QObject::connect(&diagram_container,   SIGNAL(PublishedDiagramsWereAdded(const QModelIndex&, const std::size_t&)),
+                     this,                 SLOT(QueueDisplayUpdate(const QModelIndex&, const std::size_t&)));
+
+    QObject::connect(&retention_policy_timer,   SIGNAL(timeout()),
+                     this,                      SLOT(EnforceRetentionPolicies()));
+    retention_policy_timer.start(retention_policy_check_interval_in_milliseconds);
+}
+
+Backend::~Backend()
+{
+    // The network connections are stopped first, so no more data is received while the rest is destroyed
+    for(auto& i : network_connections)
+    {
+        i.second->network_handler.Stop();
+    }
+
+    // The worker threads publish into the diagram_container, so they need to finish before it is destroyed
+    for(auto& i : file_import_threads)
+    {
+        if(i.second.joinable())
+        {
+            i.second.join();
+        }
+    }
 }
 
 void Backend::RegisterGuiSignalInterface(GuiSignalInterface* new_gui_signal_interface)
@@ -61,6 +105,18 @@ void Backend::RegisterGuiSignalInterface(GuiSignalInterface* new_gui_signal_inte
                          this,                                          SLOT(ExportFileHideCheckBoxes(void)));
         QObject::connect(dynamic_cast<QObject*>(gui_signal_interface),  SIGNAL(ExportFileStoreCheckedDiagrams(const std::string&)),
                          this,                                          SLOT(ExportFileStoreCheckedDiagrams(const std::string&)));
+        QObject::connect(dynamic_cast<QObject*>(gui_signal_interface),  SIGNAL(FilterDiagrams(const std::string&)),
+                         this,                                          SLOT(FilterDiagrams(const std::string&)));
+        QObject::connect(dynamic_cast<QObject*>(gui_signal_interface),  SIGNAL(SaveSessionSnapshot(const std::string&)),
+                         this,                                          SLOT(SaveSessionSnapshot(const std::string&)));
+        QObject::connect(dynamic_cast<QObject*>(gui_signal_interface),  SIGNAL(LoadSessionSnapshot(const std::string&)),
+                         this,                                          SLOT(LoadSessionSnapshot(const std::string&)));
+        QObject::connect(dynamic_cast<QObject*>(gui_signal_interface),  SIGNAL(TogglePinOfDiagram(const QModelIndex&)),
+                         this,                                          SLOT(TogglePinOfDiagram(const QModelIndex&)));
+        QObject::connect(dynamic_cast<QObject*>(gui_signal_interface),  SIGNAL(ShowIngestLatencies(void)),
+                         this,                                          SLOT(ShowIngestLatencies(void)));
+        QObject::connect(dynamic_cast<QObject*>(gui_signal_interface),  SIGNAL(DumpIngestLatencies(const std::string&)),
+                         this,                                          SLOT(DumpIngestLatencies(const std::string&)));
 
     }
     else
@@ -108,28 +164,22 @@ void Backend::ReportStatus(const std::string& message)
 
 void Backend::StoreNetworkDiagrams(const std::string& connection_name, std::vector<DiagramSpecialized>& new_diagrams)
 {
-    StoreDiagrams(new_diagrams,
-        [&](const DiagramSpecialized& diagram_to_add) -> QModelIndex
-        {
-            return diagram_container.AddDiagramFromNetwork(connection_name, diagram_to_add);
-        });
+    // The diagrams will be added to the tree on the thread of the diagram_container, see Backend::DisplayPublishedDiagrams()
+    diagram_container.PublishDiagramsFromNetwork(connection_name, std::move(new_diagrams));
 }
 
 void Backend::StoreFileDiagrams(const std::string& file_name, const std::string& file_path, std::vector<DiagramSpecialized>& new_diagrams)
 {
-    StoreDiagrams(new_diagrams,
-        [&](const DiagramSpecialized& diagram_to_add) -> QModelIndex
-        {
-            return diagram_container.AddDiagramFromFile(file_name, file_path, diagram_to_add);
-        });
+    // The diagrams will be added to the tree on the thread of the diagram_container, see Backend::DisplayPublishedDiagrams()
+    diagram_container.PublishDiagramsFromFile(file_name, file_path, std::move(new_diagrams));
 }
 
 std::vector<std::string> Backend::GetSupportedFileExtensions(void)
 {
-// #warning "This function needs to be changed when implementing the generic protocol handling"
     std::vector<std::string> result;
 
     result.push_back(measurement_data_protocol.GetSupportedFileType());
+    result.push_back(binary_data_protocol.GetSupportedFileType());
 
     return result;
 }
@@ -138,58 +188,231 @@ void Backend::OpenNetwokConnection(const std::string& port_name)
 {
     bool result = false;
 
-    if(serial_network_handler.Run(port_name))
+    if(0 == network_connections.count(port_name))
     {
-        result = true;
-        ReportStatus("The connection \"" + port_name + "\" was successfully opened!");
+        // The retention policy needs to be set before the first diagram of the connection arrives
+        diagram_container.SetRetentionPolicy(port_name, configuration.NetworkRetentionPolicy(port_name));
+
+        // The diagrams of the connection are stored under their own element in the diagram_container, the name of the element is the port_name
+        auto network_connection = std::make_unique<NetworkConnection>(this, &parsing_worker_pool, port_name);
+        network_connection->capture_journal = CreateCaptureJournal(port_name);
+        network_connection->connection->SetCaptureJournal(network_connection->capture_journal.get());
+        network_connection->connection->SetDataDeliveryCoalescing(std::chrono::milliseconds(configuration.DataDeliveryLatencyBudgetInMilliseconds()),
+                                                                  (configuration.DataDeliverySizeThresholdInKilobytes() * 1024));
+        if(network_connection->network_handler.Run(port_name))
+        {
+            network_connections[port_name] = std::move(network_connection);
+            result = true;
+            ReportStatus("The connection \"" + port_name + "\" was successfully opened!");
+            if(network_connections[port_name]->capture_journal)
+            {
+                ReportStatus("The raw data of the connection \"" + port_name + "\" is captured into: " +
+                             network_connections[port_name]->capture_journal->GetFilePathPrefix() + "_*" + CaptureJournal::file_extension);
+            }
+        }
+        else
+        {
+            // The settings of a replay are checked separately, so their error is not reported as a wrong file name
+            FileReplayConnection::Options replay_options;
+            if(FileReplayConnection::IsFileReplayPortName(port_name) && (!FileReplayConnection::ParsePortName(port_name, replay_options)))
+            {
+                ReportStatus("The settings of the replay \"" + port_name + "\" are invalid, the valid ones are: speed=max|realtime|<multiplier>, chunk=<bytes>, rate=<bytes per second>");
+            }
+            else
+            {
+                ReportStatus("The connection \"" + port_name + "\" could not be opened...maybe wrong name?");
+            }
+        }
     }
     else
     {
-        ReportStatus("The connection \"" + port_name + "\" could not be opened...maybe wrong name?");
+        ReportStatus("The connection \"" + port_name + "\" is already open!");
     }
     emit NetworkOperationFinished(port_name, result);
 }
 
 void Backend::CloseNetworkConnection(const std::string& port_name)
 {
-    serial_network_handler.Stop();
+    bool result = false;
 
-    ReportStatus("The connection \"" + port_name + "\" was successfully closed!");
-    NetworkOperationFinished(port_name, true);
+    auto network_connection = network_connections.find(port_name);
+    if(network_connections.end() != network_connection)
+    {
+        // The stopping waits for the parsing of the data that was already received
+        network_connection->second->network_handler.Stop();
+        ReportIngestCounters(port_name, *network_connection->second);
+        auto capture_journal = std::move(network_connection->second->capture_journal);
+        network_connections.erase(network_connection);
+        result = true;
+        ReportStatus("The connection \"" + port_name + "\" was successfully closed!");
+
+        // The connection does not write into the journal anymore, so the flushing stores everything that was received
+        if(capture_journal)
+        {
+            capture_journal->Flush();
+            ReportStatus("The capture journal of the connection \"" + port_name + "\" has stored " + std::to_string(capture_journal->GetNumberOfStoredBytes()) +
+                         " bytes, " + std::to_string(capture_journal->GetNumberOfDroppedChunks()) + " chunks were dropped" +
+                         (capture_journal->HasWriteError() ? " and there was a write error!" : "."));
+        }
+    }
+    else
+    {
+        ReportStatus("The connection \"" + port_name + "\" is not open!");
+    }
+    emit NetworkOperationFinished(port_name, result);
+}
+
+std::unique_ptr<CaptureJournal> Backend::CreateCaptureJournal(const std::string& port_name)
+{
+    std::unique_ptr<CaptureJournal> result;
+
+    std::string capture_journal_folder = configuration.CaptureJournalFolder();
+    if(!capture_journal_folder.empty())
+    {
+        // The port name can contain characters that are not allowed in file names, like the slashes of a device path or the colon of an address
+        std::string file_name = port_name;
+        std::replace_if(file_name.begin(), file_name.end(), [](char character){return (0 == std::isalnum(static_cast<unsigned char>(character)));}, '_');
+        file_name += "_" + QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss").toStdString();
+
+        result = std::make_unique<CaptureJournal>(QDir(QString::fromStdString(capture_journal_folder)).filePath(QString::fromStdString(file_name)).toStdString(),
+                                                  (configuration.CaptureJournalMaximumFileSizeInMegabytes() * 1024 * 1024),
+                                                  configuration.CaptureJournalMaximumNumberOfFiles());
+    }
+
+    return result;
+}
+
+std::unique_ptr<NetworkConnectionInterface> Backend::CreateNetworkConnection(const std::string& port_name)
+{
+    std::unique_ptr<NetworkConnectionInterface> result;
+
+    if(TcpConnection::IsTcpPortName(port_name))
+    {
+        result = std::make_unique<TcpConnection>();
+    }
+    else if(UdpConnection::IsUdpPortName(port_name))
+    {
+        result = std::make_unique<UdpConnection>();
+    }
+    else if(FileReplayConnection::IsFileReplayPortName(port_name))
+    {
+        result = std::make_unique<FileReplayConnection>();
+    }
+#if defined(__linux__)
+    else if(SharedMemoryConnection::IsSharedMemoryPortName(port_name))
+    {
+        result = std::make_unique<SharedMemoryConnection>();
+    }
+#endif
+    else
+    {
+        result = std::make_unique<SerialPort>();
+    }
+
+    return result;
+}
+
+std::unique_ptr<DataProcessingInterface> Backend::CreateDataProtocol(const std::string& file_extension)
+{
+    std::unique_ptr<DataProcessingInterface> result;
+
+    if(BinaryDataProtocol().GetSupportedFileType() == file_extension)
+    {
+        result = std::make_unique<BinaryDataProtocol>();
+    }
+    else
+    {
+        result = std::make_unique<MeasurementDataProtocol>();
+    }
+
+    return result;
+}
+
+DataProcessingInterface* Backend::GetDataProtocolOfFile(const std::string& path_to_file)
+{
+    DataProcessingInterface* result = nullptr;
+
+    if(measurement_data_protocol.CanThisFileBeProcessed(path_to_file))
+    {
+        result = &measurement_data_protocol;
+    }
+    else if(binary_data_protocol.CanThisFileBeProcessed(path_to_file))
+    {
+        result = &binary_data_protocol;
+    }
+
+    return result;
 }
 
 void Backend::RequestForDiagram(const QModelIndex& model_index)
 {
-    DiagramSpecialized* first_diagram = diagram_container.GetDiagram(model_index);
-    if(first_diagram)
+    // The views display the filtered model, so the index needs to be mapped to the diagram_container
+    QModelIndex source_model_index = diagram_filter_proxy_model.mapToSource(model_index);
+    if(diagram_container.GetDiagram(source_model_index))
     {
-        emit ShowThisDiagram(*first_diagram);
+        emit ShowThisDiagram(source_model_index);
     }
 }
 
 void Backend::ImportFile(const std::string& path_to_file)
 {
-// #warning "This function needs to be changed when implementing the generic protocol handling"
     QFileInfo file_info(QString::fromStdString(path_to_file));
     if(file_info.exists())
     {
         std::string file_name = file_info.fileName().toStdString();
-        if(!diagram_container.IsThisFileAlreadyStored(file_name, path_to_file))
+        if((!diagram_container.IsThisFileAlreadyStored(file_name, path_to_file)) && (0 == file_import_threads.count(path_to_file)))
         {
-            if(measurement_data_protocol.CanThisFileBeProcessed(path_to_file))
+            auto data_protocol = GetDataProtocolOfFile(path_to_file);
+            if(data_protocol)
             {
-                std::ifstream file_stream(path_to_file);
-                auto diagrams_from_file = measurement_data_protocol.ProcessData(file_stream);
-                StoreFileDiagrams(file_name, path_to_file, diagrams_from_file);
+                // The file is parsed on a worker thread so that the GUI remains responsive while importing large files
+                std::string file_extension = data_protocol->GetSupportedFileType();
+                file_import_threads[path_to_file] = std::thread([this, file_name, path_to_file, file_extension]()
+                {
+                    // An exception can not leave the thread, so the errors are reported on the thread of the backend
+                    bool import_was_successful = false;
+                    std::string error_message;
+                    try
+                    {
+                        // The protocol has an internal state, so the worker thread needs its own instance
+                        // The file is opened in binary mode, so the bytes of a binary protocol are not changed by the line ending conversions
+                        auto file_protocol = CreateDataProtocol(file_extension);
+                        std::ifstream file_stream(path_to_file, (std::ifstream::in | std::ifstream::binary));
+                        auto diagrams_from_file = file_protocol->ProcessData(file_stream);
+                        StoreFileDiagrams(file_name, path_to_file, diagrams_from_file);
+                        import_was_successful = true;
+                    }
+                    catch(const std::string& exception_text)
+                    {
+                        error_message = exception_text;
+                    }
+                    catch(const std::exception& exception)
+                    {
+                        error_message = exception.what();
+                    }
+                    catch(...)
+                    {
+                        error_message = "Unknown exception";
+                    }
+                    if(!import_was_successful)
+                    {
+                        QMetaObject::invokeMethod(this, [this, path_to_file, error_message]()
+                        {
+                            ReportStatus("ERROR! The file \"" + path_to_file + "\" could not be imported: " + error_message);
+                        }, Qt::QueuedConnection);
+                    }
+
+                    // The diagrams were published before this, so they will be added to the container before the import is finished
+                    // The import is always finished, so the file can be imported again after an error
+                    QMetaObject::invokeMethod(this, [this, path_to_file, import_was_successful](){FinishFileImport(path_to_file, import_was_successful);}, Qt::QueuedConnection);
+                });
 
                 // Updating the configuration with the folder of the file that was imported
                 configuration.ImportFolder(file_info.absoluteDir().absolutePath().toStdString());
-
-                ReportStatus("The file \"" + path_to_file + "\" was successfully opened!");
             }
             else
             {
-                ReportStatus("ERROR! The MeasurementDataProtocol cannot process the file: \"" + path_to_file + "\" because it has a wrong extension!");
+                ReportStatus("ERROR! None of the protocols can process the file: \"" + path_to_file + "\" because it has a wrong extension!");
             }
         }
         else
@@ -215,21 +438,29 @@ void Backend::ExportFileHideCheckBoxes(void)
 
 void Backend::ExportFileStoreCheckedDiagrams(const std::string& path_to_file)
 {
-// #warning "This function needs to be changed when implementing the generic protocol handling"
-    if(measurement_data_protocol.CanThisFileBeProcessed(path_to_file))
+    auto data_protocol = GetDataProtocolOfFile(path_to_file);
+    if(data_protocol)
     {
         auto checked_diagrams = diagram_container.GetCheckedDiagrams();
         if(checked_diagrams.size())
         {
-            auto exported_data = measurement_data_protocol.ExportData(checked_diagrams);
+            // The data is exported before the file is opened, so a diagram that the protocol can not store does not leave a truncated file behind
+            try
+            {
+                auto exported_data = data_protocol->ExportData(checked_diagrams);
 
-            std::ofstream output_file_stream(path_to_file, (std::ofstream::out | std::ofstream::trunc));
-            output_file_stream << exported_data.rdbuf();
+                std::ofstream output_file_stream(path_to_file, (std::ofstream::out | std::ofstream::trunc | std::ofstream::binary));
+                output_file_stream << exported_data.rdbuf();
 
-            // Updating the configuration with the folder of the file that was exported
-            configuration.ExportFolder(QFileInfo(QString::fromStdString(path_to_file)).absoluteDir().absolutePath().toStdString());
+                // Updating the configuration with the folder of the file that was exported
+                configuration.ExportFolder(QFileInfo(QString::fromStdString(path_to_file)).absoluteDir().absolutePath().toStdString());
 
-            ReportStatus("The selected diagrams were successfully written to \"" + path_to_file + "\"!");
+                ReportStatus("The selected diagrams were successfully written to \"" + path_to_file + "\"!");
+            }
+            catch(const std::string& error_message)
+            {
+                ReportStatus("ERROR! The selected diagrams could not be exported: " + error_message);
+            }
         }
         else
         {
@@ -238,32 +469,138 @@ void Backend::ExportFileStoreCheckedDiagrams(const std::string& path_to_file)
     }
     else
     {
-        ReportStatus("ERROR! The MeasurementDataProtocol cannot save diagrams into the file: \"" + path_to_file + "\" because it has a wrong extension!");
+        ReportStatus("ERROR! None of the protocols can save diagrams into the file: \"" + path_to_file + "\" because it has a wrong extension!");
     }
 }
 
-void Backend::StoreDiagrams(std::vector<DiagramSpecialized>& new_diagrams, const std::function<QModelIndex(const DiagramSpecialized&)> storage_logic)
+void Backend::FilterDiagrams(const std::string& filter)
+{
+    // The filter is changed while the user is typing, so the result is not reported as a status message
+    diagram_filter_proxy_model.SetFilter(filter);
+}
+
+void Backend::SaveSessionSnapshot(const std::string& path_to_file)
 {
-    auto container_is_empty = (0 == diagram_container.GetNumberOfDiagrams());
+    try
+    {
+        diagram_container.SaveSnapshot(path_to_file);
+
+        // The saved snapshot will be loaded at the next startup
+        configuration.SessionSnapshotFile(path_to_file);
+
+        ReportStatus("The session was successfully saved to \"" + path_to_file + "\"!");
+    }
+    catch(const std::string& error_message)
+    {
+        ReportStatus("ERROR! The session could not be saved: " + error_message);
+    }
+}
+
+void Backend::LoadSessionSnapshot(const std::string& path_to_file)
+{
+    try
+    {
+        auto number_of_loaded_diagrams = diagram_container.LoadSnapshot(path_to_file);
+
+        // The loaded snapshot will be loaded at the next startup as well
+        configuration.SessionSnapshotFile(path_to_file);
+
+        ReportStatus(std::to_string(number_of_loaded_diagrams) + " diagram was loaded from the session \"" + path_to_file + "\".");
+    }
+    catch(const std::string& error_message)
+    {
+        ReportStatus("ERROR! The session could not be loaded: " + error_message);
+    }
+}
 
-    // Adding the diagrams to the diagram_container
-    for(const auto& i : new_diagrams)
+void Backend::QueueDisplayUpdate(const QModelIndex& first_new_diagram, const std::size_t& number_of_new_diagrams)
+{
+    // The storage has taken the published diagrams, so the parsing that waited for it can continue
+    for(auto& i : network_connections)
     {
-        // Calling the logic that does the storage for a single diagram, this is provided by the caller
-        auto recently_added_diagram = storage_logic(i);
+        i.second->network_handler.ResumeParsing();
+    }
+
+    // The first diagram is displayed if the container was empty before these diagrams were added
+    display_update_queue.Push(DisplayUpdate(first_new_diagram, number_of_new_diagrams, (diagram_container.GetNumberOfDiagrams() == number_of_new_diagrams)));
+}
 
-        // Displaying the diagram if this was the first
-        if(container_is_empty)
+void Backend::DisplayPublishedDiagrams(const DisplayUpdate& display_update)
+{
+    if(display_update.container_was_empty)
+    {
+        if(diagram_container.GetDiagram(display_update.first_new_diagram))
         {
-            container_is_empty = false;
+            emit ShowThisDiagram(display_update.first_new_diagram);
 
-            DiagramSpecialized* first_diagram = diagram_container.GetDiagram(recently_added_diagram);
-            if(first_diagram)
-            {
-                emit ShowThisDiagram(*first_diagram);
-            }
+            // The chart is replaced by a direct connection, so the diagram is displayed when this is reached
+            // The other diagrams are only listed, so only the displayed one is a sample of the display latency
+            display_latency_histogram.Add((std::chrono::steady_clock::now() - display_update.store_time));
         }
     }
 
-    ReportStatus(std::to_string(new_diagrams.size()) + " new diagram was added to the list.");
+    ReportStatus(std::to_string(display_update.number_of_new_diagrams) + " new diagram was added to the list.");
+}
+
+void Backend::ReportIngestCounters(const std::string& port_name, const NetworkConnection& network_connection)
+{
+    ReportStatus("The receive queue of the connection \"" + port_name + "\": " + network_connection.connection->GetReceiveQueueCounters().ToString());
+    ReportStatus("The line assembly of the connection \"" + port_name + "\": " + network_connection.connection->GetLineCounters().ToString());
+    ReportStatus("The parse queue of the connection \"" + port_name + "\": " + network_connection.network_handler.GetParseQueueCounters().ToString());
+    ReportStatus("The protocol of the connection \"" + port_name + "\": " + std::to_string(network_connection.data_protocol->GetNumberOfCorruptedInputs()) + " corrupted inputs were dropped");
+    ReportStatus("The store queue: " + diagram_container.GetPublishedDiagramCounters().ToString());
+    ReportStatus("The display queue: " + display_update_queue.GetCounters().ToString());
+}
+
+void Backend::TogglePinOfDiagram(const QModelIndex& model_index)
+{
+    // The views display the filtered model, so the index needs to be mapped to the diagram_container
+    QModelIndex source_model_index = diagram_filter_proxy_model.mapToSource(model_index);
+    diagram_container.SetPinned(source_model_index, !diagram_container.IsPinned(source_model_index));
+}
+
+void Backend::EnforceRetentionPolicies(void)
+{
+    // The removed diagrams are not reported, this would flood the status messages during a long capture
+    diagram_container.EnforceRetentionPolicies();
+}
+
+void Backend::ShowIngestLatencies(void)
+{
+    ReportStatus("Latency from the receiving to the parsing: " + parse_latency_histogram.ToString());
+    ReportStatus("Latency from the parsing to the storing: " + diagram_container.GetStoreLatencyHistogram().ToString());
+    ReportStatus("Latency from the storing to the displaying: " + display_latency_histogram.ToString());
+}
+
+void Backend::DumpIngestLatencies(const std::string& path_to_file)
+{
+    std::ofstream output_file_stream(path_to_file, (std::ofstream::out | std::ofstream::trunc));
+    if(output_file_stream.is_open())
+    {
+        output_file_stream << "stage,upper_bound_in_microseconds,number_of_samples\n";
+        parse_latency_histogram.Write(output_file_stream, "receive_to_parsed");
+        diagram_container.GetStoreLatencyHistogram().Write(output_file_stream, "parsed_to_stored");
+        display_latency_histogram.Write(output_file_stream, "stored_to_displayed");
+        ReportStatus("The latency histograms were written to \"" + path_to_file + "\"!");
+    }
+    else
+    {
+        ReportStatus("ERROR! The latency histograms could not be written to \"" + path_to_file + "\"!");
+    }
+}
+
+void Backend::FinishFileImport(const std::string& path_to_file, const bool& import_was_successful)
+{
+    auto file_import_thread = file_import_threads.find(path_to_file);
+    if(file_import_threads.end() != file_import_thread)
+    {
+        // The thread has already published the diagrams or reported its error, so this will not block
+        file_import_thread->second.join();
+        file_import_threads.erase(file_import_thread);
+
+        if(import_was_successful)
+        {
+            ReportStatus("The file \"" + path_to_file + "\" was successfully opened!");
+        }
+    }
 }
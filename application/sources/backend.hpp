@@ -26,18 +26,40 @@
 #include <cstdio>
 #include <ctime>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <cctype>
 
 #include <QApplication>
 #include <QFileInfo>
+#include <QDir>
+#include <QTimer>
+#include <QDateTime>
 
 #include "global.hpp"
 #include "backend_signal_interface.hpp"
 #include "gui_signal_interface.hpp"
 #include "diagram.hpp"
 #include "serial_port.hpp"
+#include "tcp_connection.hpp"
+#include "udp_connection.hpp"
+#include "file_replay_connection.hpp"
+#if defined(__linux__)
+#include "shared_memory_connection.hpp"
+#endif
+#include "data_processing_interface.hpp"
 #include "measurement_data_protocol.hpp"
+#include "binary_data_protocol.hpp"
 #include "network_handler.hpp"
+#include "worker_pool.hpp"
+#include "capture_journal.hpp"
+#include "ingest_queue_counters.hpp"
+#include "display_update_queue.hpp"
+#include "latency_histogram.hpp"
 #include "diagram_container.hpp"
+#include "diagram_filter_proxy_model.hpp"
 #include "configuration.hpp"
 
 
@@ -57,7 +79,7 @@ public:
     Backend(const Backend& new_backend) = delete;
     Backend(Backend&& new_backend) = delete;
 
-    virtual ~Backend() override = default;
+    virtual ~Backend() override;
 
     Backend& operator=(const Backend&  new_backend) = delete;
     Backend& operator=(Backend&& new_backend) = delete;
@@ -69,15 +91,16 @@ public:
     void StoreNetworkDiagrams(const std::string& connection_name, std::vector<DiagramSpecialized>& new_diagrams);
     void StoreFileDiagrams(const std::string& file_name, const std::string& file_path, std::vector<DiagramSpecialized>& new_diagrams);
 
-    QAbstractItemModel* GetDiagramContainerModel(void) override {return &diagram_container;}
+    QAbstractItemModel* GetDiagramContainerModel(void) override {return &diagram_filter_proxy_model;}
     std::string GetFileImportDefaultFolder(void) override {return configuration.ImportFolder();}
     std::string GetFileExportDefaultFolder(void) override {return configuration.ExportFolder();}
     std::vector<std::string> GetSupportedFileExtensions(void) override;
+    const DiagramSpecialized* GetDiagram(const QModelIndex& diagram_index) override {return diagram_container.GetDiagram(diagram_index);}
 
 signals:
     void NewStatusMessage(const std::string& message_text) override;
     void NetworkOperationFinished(const std::string& port_name, bool result) override;
-    void ShowThisDiagram(const DiagramSpecialized& diagram) override;
+    void ShowThisDiagram(const QModelIndex& diagram_index) override;
 
 private slots:
     void OpenNetwokConnection(const std::string&);
@@ -87,18 +110,81 @@ private slots:
     void ExportFileShowCheckBoxes(void);
     void ExportFileHideCheckBoxes(void);
     void ExportFileStoreCheckedDiagrams(const std::string& path_to_file);
+    void FilterDiagrams(const std::string& filter);
+    void SaveSessionSnapshot(const std::string& path_to_file);
+    void LoadSessionSnapshot(const std::string& path_to_file);
+    void QueueDisplayUpdate(const QModelIndex& first_new_diagram, const std::size_t& number_of_new_diagrams);
+    void TogglePinOfDiagram(const QModelIndex& model_index);
+    void EnforceRetentionPolicies(void);
+    void ShowIngestLatencies(void);
+    void DumpIngestLatencies(const std::string& path_to_file);
 
 private:
-    void StoreDiagrams(std::vector<DiagramSpecialized>& new_diagrams, const std::function<QModelIndex(const DiagramSpecialized&)> storage_logic);
-
-    SerialPort serial_port;
+    // Every network connection has its own parser, because the parsers have an internal state
+    struct NetworkConnection
+    {
+        NetworkConnection(Backend* backend, WorkerPool* worker_pool, const std::string& port_name)
+            : capture_journal(),
+              connection(CreateNetworkConnection(port_name)),
+              data_protocol(CreateDataProtocol(backend->configuration.NetworkProtocol(port_name))),
+              network_handler(connection.get(),
+                              data_protocol.get(),
+                              std::bind(&Backend::StoreNetworkDiagrams, backend, std::placeholders::_1, std::placeholders::_2),
+                              std::bind(&Backend::ReportStatus, backend, std::placeholders::_1),
+                              worker_pool,
+                              &backend->diagram_container.GetPublishedDiagramCounters(),
+                              &backend->parse_latency_histogram) {}
+        // The journal is declared before the connection, so the connection stops writing into it before it is destroyed
+        std::unique_ptr<CaptureJournal> capture_journal;
+        std::unique_ptr<NetworkConnectionInterface> connection;
+        std::unique_ptr<DataProcessingInterface> data_protocol;
+        NetworkHandler network_handler;
+    };
+
+    // The type of the connection is selected by the scheme of the port name, the port names without a known scheme are serial ports
+    static std::unique_ptr<NetworkConnectionInterface> CreateNetworkConnection(const std::string& port_name);
+    // The protocol is selected by its file extension, the unknown extensions select the Measurement Data Protocol
+    static std::unique_ptr<DataProcessingInterface> CreateDataProtocol(const std::string& file_extension);
+    // Returns nullptr if none of the protocols can process the file
+    DataProcessingInterface* GetDataProtocolOfFile(const std::string& path_to_file);
+
+    void DisplayPublishedDiagrams(const DisplayUpdate& display_update);
+    void ReportIngestCounters(const std::string& port_name, const NetworkConnection& network_connection);
+
+    // Returns nullptr if the capturing is turned off in the configuration
+    std::unique_ptr<CaptureJournal> CreateCaptureJournal(const std::string& port_name);
+
+    void FinishFileImport(const std::string& path_to_file, const bool& import_was_successful);
+
+    // These are only used to check and export the files, the parsing is done by the instances of the file import threads and the network connections
     MeasurementDataProtocol measurement_data_protocol;
-    NetworkHandler serial_network_handler;
+    BinaryDataProtocol binary_data_protocol;
 
     GuiSignalInterface *gui_signal_interface;
 
     DiagramContainer diagram_container;
+    DiagramFilterProxyModel diagram_filter_proxy_model;
     Configuration configuration;
+
+    // The files that are being parsed on a worker thread, the key is the path of the file
+    std::map<std::string, std::thread> file_import_threads;
+
+    // The latencies of the ingest pipeline, the latency from the parsing to the storing is measured by the diagram_container
+    // The handlers of the network connections add to the parse latencies, so they are declared before the connections
+    LatencyHistogram parse_latency_histogram;
+    LatencyHistogram display_latency_histogram;
+
+    // The data of the network connections is parsed on the pool, so the connections are parsed in parallel
+    // The connections publish into the diagram_container, so they are declared after it and destroyed before it
+    WorkerPool parsing_worker_pool;
+    std::map<std::string, std::unique_ptr<NetworkConnection> > network_connections;
+
+    // The display updates that wait for the event loop, these are only queued if the overload policy of the display is not blocking
+    DisplayUpdateQueue display_update_queue;
+
+    // The maximum age of the diagrams received on the network is checked periodically
+    static constexpr int retention_policy_check_interval_in_milliseconds = 1000;
+    QTimer retention_policy_timer;
 };
 
 
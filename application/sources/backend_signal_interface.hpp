@@ -47,11 +47,13 @@ public:
     virtual std::string GetFileImportDefaultFolder(void) = 0;
     virtual std::string GetFileExportDefaultFolder(void) = 0;
     virtual std::vector<std::string> GetSupportedFileExtensions(void) = 0;
+    // The index belongs to the model of the diagrams, not to the filtered model, returns nullptr if it does not point to a diagram
+    virtual const DiagramSpecialized* GetDiagram(const QModelIndex& diagram_index) = 0;
 
 signals:
     virtual void NewStatusMessage(const std::string& message_text) = 0;
     virtual void NetworkOperationFinished(const std::string& port_name, bool result) = 0;
-    virtual void ShowThisDiagram(const DiagramSpecialized& diagram) = 0;
+    virtual void ShowThisDiagram(const QModelIndex& diagram_index) = 0;
 };
 
 Q_DECLARE_INTERFACE(BackendSignalInterface, "BackendSignalInterface")
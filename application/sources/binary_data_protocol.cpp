@@ -0,0 +1,505 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include "binary_data_protocol.hpp"
+
+
+
+BinaryDataProtocol::BinaryDataProtocol() : DataProcessingInterface("Binary Data Protocol BDP", "bdp"),
+                                           state(Constants::States::WaitingForSchema),
+                                           actual_row_size(0),
+                                           actual_frame_is_too_long(false),
+                                           read_block(Constants::read_block_size),
+                                           number_of_corrupted_frames(0)
+{
+
+}
+
+std::string BinaryDataProtocol::GetProtocolName(void)
+{
+    return protocol_name;
+}
+
+std::vector<DiagramSpecialized> BinaryDataProtocol::ProcessData(std::istream& input_data)
+{
+    std::vector<DiagramSpecialized> assembled_diagrams;
+
+    // The frame can be split between the calls, its bytes are collected in a member until its delimiter arrives
+    while(input_data.read(read_block.data(), static_cast<std::streamsize>(read_block.size())) || (0 < input_data.gcount()))
+    {
+        std::size_t number_of_read_bytes = static_cast<std::size_t>(input_data.gcount());
+        for(std::size_t i = 0; i < number_of_read_bytes; ++i)
+        {
+            uint8_t actual_byte = static_cast<uint8_t>(read_block[i]);
+            if(Constants::frame_delimiter == actual_byte)
+            {
+                // The empty frames are ignored, so a sender can send delimiters to synchronize the receiver
+                if(actual_frame_is_too_long || ((!actual_frame.empty()) && ((!DecodeFrame()) || (!ProcessPacket(assembled_diagrams)))))
+                {
+                    ++number_of_corrupted_frames;
+                }
+                actual_frame.clear();
+                actual_frame_is_too_long = false;
+            }
+            else if(actual_frame.size() < Constants::maximum_frame_size)
+            {
+                actual_frame.push_back(actual_byte);
+            }
+            else
+            {
+                actual_frame_is_too_long = true;
+            }
+        }
+    }
+
+    return assembled_diagrams;
+}
+
+bool BinaryDataProtocol::CanThisFileBeProcessed(const std::string path_to_file)
+{
+    return (native_file_extension == QFileInfo(QString::fromStdString(path_to_file)).completeSuffix().toStdString());
+}
+
+std::stringstream BinaryDataProtocol::ExportData(const std::vector<DiagramSpecialized>& diagrams_to_export)
+{
+    std::stringstream exported_data;
+
+    for(auto const& diagram : diagrams_to_export)
+    {
+        // A schema needs an X column and at least one data line
+        auto number_of_data_lines = diagram.GetTheNumberOfDataLines();
+        if(0 < number_of_data_lines)
+        {
+            std::vector<Column> columns(1, Column{diagram.GetAxisXTitle(), SampleTypes::Float64});
+            for(std::size_t data_line_index = 0; data_line_index < number_of_data_lines; data_line_index++)
+            {
+                columns.push_back(Column{diagram.GetDataLineTitle(data_line_index), SampleTypes::Float64});
+            }
+            exported_data << CreateSchemaFrame(diagram.GetTitle(), columns);
+
+            // The rows are grouped into frames, so the framing overhead is shared by several rows
+            std::size_t row_size = columns.size() * sizeof(double);
+            std::size_t rows_per_frame = std::max<std::size_t>(1, (Constants::read_block_size / row_size));
+            auto number_of_data_points = diagram.GetTheNumberOfDataPoints(0);
+            std::string row_data;
+            for(std::size_t data_point_index = 0; data_point_index < number_of_data_points; data_point_index++)
+            {
+                AppendFloat64Sample(row_data, static_cast<double>(diagram.GetDataPoint(0, data_point_index).GetX()));
+                for(std::size_t data_line_index = 0; data_line_index < number_of_data_lines; data_line_index++)
+                {
+                    AppendFloat64Sample(row_data, static_cast<double>(diagram.GetDataPoint(data_line_index, data_point_index).GetY()));
+                }
+
+                if(((data_point_index + 1) % rows_per_frame) == 0)
+                {
+                    exported_data << CreateRowsFrame(row_data);
+                    row_data.clear();
+                }
+            }
+            if(!row_data.empty())
+            {
+                exported_data << CreateRowsFrame(row_data);
+            }
+
+            exported_data << CreateEndFrame();
+        }
+    }
+
+    return exported_data;
+}
+
+std::string BinaryDataProtocol::CreateSchemaFrame(const std::string& title, const std::vector<Column>& columns)
+{
+    // The number of columns is stored in one byte, so a truncated schema would not match the rows that have a sample for every column
+    if(UINT8_MAX < columns.size())
+    {
+        std::string errorMessage = "The diagram \"" + title + "\" has " + std::to_string(columns.size()) + " columns, but the Binary Data Protocol can only store " +
+                                   std::to_string(UINT8_MAX) + " columns (the X axis and " + std::to_string(UINT8_MAX - 1) + " data lines)!";
+        throw errorMessage;
+    }
+
+    // The titles that are longer than the length byte can store are truncated
+    std::string packet(1, static_cast<char>(PacketTypes::Schema));
+    packet.push_back(static_cast<char>(columns.size()));
+    packet.push_back(static_cast<char>(std::min<std::size_t>(title.size(), UINT8_MAX)));
+    packet.append(title, 0, UINT8_MAX);
+    for(const auto& column : columns)
+    {
+        packet.push_back(static_cast<char>(column.sample_type));
+        packet.push_back(static_cast<char>(std::min<std::size_t>(column.title.size(), UINT8_MAX)));
+        packet.append(column.title, 0, UINT8_MAX);
+    }
+
+    // The receivers drop the frames that are longer than the maximum frame size, this can only be reached by many long column titles
+    std::string result = CreateFrame(packet);
+    if(Constants::maximum_frame_size < (result.size() - 1))
+    {
+        std::string errorMessage = "The titles of the diagram \"" + title + "\" do not fit into the " + std::to_string(Constants::maximum_frame_size) +
+                                   " bytes of a frame of the Binary Data Protocol!";
+        throw errorMessage;
+    }
+
+    return result;
+}
+
+std::string BinaryDataProtocol::CreateRowsFrame(const std::string& row_data)
+{
+    return CreateFrame(std::string(1, static_cast<char>(PacketTypes::Rows)) + row_data);
+}
+
+std::string BinaryDataProtocol::CreateEndFrame(void)
+{
+    return CreateFrame(std::string(1, static_cast<char>(PacketTypes::End)));
+}
+
+uint16_t BinaryDataProtocol::CalculateCrc(const uint8_t* data, const std::size_t& size)
+{
+    // The table of the polynomial 0x1021 is calculated once, so the CRC of a byte takes a single lookup
+    static const std::vector<uint16_t> crc_table = []()
+    {
+        std::vector<uint16_t> table(256);
+        for(uint16_t i = 0; i < 256; ++i)
+        {
+            uint16_t crc = static_cast<uint16_t>(i << 8);
+            for(int bit = 0; bit < 8; ++bit)
+            {
+                crc = static_cast<uint16_t>((crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1));
+            }
+            table[i] = crc;
+        }
+        return table;
+    }();
+
+    uint16_t result = 0xFFFF;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        result = static_cast<uint16_t>((result << 8) ^ crc_table[((result >> 8) ^ data[i]) & 0xFF]);
+    }
+
+    return result;
+}
+
+std::size_t BinaryDataProtocol::GetSampleSize(const SampleTypes& sample_type)
+{
+    std::size_t result = 0;
+
+    switch(sample_type)
+    {
+    case SampleTypes::Int8:
+    case SampleTypes::UInt8:
+        result = 1;
+        break;
+    case SampleTypes::Int16:
+    case SampleTypes::UInt16:
+        result = 2;
+        break;
+    case SampleTypes::Int32:
+    case SampleTypes::UInt32:
+    case SampleTypes::Float32:
+        result = 4;
+        break;
+    case SampleTypes::Float64:
+        result = 8;
+        break;
+    }
+
+    return result;
+}
+
+void BinaryDataProtocol::AppendFloat64Sample(std::string& row_data, const double& sample)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &sample, sizeof(bits));
+    for(std::size_t i = 0; i < sizeof(bits); ++i)
+    {
+        row_data.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+    }
+}
+
+std::string BinaryDataProtocol::CreateFrame(const std::string& packet)
+{
+    std::string data = packet;
+    uint16_t crc = CalculateCrc(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    data.push_back(static_cast<char>(crc & 0xFF));
+    data.push_back(static_cast<char>(crc >> 8));
+
+    // COBS: every block starts with a code byte, that is the distance to the next zero, the zeros themselves are left out
+    std::string result;
+    result.reserve(data.size() + (data.size() / (Constants::maximum_cobs_block_code - 1)) + 2);
+    std::size_t code_position = 0;
+    uint8_t code = 1;
+    result.push_back(0);
+    for(const char& i : data)
+    {
+        if(0 == i)
+        {
+            result[code_position] = static_cast<char>(code);
+            code_position = result.size();
+            result.push_back(0);
+            code = 1;
+        }
+        else
+        {
+            result.push_back(i);
+            ++code;
+            if(Constants::maximum_cobs_block_code == code)
+            {
+                result[code_position] = static_cast<char>(code);
+                code_position = result.size();
+                result.push_back(0);
+                code = 1;
+            }
+        }
+    }
+    result[code_position] = static_cast<char>(code);
+
+    // The encoded bytes are not zero, so after the XOR none of them is equal to the delimiter
+    for(char& i : result)
+    {
+        i = static_cast<char>(static_cast<uint8_t>(i) ^ Constants::frame_delimiter);
+    }
+    result.push_back(static_cast<char>(Constants::frame_delimiter));
+
+    return result;
+}
+
+bool BinaryDataProtocol::DecodeFrame(void)
+{
+    bool result = true;
+
+    actual_packet.clear();
+    std::size_t position = 0;
+    while(result && (position < actual_frame.size()))
+    {
+        uint8_t code = actual_frame[position] ^ Constants::frame_delimiter;
+        ++position;
+
+        // A zero code or a block that is longer than the frame can only be the result of a corruption
+        if((0 == code) || (actual_frame.size() < (position + code - 1)))
+        {
+            result = false;
+        }
+        else
+        {
+            for(uint8_t i = 1; i < code; ++i)
+            {
+                uint8_t actual_byte = actual_frame[position] ^ Constants::frame_delimiter;
+                ++position;
+                if(0 == actual_byte)
+                {
+                    result = false;
+                }
+                actual_packet.push_back(actual_byte);
+            }
+
+            // The zero after the block was left out, except after the last block and after the blocks with the maximum length
+            if((Constants::maximum_cobs_block_code != code) && (position < actual_frame.size()))
+            {
+                actual_packet.push_back(0);
+            }
+        }
+    }
+
+    // The packet needs a type and a CRC
+    if(result && ((1 + Constants::crc_size) <= actual_packet.size()))
+    {
+        std::size_t packet_size = actual_packet.size() - Constants::crc_size;
+        uint16_t received_crc = static_cast<uint16_t>(actual_packet[packet_size] | (actual_packet[packet_size + 1] << 8));
+        result = (CalculateCrc(actual_packet.data(), packet_size) == received_crc);
+        actual_packet.resize(packet_size);
+    }
+    else
+    {
+        result = false;
+    }
+
+    return result;
+}
+
+bool BinaryDataProtocol::ProcessPacket(std::vector<DiagramSpecialized>& assembled_diagrams)
+{
+    bool result = false;
+
+    switch(static_cast<PacketTypes>(actual_packet.front()))
+    {
+    case PacketTypes::Schema:
+        // A new schema discards the diagram that was not finished, just like a new start line of the Measurement Data Protocol
+        result = ProcessSchemaPacket();
+        break;
+    case PacketTypes::Rows:
+        // The rows without a schema are valid frames, they are ignored until the next schema arrives
+        result = ((Constants::States::ProcessingRows != state) || ProcessRowsPacket());
+        break;
+    case PacketTypes::End:
+        if(Constants::States::ProcessingRows == state)
+        {
+            assembled_diagrams.push_back(std::move(actual_diagram));
+            actual_diagram = DiagramSpecialized();
+            state = Constants::States::WaitingForSchema;
+        }
+        result = true;
+        break;
+    }
+
+    return result;
+}
+
+bool BinaryDataProtocol::ProcessSchemaPacket(void)
+{
+    bool result = false;
+
+    // Every length is checked before it is used, so a packet with a valid CRC but an invalid content can not be read beyond its end
+    const uint8_t* content = actual_packet.data() + 1;
+    std::size_t content_size = actual_packet.size() - 1;
+    std::size_t position = 0;
+    if(2 <= content_size)
+    {
+        std::size_t number_of_columns = content[position++];
+        std::size_t title_size = content[position++];
+        if((2 <= number_of_columns) && ((position + title_size) <= content_size))
+        {
+            DiagramSpecialized new_diagram(std::string(reinterpret_cast<const char*>(content + position), title_size));
+            std::vector<SampleTypes> new_sample_types;
+            std::size_t new_row_size = 0;
+            position += title_size;
+            result = true;
+
+            for(std::size_t i = 0; result && (i < number_of_columns); ++i)
+            {
+                result = false;
+                if((position + 2) <= content_size)
+                {
+                    SampleTypes sample_type = static_cast<SampleTypes>(content[position++]);
+                    std::size_t column_title_size = content[position++];
+                    if((0 < GetSampleSize(sample_type)) && ((position + column_title_size) <= content_size))
+                    {
+                        std::string column_title(reinterpret_cast<const char*>(content + position), column_title_size);
+                        position += column_title_size;
+                        if(0 == i)
+                        {
+                            new_diagram.SetAxisXTitle(column_title);
+                        }
+                        else
+                        {
+                            new_diagram.AddNewDataLine(column_title);
+                        }
+                        new_sample_types.push_back(sample_type);
+                        new_row_size += GetSampleSize(sample_type);
+                        result = true;
+                    }
+                }
+            }
+
+            if(result && (position == content_size))
+            {
+                actual_diagram = std::move(new_diagram);
+                actual_sample_types = std::move(new_sample_types);
+                actual_row_size = new_row_size;
+                state = Constants::States::ProcessingRows;
+            }
+            else
+            {
+                result = false;
+            }
+        }
+    }
+
+    return result;
+}
+
+bool BinaryDataProtocol::ProcessRowsPacket(void)
+{
+    bool result = false;
+
+    const uint8_t* content = actual_packet.data() + 1;
+    std::size_t content_size = actual_packet.size() - 1;
+    if(0 == (content_size % actual_row_size))
+    {
+        for(std::size_t row_begin = 0; row_begin < content_size; row_begin += actual_row_size)
+        {
+            std::size_t position = row_begin;
+            DataPointType x_value = ReadSample((content + position), actual_sample_types.front());
+            position += GetSampleSize(actual_sample_types.front());
+            for(std::size_t column_index = 1; column_index < actual_sample_types.size(); ++column_index)
+            {
+                actual_diagram.AddNewDataPoint((column_index - 1), DataPointSpecialized(x_value, ReadSample((content + position), actual_sample_types[column_index])));
+                position += GetSampleSize(actual_sample_types[column_index]);
+            }
+        }
+        result = true;
+    }
+
+    return result;
+}
+
+DataPointType BinaryDataProtocol::ReadSample(const uint8_t* sample, const SampleTypes& sample_type) const
+{
+    DataPointType result = 0;
+
+    // The bytes are assembled in little-endian order, so the decoding does not depend on the byte order of this machine
+    uint64_t bits = 0;
+    std::size_t sample_size = GetSampleSize(sample_type);
+    for(std::size_t i = 0; i < sample_size; ++i)
+    {
+        bits |= (static_cast<uint64_t>(sample[i]) << (8 * i));
+    }
+
+    switch(sample_type)
+    {
+    case SampleTypes::Int8:
+        result = static_cast<DataPointType>(static_cast<int8_t>(bits));
+        break;
+    case SampleTypes::UInt8:
+        result = static_cast<DataPointType>(static_cast<uint8_t>(bits));
+        break;
+    case SampleTypes::Int16:
+        result = static_cast<DataPointType>(static_cast<int16_t>(bits));
+        break;
+    case SampleTypes::UInt16:
+        result = static_cast<DataPointType>(static_cast<uint16_t>(bits));
+        break;
+    case SampleTypes::Int32:
+        result = static_cast<DataPointType>(static_cast<int32_t>(bits));
+        break;
+    case SampleTypes::UInt32:
+        result = static_cast<DataPointType>(static_cast<uint32_t>(bits));
+        break;
+    case SampleTypes::Float32:
+        {
+            uint32_t float_bits = static_cast<uint32_t>(bits);
+            float value;
+            std::memcpy(&value, &float_bits, sizeof(value));
+            result = static_cast<DataPointType>(value);
+        }
+        break;
+    case SampleTypes::Float64:
+        {
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            result = static_cast<DataPointType>(value);
+        }
+        break;
+    }
+
+    return result;
+}
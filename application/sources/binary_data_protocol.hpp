@@ -0,0 +1,159 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+#include <QFileInfo>
+
+#include "global.hpp"
+#include "data_processing_interface.hpp"
+#include "diagram.hpp"
+
+
+
+#ifndef BINARY_DATA_PROTOCOL_HPP
+#define BINARY_DATA_PROTOCOL_HPP
+
+
+
+// A compact binary alternative of the Measurement Data Protocol, a sample takes 1-8 bytes instead of a number in text with a separator
+// The wire format of a frame, this is a variant of COBS, so a standard COBS decoder can not read it:
+//     frame = XOR(COBS(packet, CRC), 0x0A), 0x0A
+//     The packet and its CRC are encoded with the standard COBS (254 data bytes per block, no trailing zero), this removes the zero bytes
+//     Then every encoded byte is XORed with 0x0A, so none of them is 0x0A, and the frame is terminated by one 0x0A byte
+//     The delimiter is fixed to the newline character, because the connections only pass on the complete lines, so a frame is passed on as soon as it is complete
+//     A corrupted frame is dropped and counted (see GetNumberOfCorruptedInputs), the decoding continues after the next delimiter
+// The packets consist of a packet type byte and the content, the numbers are stored in little-endian order:
+//     Schema: starts a new diagram
+//             uint8 number of columns (at least 2, the first column is the X axis), uint8 length and the characters of the title,
+//             then for every column: uint8 sample type, uint8 length and the characters of the column title
+//     Rows:   any number of rows, a row has a sample of the type in the schema for every column
+//     End:    finishes the diagram
+// The CRC is the CRC-16/CCITT-FALSE of the packet, it is stored in two bytes after the packet
+class BinaryDataProtocol : public DataProcessingInterface
+{
+public:
+    enum class PacketTypes : uint8_t
+    {
+        Schema = 1,
+        Rows   = 2,
+        End    = 3
+    };
+
+    enum class SampleTypes : uint8_t
+    {
+        Int8    = 0,
+        UInt8   = 1,
+        Int16   = 2,
+        UInt16  = 3,
+        Int32   = 4,
+        UInt32  = 5,
+        Float32 = 6,
+        Float64 = 7
+    };
+
+    struct Column
+    {
+        std::string title;
+        SampleTypes sample_type;
+    };
+
+    BinaryDataProtocol();
+    virtual ~BinaryDataProtocol() = default;
+
+    BinaryDataProtocol(const BinaryDataProtocol&) = delete;
+    BinaryDataProtocol(BinaryDataProtocol&&) = delete;
+
+    BinaryDataProtocol& operator=(const BinaryDataProtocol&) = delete;
+    BinaryDataProtocol& operator=(BinaryDataProtocol&&) = delete;
+
+    std::string GetProtocolName(void) override;
+    std::vector<DiagramSpecialized> ProcessData(std::istream& input_data) override;
+    bool CanThisFileBeProcessed(const std::string path_to_file) override;
+    std::string GetSupportedFileType(void) override {return native_file_extension;}
+    // The diagrams are exported with 64 bit floating point samples, so they are stored without losing precision
+    // Throws an error message if a diagram does not fit into a schema, for example because it has more data lines than the number of columns can store
+    std::stringstream ExportData(const std::vector<DiagramSpecialized>& diagrams_to_export) override;
+
+    std::size_t GetNumberOfCorruptedInputs(void) const override {return number_of_corrupted_frames;}
+
+    // These create the frames of a measurement, the senders can use them as the reference implementation
+    // The schema throws an error message if it has more than UINT8_MAX columns or if its frame is longer than the receivers accept
+    static std::string CreateSchemaFrame(const std::string& title, const std::vector<Column>& columns);
+    // The row_data contains the samples of the rows in little-endian order
+    static std::string CreateRowsFrame(const std::string& row_data);
+    static std::string CreateEndFrame(void);
+
+    static uint16_t CalculateCrc(const uint8_t* data, const std::size_t& size);
+    static std::size_t GetSampleSize(const SampleTypes& sample_type);
+
+private:
+    struct Constants
+    {
+        enum class States : uint8_t
+        {
+            WaitingForSchema,
+            ProcessingRows
+        };
+
+        // This is part of the wire format, the receiving of the connections only passes on the data up to this character
+        static constexpr uint8_t frame_delimiter = '\n';
+        static constexpr std::size_t crc_size = 2;
+        // The frames that are longer than this are dropped, a missing delimiter does not make the frame grow without a limit
+        static constexpr std::size_t maximum_frame_size = 64 * 1024;
+        static constexpr std::size_t read_block_size = 4096;
+        // Every COBS block has at most 254 data bytes
+        static constexpr uint8_t maximum_cobs_block_code = 0xFF;
+    };
+
+    static void AppendFloat64Sample(std::string& row_data, const double& sample);
+    static std::string CreateFrame(const std::string& packet);
+    // Returns false if the frame is corrupted
+    bool DecodeFrame(void);
+    // Returns false if the packet is invalid
+    bool ProcessPacket(std::vector<DiagramSpecialized>& assembled_diagrams);
+    bool ProcessSchemaPacket(void);
+    bool ProcessRowsPacket(void);
+    DataPointType ReadSample(const uint8_t* sample, const SampleTypes& sample_type) const;
+
+    Constants::States state;
+    DiagramSpecialized actual_diagram;
+    std::vector<SampleTypes> actual_sample_types;
+    std::size_t actual_row_size;
+    // The bytes of the frame that is being received, its memory is reused by the next frames
+    std::vector<uint8_t> actual_frame;
+    bool actual_frame_is_too_long;
+    std::vector<uint8_t> actual_packet;
+    std::vector<char> read_block;
+    std::size_t number_of_corrupted_frames;
+};
+
+
+
+#endif // BINARY_DATA_PROTOCOL_HPP
@@ -0,0 +1,256 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include "capture_journal.hpp"
+
+
+
+CaptureJournal::CaptureJournal(const std::string& new_file_path_prefix,
+                               const std::size_t& new_maximum_file_size_in_bytes,
+                               const std::size_t& new_maximum_number_of_files,
+                               const std::size_t& new_maximum_buffer_size_in_bytes)
+                                    : file_path_prefix(new_file_path_prefix),
+                                      maximum_file_size_in_bytes(new_maximum_file_size_in_bytes),
+                                      maximum_number_of_files(new_maximum_number_of_files),
+                                      maximum_buffer_size_in_bytes(new_maximum_buffer_size_in_bytes),
+                                      start_time(std::chrono::steady_clock::now()),
+                                      number_of_written_records(0),
+                                      number_of_stored_records(0),
+                                      writer_needs_to_stop(false),
+                                      file_sequence_number(0),
+                                      size_of_file(0),
+                                      number_of_dropped_chunks(0),
+                                      number_of_stored_bytes(0),
+                                      has_write_error(false)
+{
+    // Both buffers keep their capacity when they are swapped, so the writing does not allocate in the steady state
+    active_buffer.reserve(maximum_buffer_size_in_bytes);
+    stored_buffer.reserve(maximum_buffer_size_in_bytes);
+
+    writer_thread = std::thread(&CaptureJournal::WriteBuffers, this);
+}
+
+CaptureJournal::~CaptureJournal()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        writer_needs_to_stop = true;
+    }
+    buffer_needs_to_be_stored.notify_one();
+    writer_thread.join();
+}
+
+void CaptureJournal::Write(const char* chunk, const std::size_t& size_of_chunk, const std::chrono::steady_clock::time_point& receive_time)
+{
+    uint64_t receive_time_in_nanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(receive_time - start_time).count());
+    uint32_t size_of_record_data = static_cast<uint32_t>(size_of_chunk);
+    bool writer_needs_to_be_notified = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if((active_buffer.size() + size_of_record_header + size_of_chunk) <= maximum_buffer_size_in_bytes)
+        {
+            // The header is assembled byte by byte, so the journal has the same format on every platform
+            for(std::size_t i = 0; i < sizeof(receive_time_in_nanoseconds); ++i)
+            {
+                active_buffer.push_back(static_cast<char>((receive_time_in_nanoseconds >> (8 * i)) & 0xFF));
+            }
+            for(std::size_t i = 0; i < sizeof(size_of_record_data); ++i)
+            {
+                active_buffer.push_back(static_cast<char>((size_of_record_data >> (8 * i)) & 0xFF));
+            }
+            active_buffer.insert(active_buffer.end(), chunk, (chunk + size_of_chunk));
+            ++number_of_written_records;
+
+            // The writer only needs to be woken up if it has stored everything before
+            writer_needs_to_be_notified = (active_buffer.size() == (size_of_record_header + size_of_chunk));
+        }
+        else
+        {
+            number_of_dropped_chunks++;
+        }
+    }
+
+    if(writer_needs_to_be_notified)
+    {
+        buffer_needs_to_be_stored.notify_one();
+    }
+}
+
+void CaptureJournal::Flush(void)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    std::size_t number_of_records_to_store = number_of_written_records;
+    buffer_was_stored.wait(lock, [&](){return (number_of_records_to_store <= number_of_stored_records);});
+}
+
+std::vector<std::string> CaptureJournal::GetFilePaths(void) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return file_paths;
+}
+
+bool CaptureJournal::ReadSignature(std::istream& journal)
+{
+    constexpr std::size_t size_of_signature = sizeof(file_signature) - 1;
+    char signature[size_of_signature];
+
+    journal.read(signature, static_cast<std::streamsize>(size_of_signature));
+    return ((static_cast<std::streamsize>(size_of_signature) == journal.gcount()) &&
+            (std::char_traits<char>::compare(signature, file_signature, size_of_signature) == 0));
+}
+
+bool CaptureJournal::ReadRecord(std::istream& journal, uint64_t& receive_time_in_nanoseconds, std::vector<char>& chunk, const std::size_t& maximum_size_of_chunk)
+{
+    bool result = false;
+
+    unsigned char header[size_of_record_header];
+    journal.read(reinterpret_cast<char*>(header), static_cast<std::streamsize>(size_of_record_header));
+    if(static_cast<std::streamsize>(size_of_record_header) == journal.gcount())
+    {
+        uint64_t new_receive_time_in_nanoseconds = 0;
+        for(std::size_t i = 0; i < sizeof(uint64_t); ++i)
+        {
+            new_receive_time_in_nanoseconds |= (static_cast<uint64_t>(header[i]) << (8 * i));
+        }
+        uint32_t size_of_chunk = 0;
+        for(std::size_t i = 0; i < sizeof(uint32_t); ++i)
+        {
+            size_of_chunk |= (static_cast<uint32_t>(header[sizeof(uint64_t) + i]) << (8 * i));
+        }
+
+        // The size is checked before the memory is allocated for it
+        if(size_of_chunk <= maximum_size_of_chunk)
+        {
+            chunk.resize(size_of_chunk);
+            journal.read(chunk.data(), static_cast<std::streamsize>(size_of_chunk));
+            if(static_cast<std::streamsize>(size_of_chunk) == journal.gcount())
+            {
+                receive_time_in_nanoseconds = new_receive_time_in_nanoseconds;
+                result = true;
+            }
+        }
+    }
+
+    return result;
+}
+
+void CaptureJournal::WriteBuffers(void)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while(true)
+    {
+        buffer_needs_to_be_stored.wait(lock, [this](){return (writer_needs_to_stop || (!active_buffer.empty()));});
+
+        // The remaining chunks are stored before the writer stops
+        if(active_buffer.empty())
+        {
+            break;
+        }
+
+        // The buffers are swapped, so the receiving threads can continue to write while the disk is written without the lock
+        active_buffer.swap(stored_buffer);
+        std::size_t number_of_records_in_buffer = number_of_written_records - number_of_stored_records;
+        lock.unlock();
+
+        StoreBuffer(stored_buffer);
+        stored_buffer.clear();
+
+        lock.lock();
+        number_of_stored_records += number_of_records_in_buffer;
+        buffer_was_stored.notify_all();
+    }
+
+    file.close();
+}
+
+void CaptureJournal::StoreBuffer(const std::vector<char>& buffer)
+{
+    // The buffer is only split between the records, so every file of the journal can be read on its own
+    std::size_t position = 0;
+    while((position + size_of_record_header) <= buffer.size())
+    {
+        uint32_t size_of_chunk = 0;
+        for(std::size_t i = 0; i < sizeof(uint32_t); ++i)
+        {
+            size_of_chunk |= (static_cast<uint32_t>(static_cast<unsigned char>(buffer[position + sizeof(uint64_t) + i])) << (8 * i));
+        }
+        std::size_t size_of_record = size_of_record_header + size_of_chunk;
+
+        // A file always gets at least one record, even if that record alone is larger than the maximum file size
+        bool file_is_full = ((0 != maximum_file_size_in_bytes) &&
+                             ((sizeof(file_signature) - 1) < size_of_file) &&
+                             (maximum_file_size_in_bytes < (size_of_file + size_of_record)));
+        if((!file.is_open()) || file_is_full)
+        {
+            OpenNextFile();
+        }
+
+        if(file.is_open())
+        {
+            file.write(&buffer[position], static_cast<std::streamsize>(size_of_record));
+            size_of_file += size_of_record;
+            number_of_stored_bytes += size_of_chunk;
+        }
+        position += size_of_record;
+    }
+
+    // The data is handed over to the operating system, so it is not lost if this program crashes
+    file.flush();
+    if(!file)
+    {
+        has_write_error = true;
+    }
+}
+
+void CaptureJournal::OpenNextFile(void)
+{
+    file.close();
+    file.clear();
+
+    char sequence_number_text[16];
+    ++file_sequence_number;
+    std::snprintf(sequence_number_text, sizeof(sequence_number_text), "_%06zu", file_sequence_number);
+    std::string file_path = file_path_prefix + sequence_number_text + file_extension;
+
+    file.open(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(file.is_open())
+    {
+        file.write(file_signature, static_cast<std::streamsize>(sizeof(file_signature) - 1));
+        size_of_file = sizeof(file_signature) - 1;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        file_paths.push_back(file_path);
+        if((0 != maximum_number_of_files) && (maximum_number_of_files < file_paths.size()))
+        {
+            std::remove(file_paths.front().c_str());
+            file_paths.erase(file_paths.begin());
+        }
+    }
+    else
+    {
+        has_write_error = true;
+    }
+}
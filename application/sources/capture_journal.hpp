@@ -0,0 +1,134 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <istream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+#include "global.hpp"
+
+
+
+#ifndef CAPTURE_JOURNAL_HPP
+#define CAPTURE_JOURNAL_HPP
+
+
+
+// Records the raw received chunks with the time of their receiving, so a session can be examined or replayed even if the parser rejected it
+// The chunks are copied into a buffer and a writer thread writes the other buffer to the disk, so the receiving never waits for the disk
+// If the disk can not keep up and the buffer is full, then the new chunks are dropped and counted, the received data is not affected by this
+// The journal is written into files named <prefix>_<sequence number>.rdbj, a new file is started if the current one is full
+// and the oldest file is deleted if there are too many of them
+// Every file starts with the file_signature, it is followed by the records, a record is stored in little-endian order as:
+//     8 bytes: the receive time in nanoseconds since the start of the journal, from a monotonic clock
+//     4 bytes: the size of the chunk
+//     the bytes of the chunk
+class CaptureJournal
+{
+public:
+    static constexpr char file_signature[] = "RDB CAPTURE JOURNAL 1\n";
+    static constexpr char file_extension[] = ".rdbj";
+    static constexpr std::size_t default_maximum_buffer_size_in_bytes = 16 * 1024 * 1024;
+
+    // Zero as the maximum file size or as the maximum number of files means that there is no limit
+    CaptureJournal(const std::string& new_file_path_prefix,
+                   const std::size_t& new_maximum_file_size_in_bytes,
+                   const std::size_t& new_maximum_number_of_files,
+                   const std::size_t& new_maximum_buffer_size_in_bytes = default_maximum_buffer_size_in_bytes);
+
+    CaptureJournal(const CaptureJournal& new_capture_journal) = delete;
+    CaptureJournal(CaptureJournal&& new_capture_journal) = delete;
+
+    CaptureJournal& operator=(const CaptureJournal& new_capture_journal) = delete;
+    CaptureJournal& operator=(CaptureJournal&& new_capture_journal) = delete;
+
+    // The chunks that were written before are stored on the disk before the journal is destroyed
+    ~CaptureJournal();
+
+    // These can be called from any thread
+    void Write(const char* chunk, const std::size_t& size_of_chunk, const std::chrono::steady_clock::time_point& receive_time = std::chrono::steady_clock::now());
+    // Waits until every chunk that was written before this call is stored on the disk
+    void Flush(void);
+    std::size_t GetNumberOfDroppedChunks(void) const {return number_of_dropped_chunks.load();}
+    std::size_t GetNumberOfStoredBytes(void) const {return number_of_stored_bytes.load();}
+    bool HasWriteError(void) const {return has_write_error.load();}
+    // The files of the journal that were not deleted by the rotation, from the oldest to the newest
+    std::vector<std::string> GetFilePaths(void) const;
+    const std::string& GetFilePathPrefix(void) const {return file_path_prefix;}
+
+    // These read the files of the journal
+    // Returns false if the stream is not a journal, in this case the read characters are not put back into the stream
+    static bool ReadSignature(std::istream& journal);
+    // Returns false at the end of the journal, if the last record is incomplete or if the size of the record is larger than the maximum
+    // A record can not be larger than the buffer of the journal that wrote it, so a larger size means that the file is corrupted
+    static bool ReadRecord(std::istream& journal, uint64_t& receive_time_in_nanoseconds, std::vector<char>& chunk,
+                           const std::size_t& maximum_size_of_chunk = default_maximum_buffer_size_in_bytes);
+
+private:
+    // These run on the writer thread
+    void WriteBuffers(void);
+    void StoreBuffer(const std::vector<char>& buffer);
+    void OpenNextFile(void);
+
+    static constexpr std::size_t size_of_record_header = sizeof(uint64_t) + sizeof(uint32_t);
+
+    const std::string file_path_prefix;
+    const std::size_t maximum_file_size_in_bytes;
+    const std::size_t maximum_number_of_files;
+    const std::size_t maximum_buffer_size_in_bytes;
+    const std::chrono::steady_clock::time_point start_time;
+
+    // The active_buffer is filled by the receiving threads, the stored_buffer is written to the disk by the writer thread, they are swapped under the mutex
+    mutable std::mutex mutex;
+    std::condition_variable buffer_needs_to_be_stored;
+    std::condition_variable buffer_was_stored;
+    std::vector<char> active_buffer;
+    std::vector<char> stored_buffer;
+    std::size_t number_of_written_records;
+    std::size_t number_of_stored_records;
+    bool writer_needs_to_stop;
+    std::vector<std::string> file_paths;
+
+    // The file is only accessed by the writer thread
+    std::ofstream file;
+    std::size_t file_sequence_number;
+    std::size_t size_of_file;
+
+    std::atomic<std::size_t> number_of_dropped_chunks;
+    std::atomic<std::size_t> number_of_stored_bytes;
+    std::atomic<bool> has_write_error;
+    std::thread writer_thread;
+};
+
+
+
+#endif // CAPTURE_JOURNAL_HPP
@@ -0,0 +1,113 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include "chart_series_builder.hpp"
+
+
+
+QVector<QPointF> ChartSeriesBuilder::CreatePoints(const DataLineSpecialized& data_line)
+{
+    const auto& data_points = data_line.GetDataPoints();
+    QVector<QPointF> result(static_cast<int>(data_points.size()));
+
+    // The vector is written through its raw memory, so it is not checked for detaching at every point
+    QPointF* point = result.data();
+    for(const auto& i : data_points)
+    {
+        *point = QPointF(i.GetX(), i.GetY());
+        ++point;
+    }
+
+    return result;
+}
+
+bool ChartSeriesBuilder::IsOrderedByX(const DataLineSpecialized& data_line)
+{
+    return std::is_sorted(data_line.GetDataPoints().begin(), data_line.GetDataPoints().end(), DataPointSpecialized::CompareXValues);
+}
+
+QVector<QPointF> ChartSeriesBuilder::CreateDecimatedPoints(const DataLineSpecialized& data_line, const qreal& x_minimum, const qreal& x_maximum, const std::size_t& number_of_buckets)
+{
+    const auto& data_points = data_line.GetDataPoints();
+    QVector<QPointF> result;
+
+    // The visible points are found with binary searches, so the points outside the range are not visited
+    auto first = std::lower_bound(data_points.begin(), data_points.end(), x_minimum,
+                                  [](const DataPointSpecialized& data_point, const qreal& x){return (data_point.GetX() < x);});
+    auto last = std::upper_bound(first, data_points.end(), x_maximum,
+                                 [](const qreal& x, const DataPointSpecialized& data_point){return (x < data_point.GetX());});
+    if(data_points.begin() != first)
+    {
+        --first;
+    }
+    if(data_points.end() != last)
+    {
+        ++last;
+    }
+
+    auto number_of_points = static_cast<std::size_t>(std::distance(first, last));
+    if((0 == number_of_buckets) || (x_maximum <= x_minimum) || (number_of_points <= (2 * number_of_buckets)))
+    {
+        result.reserve(static_cast<int>(number_of_points));
+        for(auto i = first; i != last; ++i)
+        {
+            result.append(QPointF(i->GetX(), i->GetY()));
+        }
+    }
+    else
+    {
+        // The neighbouring points outside the range get buckets of their own
+        result.reserve(static_cast<int>((2 * number_of_buckets) + 4));
+        qreal bucket_width = (x_maximum - x_minimum) / static_cast<qreal>(number_of_buckets);
+        auto bucket_begin = first;
+        while(last != bucket_begin)
+        {
+            qreal bucket_end_x = x_minimum + ((std::floor((bucket_begin->GetX() - x_minimum) / bucket_width) + 1.0) * bucket_width);
+            auto minimum = bucket_begin;
+            auto maximum = bucket_begin;
+            auto i = std::next(bucket_begin);
+            for(; (last != i) && (i->GetX() < bucket_end_x); ++i)
+            {
+                if(i->GetY() < minimum->GetY())
+                {
+                    minimum = i;
+                }
+                if(maximum->GetY() < i->GetY())
+                {
+                    maximum = i;
+                }
+            }
+
+            auto earlier = std::min(minimum, maximum);
+            auto later = std::max(minimum, maximum);
+            result.append(QPointF(earlier->GetX(), earlier->GetY()));
+            if(earlier != later)
+            {
+                result.append(QPointF(later->GetX(), later->GetY()));
+            }
+            bucket_begin = i;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,62 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+
+#include <QVector>
+#include <QPointF>
+
+#include "global.hpp"
+#include "data_line.hpp"
+
+
+
+#ifndef CHART_SERIES_BUILDER_HPP
+#define CHART_SERIES_BUILDER_HPP
+
+
+
+// Creates the points of the chart series from the data lines of the diagrams
+// The points are handed over to a series with one QXYSeries::replace() call, because every QXYSeries::append() call emits a signal and updates the series
+// A chart can not show more points than its width in pixels, so the long data lines are decimated to a few points per pixel column
+class ChartSeriesBuilder
+{
+public:
+    ChartSeriesBuilder() = delete;
+
+    // The points are converted in one pass over the contiguous data points of the data line
+    static QVector<QPointF> CreatePoints(const DataLineSpecialized& data_line);
+
+    // Only the data lines whose X values never decrease can be cut to a range by a binary search and decimated
+    static bool IsOrderedByX(const DataLineSpecialized& data_line);
+
+    // The range between the x_minimum and the x_maximum is divided into buckets of equal width, the points of a bucket are replaced with their minimum and maximum in their original order
+    // So the spikes stay visible and at most two points are created per bucket, the neighbouring points outside the range are kept so that the line continues to the edges
+    static QVector<QPointF> CreateDecimatedPoints(const DataLineSpecialized& data_line, const qreal& x_minimum, const qreal& x_maximum, const std::size_t& number_of_buckets);
+};
+
+
+
+#endif // CHART_SERIES_BUILDER_HPP
@@ -106,3 +106,98 @@ void Configuration::SaveConfiguration(void)
     }
     file.close();
 }
+
+OverloadPolicy Configuration::DisplayOverloadPolicy(void)
+{
+    OverloadPolicy result = OverloadPolicy::Coalesce;
+
+    QString overload_policy = data[setting_display_overload_policy].toString();
+    if(overload_policy_block == overload_policy)
+    {
+        result = OverloadPolicy::Block;
+    }
+    else if(overload_policy_drop_oldest_display_updates == overload_policy)
+    {
+        result = OverloadPolicy::DropOldestDisplayUpdates;
+    }
+
+    return result;
+}
+
+void Configuration::DisplayOverloadPolicy(const OverloadPolicy& new_value)
+{
+    switch(new_value)
+    {
+    case OverloadPolicy::Block:
+        data[setting_display_overload_policy] = QString(overload_policy_block);
+        break;
+    case OverloadPolicy::DropOldestDisplayUpdates:
+        data[setting_display_overload_policy] = QString(overload_policy_drop_oldest_display_updates);
+        break;
+    case OverloadPolicy::Coalesce:
+        data[setting_display_overload_policy] = QString(overload_policy_coalesce);
+        break;
+    }
+}
+
+std::string Configuration::NetworkProtocol(const std::string& connection_name)
+{
+    // Falling back to the default protocol if the connection does not have its own protocol
+    auto network_protocols = data[setting_network_protocols].toObject();
+    auto network_protocol = network_protocols[QString::fromStdString(connection_name)];
+    if(!network_protocol.isString())
+    {
+        network_protocol = network_protocols[network_protocol_default_name];
+    }
+
+    return network_protocol.toString(QString(default_network_protocol)).toStdString();
+}
+
+void Configuration::NetworkProtocol(const std::string& connection_name, const std::string& new_value)
+{
+    auto network_protocols = data[setting_network_protocols].toObject();
+    network_protocols[QString::fromStdString(connection_name)] = QString::fromStdString(new_value);
+    data[setting_network_protocols] = network_protocols;
+}
+
+RetentionPolicy Configuration::NetworkRetentionPolicy(const std::string& connection_name)
+{
+    RetentionPolicy result;
+
+    // Falling back to the default policy if the connection does not have its own policy
+    auto retention_policies = data[setting_network_retention_policies].toObject();
+    auto retention_policy = retention_policies[QString::fromStdString(connection_name)];
+    if(!retention_policy.isObject())
+    {
+        retention_policy = retention_policies[retention_policy_default_name];
+    }
+
+    if(retention_policy.isObject())
+    {
+        auto retention_policy_object = retention_policy.toObject();
+        result.maximum_number_of_diagrams = static_cast<std::size_t>(std::max(0, retention_policy_object[retention_policy_maximum_number_of_diagrams].toInt()));
+        result.maximum_memory_usage_in_bytes = static_cast<std::size_t>(std::max(0, retention_policy_object[retention_policy_maximum_memory_usage].toInt())) * 1024 * 1024;
+        result.maximum_age = std::chrono::seconds(std::max(0, retention_policy_object[retention_policy_maximum_age].toInt()));
+    }
+
+    return result;
+}
+
+void Configuration::NetworkRetentionPolicy(const std::string& connection_name, const RetentionPolicy& new_value)
+{
+    auto retention_policies = data[setting_network_retention_policies].toObject();
+    retention_policies[QString::fromStdString(connection_name)] = CreateRetentionPolicyObject(new_value);
+    data[setting_network_retention_policies] = retention_policies;
+}
+
+QJsonObject Configuration::CreateRetentionPolicyObject(const RetentionPolicy& retention_policy)
+{
+    QJsonObject result;
+
+    // The memory usage is stored in megabytes just like the memory budget
+    result[retention_policy_maximum_number_of_diagrams] = static_cast<int>(retention_policy.maximum_number_of_diagrams);
+    result[retention_policy_maximum_memory_usage] = static_cast<int>(retention_policy.maximum_memory_usage_in_bytes / (1024 * 1024));
+    result[retention_policy_maximum_age] = static_cast<int>(retention_policy.maximum_age.count());
+
+    return result;
+}
@@ -22,6 +22,7 @@
 
 
 #include <set>
+#include <algorithm>
 
 #include <QString>
 #include <QFile>
@@ -31,6 +32,8 @@
 #include <QJsonValue>
 
 #include "global.hpp"
+#include "retention_policy.hpp"
+#include "ingest_queue_counters.hpp"
 
 
 
@@ -47,6 +50,17 @@ public:
     {
         valid_settings.emplace(setting_import_folder, QDir::homePath());
         valid_settings.emplace(setting_export_folder, QDir::homePath());
+        valid_settings.emplace(setting_diagram_cache_folder, QDir::tempPath());
+        valid_settings.emplace(setting_diagram_memory_budget, default_diagram_memory_budget_in_megabytes);
+        valid_settings.emplace(setting_session_snapshot_file, QString());
+        valid_settings.emplace(setting_capture_journal_folder, QString());
+        valid_settings.emplace(setting_capture_journal_maximum_file_size, default_capture_journal_maximum_file_size_in_megabytes);
+        valid_settings.emplace(setting_capture_journal_maximum_number_of_files, default_capture_journal_maximum_number_of_files);
+        valid_settings.emplace(setting_data_delivery_latency_budget, default_data_delivery_latency_budget_in_milliseconds);
+        valid_settings.emplace(setting_data_delivery_size_threshold, default_data_delivery_size_threshold_in_kilobytes);
+        valid_settings.emplace(setting_display_overload_policy, QString(overload_policy_coalesce));
+        valid_settings.emplace(setting_network_protocols, QJsonObject({{network_protocol_default_name, QString(default_network_protocol)}}));
+        valid_settings.emplace(setting_network_retention_policies, QJsonObject({{retention_policy_default_name, CreateRetentionPolicyObject(RetentionPolicy())}}));
 
         if(!LoadExistingConfiguration())
         {
@@ -69,12 +83,45 @@ public:
     void ImportFolder(const std::string& new_value) {data[setting_import_folder] = QJsonValue(QString::fromStdString(new_value));}
     std::string ExportFolder(void) {return data[setting_export_folder].toString().toStdString();}
     void ExportFolder(const std::string& new_value) {data[setting_export_folder] = QString::fromStdString(new_value);}
+    std::string DiagramCacheFolder(void) {return data[setting_diagram_cache_folder].toString().toStdString();}
+    void DiagramCacheFolder(const std::string& new_value) {data[setting_diagram_cache_folder] = QString::fromStdString(new_value);}
+    // The memory budget is stored in megabytes, zero means that the diagrams are never moved to the diagram cache
+    std::size_t DiagramMemoryBudgetInMegabytes(void) {return static_cast<std::size_t>(std::max(0, data[setting_diagram_memory_budget].toInt()));}
+    void DiagramMemoryBudgetInMegabytes(const std::size_t& new_value) {data[setting_diagram_memory_budget] = static_cast<int>(new_value);}
+    // The snapshot that was saved or loaded the last time, this is loaded at the startup, an empty string means that there is no such snapshot
+    std::string SessionSnapshotFile(void) {return data[setting_session_snapshot_file].toString().toStdString();}
+    void SessionSnapshotFile(const std::string& new_value) {data[setting_session_snapshot_file] = QString::fromStdString(new_value);}
+    // The raw data of the network connections is captured into this folder, an empty string means that the capturing is turned off
+    std::string CaptureJournalFolder(void) {return data[setting_capture_journal_folder].toString().toStdString();}
+    void CaptureJournalFolder(const std::string& new_value) {data[setting_capture_journal_folder] = QString::fromStdString(new_value);}
+    // A capture journal is split into files of this size, zero means that the files are not limited
+    std::size_t CaptureJournalMaximumFileSizeInMegabytes(void) {return static_cast<std::size_t>(std::max(0, data[setting_capture_journal_maximum_file_size].toInt()));}
+    void CaptureJournalMaximumFileSizeInMegabytes(const std::size_t& new_value) {data[setting_capture_journal_maximum_file_size] = static_cast<int>(new_value);}
+    // The oldest file of a capture journal is deleted if it has more files than this, zero means that every file is kept
+    std::size_t CaptureJournalMaximumNumberOfFiles(void) {return static_cast<std::size_t>(std::max(0, data[setting_capture_journal_maximum_number_of_files].toInt()));}
+    void CaptureJournalMaximumNumberOfFiles(const std::size_t& new_value) {data[setting_capture_journal_maximum_number_of_files] = static_cast<int>(new_value);}
+    // The received lines are passed on to the parsing when the oldest of them has waited this long, zero means that they are passed on at once
+    std::size_t DataDeliveryLatencyBudgetInMilliseconds(void) {return static_cast<std::size_t>(std::max(0, data[setting_data_delivery_latency_budget].toInt()));}
+    void DataDeliveryLatencyBudgetInMilliseconds(const std::size_t& new_value) {data[setting_data_delivery_latency_budget] = static_cast<int>(new_value);}
+    // The received lines are also passed on when they have reached this size, zero means that they are passed on at once
+    std::size_t DataDeliverySizeThresholdInKilobytes(void) {return static_cast<std::size_t>(std::max(0, data[setting_data_delivery_size_threshold].toInt()));}
+    void DataDeliverySizeThresholdInKilobytes(const std::size_t& new_value) {data[setting_data_delivery_size_threshold] = static_cast<int>(new_value);}
+    // The policy of the display updates if the diagrams arrive faster than they can be displayed, an unknown value means the coalescing
+    OverloadPolicy DisplayOverloadPolicy(void);
+    void DisplayOverloadPolicy(const OverloadPolicy& new_value);
+    // The protocols are identified by their file extensions, the connections that do not have their own protocol use the protocol stored with the name "default"
+    std::string NetworkProtocol(const std::string& connection_name);
+    void NetworkProtocol(const std::string& connection_name, const std::string& new_value);
+    // The connections that do not have their own retention policy use the policy stored with the name "default"
+    RetentionPolicy NetworkRetentionPolicy(const std::string& connection_name);
+    void NetworkRetentionPolicy(const std::string& connection_name, const RetentionPolicy& new_value);
 
 private:
     bool LoadExistingConfiguration(void);
     bool CheckSetting(const QString& name, QJsonValue::Type type) const;
     QJsonObject CreateEmptyConfiguration(void);
     void SaveConfiguration(void);
+    static QJsonObject CreateRetentionPolicyObject(const RetentionPolicy& retention_policy);
 
     struct Setting
     {
@@ -89,6 +136,31 @@ private:
     static constexpr char configuration_file_name[] = "configuration.json";
     static constexpr char setting_import_folder[] = "import_folder";
     static constexpr char setting_export_folder[] = "export_folder";
+    static constexpr char setting_diagram_cache_folder[] = "diagram_cache_folder";
+    static constexpr char setting_diagram_memory_budget[] = "diagram_memory_budget_in_megabytes";
+    static constexpr char setting_session_snapshot_file[] = "session_snapshot_file";
+    static constexpr char setting_capture_journal_folder[] = "capture_journal_folder";
+    static constexpr char setting_capture_journal_maximum_file_size[] = "capture_journal_maximum_file_size_in_megabytes";
+    static constexpr char setting_capture_journal_maximum_number_of_files[] = "capture_journal_maximum_number_of_files";
+    static constexpr char setting_data_delivery_latency_budget[] = "data_delivery_latency_budget_in_milliseconds";
+    static constexpr char setting_data_delivery_size_threshold[] = "data_delivery_size_threshold_in_kilobytes";
+    static constexpr char setting_display_overload_policy[] = "display_overload_policy";
+    static constexpr char overload_policy_block[] = "block";
+    static constexpr char overload_policy_drop_oldest_display_updates[] = "drop_oldest_display_updates";
+    static constexpr char overload_policy_coalesce[] = "coalesce";
+    static constexpr char setting_network_protocols[] = "network_protocols";
+    static constexpr char network_protocol_default_name[] = "default";
+    static constexpr char default_network_protocol[] = "mdp";
+    static constexpr char setting_network_retention_policies[] = "network_retention_policies";
+    static constexpr char retention_policy_default_name[] = "default";
+    static constexpr char retention_policy_maximum_number_of_diagrams[] = "maximum_number_of_diagrams";
+    static constexpr char retention_policy_maximum_memory_usage[] = "maximum_memory_usage_in_megabytes";
+    static constexpr char retention_policy_maximum_age[] = "maximum_age_in_seconds";
+    static constexpr int default_diagram_memory_budget_in_megabytes = 2048;
+    static constexpr int default_capture_journal_maximum_file_size_in_megabytes = 64;
+    static constexpr int default_capture_journal_maximum_number_of_files = 16;
+    static constexpr int default_data_delivery_latency_budget_in_milliseconds = 5;
+    static constexpr int default_data_delivery_size_threshold_in_kilobytes = 64;
 
     std::set<Setting> valid_settings;
     const std::string configuration_file_path;
@@ -75,6 +75,22 @@ public:
     {
         return Data.size();
     }
+
+    inline const std::vector<DataPoint<T_DATA_POINT> >& GetDataPoints(void) const
+    {
+        return Data;
+    }
+
+    inline void SetDataPoints(std::vector<DataPoint<T_DATA_POINT> >&& newDataPoints)
+    {
+        Data = std::move(newDataPoints);
+    }
+
+    // Removes all the data points and releases the memory that was allocated for them
+    inline void EraseDataPoints(void)
+    {
+        std::vector<DataPoint<T_DATA_POINT> >().swap(Data);
+    }
     
     inline const DataPoint<T_DATA_POINT> GetDataPoint(const T_INDEX& dataPointIndex) const
     {
@@ -115,6 +131,12 @@ public:
 
         return *max_value;
     }
+
+    // Returns the number of bytes occupied by the object including the memory allocated for the title and the data points
+    inline std::size_t GetMemoryUsage(void) const
+    {
+        return (sizeof(*this) + GetHeapMemoryUsageOfString(DataLineTitle) + (Data.capacity() * sizeof(DataPoint<T_DATA_POINT>)));
+    }
     
 private:
     void CheckDataPointIndex(const T_INDEX& dataPointIndex) const
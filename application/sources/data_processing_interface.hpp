@@ -24,6 +24,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <cstddef>
 
 #include "global.hpp"
 
@@ -37,15 +38,20 @@
 class DataProcessingInterface
 {
 public:
+    // The protocols can be owned through this interface, so the destructor is virtual
+    virtual ~DataProcessingInterface() {}
+
     virtual std::string GetProtocolName(void) = 0;
     virtual std::vector<DiagramSpecialized> ProcessData(std::istream& input_data) = 0;
     virtual bool CanThisFileBeProcessed(const std::string path_to_file) = 0;
     virtual std::string GetSupportedFileType(void) = 0;
     virtual std::stringstream ExportData(const std::vector<DiagramSpecialized>& diagrams_to_export) = 0;
+    // The number of inputs that were dropped because they were corrupted, like the frames with a wrong CRC, the protocols without an integrity check report zero
+    // This can only be called while no data is being processed
+    virtual std::size_t GetNumberOfCorruptedInputs(void) const {return 0;}
 
 protected:
     DataProcessingInterface(const std::string& new_protocol_name, const std::string& new_file_extension) : protocol_name(new_protocol_name), native_file_extension(new_file_extension) {}
-    ~DataProcessingInterface() {}
 
     const std::string protocol_name;
     const std::string native_file_extension;
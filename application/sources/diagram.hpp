@@ -107,6 +107,29 @@ public:
         return Data[dataLineIndex].GetTheNumberOfDataPoints();
     }
 
+    inline const DataLine<T_DATA_POINT, T_INDEX>& GetDataLine(const T_INDEX& dataLineIndex) const
+    {
+        CheckDataLineIndex(dataLineIndex);
+
+        return Data[dataLineIndex];
+    }
+
+    inline void SetDataPoints(const T_INDEX& dataLineIndex, std::vector<DataPoint<T_DATA_POINT> >&& newDataPoints)
+    {
+        CheckDataLineIndex(dataLineIndex);
+
+        Data[dataLineIndex].SetDataPoints(std::move(newDataPoints));
+    }
+
+    // Removes the data points of all the DataLines, but keeps the titles and the DataLines themselves
+    void EraseDataPoints(void)
+    {
+        for(auto& i : Data)
+        {
+            i.EraseDataPoints();
+        }
+    }
+
     inline const DataPoint<T_DATA_POINT> GetDataPoint(const T_INDEX& dataLineIndex, const T_INDEX& dataPointIndex) const
     {
         CheckDataLineIndex(dataLineIndex);
@@ -170,6 +193,22 @@ public:
         }
     }
 
+    // Returns the number of bytes occupied by the object including the memory allocated for the titles and the DataLines
+    std::size_t GetMemoryUsage(void) const
+    {
+        std::size_t result = sizeof(*this) + GetHeapMemoryUsageOfString(DiagramTitle) + GetHeapMemoryUsageOfString(AxisXTitle);
+
+        // The DataLine objects themselves are stored in the vector, so their size is counted with the capacity
+        // and only the memory allocated by them is added on top of that
+        result += Data.capacity() * sizeof(DataLine<T_DATA_POINT, T_INDEX>);
+        for(const auto& i : Data)
+        {
+            result += i.GetMemoryUsage() - sizeof(i);
+        }
+
+        return result;
+    }
+
     void EraseContent(void)
     {
         DiagramTitle = "";
@@ -0,0 +1,264 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <cstdio>
+#include <algorithm>
+#include <iterator>
+
+#include "diagram_cache.hpp"
+
+
+
+DiagramCache::DiagramCache(const std::string& new_cache_file_path, const bool& new_open_existing_file) : cache_file_path(new_cache_file_path),
+                                                                                                          open_existing_file(new_open_existing_file),
+                                                                                                          cache_file_size(0),
+                                                                                                          size_of_released_entries(0)
+{
+    if(open_existing_file)
+    {
+        // The existing file is only read, the size of the file is needed to check the requested entries
+        cache_file.open(cache_file_path, (std::fstream::in | std::fstream::binary | std::fstream::ate));
+        if(cache_file.is_open())
+        {
+            cache_file_size = static_cast<std::uint64_t>(cache_file.tellg());
+        }
+    }
+    else
+    {
+        cache_file.open(cache_file_path, (std::fstream::in | std::fstream::out | std::fstream::binary | std::fstream::trunc));
+    }
+
+    if(!cache_file.is_open())
+    {
+        std::string errorMessage = "The diagram cache file could not be opened: " + cache_file_path;
+        throw errorMessage;
+    }
+}
+
+DiagramCache::~DiagramCache()
+{
+    // The cache file is only valid during the lifetime of the cache so it will be removed (the existing files are kept)
+    cache_file.close();
+    if(!open_existing_file)
+    {
+        std::remove(cache_file_path.c_str());
+    }
+}
+
+DiagramCache::Entry DiagramCache::Store(const DiagramSpecialized& diagram)
+{
+    if(open_existing_file)
+    {
+        std::string errorMessage = "The diagram can not be written to the read only cache file: " + cache_file_path;
+        throw errorMessage;
+    }
+
+    // The data points are collected into a buffer first so that they can be written with a single call
+    std::vector<char> buffer = Serialize(diagram);
+
+    // The first released extent that is large enough is reused, otherwise the new entry is appended to the end of the file
+    Entry new_entry(cache_file_size, buffer.size());
+    auto released_extent = std::find_if(released_extents.begin(), released_extents.end(),
+                                        [&](const std::pair<const std::uint64_t, std::uint64_t>& extent){return (new_entry.size <= extent.second);});
+    if(released_extents.end() != released_extent)
+    {
+        new_entry.offset = released_extent->first;
+    }
+    cache_file.seekp(static_cast<std::streamoff>(new_entry.offset));
+    cache_file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if(!cache_file.good())
+    {
+        cache_file.clear();
+        std::string errorMessage = "The diagram could not be written to the cache file: " + cache_file_path;
+        throw errorMessage;
+    }
+    if(released_extents.end() != released_extent)
+    {
+        // The rest of the reused extent remains released
+        std::uint64_t remaining_size = released_extent->second - new_entry.size;
+        released_extents.erase(released_extent);
+        if(0 != remaining_size)
+        {
+            released_extents.emplace((new_entry.offset + new_entry.size), remaining_size);
+        }
+        size_of_released_entries -= new_entry.size;
+    }
+    else
+    {
+        cache_file_size += new_entry.size;
+    }
+
+    return new_entry;
+}
+
+void DiagramCache::Load(const Entry& entry, DiagramSpecialized& diagram)
+{
+    Deserialize(Read(entry), diagram);
+}
+
+std::vector<char> DiagramCache::Read(const Entry& entry)
+{
+    if(cache_file_size < (entry.offset + entry.size))
+    {
+        std::string errorMessage = "The requested diagram cache entry is outside of the cache file: " + cache_file_path;
+        throw errorMessage;
+    }
+
+    // The whole entry is read with a single call
+    std::vector<char> buffer(entry.size);
+    cache_file.seekg(static_cast<std::streamoff>(entry.offset));
+    cache_file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if(!cache_file.good())
+    {
+        cache_file.clear();
+        std::string errorMessage = "The diagram could not be read from the cache file: " + cache_file_path;
+        throw errorMessage;
+    }
+
+    return buffer;
+}
+
+void DiagramCache::Release(const Entry& entry)
+{
+    // The read only files are not changed and an entry that was already released or never stored is ignored
+    if((!open_existing_file) && (0 != entry.size) && ((entry.offset + entry.size) <= cache_file_size))
+    {
+        auto next_extent = released_extents.lower_bound(entry.offset);
+        bool entry_is_released = ((released_extents.end() != next_extent) && (next_extent->first < (entry.offset + entry.size)));
+        if((!entry_is_released) && (released_extents.begin() != next_extent))
+        {
+            auto previous_extent = std::prev(next_extent);
+            entry_is_released = (entry.offset < (previous_extent->first + previous_extent->second));
+        }
+
+        if(!entry_is_released)
+        {
+            // The extent is merged with its released neighbours
+            std::uint64_t offset = entry.offset;
+            std::uint64_t size = entry.size;
+            size_of_released_entries += entry.size;
+            if((released_extents.end() != next_extent) && ((offset + size) == next_extent->first))
+            {
+                size += next_extent->second;
+                next_extent = released_extents.erase(next_extent);
+            }
+            if(released_extents.begin() != next_extent)
+            {
+                auto previous_extent = std::prev(next_extent);
+                if((previous_extent->first + previous_extent->second) == offset)
+                {
+                    offset = previous_extent->first;
+                    size += previous_extent->second;
+                    released_extents.erase(previous_extent);
+                }
+            }
+
+            // An extent at the end of the file is given back, the next entries are appended in its place
+            if((offset + size) == cache_file_size)
+            {
+                cache_file_size = offset;
+                size_of_released_entries -= size;
+            }
+            else
+            {
+                released_extents.emplace(offset, size);
+            }
+        }
+    }
+}
+
+std::vector<char> DiagramCache::Serialize(const DiagramSpecialized& diagram)
+{
+    // Layout: number of data lines, then for every data line the number of data points followed by the X and Y values of the data points
+    std::vector<char> buffer;
+    std::uint64_t number_of_data_lines = diagram.GetTheNumberOfDataLines();
+    std::size_t size_of_the_entry = sizeof(number_of_data_lines);
+    for(DataIndexType data_line_index = 0; data_line_index < number_of_data_lines; data_line_index++)
+    {
+        size_of_the_entry += sizeof(std::uint64_t) + (diagram.GetTheNumberOfDataPoints(data_line_index) * 2 * sizeof(DataPointType));
+    }
+    buffer.reserve(size_of_the_entry);
+    AppendToBuffer(buffer, &number_of_data_lines, sizeof(number_of_data_lines));
+    for(DataIndexType data_line_index = 0; data_line_index < number_of_data_lines; data_line_index++)
+    {
+        const auto& data_points = diagram.GetDataLine(data_line_index).GetDataPoints();
+        std::uint64_t number_of_data_points = data_points.size();
+        AppendToBuffer(buffer, &number_of_data_points, sizeof(number_of_data_points));
+        for(const auto& data_point : data_points)
+        {
+            DataPointType values[] = {data_point.GetX(), data_point.GetY()};
+            AppendToBuffer(buffer, values, sizeof(values));
+        }
+    }
+
+    return buffer;
+}
+
+void DiagramCache::Deserialize(const std::vector<char>& buffer, DiagramSpecialized& diagram)
+{
+    std::size_t position = 0;
+    std::uint64_t number_of_data_lines;
+    ReadFromBuffer(buffer, position, &number_of_data_lines, sizeof(number_of_data_lines));
+    if(diagram.GetTheNumberOfDataLines() != number_of_data_lines)
+    {
+        std::string errorMessage = "The diagram cache entry does not belong to the diagram: " + diagram.GetTitle();
+        throw errorMessage;
+    }
+    for(DataIndexType data_line_index = 0; data_line_index < number_of_data_lines; data_line_index++)
+    {
+        std::uint64_t number_of_data_points;
+        ReadFromBuffer(buffer, position, &number_of_data_points, sizeof(number_of_data_points));
+        if(((buffer.size() - position) / (2 * sizeof(DataPointType))) < number_of_data_points)
+        {
+            std::string errorMessage = "The binary data is corrupted, it contains more data points than its size allows!";
+            throw errorMessage;
+        }
+        std::vector<DataPointSpecialized> data_points;
+        data_points.reserve(number_of_data_points);
+        for(std::uint64_t data_point_index = 0; data_point_index < number_of_data_points; data_point_index++)
+        {
+            DataPointType values[2];
+            ReadFromBuffer(buffer, position, values, sizeof(values));
+            data_points.emplace_back(values[0], values[1]);
+        }
+        diagram.SetDataPoints(data_line_index, std::move(data_points));
+    }
+}
+
+void DiagramCache::AppendToBuffer(std::vector<char>& buffer, const void* data, const std::size_t& size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    buffer.insert(buffer.end(), bytes, (bytes + size));
+}
+
+void DiagramCache::ReadFromBuffer(const std::vector<char>& buffer, std::size_t& position, void* data, const std::size_t& size)
+{
+    if(buffer.size() < (position + size))
+    {
+        std::string errorMessage = "The binary data is corrupted, it ended unexpectedly!";
+        throw errorMessage;
+    }
+    std::copy(buffer.begin() + static_cast<std::ptrdiff_t>(position), buffer.begin() + static_cast<std::ptrdiff_t>(position + size), static_cast<char*>(data));
+    position += size;
+}
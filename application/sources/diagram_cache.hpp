@@ -0,0 +1,98 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <cstdint>
+
+#include "global.hpp"
+#include "diagram.hpp"
+
+
+
+#ifndef DIAGRAM_CACHE_HPP
+#define DIAGRAM_CACHE_HPP
+
+
+
+// Stores the data points of diagrams in a binary file so that they can be released from the memory and reloaded later
+// Only the data points are stored, the titles remain in the memory to keep the diagrams browsable
+// An already existing file (for example a session snapshot) can be opened as well, in this case the file is only read and it is kept after the cache is destroyed
+// The entries of the removed diagrams are released, their extents are reused by the later entries so the file does not grow while diagrams are replaced
+class DiagramCache
+{
+public:
+    // Describes where the data points of a diagram can be found in the cache file
+    struct Entry
+    {
+        Entry(const std::uint64_t& new_offset = 0, const std::uint64_t& new_size = 0) : offset(new_offset), size(new_size) {}
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    explicit DiagramCache(const std::string& new_cache_file_path, const bool& new_open_existing_file = false);
+
+    DiagramCache(const DiagramCache&) = delete;
+    DiagramCache(DiagramCache&&) = delete;
+
+    ~DiagramCache();
+
+    DiagramCache& operator=(const DiagramCache&) = delete;
+    DiagramCache& operator=(DiagramCache&&) = delete;
+
+    const std::string& GetCacheFilePath(void) const {return cache_file_path;}
+    std::uint64_t GetCacheFileSize(void) const {return cache_file_size;}
+    std::uint64_t GetSizeOfReleasedEntries(void) const {return size_of_released_entries;}
+
+    bool IsReadOnly(void) const {return open_existing_file;}
+
+    Entry Store(const DiagramSpecialized& diagram);
+    void Load(const Entry& entry, DiagramSpecialized& diagram);
+    std::vector<char> Read(const Entry& entry);
+    void Release(const Entry& entry);
+
+    // The binary representation of the data points of a diagram, this is stored in the entries
+    static std::vector<char> Serialize(const DiagramSpecialized& diagram);
+    static void Deserialize(const std::vector<char>& buffer, DiagramSpecialized& diagram);
+
+    // Helper functions to assemble and to parse binary data
+    static void AppendToBuffer(std::vector<char>& buffer, const void* data, const std::size_t& size);
+    static void ReadFromBuffer(const std::vector<char>& buffer, std::size_t& position, void* data, const std::size_t& size);
+
+private:
+    const std::string cache_file_path;
+    const bool open_existing_file;
+    std::fstream cache_file;
+    // The used part of the file, the released extents at the end of the file are not counted
+    std::uint64_t cache_file_size;
+    // The released extents that can be reused by the next entries (offset -> size), the neighbouring extents are merged
+    std::map<std::uint64_t, std::uint64_t> released_extents;
+    std::uint64_t size_of_released_entries;
+};
+
+
+
+#endif // DIAGRAM_CACHE_HPP
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "diagram_container.hpp"
 
 
@@ -11,7 +13,9 @@ const DiagramContainer::Element::DataType_Name DiagramContainer::empty_element_d
 
 // --- Methods of the DiagramContainer class ----------------------------------------------------------------------------------------------------------------------------------------------------------
 
-DiagramContainer::DiagramContainer(QObject* parent) : QAbstractItemModel(parent)
+DiagramContainer::DiagramContainer(QObject* parent) : QAbstractItemModel(parent),
+                                                      memory_budget(0),
+                                                      published_diagrams([this](){QMetaObject::invokeMethod(this, "AddPublishedDiagrams", Qt::QueuedConnection);})
 {
     // Creating the root element
     root_element = std::make_unique<Element>(root_element_data);
@@ -43,6 +47,34 @@ bool DiagramContainer::IsThisFileAlreadyStored(const std::string& file_name, con
     return bResult;
 }
 
+std::size_t DiagramContainer::GetMemoryUsage(const QModelIndex& model_index) const
+{
+    std::size_t result;
+
+    if(model_index.isValid())
+    {
+        result = static_cast<Element*>(model_index.internalPointer())->GetMemoryUsage();
+    }
+    else
+    {
+        result = root_element->GetMemoryUsage();
+    }
+
+    return result;
+}
+
+void DiagramContainer::ConfigureDiagramCache(const std::string& new_cache_file_path, const std::size_t& new_memory_budget_in_bytes)
+{
+    // The path can only be changed until the cache was created, because the already evicted diagrams are stored in the current file
+    if(!diagram_cache)
+    {
+        cache_file_path = new_cache_file_path;
+    }
+    memory_budget = new_memory_budget_in_bytes;
+
+    EnforceMemoryBudget();
+}
+
 DiagramSpecialized* DiagramContainer::GetDiagram(const QModelIndex& model_index)
 {
     DiagramSpecialized* result = nullptr;
@@ -52,6 +84,18 @@ DiagramSpecialized* DiagramContainer::GetDiagram(const QModelIndex& model_index)
         Element* requested_element = static_cast<Element*>(model_index.internalPointer());
         if(requested_element->ContainsType<Element::DataType_Diagram>())
         {
+            // The data points of the requested diagram need to be in the memory
+            if(requested_element->diagram_is_evicted)
+            {
+                ReloadDiagram(requested_element);
+            }
+            else
+            {
+                MarkDiagramAsViewed(requested_element);
+            }
+            // The reloaded diagram might have exceeded the memory budget, but it can not be evicted while it is being used
+            EnforceMemoryBudget(requested_element);
+
             result = &std::get<DiagramSpecialized>(requested_element->data);
         }
     }
@@ -59,6 +103,38 @@ DiagramSpecialized* DiagramContainer::GetDiagram(const QModelIndex& model_index)
     return result;
 }
 
+std::size_t DiagramContainer::SetFilter(const std::string& new_filter)
+{
+    filter = new_filter;
+    elements_accepted_by_filter.clear();
+
+    // The matching diagrams are looked up in the search index, so the elements of the tree do not need to be visited
+    auto matching_diagrams = search_index.Search(filter);
+    for(const auto& i : matching_diagrams)
+    {
+        // The views are not notified about the changes of a new filter, they need to re-evaluate every row anyway
+        for(const Element* element = i; (!element->IsRoot()) && elements_accepted_by_filter.insert(element).second; element = element->parent) {}
+
+        // The matching diagrams are exposed to the views, since the filtered views would not fetch the many rejected diagrams before them
+        FetchChildrenOfElement(i->parent, (i->row + 1));
+    }
+
+    return matching_diagrams.size();
+}
+
+bool DiagramContainer::IsAcceptedByFilter(const QModelIndex& model_index) const
+{
+    bool result = true;
+
+    // Without a filter every element is accepted
+    if((!filter.empty()) && model_index.isValid())
+    {
+        result = (0 != elements_accepted_by_filter.count(static_cast<const Element*>(model_index.internalPointer())));
+    }
+
+    return result;
+}
+
 void DiagramContainer::ShowCheckBoxes(void)
 {
     // Showing the checkboxes is done trough setting the check state and the flag for every element
@@ -104,6 +180,11 @@ std::vector<DiagramSpecialized> DiagramContainer::GetCheckedDiagrams(void)
            if(element->ContainsType<Element::DataType_Diagram>())
            {
                checked_diagrams.push_back(std::get<Element::DataType_Diagram>(element->data));
+               // The evicted diagrams are loaded into the copy so that they stay evicted in the container
+               if(element->diagram_is_evicted)
+               {
+                   element->cache_of_the_entry->Load(*element->cache_entry, checked_diagrams.back());
+               }
            }
        }
     });
@@ -113,43 +194,384 @@ std::vector<DiagramSpecialized> DiagramContainer::GetCheckedDiagrams(void)
 
 QModelIndex DiagramContainer::AddDiagramFromNetwork(const std::string connection_name, const DiagramSpecialized& diagram)
 {
-    return AddDiagram(network_element, diagram,
-            [&]() -> Element*
-            {
-                // Looking for the connection element that contains the diagrams of this file and creating it if it does not exists
-                Element::DataType_Connection connection_element_data(connection_name);
-                Element* connection_element = network_element->GetChildWithData(connection_element_data);
-                if(nullptr == connection_element)
-                {
-                    connection_element = AddChildToElement(network_element, connection_element_data);
-                }
-                return connection_element;
-            });
+    return AddDiagramsFromNetwork(connection_name, std::vector<DiagramSpecialized>(1, diagram));
 }
 
 QModelIndex DiagramContainer::AddDiagramFromFile(const std::string file_name, const std::string& file_path, const DiagramSpecialized& diagram)
 {
-    return AddDiagram(files_element, diagram,
-            [&]() -> Element*
+    return AddDiagramsFromFile(file_name, file_path, std::vector<DiagramSpecialized>(1, diagram));
+}
+
+QModelIndex DiagramContainer::AddDiagramsFromNetwork(const std::string& connection_name, std::vector<DiagramSpecialized>&& diagrams)
+{
+    return AddDiagrams(network_element, std::move(diagrams), [&]() -> Element* {return GetConnectionElement(connection_name);});
+}
+
+QModelIndex DiagramContainer::AddDiagramsFromFile(const std::string& file_name, const std::string& file_path, std::vector<DiagramSpecialized>&& diagrams)
+{
+    return AddDiagrams(files_element, std::move(diagrams), [&]() -> Element* {return GetFileElement(file_name, file_path);});
+}
+
+void DiagramContainer::PublishDiagramsFromNetwork(const std::string& connection_name, std::vector<DiagramSpecialized>&& diagrams)
+{
+    published_diagrams.Publish(PublishedDiagramQueue::Batch(connection_name, std::string(), false, std::move(diagrams)));
+}
+
+void DiagramContainer::PublishDiagramsFromFile(const std::string& file_name, const std::string& file_path, std::vector<DiagramSpecialized>&& diagrams)
+{
+    published_diagrams.Publish(PublishedDiagramQueue::Batch(file_name, file_path, true, std::move(diagrams)));
+}
+
+void DiagramContainer::AddPublishedDiagrams(void)
+{
+    // Every batch is added with a single insertion, the batches are added in the order of their publication
+    for(auto& i : published_diagrams.TakeAll())
+    {
+        std::size_t number_of_new_diagrams = i.diagrams.size();
+        QModelIndex first_new_diagram;
+        if(i.is_from_file)
+        {
+            first_new_diagram = AddDiagramsFromFile(i.source_name, i.file_path, std::move(i.diagrams));
+        }
+        else
+        {
+            first_new_diagram = AddDiagramsFromNetwork(i.source_name, std::move(i.diagrams));
+            store_latency_histogram.Add((std::chrono::steady_clock::now() - i.publish_time), number_of_new_diagrams);
+        }
+
+        emit PublishedDiagramsWereAdded(first_new_diagram, number_of_new_diagrams);
+    }
+}
+
+void DiagramContainer::SaveSnapshot(const std::string& snapshot_file_path)
+{
+    // The snapshot is written into a temporary file first, so a failed save does not destroy the previous snapshot
+    std::string temporary_file_path = snapshot_file_path + ".tmp";
+    std::ofstream snapshot_file(temporary_file_path, (std::ofstream::out | std::ofstream::binary | std::ofstream::trunc));
+    if(!snapshot_file.is_open())
+    {
+        std::string errorMessage = "The snapshot file could not be opened: " + temporary_file_path;
+        throw errorMessage;
+    }
+
+    // Layout: header, then the data points of the diagrams in the same format as in the diagram cache, then the metadata (hierarchy, titles, check states)
+    // The metadata is written last because it contains the location of the data points, the header tells where it can be found
+    std::vector<char> header(snapshot_header_size, 0);
+    snapshot_file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    std::uint64_t position = snapshot_header_size;
+    std::vector<char> metadata;
+    // The location of every saved diagram in the new snapshot, the diagrams of a replaced snapshot are moved over to these
+    std::vector<std::pair<Element*, DiagramCache::Entry> > saved_entries;
+
+    auto save_diagrams = [&](Element* parent_element)
+    {
+        std::uint64_t number_of_diagrams = parent_element->GetNumberOfChildren();
+        DiagramCache::AppendToBuffer(metadata, &number_of_diagrams, sizeof(number_of_diagrams));
+        for(const auto& i : parent_element->children)
+        {
+            const auto& diagram = std::get<Element::DataType_Diagram>(i->data);
+
+            // The data points of the evicted diagrams are copied from the cache without loading them into the diagrams
+            std::vector<char> data_points = (i->diagram_is_evicted ? i->cache_of_the_entry->Read(*i->cache_entry) : DiagramCache::Serialize(diagram));
+            snapshot_file.write(data_points.data(), static_cast<std::streamsize>(data_points.size()));
+            DiagramCache::Entry entry(position, data_points.size());
+            position += entry.size;
+            saved_entries.emplace_back(i.get(), entry);
+
+            AppendStringToBuffer(metadata, diagram.GetTitle());
+            AppendStringToBuffer(metadata, diagram.GetAxisXTitle());
+            std::uint64_t number_of_data_lines = diagram.GetTheNumberOfDataLines();
+            DiagramCache::AppendToBuffer(metadata, &number_of_data_lines, sizeof(number_of_data_lines));
+            for(std::size_t data_line_index = 0; data_line_index < number_of_data_lines; data_line_index++)
             {
-                // Looking for the file name element that contains the diagrams of this file and creating it if it does not exists
-                Element::DataType_File file_name_element_data(file_name, file_path);
-                Element* file_name_element = files_element->GetChildWithData(file_name_element_data);
-                if(nullptr == file_name_element)
-                {
-                    file_name_element = AddChildToElement(files_element, file_name_element_data);
-                }
-                return file_name_element;
-            });
+                AppendStringToBuffer(metadata, diagram.GetDataLineTitle(data_line_index));
+            }
+            std::uint8_t check_state = static_cast<std::uint8_t>(i->check_state);
+            DiagramCache::AppendToBuffer(metadata, &check_state, sizeof(check_state));
+            DiagramCache::AppendToBuffer(metadata, &entry.offset, sizeof(entry.offset));
+            DiagramCache::AppendToBuffer(metadata, &entry.size, sizeof(entry.size));
+        }
+    };
+
+    // The files and the connections are saved with their diagrams (the empty elements are not saved)
+    for(Element* type_parent : {files_element, network_element})
+    {
+        std::uint64_t number_of_sources = 0;
+        for(const auto& i : type_parent->children)
+        {
+            if(!i->ContainsType<Element::DataType_Name>())
+            {
+                number_of_sources++;
+            }
+        }
+        DiagramCache::AppendToBuffer(metadata, &number_of_sources, sizeof(number_of_sources));
+
+        for(const auto& i : type_parent->children)
+        {
+            if(i->ContainsType<Element::DataType_File>())
+            {
+                AppendStringToBuffer(metadata, std::get<Element::DataType_File>(i->data).name);
+                AppendStringToBuffer(metadata, std::get<Element::DataType_File>(i->data).path);
+                save_diagrams(i.get());
+            }
+            else if(i->ContainsType<Element::DataType_Connection>())
+            {
+                AppendStringToBuffer(metadata, std::get<Element::DataType_Connection>(i->data).name);
+                save_diagrams(i.get());
+            }
+        }
+    }
+    snapshot_file.write(metadata.data(), static_cast<std::streamsize>(metadata.size()));
+
+    // Writing the header now that the location of the metadata is known
+    std::uint64_t metadata_size = metadata.size();
+    header.clear();
+    DiagramCache::AppendToBuffer(header, snapshot_file_identifier, snapshot_file_identifier_size);
+    DiagramCache::AppendToBuffer(header, &position, sizeof(position));
+    DiagramCache::AppendToBuffer(header, &metadata_size, sizeof(metadata_size));
+    snapshot_file.seekp(0);
+    snapshot_file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    snapshot_file.close();
+    if(!snapshot_file.good())
+    {
+        std::remove(temporary_file_path.c_str());
+        std::string errorMessage = "The snapshot could not be written to the file: " + temporary_file_path;
+        throw errorMessage;
+    }
+
+    // The previous snapshot can be open as the cache of the loaded diagrams, it is closed before the file is replaced
+    std::vector<DiagramCache*> replaced_caches;
+    for(const auto& i : snapshot_caches)
+    {
+        if(snapshot_file_path == i->GetCacheFilePath())
+        {
+            replaced_caches.push_back(i.get());
+        }
+    }
+    std::vector<std::pair<Element*, DiagramCache::Entry> > moved_entries;
+    for(const auto& i : saved_entries)
+    {
+        if(replaced_caches.end() != std::find(replaced_caches.begin(), replaced_caches.end(), i.first->cache_of_the_entry))
+        {
+            moved_entries.push_back(i);
+        }
+    }
+    snapshot_caches.erase(std::remove_if(snapshot_caches.begin(), snapshot_caches.end(),
+                                         [&](const std::unique_ptr<DiagramCache>& cache){return (snapshot_file_path == cache->GetCacheFilePath());}),
+                          snapshot_caches.end());
+
+    // Replacing the previous snapshot with the new one, if this fails then the diagrams of the previous snapshot are read from the new one under its temporary name
+    std::remove(snapshot_file_path.c_str());
+    bool snapshot_file_was_renamed = (0 == std::rename(temporary_file_path.c_str(), snapshot_file_path.c_str()));
+    if(!moved_entries.empty())
+    {
+        snapshot_caches.push_back(std::make_unique<DiagramCache>((snapshot_file_was_renamed ? snapshot_file_path : temporary_file_path), true));
+        for(const auto& i : moved_entries)
+        {
+            i.first->cache_entry = i.second;
+            i.first->cache_of_the_entry = snapshot_caches.back().get();
+        }
+    }
+    if(!snapshot_file_was_renamed)
+    {
+        std::string errorMessage = "The snapshot file could not be renamed to: " + snapshot_file_path;
+        throw errorMessage;
+    }
+}
+
+std::size_t DiagramContainer::LoadSnapshot(const std::string& snapshot_file_path)
+{
+    std::size_t number_of_loaded_diagrams = 0;
+
+    // The snapshot file is used as a read only diagram cache, so only the metadata is read now and the data points are read when the diagrams are requested
+    // The cache is kept from the first added diagram on, so the diagrams that were added before a corrupted part of the file remain readable
+    auto snapshot_cache = std::make_unique<DiagramCache>(snapshot_file_path, true);
+    DiagramCache* snapshot_cache_of_the_diagrams = snapshot_cache.get();
+    std::size_t position = 0;
+    auto header = snapshot_cache->Read(DiagramCache::Entry(0, snapshot_header_size));
+    if(!std::equal(snapshot_file_identifier, (snapshot_file_identifier + snapshot_file_identifier_size), header.begin()))
+    {
+        std::string errorMessage = "The file is not a snapshot of the diagrams: " + snapshot_file_path;
+        throw errorMessage;
+    }
+    position += snapshot_file_identifier_size;
+    DiagramCache::Entry metadata_entry;
+    DiagramCache::ReadFromBuffer(header, position, &metadata_entry.offset, sizeof(metadata_entry.offset));
+    DiagramCache::ReadFromBuffer(header, position, &metadata_entry.size, sizeof(metadata_entry.size));
+    auto metadata = snapshot_cache->Read(metadata_entry);
+    position = 0;
+
+    auto load_diagrams = [&](Element* type_parent, const std::function<Element*(void)> storage_logic, const bool& skip_the_diagrams)
+    {
+        std::uint64_t number_of_diagrams;
+        DiagramCache::ReadFromBuffer(metadata, position, &number_of_diagrams, sizeof(number_of_diagrams));
+        if(((metadata.size() - position) / snapshot_minimum_metadata_size_of_diagram) < number_of_diagrams)
+        {
+            std::string errorMessage = "The snapshot file is corrupted, it contains more diagrams than its metadata can describe: " + snapshot_file_path;
+            throw errorMessage;
+        }
+        std::vector<DiagramSpecialized> diagrams;
+        std::vector<DiagramCache::Entry> entries;
+        std::vector<Qt::CheckState> check_states;
+        diagrams.reserve(number_of_diagrams);
+        entries.reserve(number_of_diagrams);
+        check_states.reserve(number_of_diagrams);
+        for(std::uint64_t i = 0; i < number_of_diagrams; i++)
+        {
+            std::string title = ReadStringFromBuffer(metadata, position);
+            std::string axis_x_title = ReadStringFromBuffer(metadata, position);
+            diagrams.emplace_back(title, axis_x_title);
+            std::uint64_t number_of_data_lines;
+            DiagramCache::ReadFromBuffer(metadata, position, &number_of_data_lines, sizeof(number_of_data_lines));
+            for(std::uint64_t data_line_index = 0; data_line_index < number_of_data_lines; data_line_index++)
+            {
+                diagrams.back().AddNewDataLine(ReadStringFromBuffer(metadata, position));
+            }
+            std::uint8_t check_state;
+            DiagramCache::ReadFromBuffer(metadata, position, &check_state, sizeof(check_state));
+            if(static_cast<std::uint8_t>(Qt::Checked) < check_state)
+            {
+                std::string errorMessage = "The snapshot file is corrupted, it contains an invalid check state: " + snapshot_file_path;
+                throw errorMessage;
+            }
+            check_states.push_back(static_cast<Qt::CheckState>(check_state));
+            entries.emplace_back();
+            DiagramCache::ReadFromBuffer(metadata, position, &entries.back().offset, sizeof(entries.back().offset));
+            DiagramCache::ReadFromBuffer(metadata, position, &entries.back().size, sizeof(entries.back().size));
+        }
+
+        if((!skip_the_diagrams) && (!diagrams.empty()))
+        {
+            // The diagrams are added as evicted diagrams whose data points are in the snapshot
+            if(snapshot_cache)
+            {
+                snapshot_caches.push_back(std::move(snapshot_cache));
+            }
+            // The check states are restored while the diagrams are added, because the retention policy of a connection might remove some of them
+            AddDiagrams(type_parent, std::move(diagrams), storage_logic, snapshot_cache_of_the_diagrams, entries, check_states);
+            number_of_loaded_diagrams += number_of_diagrams;
+        }
+    };
+
+    // The files that are already stored in the container are not loaded again
+    std::uint64_t number_of_files;
+    DiagramCache::ReadFromBuffer(metadata, position, &number_of_files, sizeof(number_of_files));
+    for(std::uint64_t i = 0; i < number_of_files; i++)
+    {
+        std::string file_name = ReadStringFromBuffer(metadata, position);
+        std::string file_path = ReadStringFromBuffer(metadata, position);
+        load_diagrams(files_element, [&]() -> Element* {return GetFileElement(file_name, file_path);}, IsThisFileAlreadyStored(file_name, file_path));
+    }
+    std::uint64_t number_of_connections;
+    DiagramCache::ReadFromBuffer(metadata, position, &number_of_connections, sizeof(number_of_connections));
+    for(std::uint64_t i = 0; i < number_of_connections; i++)
+    {
+        std::string connection_name = ReadStringFromBuffer(metadata, position);
+        load_diagrams(network_element, [&]() -> Element* {return GetConnectionElement(connection_name);}, false);
+    }
+
+    // The snapshot was moved among the caches with its first diagram, it needs to be kept open as long as its diagrams are in the container
+    return number_of_loaded_diagrams;
+}
+
+bool DiagramContainer::SetPinned(const QModelIndex& model_index, const bool& new_is_pinned)
+{
+    bool result = false;
+
+    // Only the diagrams can be pinned
+    if(model_index.isValid())
+    {
+        Element* element = static_cast<Element*>(model_index.internalPointer());
+        if(element->ContainsType<Element::DataType_Diagram>())
+        {
+            if(new_is_pinned != element->is_pinned)
+            {
+                element->is_pinned = new_is_pinned;
+                emit dataChanged(model_index, model_index, QVector<int>({Qt::DisplayRole}));
+            }
+            result = true;
+        }
+    }
+
+    return result;
 }
 
-QModelIndex DiagramContainer::AddDiagram(Element* type_parent, const DiagramSpecialized& diagram, const std::function<Element*(void)> storage_logic)
+bool DiagramContainer::IsPinned(const QModelIndex& model_index) const
+{
+    bool result = false;
+
+    if(model_index.isValid())
+    {
+        result = static_cast<const Element*>(model_index.internalPointer())->is_pinned;
+    }
+
+    return result;
+}
+
+void DiagramContainer::SetRetentionPolicy(const std::string& connection_name, const RetentionPolicy& new_retention_policy)
+{
+    if(new_retention_policy.IsUnlimited())
+    {
+        retention_policies.erase(connection_name);
+    }
+    else
+    {
+        retention_policies[connection_name] = new_retention_policy;
+
+        // The new policy is applied to the diagrams that were already received on the connection
+        Element* connection_element = network_element->GetChildWithData(Element::DataType_Connection(connection_name));
+        if(nullptr != connection_element)
+        {
+            EnforceRetentionPolicy(connection_element, std::chrono::steady_clock::now());
+        }
+    }
+}
+
+RetentionPolicy DiagramContainer::GetRetentionPolicy(const std::string& connection_name) const
+{
+    RetentionPolicy result;
+
+    auto iterator = retention_policies.find(connection_name);
+    if(retention_policies.end() != iterator)
+    {
+        result = iterator->second;
+    }
+
+    return result;
+}
+
+std::size_t DiagramContainer::EnforceRetentionPolicies(const std::chrono::steady_clock::time_point& now)
+{
+    std::size_t result = 0;
+
+    // The limits of the number of diagrams and the memory usage are enforced when the diagrams are added, this is needed for the maximum age
+    for(const auto& i : retention_policies)
+    {
+        Element* connection_element = network_element->GetChildWithData(Element::DataType_Connection(i.first));
+        if(nullptr != connection_element)
+        {
+            result += EnforceRetentionPolicy(connection_element, now);
+        }
+    }
+
+    return result;
+}
+
+QModelIndex DiagramContainer::AddDiagrams(Element* type_parent, std::vector<DiagramSpecialized>&& diagrams, const std::function<Element*(void)> storage_logic,
+                                          DiagramCache* cache_of_the_diagrams, const std::vector<DiagramCache::Entry>& cache_entries,
+                                          const std::vector<Qt::CheckState>& check_states)
 {
     // The type parent is the top level element that determines the source of the diagram
     // This must be either the files_element or the network_element helper variable
     if((files_element != type_parent) && (network_element != type_parent))
     {
-        throw("ERROR! The DiagramContainer::AddDiagram has received an unknown type_parent!");
+        throw("ERROR! The DiagramContainer::AddDiagrams has received an unknown type_parent!");
+    }
+
+    // Without diagrams there is nothing to add and no parent element shall be created
+    if(diagrams.empty())
+    {
+        return QModelIndex();
     }
 
     // If the empty element is still present before the type parent, then we remove it
@@ -159,97 +581,452 @@ QModelIndex DiagramContainer::AddDiagram(Element* type_parent, const DiagramSpec
         RemoveChildFromElement(type_parent, empty_element);
     }
 
-    // Selecting the parent element to which the diagram will be added
+    // Selecting the parent element to which the diagrams will be added
     // This logic is provided to this function by the caller
     auto parent_element = storage_logic();
 
-    // Adding the diagram to the element that represents this file
-    Element* new_diagram_element = AddChildToElement(parent_element, diagram);
-    // The diagram elements are always editable
-    new_diagram_element->flags |= Qt::ItemIsEditable;
+    // Moving the diagrams into the element that represents this file or connection with a single insertion
+    std::vector<Element::DataType> data_of_the_new_elements;
+    data_of_the_new_elements.reserve(diagrams.size());
+    for(auto& i : diagrams)
+    {
+        data_of_the_new_elements.emplace_back(std::move(i));
+    }
+    diagrams.clear();
+    // The diagram elements are always editable
+    Element* first_new_diagram_element = AddChildrenToElement(parent_element, std::move(data_of_the_new_elements), Qt::ItemIsEditable);
+
+    // The new diagrams count as the most recently viewed ones, the older diagrams will be evicted first if the memory budget was exceeded
+    // If the data points of the new diagrams are in a cache, then the diagrams are added as already evicted ones
+    // The given check states are restored before the retention policy, so the checked diagrams are protected by it
+    std::vector<Element*> changed_elements;
+    for(std::size_t row = first_new_diagram_element->row; row < parent_element->GetNumberOfChildren(); row++)
+    {
+        Element* new_diagram_element = parent_element->GetChildWithIndex(row);
+        std::size_t index_of_new_diagram = row - first_new_diagram_element->row;
+        if((index_of_new_diagram < check_states.size()) && (check_states[index_of_new_diagram] != new_diagram_element->check_state))
+        {
+            new_diagram_element->check_state = check_states[index_of_new_diagram];
+            changed_elements.push_back(new_diagram_element);
+        }
+        if(nullptr != cache_of_the_diagrams)
+        {
+            new_diagram_element->diagram_is_evicted = true;
+            new_diagram_element->cache_entry = cache_entries.at(index_of_new_diagram);
+            new_diagram_element->cache_of_the_entry = cache_of_the_diagrams;
+        }
+        else
+        {
+            AddToRecentlyViewedDiagrams(new_diagram_element);
+        }
+    }
+    // The parents are updated the same way as if the user had checked the diagrams
+    if(!changed_elements.empty())
+    {
+        parent_element->ChildsCheckStateHasChanged(changed_elements);
+        NotifyAboutCheckStateChanges(changed_elements);
+    }
+
+    // The retention policy of a connection might remove the oldest diagrams, even some of the new ones if there are more of them than allowed
+    // This is done before the memory budget is enforced, so the diagrams that are about to be removed are not written to the diagram cache
+    std::size_t first_new_diagram_row = first_new_diagram_element->row;
+    if(network_element == type_parent)
+    {
+        EnforceRetentionPolicy(parent_element, std::chrono::steady_clock::now(), &first_new_diagram_row);
+    }
+    EnforceMemoryBudget();
+
+    QModelIndex result;
+    Element* first_remaining_new_diagram_element = parent_element->GetChildWithIndex(first_new_diagram_row);
+    if(nullptr != first_remaining_new_diagram_element)
+    {
+        result = GetModelIndexOfElement(first_remaining_new_diagram_element);
+    }
+
+    return result;
+}
+
+DiagramContainer::Element* DiagramContainer::GetFileElement(const std::string& file_name, const std::string& file_path)
+{
+    // Looking for the file name element that contains the diagrams of this file and creating it if it does not exists
+    Element::DataType_File file_name_element_data(file_name, file_path);
+    Element* file_name_element = files_element->GetChildWithData(file_name_element_data);
+    if(nullptr == file_name_element)
+    {
+        file_name_element = AddChildToElement(files_element, file_name_element_data);
+    }
+    return file_name_element;
+}
+
+DiagramContainer::Element* DiagramContainer::GetConnectionElement(const std::string& connection_name)
+{
+    // Looking for the connection element that contains the diagrams of this connection and creating it if it does not exists
+    Element::DataType_Connection connection_element_data(connection_name);
+    Element* connection_element = network_element->GetChildWithData(connection_element_data);
+    if(nullptr == connection_element)
+    {
+        connection_element = AddChildToElement(network_element, connection_element_data);
+    }
+    return connection_element;
+}
+
+void DiagramContainer::AppendStringToBuffer(std::vector<char>& buffer, const std::string& string)
+{
+    std::uint64_t size = string.size();
+    DiagramCache::AppendToBuffer(buffer, &size, sizeof(size));
+    DiagramCache::AppendToBuffer(buffer, string.data(), string.size());
+}
+
+std::string DiagramContainer::ReadStringFromBuffer(const std::vector<char>& buffer, std::size_t& position)
+{
+    std::uint64_t size;
+    DiagramCache::ReadFromBuffer(buffer, position, &size, sizeof(size));
+    if((buffer.size() - position) < size)
+    {
+        std::string errorMessage = "The binary data is corrupted, a string is longer than the remaining data!";
+        throw errorMessage;
+    }
+    std::string result(buffer.data() + position, static_cast<std::size_t>(size));
+    position += size;
+    return result;
+}
+
+QModelIndex DiagramContainer::GetModelIndexOfElement(Element *element) const
+{
+    QModelIndex result;
+    std::size_t index_of_element;
+
+    // The root element is represented by the invalid model index
+    if((!element->IsRoot()) && element->parent->GetIndexWithChild(element, index_of_element))
+    {
+        result = createIndex(static_cast<int>(index_of_element), (column_count - 1), element);
+    }
+
+    return result;
+}
+
+DiagramContainer::Element* DiagramContainer::AddChildToElement(Element* element, const Element::DataType& data)
+{
+    return AddChildrenToElement(element, std::vector<Element::DataType>(1, data));
+}
+
+DiagramContainer::Element* DiagramContainer::AddChildrenToElement(Element* element, std::vector<Element::DataType>&& data, const Qt::ItemFlags& additional_flags)
+{
+    Element* result = nullptr;
+
+    if(!data.empty())
+    {
+        std::size_t first_new_row = element->GetNumberOfChildren();
+        std::size_t last_new_row = first_new_row + data.size() - 1;
+
+        // The lazily populated elements only expose the new children if the views have already fetched every earlier child and at most one batch of them
+        // The rest of the new children will be exposed when the views fetch them
+        std::size_t number_of_exposed_new_children = data.size();
+        if(element->IsPopulatedLazily())
+        {
+            number_of_exposed_new_children = ((element->number_of_fetched_children == first_new_row) ? std::min(data.size(), fetch_batch_size) : 0);
+        }
+
+        // Notifying the views that an insertion will happen, all the exposed children are inserted as one contiguous range
+        if(0 < number_of_exposed_new_children)
+        {
+            beginInsertRows(GetModelIndexOfElement(element), static_cast<int>(first_new_row), static_cast<int>(first_new_row + number_of_exposed_new_children - 1));
+        }
+
+        // The childs check_state will be inherited from the parent in a way to respect the tri-state checkedness
+        // (If the parent is partially checked then the child will not be checked)
+        Qt::CheckState childs_check_state;
+        if(Qt::CheckState::Checked == element->check_state)
+        {
+            childs_check_state = Qt::CheckState::Checked;
+        }
+        else
+        {
+            childs_check_state = Qt::CheckState::Unchecked;
+        }
+
+        // Creating the children, the data is moved into them
+        // (The childs flags are inherited from the parent and extended with the additional flags)
+        // The new diagrams are added to the search index and the ones matching the current filter are accepted before the views are notified
+        bool a_child_was_accepted_by_the_filter = false;
+        std::size_t last_accepted_row = 0;
+        element->ReserveChildren(last_new_row + 1);
+        for(auto& i : data)
+        {
+            Element* child = element->CreateChild(std::move(i), (element->flags | additional_flags), childs_check_state);
+            if(nullptr == result)
+            {
+                result = child;
+            }
+            if(child->ContainsType<Element::DataType_Diagram>())
+            {
+                IndexDiagram(child);
+                if((!filter.empty()) && search_index.IsMatching(child, filter))
+                {
+                    elements_accepted_by_filter.insert(child);
+                    a_child_was_accepted_by_the_filter = true;
+                    last_accepted_row = child->row;
+                }
+            }
+        }
+        element->number_of_fetched_children += number_of_exposed_new_children;
+
+        // Notifying the views that an insertion just happened
+        if(0 < number_of_exposed_new_children)
+        {
+            endInsertRows();
+        }
+
+        // The accepted children are exposed to the views, since the filtered views would not fetch the many rejected children before them
+        // The parents of the accepted children need to be accepted as well, otherwise the children could not be reached in the filtered views
+        if(a_child_was_accepted_by_the_filter)
+        {
+            FetchChildrenOfElement(element, (last_accepted_row + 1));
+            AcceptElementByFilter(element);
+        }
+    }
+
+    return result;
+}
+
+void DiagramContainer::FetchChildrenOfElement(Element* element, const std::size_t& new_number_of_fetched_children)
+{
+    std::size_t number_of_fetched_children = element->GetNumberOfFetchedChildren();
+    std::size_t last_fetched_row = std::min(new_number_of_fetched_children, element->GetNumberOfChildren());
+
+    // The children are exposed to the views in the order of their rows, so the fetched children are inserted as one contiguous range
+    if(number_of_fetched_children < last_fetched_row)
+    {
+        beginInsertRows(GetModelIndexOfElement(element), static_cast<int>(number_of_fetched_children), static_cast<int>(last_fetched_row - 1));
+        element->number_of_fetched_children = last_fetched_row;
+        endInsertRows();
+    }
+}
+
+void DiagramContainer::RemoveChildFromElement(Element* element, Element* child)
+{
+    std::size_t index_of_child;
+
+    // Checking whether the child exists
+    if(element->GetIndexWithChild(child, index_of_child))
+    {
+        // The views only need to be notified if the child was already fetched by them
+        bool child_was_fetched = (index_of_child < element->GetNumberOfFetchedChildren());
+
+        // Notifying the views that a removal will happen
+        if(child_was_fetched)
+        {
+            beginRemoveRows(GetModelIndexOfElement(element), static_cast<int>(index_of_child), static_cast<int>(index_of_child));
+        }
+
+        // Removing the selected child
+        ForgetDiagramsBelow(child);
+        element->KillChild(index_of_child);
+
+        // Notifying the views that a removal just happened
+        if(child_was_fetched)
+        {
+            endRemoveRows();
+        }
+    }
+}
+
+void DiagramContainer::RemoveChildrenFromElement(Element* element, const std::size_t& first_row, const std::size_t& number_of_rows, std::size_t* tracked_row)
+{
+    if((0 < number_of_rows) && ((first_row + number_of_rows) <= element->GetNumberOfChildren()))
+    {
+        // The views only need to be notified about the children that were already fetched by them
+        std::size_t number_of_fetched_children = element->GetNumberOfFetchedChildren();
+        bool children_were_fetched = (first_row < number_of_fetched_children);
+
+        if(children_were_fetched)
+        {
+            std::size_t last_fetched_row = std::min((first_row + number_of_rows), number_of_fetched_children) - 1;
+            beginRemoveRows(GetModelIndexOfElement(element), static_cast<int>(first_row), static_cast<int>(last_fetched_row));
+        }
+
+        for(std::size_t row = first_row; row < (first_row + number_of_rows); row++)
+        {
+            ForgetDiagramsBelow(element->GetChildWithIndex(row));
+        }
+        element->KillChildren(first_row, number_of_rows);
+
+        if(children_were_fetched)
+        {
+            endRemoveRows();
+        }
+
+        // Following the row of the caller, if the child in that row was removed, then the next remaining child will be in the tracked row
+        if(nullptr != tracked_row)
+        {
+            if((first_row + number_of_rows) <= *tracked_row)
+            {
+                *tracked_row -= number_of_rows;
+            }
+            else if(first_row < *tracked_row)
+            {
+                *tracked_row = first_row;
+            }
+        }
+    }
+}
+
+std::size_t DiagramContainer::EnforceRetentionPolicy(Element* connection_element, const std::chrono::steady_clock::time_point& now, std::size_t* tracked_row)
+{
+    std::size_t result = 0;
+
+    auto iterator = retention_policies.find(std::get<Element::DataType_Connection>(connection_element->data).name);
+    if(retention_policies.end() != iterator)
+    {
+        const RetentionPolicy& policy = iterator->second;
+        std::size_t remaining_number_of_diagrams = connection_element->GetNumberOfDiagrams();
+        std::size_t remaining_memory_usage = connection_element->GetMemoryUsage();
+
+        // The diagrams are stored in the order of their arrival, so the oldest diagrams are selected from the first rows
+        // The selected rows are collected as ranges, because the pinned and the checked diagrams interrupt them
+        std::vector<std::pair<std::size_t, std::size_t> > ranges_to_remove;
+        for(std::size_t row = 0; row < connection_element->GetNumberOfChildren(); row++)
+        {
+            Element* child = connection_element->GetChildWithIndex(row);
+
+            bool too_many_diagrams = ((0 != policy.maximum_number_of_diagrams) && (policy.maximum_number_of_diagrams < remaining_number_of_diagrams));
+            bool too_much_memory = ((0 != policy.maximum_memory_usage_in_bytes) && (policy.maximum_memory_usage_in_bytes < remaining_memory_usage));
+            bool too_old = ((0 != policy.maximum_age.count()) && (policy.maximum_age < (now - child->arrival_time)));
+            if(!(too_many_diagrams || too_much_memory || too_old))
+            {
+                // Every limit is kept and the remaining diagrams are even newer
+                break;
+            }
+
+            if((!child->is_pinned) && (Qt::Unchecked == child->check_state))
+            {
+                remaining_number_of_diagrams -= child->GetNumberOfDiagrams();
+                remaining_memory_usage -= child->GetMemoryUsage();
 
-    return GetModelIndexOfElement(new_diagram_element);
-}
+                if((!ranges_to_remove.empty()) && ((ranges_to_remove.back().first + ranges_to_remove.back().second) == row))
+                {
+                    ranges_to_remove.back().second++;
+                }
+                else
+                {
+                    ranges_to_remove.emplace_back(row, 1);
+                }
+                result++;
+            }
+        }
 
-QModelIndex DiagramContainer::GetModelIndexOfElement(Element *element) const
-{
-    QModelIndex result;
-    std::size_t index_of_element;
+        // Removing the last range first, so the rows of the other ranges remain valid
+        for(auto range = ranges_to_remove.rbegin(); range != ranges_to_remove.rend(); range++)
+        {
+            RemoveChildrenFromElement(connection_element, range->first, range->second, tracked_row);
+        }
 
-    if(element->parent->GetIndexWithChild(element, index_of_element))
-    {
-        result = createIndex(static_cast<int>(index_of_element), (column_count - 1), element);
+        // Only unchecked diagrams were removed, so the remaining checked diagrams might change the check state of the connection
+        if((0 != result) && (0 < connection_element->GetNumberOfChildren()))
+        {
+            std::vector<Element*> changed_elements;
+            connection_element->ChildsCheckStateHasChanged(changed_elements);
+            NotifyAboutCheckStateChanges(changed_elements);
+        }
     }
 
     return result;
 }
 
-DiagramContainer::Element* DiagramContainer::AddChildToElement(Element* element, const Element::DataType& data)
+void DiagramContainer::SetCheckStateOfElement(Element* element, const Qt::CheckState& new_check_state)
 {
-    Element* result = nullptr;
-
-    // Notifying the views that an insertion will happen
-    beginInsertRows(GetModelIndexOfElement(element), static_cast<int>(element->GetNumberOfChildren()), static_cast<int>(element->GetNumberOfChildren()));
+    // The elements whose check state has really changed, only these will be reported to the views
+    std::vector<Element*> changed_elements;
 
+    // Setting the new check state for this element and all the elements below this
+    element->CallFunctionOnElementsRecursive(
+        [&](Element* element_to_change)
+        {
+            if(new_check_state != element_to_change->check_state)
+            {
+                element_to_change->check_state = new_check_state;
+                changed_elements.push_back(element_to_change);
+            }
+        });
 
-    // The childs check_state will be inherited from the parent in a way to respect the tri-state checkedness
-    // (If the parent is partially checked then the child will not be checked)
-    Qt::CheckState childs_check_state;
-    if(Qt::CheckState::Checked == element->check_state)
-    {
-        childs_check_state = Qt::CheckState::Checked;
-    }
-    else
+    // Root elements do not have a parent and if there is no parent to notify then there is nothing to do here
+    if(!element->IsRoot())
     {
-        childs_check_state = Qt::CheckState::Unchecked;
+        element->parent->ChildsCheckStateHasChanged(changed_elements);
     }
 
-    // Creating the child
-    // (The childs flags are simply inherited from the parent)
-    result = element->CreateChild(data, element->flags, childs_check_state);
-
-    // Notifying the views that an insertion just happened
-    endInsertRows();
-
-    return result;
+    // Notifying the views about the check_state changes
+    NotifyAboutCheckStateChanges(changed_elements);
 }
 
-void DiagramContainer::RemoveChildFromElement(Element* element, Element* child)
+void DiagramContainer::NotifyAboutCheckStateChanges(std::vector<Element*>& changed_elements)
 {
-    std::size_t index_of_child;
+    // Ordering the changed elements by their parents and then by their rows, so that the siblings with neighbouring rows can be reported as one range
+    std::sort(changed_elements.begin(), changed_elements.end(),
+              [](const Element* first, const Element* second) -> bool
+              {
+                  return ((first->parent < second->parent) || ((first->parent == second->parent) && (first->row < second->row)));
+              });
 
-    // Checking whether the child exists
-    if(element->GetIndexWithChild(child, index_of_child))
+    QVector<int> role;
+    role.append(Qt::CheckStateRole);
+
+    auto range_begin = changed_elements.begin();
+    while(changed_elements.end() != range_begin)
     {
-        // Notifying the views that a removal will happen
-        beginRemoveRows(GetModelIndexOfElement(element), static_cast<int>(index_of_child), static_cast<int>(index_of_child));
+        // Extending the range while the next element is the next sibling
+        auto range_end = range_begin;
+        while(((range_end + 1) != changed_elements.end()) &&
+              ((*(range_end + 1))->parent == (*range_end)->parent) &&
+              ((*(range_end + 1))->row == ((*range_end)->row + 1)))
+        {
+            range_end++;
+        }
 
-        // Removing the selected child
-        element->KillChild(index_of_child);
+        // The root element is not displayed by the views and the children that were not fetched yet are not known by the views, so these do not need to be reported
+        if((!(*range_begin)->IsRoot()) && ((*range_begin)->row < (*range_begin)->parent->GetNumberOfFetchedChildren()))
+        {
+            Element* last_fetched_element = (*range_begin)->parent->GetChildWithIndex(std::min((*range_end)->row, ((*range_begin)->parent->GetNumberOfFetchedChildren() - 1)));
+            emit dataChanged(GetModelIndexOfElement(*range_begin), GetModelIndexOfElement(last_fetched_element), role);
+        }
 
-        // Notifying the views that a removal just happened
-        endRemoveRows();
+        range_begin = range_end + 1;
     }
 }
 
-void DiagramContainer::SetCheckStateOfElement(Element* element, const Qt::CheckState& new_check_state)
+void DiagramContainer::IndexDiagram(const Element* element)
 {
-    // Setting the new check state for this element and all the elements below this
-    element->CallFunctionOnElementsRecursive([&new_check_state](Element* element){element->check_state = new_check_state;});
+    const auto& diagram = std::get<Element::DataType_Diagram>(element->data);
 
-    // Root elements do not have a parent and if there is no parent to notify then there is nothing to do here
-    if(!element->IsRoot())
+    // The diagram can be found by its title, the title of the X axis and the titles of the data lines
+    std::vector<std::string> texts = {diagram.GetTitle(), diagram.GetAxisXTitle()};
+    for(std::size_t i = 0; i < diagram.GetTheNumberOfDataLines(); i++)
     {
-        element->parent->ChildsCheckStateHasChanged();
+        texts.push_back(diagram.GetDataLineTitle(i));
     }
 
-    // Notifying the views about the check_state changes
-    // For the sake of simplicity, we are signaling a change for all the elements with the invalid QModelIndex
-    // If this will cause a performance issue, then a more complex solution can be introduced that sends notifications only for the changed elements,
-    // but at the moment this case seams to be highly unlikely because the number of Elements stored in the DiagramContainer are relatively low
-    QVector<int> role;
-    role.append(Qt::CheckStateRole);
-    emit dataChanged(QModelIndex(), QModelIndex(), role);
+    search_index.AddDocument(element, texts);
+}
+
+void DiagramContainer::AcceptElementByFilter(Element* element)
+{
+    // Collecting the element and its parents that were not accepted yet (the root element is not displayed, so it does not need to be accepted)
+    std::vector<Element*> newly_accepted_elements;
+    for(Element* i = element; (!i->IsRoot()) && elements_accepted_by_filter.insert(i).second; i = i->parent)
+    {
+        newly_accepted_elements.push_back(i);
+    }
+
+    // Notifying the views starting from the top, so that the filtered views can insert the rows below their already accepted parents
+    // (The elements that were not fetched yet are not known by the views, so these are not reported)
+    for(auto i = newly_accepted_elements.rbegin(); newly_accepted_elements.rend() != i; i++)
+    {
+        if((*i)->row < (*i)->parent->GetNumberOfFetchedChildren())
+        {
+            auto model_index_of_element = GetModelIndexOfElement(*i);
+            emit dataChanged(model_index_of_element, model_index_of_element);
+        }
+    }
 }
 
 void DiagramContainer::ChangeDiagramTitleOfElement(Element* element, const std::string& new_diagram_title)
@@ -268,6 +1045,20 @@ void DiagramContainer::ChangeDiagramTitleOfElement(Element* element, const std::
                 {
                     // Setting the new title
                     std::get<Element::DataType_Diagram>(element->data).SetTitle(new_diagram_title);
+                    element->UpdateMemoryUsage();
+                    // The new title needs to be searchable and it might change whether the element is accepted by the filter
+                    IndexDiagram(element);
+                    if(!filter.empty())
+                    {
+                        if(search_index.IsMatching(element, filter))
+                        {
+                            AcceptElementByFilter(element);
+                        }
+                        else
+                        {
+                            elements_accepted_by_filter.erase(element);
+                        }
+                    }
                     // Notifying the views about the change
                     auto model_index_of_element = GetModelIndexOfElement(element);
                     emit dataChanged(model_index_of_element, model_index_of_element);
@@ -277,6 +1068,108 @@ void DiagramContainer::ChangeDiagramTitleOfElement(Element* element, const std::
     }
 }
 
+std::string DiagramContainer::CreateMemoryUsageString(const std::size_t& bytes)
+{
+    static const char* const units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    static constexpr std::size_t number_of_units = sizeof(units) / sizeof(units[0]);
+
+    // Selecting the largest unit in which the value is still at least one
+    double value = static_cast<double>(bytes);
+    std::size_t unit_index = 0;
+    while((1024.0 <= value) && ((number_of_units - 1) > unit_index))
+    {
+        value /= 1024.0;
+        unit_index++;
+    }
+
+    return "Memory usage: " + QString::number(value, 'f', ((0 == unit_index) ? 0 : 2)).toStdString() + " " + units[unit_index];
+}
+
+void DiagramContainer::AddToRecentlyViewedDiagrams(Element* element)
+{
+    recently_viewed_diagrams.push_front(element);
+    element->recently_viewed_position = recently_viewed_diagrams.begin();
+}
+
+void DiagramContainer::MarkDiagramAsViewed(Element* element)
+{
+    // Moving the diagram to the front of the list, the splice does not invalidate the stored iterator
+    recently_viewed_diagrams.splice(recently_viewed_diagrams.begin(), recently_viewed_diagrams, element->recently_viewed_position);
+}
+
+void DiagramContainer::ForgetDiagramsBelow(Element* element)
+{
+    // The elements that will be removed can not remain in the list of the recently viewed diagrams, in the search index and among the accepted elements
+    element->CallFunctionOnElementsRecursive(
+        [&](Element* element_to_forget)
+        {
+            if(element_to_forget->ContainsType<Element::DataType_Diagram>())
+            {
+                if(!element_to_forget->diagram_is_evicted)
+                {
+                    recently_viewed_diagrams.erase(element_to_forget->recently_viewed_position);
+                }
+                // The extent of the diagram in the diagram cache can be reused (the snapshots are read only)
+                if(element_to_forget->cache_entry && diagram_cache && (diagram_cache.get() == element_to_forget->cache_of_the_entry))
+                {
+                    diagram_cache->Release(*element_to_forget->cache_entry);
+                }
+                search_index.RemoveDocument(element_to_forget);
+            }
+            elements_accepted_by_filter.erase(element_to_forget);
+        });
+}
+
+void DiagramContainer::EvictDiagram(Element* element)
+{
+    auto& diagram = std::get<Element::DataType_Diagram>(element->data);
+
+    if(!diagram_cache)
+    {
+        diagram_cache = std::make_unique<DiagramCache>(cache_file_path);
+    }
+
+    // The data points of a diagram can not be changed in the container, so a diagram only needs to be written to the cache once
+    // (The diagrams loaded from a snapshot already have their data points in the snapshot)
+    if(!element->cache_entry)
+    {
+        element->cache_entry = diagram_cache->Store(diagram);
+        element->cache_of_the_entry = diagram_cache.get();
+    }
+
+    recently_viewed_diagrams.erase(element->recently_viewed_position);
+    diagram.EraseDataPoints();
+    element->diagram_is_evicted = true;
+    element->UpdateMemoryUsage();
+}
+
+void DiagramContainer::ReloadDiagram(Element* element)
+{
+    element->cache_of_the_entry->Load(*element->cache_entry, std::get<Element::DataType_Diagram>(element->data));
+    element->diagram_is_evicted = false;
+    element->UpdateMemoryUsage();
+    AddToRecentlyViewedDiagrams(element);
+}
+
+void DiagramContainer::EnforceMemoryBudget(const Element* element_to_keep)
+{
+    // The eviction is disabled if there is no budget or no file that could be used as the diagram cache
+    if((0 != memory_budget) && (!cache_file_path.empty()))
+    {
+        // Evicting the least recently viewed diagrams until the memory usage is within the budget
+        while((memory_budget < root_element->GetMemoryUsage()) && (!recently_viewed_diagrams.empty()))
+        {
+            Element* least_recently_viewed_diagram = recently_viewed_diagrams.back();
+            if(element_to_keep == least_recently_viewed_diagram)
+            {
+                // This diagram can not be evicted and all the other diagrams were already evicted
+                break;
+            }
+            EvictDiagram(least_recently_viewed_diagram);
+        }
+    }
+}
+
 // --- Methods of the DiagramContainer class that override the methods of the QAbstractItemModel ------------------------------------------------------------------------------------------------------
 
 QModelIndex DiagramContainer::index(int row, int column, const QModelIndex &parent) const
@@ -304,10 +1197,11 @@ QModelIndex DiagramContainer::index(int row, int column, const QModelIndex &pare
         parent_element = root_element.get();
     }
 
-    std::size_t number_of_children = parent_element->GetNumberOfChildren();
-    if(number_of_children > static_cast<std::size_t>(row))
+    // Only the fetched children are known by the views
+    std::size_t number_of_children = parent_element->GetNumberOfFetchedChildren();
+    if((0 <= row) && (number_of_children > static_cast<std::size_t>(row)))
     {
-        if(column_count > column)
+        if((0 <= column) && (column_count > column))
         {
             Element* child_element = parent_element->GetChildWithIndex(static_cast<std::size_t>(row));
             result = createIndex(row, column, child_element);
@@ -336,7 +1230,8 @@ QModelIndex DiagramContainer::parent(const QModelIndex &index) const
         Element* parent_element = indexed_element->parent;
         if(root_element.get() != parent_element)
         {
-            result = createIndex(0, (column_count - 1), parent_element);
+            // Every element knows its own row, so the index of the parent can be created without searching
+            result = createIndex(static_cast<int>(parent_element->row), (column_count - 1), parent_element);
         }
     }
 
@@ -359,16 +1254,38 @@ int DiagramContainer::rowCount(const QModelIndex &parent) const
     if(parent.isValid())
     {
         Element* indexed_element = static_cast<Element*>(parent.internalPointer());
-        result = static_cast<int>(indexed_element->GetNumberOfChildren());
+        result = static_cast<int>(indexed_element->GetNumberOfFetchedChildren());
     }
     else
     {
-        result = static_cast<int>(root_element->GetNumberOfChildren());
+        result = static_cast<int>(root_element->GetNumberOfFetchedChildren());
     }
 
     return result;
 }
 
+bool DiagramContainer::hasChildren(const QModelIndex &parent) const
+{
+    const Element* parent_element = (parent.isValid() ? static_cast<const Element*>(parent.internalPointer()) : root_element.get());
+
+    // The element can be expanded even if its children were not fetched yet
+    return (0 < parent_element->GetNumberOfChildren());
+}
+
+bool DiagramContainer::canFetchMore(const QModelIndex &parent) const
+{
+    const Element* parent_element = (parent.isValid() ? static_cast<const Element*>(parent.internalPointer()) : root_element.get());
+
+    return (parent_element->GetNumberOfFetchedChildren() < parent_element->GetNumberOfChildren());
+}
+
+void DiagramContainer::fetchMore(const QModelIndex &parent)
+{
+    Element* parent_element = (parent.isValid() ? static_cast<Element*>(parent.internalPointer()) : root_element.get());
+
+    FetchChildrenOfElement(parent_element, (parent_element->GetNumberOfFetchedChildren() + fetch_batch_size));
+}
+
 int DiagramContainer::columnCount(const QModelIndex &parent) const
 {
 #ifdef DIAGRAM_CONTAINER_DEBUG_MODE
@@ -407,7 +1324,14 @@ QVariant DiagramContainer::data(const QModelIndex &index, int role) const
         switch(role)
         {
         case Qt::DisplayRole:
-            result = QVariant(QString::fromStdString(element->GetDisplayableString()));
+            if(element->is_pinned)
+            {
+                result = QVariant(QString::fromStdString(element->GetDisplayableString() + pinned_element_suffix));
+            }
+            else
+            {
+                result = QVariant(QString::fromStdString(element->GetDisplayableString()));
+            }
             break;
         case Qt::CheckStateRole:
             // We will only return a valid QVariant if the element is checkable
@@ -417,6 +1341,16 @@ QVariant DiagramContainer::data(const QModelIndex &index, int role) const
                 result = QVariant(element->check_state);
             }
             break;
+        case Qt::ToolTipRole:
+            if(element->diagram_is_evicted)
+            {
+                result = QVariant(QString::fromStdString(CreateMemoryUsageString(element->GetMemoryUsage()) + " (the data points are cached on the disk)"));
+            }
+            else
+            {
+                result = QVariant(QString::fromStdString(CreateMemoryUsageString(element->GetMemoryUsage())));
+            }
+            break;
         default:
             // Nothing to do here, an invalid QVariant will be returned...
             break;
@@ -512,10 +1446,101 @@ bool DiagramContainer::setData(const QModelIndex &index, const QVariant &value,
 
 // --- Methods functions of the DiagramContainer::Element class ---------------------------------------------------------------------------------------------------------------------------------------
 
-DiagramContainer::Element* DiagramContainer::Element::CreateChild(const DataType& childs_data, const Qt::ItemFlags& childs_flags, const Qt::CheckState& childs_check_state)
+DiagramContainer::Element* DiagramContainer::Element::CreateChild(DataType childs_data, const Qt::ItemFlags& childs_flags, const Qt::CheckState& childs_check_state)
+{
+    // The memory usage of the child is added to this element by the constructor of the child
+    children.push_back(std::make_unique<Element>(std::move(childs_data), this, childs_flags, childs_check_state));
+    Element* child = children.back().get();
+    child->row = children.size() - 1;
+
+    // Registering the child in the index so that it can be looked up by its data
+    auto index_key = CreateIndexKey(child->data);
+    if(index_key)
+    {
+        children_index.emplace(std::move(*index_key), child);
+    }
+
+    // The capacity of the children container and the size of the index might have changed
+    UpdateMemoryUsage();
+    return child;
+}
+
+void DiagramContainer::Element::ReserveChildren(const std::size_t& number_of_children)
+{
+    // The capacity grows geometrically, so the frequent small batches of a network connection do not move the whole vector every time
+    if(children.capacity() < number_of_children)
+    {
+        children.reserve(std::max(number_of_children, (2 * children.capacity())));
+        UpdateMemoryUsage();
+    }
+}
+
+void DiagramContainer::Element::KillTheChildren(void)
+{
+    for(const auto& i : children)
+    {
+        DecreaseMemoryUsage(i->GetMemoryUsage());
+        DecreaseNumberOfDiagrams(i->GetNumberOfDiagrams());
+    }
+    children.clear();
+    children_index.clear();
+    number_of_fetched_children = 0;
+    UpdateMemoryUsage();
+}
+
+void DiagramContainer::Element::KillChild(std::size_t child_index)
 {
-    children.push_back(std::make_unique<Element>(childs_data, this, childs_flags, childs_check_state));
-    return children.at(children.size() - 1).get();
+    KillChildren(child_index, 1);
+}
+
+void DiagramContainer::Element::KillChildren(const std::size_t& first_child_index, const std::size_t& number_of_children_to_kill)
+{
+    std::size_t end_child_index = first_child_index + number_of_children_to_kill;
+    std::vector<std::string> released_index_keys;
+
+    for(std::size_t i = first_child_index; i < end_child_index; i++)
+    {
+        // Only the first of the siblings with the same key is in the index, so the entry is only removed if it belongs to the killed child
+        auto index_key = CreateIndexKey(children[i]->data);
+        if(index_key)
+        {
+            auto iterator = children_index.find(*index_key);
+            if((children_index.end() != iterator) && (children[i].get() == iterator->second))
+            {
+                children_index.erase(iterator);
+                released_index_keys.push_back(std::move(*index_key));
+            }
+        }
+
+        DecreaseMemoryUsage(children[i]->GetMemoryUsage());
+        DecreaseNumberOfDiagrams(children[i]->GetNumberOfDiagrams());
+    }
+    children.erase((children.begin() + static_cast<std::ptrdiff_t>(first_child_index)), (children.begin() + static_cast<std::ptrdiff_t>(end_child_index)));
+    if(first_child_index < number_of_fetched_children)
+    {
+        number_of_fetched_children -= (std::min(end_child_index, number_of_fetched_children) - first_child_index);
+    }
+
+    // The children after the removed ones have moved forward, the range is removed at once so they only need to be renumbered once
+    for(std::size_t i = first_child_index; i < children.size(); i++)
+    {
+        children[i]->row = i;
+    }
+
+    // A surviving sibling with the same key as a killed child takes over its entry in the index
+    if(!released_index_keys.empty())
+    {
+        for(const auto& i : children)
+        {
+            auto index_key = CreateIndexKey(i->data);
+            if(index_key && (released_index_keys.end() != std::find(released_index_keys.begin(), released_index_keys.end(), *index_key)))
+            {
+                children_index.emplace(std::move(*index_key), i.get());
+            }
+        }
+    }
+
+    UpdateMemoryUsage();
 }
 
 DiagramContainer::Element* DiagramContainer::Element::GetChildWithIndex(const std::size_t& index)
@@ -523,7 +1548,7 @@ DiagramContainer::Element* DiagramContainer::Element::GetChildWithIndex(const st
     Element* result = nullptr;
     if(index < children.size())
     {
-        result = children.at(index).get();
+        result = children[index].get();
     }
 
     return result;
@@ -533,19 +1558,40 @@ bool DiagramContainer::Element::GetIndexWithChild(const Element* child, std::siz
 {
     bool bResult = false;
 
-    for(std::size_t i = 0; i < children.size(); i++)
+    // Every element knows its own index, this only needs to be checked
+    if((this == child->parent) && (child->row < children.size()) && (children[child->row].get() == child))
     {
-        if(children[i].get() == child)
-        {
-            index_of_child = i;
-            bResult = true;
-            break;
-        }
+        index_of_child = child->row;
+        bResult = true;
     }
 
     return bResult;
 }
 
+std::optional<std::string> DiagramContainer::Element::CreateIndexKey(const DataType& data_to_index)
+{
+    std::optional<std::string> result;
+
+    if(std::holds_alternative<Element::DataType_Name>(data_to_index))
+    {
+        result = CreateIndexKey(std::get<Element::DataType_Name>(data_to_index));
+    }
+    else if(std::holds_alternative<Element::DataType_File>(data_to_index))
+    {
+        result = CreateIndexKey(std::get<Element::DataType_File>(data_to_index));
+    }
+    else if(std::holds_alternative<Element::DataType_Connection>(data_to_index))
+    {
+        result = CreateIndexKey(std::get<Element::DataType_Connection>(data_to_index));
+    }
+    else
+    {
+        // The diagrams are not indexed, they are only accessed by their position
+    }
+
+    return result;
+}
+
 std::string DiagramContainer::Element::GetDisplayableString(void) const
 {
     std::string result;
@@ -575,7 +1621,7 @@ std::string DiagramContainer::Element::GetDisplayableString(void) const
     return result;
 }
 
-void DiagramContainer::Element::ChildsCheckStateHasChanged(void)
+void DiagramContainer::Element::ChildsCheckStateHasChanged(std::vector<Element*>& changed_elements)
 {
     // It does not make sense to call this function on an element that does not have a child,
     // but just to be on the safe side, we will check it to avoid invalid access to the children container
@@ -590,6 +1636,7 @@ void DiagramContainer::Element::ChildsCheckStateHasChanged(void)
             if(accumulated_check_state_of_the_children != i->check_state)
             {
                 accumulated_check_state_of_the_children = Qt::CheckState::PartiallyChecked;
+                break;
             }
         }
 
@@ -599,9 +1646,10 @@ void DiagramContainer::Element::ChildsCheckStateHasChanged(void)
             // We need to make sure that the new chec_state is set before notifying the parent about the changes
             // This is needed because the parent will also take into account of this element's check_state
             check_state = accumulated_check_state_of_the_children;
+            changed_elements.push_back(this);
             if(!IsRoot())
             {
-                parent->ChildsCheckStateHasChanged();
+                parent->ChildsCheckStateHasChanged(changed_elements);
             }
         }
     }
@@ -619,6 +1667,95 @@ void DiagramContainer::Element::CallFunctionOnElementsRecursive(std::function<vo
     }
 }
 
+void DiagramContainer::Element::UpdateMemoryUsage(void)
+{
+    // Only the difference between the old and the new value is applied to this element and its parents
+    std::size_t new_own_memory_usage = CalculateOwnMemoryUsage();
+    if(new_own_memory_usage > own_memory_usage)
+    {
+        IncreaseMemoryUsage(new_own_memory_usage - own_memory_usage);
+    }
+    else
+    {
+        DecreaseMemoryUsage(own_memory_usage - new_own_memory_usage);
+    }
+    own_memory_usage = new_own_memory_usage;
+}
+
+std::size_t DiagramContainer::Element::CalculateOwnMemoryUsage(void) const
+{
+    // The element itself, the pointers to the children and the buckets of the index are always present
+    std::size_t result = sizeof(*this) + (children.capacity() * sizeof(decltype(children)::value_type)) + (children_index.bucket_count() * sizeof(void*));
+
+    // Every indexed element accounts for its own node in the index of the parent (the node holds the key, the value, the next pointer and the cached hash code)
+    if(!IsRoot())
+    {
+        auto index_key = CreateIndexKey(data);
+        if(index_key)
+        {
+            result += sizeof(decltype(children_index)::value_type) + (2 * sizeof(void*)) + GetHeapMemoryUsageOfString(*index_key);
+        }
+    }
+
+    // The contained data is part of the element, so only the memory allocated by it needs to be added
+    if(std::holds_alternative<Element::DataType_Name>(data))
+    {
+        result += GetHeapMemoryUsageOfString(std::get<Element::DataType_Name>(data));
+    }
+    else if(std::holds_alternative<Element::DataType_File>(data))
+    {
+        result += GetHeapMemoryUsageOfString(std::get<Element::DataType_File>(data).name);
+        result += GetHeapMemoryUsageOfString(std::get<Element::DataType_File>(data).path);
+    }
+    else if(std::holds_alternative<Element::DataType_Connection>(data))
+    {
+        result += GetHeapMemoryUsageOfString(std::get<Element::DataType_Connection>(data).name);
+    }
+    else if(std::holds_alternative<Element::DataType_Diagram>(data))
+    {
+        result += std::get<Element::DataType_Diagram>(data).GetMemoryUsage() - sizeof(Element::DataType_Diagram);
+    }
+    else
+    {
+        std::string errorMessage = "The DiagramContainer::data has an unknown type!";
+        throw errorMessage;
+    }
+
+    return result;
+}
+
+void DiagramContainer::Element::IncreaseMemoryUsage(const std::size_t& bytes)
+{
+    for(Element* element = this; nullptr != element; element = element->parent)
+    {
+        element->memory_usage += bytes;
+    }
+}
+
+void DiagramContainer::Element::DecreaseMemoryUsage(const std::size_t& bytes)
+{
+    for(Element* element = this; nullptr != element; element = element->parent)
+    {
+        element->memory_usage -= bytes;
+    }
+}
+
+void DiagramContainer::Element::IncreaseNumberOfDiagrams(const std::size_t& diagrams)
+{
+    for(Element* element = this; nullptr != element; element = element->parent)
+    {
+        element->number_of_diagrams += diagrams;
+    }
+}
+
+void DiagramContainer::Element::DecreaseNumberOfDiagrams(const std::size_t& diagrams)
+{
+    for(Element* element = this; nullptr != element; element = element->parent)
+    {
+        element->number_of_diagrams -= diagrams;
+    }
+}
+
 #ifdef DIAGRAM_CONTAINER_DEBUG_MODE
 void DiagramContainer::Element::PrintAllElementsRecursive(const std::string& identation) const
 {
@@ -26,12 +26,26 @@
 #include <vector>
 #include <memory>
 #include <variant>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+#include <algorithm>
 
 #include <QAbstractItemModel>
 #include <QModelIndex>
 
 #include "global.hpp"
 #include "diagram.hpp"
+#include "diagram_cache.hpp"
+#include "search_index.hpp"
+#include "published_diagram_queue.hpp"
+#include "latency_histogram.hpp"
+#include "retention_policy.hpp"
 
 
 
@@ -42,6 +56,8 @@
 
 
 
+// The elements of the container can only be accessed and changed on the thread the container lives in, because the views need to be notified on that thread
+// The other threads can publish their diagrams, these are added to the container by its own thread with the usual notifications
 class DiagramContainer : public QAbstractItemModel
 {
     Q_OBJECT
@@ -57,14 +73,37 @@ public:
 
     virtual ~DiagramContainer() override = default;
 
-    std::size_t GetNumberOfDiagrams(void) const {return root_element->CountElementsWithTypeRecursive<Element::DataType_Diagram>();}
+    std::size_t GetNumberOfDiagrams(void) const {return root_element->GetNumberOfDiagrams();}
+    std::size_t GetMemoryUsage(void) const {return root_element->GetMemoryUsage();}
+    std::size_t GetMemoryUsage(const QModelIndex& model_index) const;
+    void ConfigureDiagramCache(const std::string& new_cache_file_path, const std::size_t& new_memory_budget_in_bytes);
     bool IsThisFileAlreadyStored(const std::string& file_name, const std::string& file_path);
     DiagramSpecialized* GetDiagram(const QModelIndex& model_index);
+    std::size_t SetFilter(const std::string& new_filter);
+    const std::string& GetFilter(void) const {return filter;}
+    bool IsAcceptedByFilter(const QModelIndex& model_index) const;
     void ShowCheckBoxes(void);
     void HideCheckBoxes(void);
     std::vector<DiagramSpecialized> GetCheckedDiagrams(void);
     QModelIndex AddDiagramFromNetwork(const std::string connection_name, const DiagramSpecialized& diagram);
     QModelIndex AddDiagramFromFile(const std::string file_name, const std::string& file_path, const DiagramSpecialized& diagram);
+    QModelIndex AddDiagramsFromNetwork(const std::string& connection_name, std::vector<DiagramSpecialized>&& diagrams);
+    QModelIndex AddDiagramsFromFile(const std::string& file_name, const std::string& file_path, std::vector<DiagramSpecialized>&& diagrams);
+    void SaveSnapshot(const std::string& snapshot_file_path);
+    // These can be called from any thread
+    void PublishDiagramsFromNetwork(const std::string& connection_name, std::vector<DiagramSpecialized>&& diagrams);
+    void PublishDiagramsFromFile(const std::string& file_name, const std::string& file_path, std::vector<DiagramSpecialized>&& diagrams);
+    std::size_t GetNumberOfPublishedDiagrams(void) const {return published_diagrams.GetNumberOfDiagrams();}
+    IngestQueueCounters& GetPublishedDiagramCounters(void) {return published_diagrams.GetCounters();}
+    // The time from the publication of the network diagrams until they were added to the container
+    LatencyHistogram& GetStoreLatencyHistogram(void) {return store_latency_histogram;}
+    std::size_t LoadSnapshot(const std::string& snapshot_file_path);
+    // The pinned diagrams and the checked diagrams are never removed by the retention policies
+    bool SetPinned(const QModelIndex& model_index, const bool& new_is_pinned);
+    bool IsPinned(const QModelIndex& model_index) const;
+    void SetRetentionPolicy(const std::string& connection_name, const RetentionPolicy& new_retention_policy);
+    RetentionPolicy GetRetentionPolicy(const std::string& connection_name) const;
+    std::size_t EnforceRetentionPolicies(const std::chrono::steady_clock::time_point& now = std::chrono::steady_clock::now());
 
     // Members overridden from the QAbstractItemModel
     QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
@@ -75,6 +114,16 @@ public:
     QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
     bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+signals:
+    void PublishedDiagramsWereAdded(const QModelIndex& first_new_diagram, const std::size_t& number_of_new_diagrams);
+
+public slots:
+    // Adds the diagrams that were published by the other threads, this is called automatically on the thread of the container
+    void AddPublishedDiagrams(void);
 
 private:
     // The type definition of the elements of the diagram container
@@ -109,8 +158,16 @@ private:
         // Pre-set flag value
         static constexpr Qt::ItemFlags element_flags_default = Qt::ItemIsEnabled;
 
-        explicit Element(const DataType& new_data, Element* new_parent = nullptr, const Qt::ItemFlags& new_flags = element_flags_default, const Qt::CheckState new_check_state = Qt::Unchecked)
-            : data(new_data), parent(new_parent), flags(new_flags), check_state(new_check_state) {}
+        explicit Element(DataType new_data, Element* new_parent = nullptr, const Qt::ItemFlags& new_flags = element_flags_default, const Qt::CheckState new_check_state = Qt::Unchecked)
+            : data(std::move(new_data)), parent(new_parent), row(0), number_of_fetched_children(0), flags(new_flags), check_state(new_check_state), is_pinned(false), arrival_time(std::chrono::steady_clock::now()),
+              diagram_is_evicted(false), cache_of_the_entry(nullptr), own_memory_usage(0), memory_usage(0), number_of_diagrams(0)
+        {
+            UpdateMemoryUsage();
+            if(ContainsType<DataType_Diagram>())
+            {
+                IncreaseNumberOfDiagrams(1);
+            }
+        }
 
         Element(const Element& new_backend) = delete;
         Element(Element&& new_backend) = delete;
@@ -122,51 +179,36 @@ private:
 
         bool IsRoot(void) const {return (nullptr == parent);}
         std::size_t GetNumberOfChildren(void) const {return children.size();}
-        Element* CreateChild(const DataType& childs_data, const Qt::ItemFlags& childs_flags = element_flags_default, const Qt::CheckState& childs_check_state = Qt::CheckState::Unchecked);
+        // The files and the connections can have thousands of diagrams, so their children are only exposed to the views when they are fetched
+        bool IsPopulatedLazily(void) const {return (ContainsType<DataType_File>() || ContainsType<DataType_Connection>());}
+        std::size_t GetNumberOfFetchedChildren(void) const {return (IsPopulatedLazily() ? number_of_fetched_children : children.size());}
+        Element* CreateChild(DataType childs_data, const Qt::ItemFlags& childs_flags = element_flags_default, const Qt::CheckState& childs_check_state = Qt::CheckState::Unchecked);
+        void ReserveChildren(const std::size_t& number_of_children);
         Element* GetChildWithIndex(const std::size_t& index);
         bool GetIndexWithChild(const Element* child, std::size_t& index_of_child);
-        void KillTheChildren(void) {children.clear();}
-        void KillChild(std::size_t child_index) {children.erase(children.begin() + child_index);}
+        void KillTheChildren(void);
+        void KillChild(std::size_t child_index);
+        void KillChildren(const std::size_t& first_child_index, const std::size_t& number_of_children_to_kill);
         template <typename T> bool ContainsType(void) const {return std::holds_alternative<T>(data);}
-        template <typename T> std::size_t CountElementsWithTypeRecursive(void) const
-            {
-                std::size_t result = 0;
-
-                // Checking whether this element has the type
-                if(std::holds_alternative<T>(data))
-                {
-                    result++;
-                }
-
-                // Going trough all the children and calling the same function on them
-                for(const auto& i : children)
-                {
-                    result += i->CountElementsWithTypeRecursive<T>();
-                }
-
-                return result;
-            }
-        template <typename T> Element* GetChildWithData(const T& data_to_look_for)
+        template <typename T> Element* GetChildWithData(const T& data_to_look_for) const
         {
             Element* result = nullptr;
 
-            for(const auto& i: children)
+            // The key contains the type and every compared member of the data, so a match in the index is a match of the data
+            auto iterator = children_index.find(CreateIndexKey(data_to_look_for));
+            if(children_index.end() != iterator)
             {
-                if(std::holds_alternative<T>(i->data))
-                {
-                    if(data_to_look_for == std::get<T>(i->data))
-                    {
-                        result = i.get();
-                        break;
-                    }
-                }
+                result = iterator->second;
             }
 
             return result;
         }
         std::string GetDisplayableString(void) const;
-        void ChildsCheckStateHasChanged(void);
+        void ChildsCheckStateHasChanged(std::vector<Element*>& changed_elements);
         void CallFunctionOnElementsRecursive(std::function<void(Element*)> function);
+        std::size_t GetMemoryUsage(void) const {return memory_usage;}
+        void UpdateMemoryUsage(void);
+        std::size_t GetNumberOfDiagrams(void) const {return number_of_diagrams;}
 #ifdef DIAGRAM_CONTAINER_DEBUG_MODE
         void PrintAllElementsRecursive(const std::string& identation = "   ") const;
 #endif
@@ -177,26 +219,92 @@ private:
         Element* parent;
         // The elements whose parent is this element
         std::vector<std::unique_ptr<Element> > children;
+        // The children that can be looked up by their data (every child, except the diagrams) stored with their index keys
+        std::unordered_map<std::string, Element*> children_index;
+        // The index of this element among the children of its parent
+        std::size_t row;
+        // The number of children that were exposed to the views, the children are always exposed in the order of their rows
+        std::size_t number_of_fetched_children;
         // Flags in OR combination that control the visualisation of the element
         Qt::ItemFlags flags;
         // Flag that tells whether the element was checked by the user
         Qt::CheckState check_state;
+        // Flag that tells whether the user has pinned the element, the pinned diagrams are never removed by the retention policies
+        bool is_pinned;
+        // The time when the element was added to the container, the retention policies remove the diagrams above their maximum age
+        std::chrono::steady_clock::time_point arrival_time;
+        // Flag that tells whether the data points of the contained diagram were released from the memory and need to be reloaded from the diagram cache
+        bool diagram_is_evicted;
+        // The location of the data points of the contained diagram in the diagram cache, this is set when the diagram is evicted for the first time
+        std::optional<DiagramCache::Entry> cache_entry;
+        // The diagram cache that contains the cache_entry, this is either the diagram cache of the container or the cache of a loaded snapshot
+        DiagramCache* cache_of_the_entry;
+        // The position of the element in the list of the recently viewed diagrams, this is only valid for diagrams that are not evicted
+        std::list<Element*>::iterator recently_viewed_position;
+
+    private:
+        static std::string CreateIndexKey(const DataType_Name& data_to_index) {return "N" + data_to_index;}
+        static std::string CreateIndexKey(const DataType_File& data_to_index) {return "F" + data_to_index.path + '\n' + data_to_index.name;}
+        static std::string CreateIndexKey(const DataType_Connection& data_to_index) {return "C" + data_to_index.name;}
+        static std::optional<std::string> CreateIndexKey(const DataType& data_to_index);
+        std::size_t CalculateOwnMemoryUsage(void) const;
+        void IncreaseMemoryUsage(const std::size_t& bytes);
+        void DecreaseMemoryUsage(const std::size_t& bytes);
+        void IncreaseNumberOfDiagrams(const std::size_t& diagrams);
+        void DecreaseNumberOfDiagrams(const std::size_t& diagrams);
+
+        // The number of bytes occupied by this element without its children: the tree overhead and the memory allocated by the contained data
+        std::size_t own_memory_usage;
+        // The number of bytes occupied by this element and all the elements below it, this is updated incrementally
+        std::size_t memory_usage;
+        // The number of diagrams contained by this element and all the elements below it, this is updated incrementally
+        std::size_t number_of_diagrams;
     };
 
-    QModelIndex AddDiagram(Element* type_parent, const DiagramSpecialized& diagram, const std::function<Element*(void)> storage_logic);
+    QModelIndex AddDiagrams(Element* type_parent, std::vector<DiagramSpecialized>&& diagrams, const std::function<Element*(void)> storage_logic,
+                            DiagramCache* cache_of_the_diagrams = nullptr, const std::vector<DiagramCache::Entry>& cache_entries = std::vector<DiagramCache::Entry>(),
+                            const std::vector<Qt::CheckState>& check_states = std::vector<Qt::CheckState>());
+    Element* GetFileElement(const std::string& file_name, const std::string& file_path);
+    Element* GetConnectionElement(const std::string& connection_name);
+    static void AppendStringToBuffer(std::vector<char>& buffer, const std::string& string);
+    static std::string ReadStringFromBuffer(const std::vector<char>& buffer, std::size_t& position);
     QModelIndex GetModelIndexOfElement(Element* element) const;
     Element* AddChildToElement(Element* element, const Element::DataType& data);
+    Element* AddChildrenToElement(Element* element, std::vector<Element::DataType>&& data, const Qt::ItemFlags& additional_flags = Qt::NoItemFlags);
+    void FetchChildrenOfElement(Element* element, const std::size_t& new_number_of_fetched_children);
     void RemoveChildFromElement(Element* element, Element* child);
+    void RemoveChildrenFromElement(Element* element, const std::size_t& first_row, const std::size_t& number_of_rows, std::size_t* tracked_row = nullptr);
+    std::size_t EnforceRetentionPolicy(Element* connection_element, const std::chrono::steady_clock::time_point& now, std::size_t* tracked_row = nullptr);
     void SetCheckStateOfElement(Element* element, const Qt::CheckState& new_check_state);
+    void NotifyAboutCheckStateChanges(std::vector<Element*>& changed_elements);
+    void IndexDiagram(const Element* element);
+    void AcceptElementByFilter(Element* element);
     void ChangeDiagramTitleOfElement(Element* element, const std::string& new_diagram_title);
+    static std::string CreateMemoryUsageString(const std::size_t& bytes);
+    void AddToRecentlyViewedDiagrams(Element* element);
+    void MarkDiagramAsViewed(Element* element);
+    void ForgetDiagramsBelow(Element* element);
+    void EvictDiagram(Element* element);
+    void ReloadDiagram(Element* element);
+    void EnforceMemoryBudget(const Element* element_to_keep = nullptr);
 
     // Every element contains only one column
     static constexpr int column_count = 1;
+    // The number of children that are exposed to the views at once by the lazily populated elements
+    static constexpr std::size_t fetch_batch_size = 256;
     // Pre-defined element data
     static const Element::DataType_Name root_element_data;
     static const Element::DataType_Name files_element_data;
     static const Element::DataType_Name network_element_data;
     static const Element::DataType_Name empty_element_data;
+    // This is appended to the displayed name of the pinned elements
+    static constexpr char pinned_element_suffix[] = " (pinned)";
+    // The snapshot files start with this identifier followed by the offset and the size of the metadata
+    static constexpr char snapshot_file_identifier[] = "RDBSNAP1";
+    static constexpr std::size_t snapshot_file_identifier_size = sizeof(snapshot_file_identifier) - 1;
+    static constexpr std::size_t snapshot_header_size = snapshot_file_identifier_size + (2 * sizeof(std::uint64_t));
+    // A diagram is described by at least two empty titles, the number of its data lines, its check state and its entry
+    static constexpr std::size_t snapshot_minimum_metadata_size_of_diagram = (2 * sizeof(std::uint64_t)) + sizeof(std::uint64_t) + sizeof(std::uint8_t) + (2 * sizeof(std::uint64_t));
     // This is root element of the tree, it only contains a string that can be used as header in the view
     std::unique_ptr<Element> root_element;
     // The following two members are helper pointers to easily access the elements directly below the root elements
@@ -204,6 +312,26 @@ private:
     Element* files_element;
     // This is a pointer to the element that is responsible for holding the diagrams that were received trough the network connetions
     Element* network_element;
+    // The diagrams whose data points are in the memory, the most recently viewed diagram is at the front
+    std::list<Element*> recently_viewed_diagrams;
+    // The memory usage above which the least recently viewed diagrams are evicted to the diagram cache, zero disables the eviction
+    std::size_t memory_budget;
+    // The path of the file that will be used by the diagram cache, the cache is only created when the first diagram is evicted
+    std::string cache_file_path;
+    std::unique_ptr<DiagramCache> diagram_cache;
+    // The loaded snapshot files, the data points of the diagrams loaded from them are read from these files when the diagrams are requested
+    std::vector<std::unique_ptr<DiagramCache> > snapshot_caches;
+    // The retention policies of the network connections by their names, the diagrams of the other connections are kept forever
+    std::unordered_map<std::string, RetentionPolicy> retention_policies;
+    // The diagrams that were published by the other threads and were not added yet
+    PublishedDiagramQueue published_diagrams;
+    LatencyHistogram store_latency_histogram;
+    // The diagrams indexed by their titles, the titles of their X axes and the titles of their data lines
+    SearchIndex<const Element*> search_index;
+    // The text that the displayed diagrams need to match, if this is empty, then every element is displayed
+    std::string filter;
+    // The diagrams that match the filter and every element above them
+    std::unordered_set<const Element*> elements_accepted_by_filter;
 };
 
 #endif // DIAGRAM_CONTAINER_HPP
@@ -0,0 +1,54 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include "diagram_filter_proxy_model.hpp"
+
+
+
+DiagramFilterProxyModel::DiagramFilterProxyModel(DiagramContainer* new_diagram_container, QObject* parent) : QSortFilterProxyModel(parent),
+                                                                                                            diagram_container(new_diagram_container)
+{
+    if(nullptr == diagram_container)
+    {
+        std::string errorMessage = "There was no diagram_container set in DiagramFilterProxyModel::DiagramFilterProxyModel!";
+        throw errorMessage;
+    }
+
+    setSourceModel(diagram_container);
+}
+
+std::size_t DiagramFilterProxyModel::SetFilter(const std::string& new_filter)
+{
+    auto result = diagram_container->SetFilter(new_filter);
+
+    // Every row needs to be re-evaluated with the new filter
+    invalidateFilter();
+
+    return result;
+}
+
+bool DiagramFilterProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
+{
+    return diagram_container->IsAcceptedByFilter(diagram_container->index(source_row, 0, source_parent));
+}
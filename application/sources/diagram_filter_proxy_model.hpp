@@ -0,0 +1,67 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <string>
+
+#include <QSortFilterProxyModel>
+#include <QModelIndex>
+
+#include "global.hpp"
+#include "diagram_container.hpp"
+
+
+
+#ifndef DIAGRAM_FILTER_PROXY_MODEL_HPP
+#define DIAGRAM_FILTER_PROXY_MODEL_HPP
+
+
+
+// Displays only the elements of the DiagramContainer that are accepted by its filter
+// The filtering is done by the search index of the DiagramContainer, so the rows do not need to be converted to strings and matched one by one
+class DiagramFilterProxyModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+public:
+    explicit DiagramFilterProxyModel(DiagramContainer* new_diagram_container, QObject* parent = nullptr);
+
+    DiagramFilterProxyModel(const DiagramFilterProxyModel& new_diagram_filter_proxy_model) = delete;
+    DiagramFilterProxyModel(DiagramFilterProxyModel&& new_diagram_filter_proxy_model) = delete;
+
+    DiagramFilterProxyModel& operator=(const DiagramFilterProxyModel& new_diagram_filter_proxy_model) = delete;
+    DiagramFilterProxyModel& operator=(DiagramFilterProxyModel&& new_diagram_filter_proxy_model) = delete;
+
+    virtual ~DiagramFilterProxyModel() override = default;
+
+    // Sets the filter of the DiagramContainer and returns the number of the matching diagrams
+    std::size_t SetFilter(const std::string& new_filter);
+
+protected:
+    bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
+
+private:
+    DiagramContainer* diagram_container;
+};
+
+#endif // DIAGRAM_FILTER_PROXY_MODEL_HPP
@@ -0,0 +1,90 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include "display_update_queue.hpp"
+
+
+
+DisplayUpdateQueue::DisplayUpdateQueue(QObject* new_context, display_function_type new_display_function, const std::size_t& capacity) :
+                                            context(new_context),
+                                            display_function(new_display_function),
+                                            overload_policy(OverloadPolicy::Block),
+                                            display_is_scheduled(false),
+                                            counters(capacity)
+{
+
+}
+
+void DisplayUpdateQueue::Push(const DisplayUpdate& display_update)
+{
+    switch(overload_policy)
+    {
+    case OverloadPolicy::Block:
+        display_function(display_update);
+        break;
+    case OverloadPolicy::DropOldestDisplayUpdates:
+        display_updates.push_back(display_update);
+        if(counters.GetCapacity() < display_updates.size())
+        {
+            display_updates.pop_front();
+            counters.CountDroppedElements(1);
+        }
+        break;
+    case OverloadPolicy::Coalesce:
+        // The coalesced update shows the first diagram of the earliest update and the number of every diagram
+        if(display_updates.empty())
+        {
+            display_updates.push_back(display_update);
+        }
+        else
+        {
+            display_updates.back().number_of_new_diagrams += display_update.number_of_new_diagrams;
+            counters.CountDroppedElements(1);
+        }
+        break;
+    }
+    counters.SetDepth(display_updates.size());
+
+    // The queued updates are displayed together when the event loop has added every published diagram
+    // The queued invocation is discarded if the context is destroyed before it is executed
+    if((!display_updates.empty()) && (!display_is_scheduled))
+    {
+        display_is_scheduled = true;
+        QMetaObject::invokeMethod(context, [this](){DisplayQueuedUpdates();}, Qt::QueuedConnection);
+    }
+}
+
+void DisplayUpdateQueue::DisplayQueuedUpdates(void)
+{
+    display_is_scheduled = false;
+
+    // The display can queue new updates, so the current ones are taken out first
+    std::deque<DisplayUpdate> current_display_updates;
+    current_display_updates.swap(display_updates);
+    counters.SetDepth(0);
+
+    for(const auto& i : current_display_updates)
+    {
+        display_function(i);
+    }
+}
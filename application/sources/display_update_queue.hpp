@@ -0,0 +1,100 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <deque>
+#include <cstddef>
+#include <chrono>
+#include <functional>
+
+#include <QObject>
+#include <QModelIndex>
+#include <QPersistentModelIndex>
+
+#include "global.hpp"
+#include "ingest_queue_counters.hpp"
+
+
+
+#ifndef DISPLAY_UPDATE_QUEUE_HPP
+#define DISPLAY_UPDATE_QUEUE_HPP
+
+
+
+// The diagrams that were added to the diagram container with one publication
+struct DisplayUpdate
+{
+    DisplayUpdate(const QModelIndex& new_first_new_diagram, const std::size_t& new_number_of_new_diagrams, const bool& new_container_was_empty)
+        : first_new_diagram(new_first_new_diagram), number_of_new_diagrams(new_number_of_new_diagrams), container_was_empty(new_container_was_empty),
+          store_time(std::chrono::steady_clock::now()) {}
+    // The later insertions and removals move the diagram, so its index needs to follow it
+    QPersistentModelIndex first_new_diagram;
+    std::size_t number_of_new_diagrams;
+    bool container_was_empty;
+    // A coalesced update keeps the store time of its earliest diagrams
+    std::chrono::steady_clock::time_point store_time;
+};
+
+// Passes the display updates to the display according to the overload policy
+// The updates that are not displayed at once wait for the event loop of the context, so the display is only scheduled once for many updates
+class DisplayUpdateQueue
+{
+public:
+    using display_function_type = std::function<void(const DisplayUpdate&)>;
+
+    // The display is scheduled on the thread of the context, the context is the object that owns this queue
+    DisplayUpdateQueue(QObject* new_context, display_function_type new_display_function, const std::size_t& capacity = INGEST_DISPLAY_QUEUE_CAPACITY_IN_UPDATES);
+
+    DisplayUpdateQueue(const DisplayUpdateQueue& new_display_update_queue) = delete;
+    DisplayUpdateQueue(DisplayUpdateQueue&& new_display_update_queue) = delete;
+
+    DisplayUpdateQueue& operator=(const DisplayUpdateQueue& new_display_update_queue) = delete;
+    DisplayUpdateQueue& operator=(DisplayUpdateQueue&& new_display_update_queue) = delete;
+
+    ~DisplayUpdateQueue() = default;
+
+    // These can only be called on the thread of the context
+    void SetOverloadPolicy(const OverloadPolicy& new_overload_policy) {overload_policy = new_overload_policy;}
+    const OverloadPolicy& GetOverloadPolicy(void) const {return overload_policy;}
+    // The blocking policy displays the update at once, the others queue it and schedule the display if it is not scheduled yet
+    void Push(const DisplayUpdate& display_update);
+    // Displays every queued update, this is called by the scheduled display
+    void DisplayQueuedUpdates(void);
+    std::size_t GetNumberOfQueuedUpdates(void) const {return display_updates.size();}
+    bool IsDisplayScheduled(void) const {return display_is_scheduled;}
+
+    // These can be called from any thread
+    // The dropped elements are the updates that were dropped or merged into another one
+    const IngestQueueCounters& GetCounters(void) const {return counters;}
+
+private:
+    QObject* context;
+    display_function_type display_function;
+    OverloadPolicy overload_policy;
+    std::deque<DisplayUpdate> display_updates;
+    bool display_is_scheduled;
+    IngestQueueCounters counters;
+};
+
+
+
+#endif // DISPLAY_UPDATE_QUEUE_HPP
@@ -0,0 +1,311 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include "file_replay_connection.hpp"
+
+
+
+bool FileReplayConnection::ParsePortName(const std::string& port_name, Options& options)
+{
+    bool result = false;
+
+    if(0 == port_name.compare(0, std::char_traits<char>::length(scheme), scheme))
+    {
+        // The settings follow the last question mark, so the path can contain question marks if the settings are given
+        std::string path_and_settings = port_name.substr(std::char_traits<char>::length(scheme));
+        auto settings_separator = path_and_settings.rfind('?');
+        Options new_options;
+        new_options.file_path = path_and_settings.substr(0, settings_separator);
+        result = (!new_options.file_path.empty());
+
+        std::string settings;
+        if(std::string::npos != settings_separator)
+        {
+            settings = path_and_settings.substr(settings_separator + 1);
+        }
+
+        std::size_t setting_begin = 0;
+        while(result && (setting_begin < settings.size()))
+        {
+            std::size_t setting_end = settings.find('&', setting_begin);
+            if(std::string::npos == setting_end)
+            {
+                setting_end = settings.size();
+            }
+            std::string setting = settings.substr(setting_begin, (setting_end - setting_begin));
+            setting_begin = setting_end + 1;
+
+            auto value_separator = setting.find('=');
+            std::string key = setting.substr(0, value_separator);
+            std::string value = (std::string::npos != value_separator) ? setting.substr(value_separator + 1) : std::string();
+
+            // Every value needs to be a whole number, except the multiplier of the speed
+            char* end_of_number = nullptr;
+            if("speed" == key)
+            {
+                if("max" == value)
+                {
+                    new_options.speed = 0.0;
+                }
+                else if("realtime" == value)
+                {
+                    new_options.speed = 1.0;
+                }
+                else
+                {
+                    new_options.speed = std::strtod(value.c_str(), &end_of_number);
+                    result = ((!value.empty()) && (0.0 < new_options.speed) &&
+                              (('\0' == *end_of_number) || (('x' == *end_of_number) && ('\0' == *(end_of_number + 1)))));
+                }
+            }
+            else if(("chunk" == key) || ("rate" == key))
+            {
+                unsigned long long number = std::strtoull(value.c_str(), &end_of_number, 10);
+                result = ((!value.empty()) && (std::string::npos == value.find_first_not_of("0123456789")) && (0 < number));
+                if("chunk" == key)
+                {
+                    new_options.chunk_size_in_bytes = static_cast<std::size_t>(number);
+                }
+                else
+                {
+                    new_options.real_time_rate_in_bytes_per_second = static_cast<std::size_t>(number);
+                }
+            }
+            else
+            {
+                result = false;
+            }
+        }
+
+        if(result)
+        {
+            options = new_options;
+        }
+    }
+
+    return result;
+}
+
+bool FileReplayConnection::IsFileReplayPortName(const std::string& port_name)
+{
+    // Only the scheme is checked, so a replay with invalid settings is not opened as a serial port, its Open() fails instead
+    return (0 == port_name.compare(0, std::char_traits<char>::length(scheme), scheme));
+}
+
+FileReplayConnection::FileReplayConnection() : QObject(),
+                                               file_is_capture_journal(false),
+                                               replay_needs_to_stop(false),
+                                               replay_is_finished(false),
+                                               number_of_replayed_bytes(0),
+                                               replay_duration(0),
+                                               received_data_delivery(this, received_chunks_capacity, SERIAL_PORT_MAX_READ_LENGTH_IN_BYTES,
+                                                                      [this](std::istream& received_data){emit DataReceived(received_data);},
+                                                                      [this](const std::string& error_message){emit ErrorReport(error_message);})
+{
+
+}
+
+FileReplayConnection::~FileReplayConnection()
+{
+    Close();
+}
+
+bool FileReplayConnection::Open(const std::string& port_name)
+{
+    bool result = false;
+
+    if(opened_port_name.empty())
+    {
+        Options new_options;
+        if(ParsePortName(port_name, new_options))
+        {
+            file.open(new_options.file_path, std::ios::in | std::ios::binary);
+            if(file.is_open())
+            {
+                // A file without the signature of a capture journal is replayed from its beginning as a plain recording
+                file_is_capture_journal = CaptureJournal::ReadSignature(file);
+                if(!file_is_capture_journal)
+                {
+                    file.clear();
+                    file.seekg(0);
+                }
+
+                options = new_options;
+                opened_port_name = port_name;
+                received_data_delivery.SetConnectionName("file replay " + port_name);
+                replay_is_finished = false;
+                number_of_replayed_bytes = 0;
+                result = true;
+            }
+        }
+    }
+    else
+    {
+        if(port_name == opened_port_name)
+        {
+            result = true;
+        }
+        else
+        {
+            throw("Another file replay was already openend with this object: " + port_name);
+        }
+    }
+
+    return result;
+}
+
+void FileReplayConnection::Close()
+{
+    if(IsOpen())
+    {
+        // After the replay thread has stopped, no more chunks will be received
+        replay_needs_to_stop = true;
+        received_data_delivery.InterruptWaiting();
+        if(replay_thread.joinable())
+        {
+            replay_thread.join();
+        }
+        replay_needs_to_stop = false;
+        file.close();
+        opened_port_name.clear();
+
+        // The data that was not processed yet belongs to the closed connection
+        received_data_delivery.Clear();
+    }
+}
+
+bool FileReplayConnection::IsOpen()
+{
+    return (!opened_port_name.empty());
+}
+
+bool FileReplayConnection::StartListening(void)
+{
+    bool result = false;
+
+    if(IsOpen())
+    {
+        if(!replay_thread.joinable())
+        {
+            replay_thread = std::thread(&FileReplayConnection::Replay, this);
+        }
+        result = true;
+    }
+
+    return result;
+}
+
+void FileReplayConnection::Replay(void)
+{
+    // The chunks are sent when they would have arrived in the recording that was sped up with the multiplier
+    double bytes_per_second = options.speed * static_cast<double>(options.real_time_rate_in_bytes_per_second);
+    std::size_t replayed_bytes = 0;
+    char last_replayed_byte = '\n';
+    bool first_record_was_read = false;
+    uint64_t first_receive_time_in_nanoseconds = 0;
+    auto start_time = std::chrono::steady_clock::now();
+
+    while(!replay_needs_to_stop)
+    {
+        auto chunk = received_data_delivery.GetFreeChunk();
+        std::chrono::duration<double> send_delay(0.0);
+
+        // The chunks of a capture journal keep their recorded sizes and distances, a plain recording is cut into evenly paced chunks
+        if(file_is_capture_journal)
+        {
+            uint64_t receive_time_in_nanoseconds = 0;
+            if(!CaptureJournal::ReadRecord(file, receive_time_in_nanoseconds, chunk))
+            {
+                break;
+            }
+            if(!first_record_was_read)
+            {
+                first_receive_time_in_nanoseconds = receive_time_in_nanoseconds;
+                first_record_was_read = true;
+            }
+            if(0.0 < options.speed)
+            {
+                send_delay = std::chrono::duration<double>(static_cast<double>(receive_time_in_nanoseconds - first_receive_time_in_nanoseconds) / (1.0e9 * options.speed));
+            }
+        }
+        else
+        {
+            chunk.resize(options.chunk_size_in_bytes);
+            file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            chunk.resize(static_cast<std::size_t>(file.gcount()));
+            if(chunk.empty())
+            {
+                break;
+            }
+            if(0.0 < bytes_per_second)
+            {
+                send_delay = std::chrono::duration<double>(static_cast<double>(replayed_bytes) / bytes_per_second);
+            }
+        }
+
+        // The waiting is done in short steps, so a slow replay can be stopped at any time
+        auto send_time = start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(send_delay);
+        auto current_time = std::chrono::steady_clock::now();
+        while((!replay_needs_to_stop) && (current_time < send_time))
+        {
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>((send_time - current_time), maximum_waiting_step));
+            current_time = std::chrono::steady_clock::now();
+        }
+
+        replayed_bytes += chunk.size();
+        if(!chunk.empty())
+        {
+            last_replayed_byte = chunk.back();
+        }
+        // The file can be replayed faster than it is processed, in that case the pushing waits instead of dropping the chunk
+        received_data_delivery.Push(chunk);
+        number_of_replayed_bytes = replayed_bytes;
+    }
+
+    if(!replay_needs_to_stop)
+    {
+        // The last line of a recording can be incomplete, it is completed so that it is also processed
+        if('\n' != last_replayed_byte)
+        {
+            auto chunk = received_data_delivery.GetFreeChunk();
+            chunk.assign(1, '\n');
+            received_data_delivery.Push(chunk);
+        }
+
+        replay_duration = (std::chrono::steady_clock::now() - start_time);
+        replay_is_finished = true;
+        QMetaObject::invokeMethod(this, "ReportReplayResult", Qt::QueuedConnection);
+    }
+}
+
+void FileReplayConnection::ReportReplayResult(void)
+{
+    // The replay_duration was written before the replay_is_finished, and this is only invoked after that
+    if(replay_is_finished)
+    {
+        double seconds = std::chrono::duration<double>(replay_duration).count();
+        double megabytes = static_cast<double>(number_of_replayed_bytes.load()) / (1024.0 * 1024.0);
+        emit ErrorReport("The replay of the file " + options.file_path + " has finished: " + std::to_string(number_of_replayed_bytes.load()) +
+                         " bytes in " + std::to_string(seconds) + " s (" + std::to_string((0.0 < seconds) ? (megabytes / seconds) : 0.0) + " MB/s)");
+    }
+}
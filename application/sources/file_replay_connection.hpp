@@ -0,0 +1,148 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+
+#include <QObject>
+
+#include "global.hpp"
+#include "network_connection_interface.hpp"
+#include "received_data_delivery.hpp"
+#include "capture_journal.hpp"
+
+
+
+#ifndef FILE_REPLAY_CONNECTION_HPP
+#define FILE_REPLAY_CONNECTION_HPP
+
+
+
+// Streams a recorded file through the same path as the data of a real connection, so the processing can be tested without a test bench
+// The port name is the path of the file with optional pacing settings, for example: replay:///home/user/MotorTestOutput.txt?speed=100x&chunk=4096
+//     speed: "realtime", a multiplier of the real time like "100x" or "max" for streaming as fast as the processing can take it
+//     chunk: the number of bytes that are passed on at once, like the chunks that are read from a port
+//     rate:  the number of bytes per second that were recorded in real time, the default is the rate of a serial port with the default baudrate
+// A capture journal is replayed with the chunks and the distances of their receiving multiplied by the speed, the chunk and the rate are not used for it
+// The file is read on a dedicated thread, that waits for the processing if it falls behind, so a replay never drops data
+class FileReplayConnection : public QObject, public NetworkConnectionInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(NetworkConnectionInterface)
+
+public:
+    struct Options
+    {
+        std::string file_path;
+        // Zero means that the pacing is turned off
+        double speed = 1.0;
+        std::size_t chunk_size_in_bytes = default_chunk_size_in_bytes;
+        // A serial byte is transferred with a start bit and a stop bit
+        std::size_t real_time_rate_in_bytes_per_second = (SERIAL_PORT_DEFAULT_BAUDRATE / 10);
+    };
+
+    static constexpr char scheme[] = "replay://";
+    static constexpr std::size_t default_chunk_size_in_bytes = 256;
+
+    // Returns false if the port_name does not start with the scheme or it has an invalid setting
+    static bool ParsePortName(const std::string& port_name, Options& options);
+    // Returns true if the port_name starts with the scheme, even if its settings are invalid
+    static bool IsFileReplayPortName(const std::string& port_name);
+
+    FileReplayConnection();
+    ~FileReplayConnection() override;
+
+    FileReplayConnection(const FileReplayConnection&) = delete;
+    FileReplayConnection(FileReplayConnection&&) = delete;
+
+    FileReplayConnection& operator=(const FileReplayConnection&) = delete;
+    FileReplayConnection& operator=(FileReplayConnection&&) = delete;
+
+    bool Open(const std::string& port_name) override;
+
+    void Close(void) override;
+
+    bool IsOpen(void) override;
+
+    bool StartListening(void) override;
+
+    void SetCaptureJournal(CaptureJournal* capture_journal) override {received_data_delivery.SetCaptureJournal(capture_journal);}
+
+    void SetDataDeliveryPaused(const bool& is_paused) override {received_data_delivery.SetDataDeliveryPaused(is_paused);}
+
+    void SetDataDeliveryCoalescing(const std::chrono::milliseconds& latency_budget, const std::size_t& size_threshold_in_bytes) override
+    {
+        received_data_delivery.SetDataDeliveryCoalescing(latency_budget, size_threshold_in_bytes);
+    }
+
+    const IngestQueueCounters& GetReceiveQueueCounters(void) const override {return received_data_delivery.GetCounters();}
+    const IngestQueueCounters& GetLineCounters(void) const override {return received_data_delivery.GetLineCounters();}
+
+    std::chrono::steady_clock::time_point GetReceiveTimeOfReceivedData(void) const override {return received_data_delivery.GetReceiveTimeOfReceivedData();}
+
+    // These can be called from any thread
+    bool IsReplayFinished(void) const {return replay_is_finished.load();}
+    std::size_t GetNumberOfReplayedBytes(void) const {return number_of_replayed_bytes.load();}
+
+signals:
+    void DataReceived(std::istream& received_data) override;
+    void ErrorReport(const std::string& error_message) override;
+
+private slots:
+    void ReportReplayResult(void);
+
+private:
+    // These run on the replay thread
+    void Replay(void);
+
+    // The number of chunks that can wait for the processing, the replay waits if the queue is full
+    static constexpr std::size_t received_chunks_capacity = 4096;
+    static constexpr std::chrono::milliseconds maximum_waiting_step = std::chrono::milliseconds(10);
+
+    // The name of the opened port, this is empty if no port is open, only accessed from the thread of this object
+    std::string opened_port_name;
+    Options options;
+    // The file is only read by the replay thread after it was started
+    std::ifstream file;
+    bool file_is_capture_journal;
+    std::thread replay_thread;
+    std::atomic<bool> replay_needs_to_stop;
+    std::atomic<bool> replay_is_finished;
+    std::atomic<std::size_t> number_of_replayed_bytes;
+    std::chrono::steady_clock::duration replay_duration;
+
+    // Owns the received chunks until their complete lines are delivered on the thread of this object
+    ReceivedDataDelivery received_data_delivery;
+};
+
+
+
+#endif // FILE_REPLAY_CONNECTION_HPP
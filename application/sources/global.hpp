@@ -23,6 +23,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 
 
 
@@ -57,6 +58,37 @@ using DataPointSpecialized = DataPoint<DataPointType>;
 constexpr uint32_t SERIAL_PORT_DEFAULT_BAUDRATE = 115200;
 constexpr std::size_t SERIAL_PORT_MAX_READ_LENGTH_IN_BYTES = 100 * 1024;
 
+constexpr std::size_t SOCKET_MAX_READ_LENGTH_IN_BYTES = 1024 * 1024;
+constexpr int SOCKET_RECEIVE_BUFFER_SIZE_IN_BYTES = 8 * 1024 * 1024;
+constexpr int SOCKET_CONNECT_TIMEOUT_IN_MILLISECONDS = 3000;
+
+constexpr std::size_t SHARED_MEMORY_DEFAULT_CAPACITY_IN_BYTES = 16 * 1024 * 1024;
+constexpr std::size_t SHARED_MEMORY_MAX_READ_LENGTH_IN_BYTES = 1024 * 1024;
+
+// The bounds of the queues of the ingest pipeline, if a queue is full, then the stage before it waits
+constexpr std::size_t INGEST_RECEIVE_QUEUE_CAPACITY_IN_BYTES = 64 * 1024 * 1024;
+constexpr std::size_t INGEST_PARSE_QUEUE_CAPACITY_IN_BYTES = 64 * 1024 * 1024;
+constexpr std::size_t INGEST_STORE_QUEUE_CAPACITY_IN_DIAGRAMS = 1024;
+constexpr std::size_t INGEST_DISPLAY_QUEUE_CAPACITY_IN_UPDATES = 16;
+// The longest incomplete line that the received data is assembled into, a longer one is dropped, so a stream without line ends can not fill the memory
+constexpr std::size_t INGEST_MAX_LINE_LENGTH_IN_BYTES = 16 * 1024 * 1024;
+
+// Returns the number of bytes that a string has allocated on the heap
+// Short strings are stored inside the object itself (small string optimization), these do not allocate anything
+inline std::size_t GetHeapMemoryUsageOfString(const std::string& string)
+{
+    static const std::size_t capacity_without_allocation = std::string().capacity();
+    std::size_t result = 0;
+
+    if(capacity_without_allocation < string.capacity())
+    {
+        // The terminating null character is also allocated
+        result = string.capacity() + 1;
+    }
+
+    return result;
+}
+
 
 
 #endif /* GLOBAL_HPP */
@@ -47,6 +47,12 @@ signals:
     virtual void ExportFileShowCheckBoxes(void) = 0;
     virtual void ExportFileHideCheckBoxes(void) = 0;
     virtual void ExportFileStoreCheckedDiagrams(const std::string& path_to_file) = 0;
+    virtual void FilterDiagrams(const std::string& filter) = 0;
+    virtual void SaveSessionSnapshot(const std::string& path_to_file) = 0;
+    virtual void LoadSessionSnapshot(const std::string& path_to_file) = 0;
+    virtual void TogglePinOfDiagram(const QModelIndex& model_index) = 0;
+    virtual void ShowIngestLatencies(void) = 0;
+    virtual void DumpIngestLatencies(const std::string& path_to_file) = 0;
 
 protected:
     ~GuiSignalInterface() {}
@@ -0,0 +1,114 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstddef>
+
+#include "global.hpp"
+
+
+
+#ifndef INGEST_QUEUE_COUNTERS_HPP
+#define INGEST_QUEUE_COUNTERS_HPP
+
+
+
+// What happens with the display updates if the display can not keep up with the incoming diagrams
+// The earlier stages of the ingest pipeline wait for the later ones, the waiting only moves the backlog to the source of the data
+// A source that can not wait, for example a serial port, can lose data in its own buffers, the stalls and the drops of the counters show this
+//     Block:                    every update is displayed when its diagrams are stored, the storing waits for the display
+//     DropOldestDisplayUpdates: the updates wait in a bounded queue, if it is full, then the oldest update is dropped
+//     Coalesce:                 the waiting updates are merged into one update
+enum class OverloadPolicy
+{
+    Block,
+    DropOldestDisplayUpdates,
+    Coalesce
+};
+
+// The counters of one bounded queue of the ingest pipeline (receive -> parse -> store -> display)
+// The queue is full if its depth reached the capacity, the stall time is the time that its producers waited because of this
+// The counters can be updated and read from any thread
+class IngestQueueCounters
+{
+public:
+    explicit IngestQueueCounters(const std::size_t& new_capacity) : capacity(new_capacity), depth(0), high_water_mark(0), number_of_dropped_elements(0),
+                                                                    number_of_stalls(0), stall_time_in_nanoseconds(0) {}
+
+    IngestQueueCounters(const IngestQueueCounters& new_ingest_queue_counters) = delete;
+    IngestQueueCounters(IngestQueueCounters&& new_ingest_queue_counters) = delete;
+
+    IngestQueueCounters& operator=(const IngestQueueCounters& new_ingest_queue_counters) = delete;
+    IngestQueueCounters& operator=(IngestQueueCounters&& new_ingest_queue_counters) = delete;
+
+    ~IngestQueueCounters() = default;
+
+    void SetDepth(const std::size_t& new_depth)
+    {
+        depth.store(new_depth, std::memory_order_relaxed);
+
+        // The queues can have several producers, so the high water mark needs a compare-exchange loop
+        std::size_t current_high_water_mark = high_water_mark.load(std::memory_order_relaxed);
+        while((current_high_water_mark < new_depth) && (!high_water_mark.compare_exchange_weak(current_high_water_mark, new_depth, std::memory_order_relaxed))) {}
+    }
+    void CountDroppedElements(const std::size_t& number_of_new_dropped_elements)
+    {
+        number_of_dropped_elements.fetch_add(number_of_new_dropped_elements, std::memory_order_relaxed);
+    }
+    void AddStall(const std::chrono::steady_clock::duration& stall_time)
+    {
+        number_of_stalls.fetch_add(1, std::memory_order_relaxed);
+        stall_time_in_nanoseconds.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stall_time).count()), std::memory_order_relaxed);
+    }
+
+    std::size_t GetCapacity(void) const {return capacity;}
+    std::size_t GetDepth(void) const {return depth.load(std::memory_order_relaxed);}
+    bool IsFull(void) const {return (capacity <= GetDepth());}
+    std::size_t GetHighWaterMark(void) const {return high_water_mark.load(std::memory_order_relaxed);}
+    std::size_t GetNumberOfDroppedElements(void) const {return number_of_dropped_elements.load(std::memory_order_relaxed);}
+    std::size_t GetNumberOfStalls(void) const {return number_of_stalls.load(std::memory_order_relaxed);}
+    std::chrono::nanoseconds GetStallTime(void) const {return std::chrono::nanoseconds(stall_time_in_nanoseconds.load(std::memory_order_relaxed));}
+
+    // For the status messages, for example: "depth 12/4096 (max 4096), 0 dropped, 3 stalls for 0.250 s"
+    std::string ToString(void) const
+    {
+        std::string stall_seconds = std::to_string(std::chrono::duration<double>(GetStallTime()).count());
+        return ("depth " + std::to_string(GetDepth()) + "/" + std::to_string(capacity) + " (max " + std::to_string(GetHighWaterMark()) + "), " +
+                std::to_string(GetNumberOfDroppedElements()) + " dropped, " + std::to_string(GetNumberOfStalls()) + " stalls for " + stall_seconds + " s");
+    }
+
+private:
+    const std::size_t capacity;
+    std::atomic<std::size_t> depth;
+    std::atomic<std::size_t> high_water_mark;
+    std::atomic<std::size_t> number_of_dropped_elements;
+    std::atomic<std::size_t> number_of_stalls;
+    std::atomic<uint64_t> stall_time_in_nanoseconds;
+};
+
+
+
+#endif // INGEST_QUEUE_COUNTERS_HPP
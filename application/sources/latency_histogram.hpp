@@ -0,0 +1,155 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+
+#include "global.hpp"
+
+
+
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+
+
+// Counts the latencies of one stage of the ingest pipeline (receive -> parsed -> stored -> displayed) in logarithmic buckets
+// The bucket N counts the latencies below 2^N microseconds that did not fit into the previous bucket, the last bucket counts every longer latency
+// The samples can be added and read from any thread, the memory does not depend on the number of samples
+class LatencyHistogram
+{
+public:
+    static constexpr std::size_t number_of_buckets = 32;
+
+    LatencyHistogram() : number_of_samples(0), sum_in_nanoseconds(0), maximum_in_nanoseconds(0)
+    {
+        for(auto& i : buckets)
+        {
+            i.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    LatencyHistogram(const LatencyHistogram& new_latency_histogram) = delete;
+    LatencyHistogram(LatencyHistogram&& new_latency_histogram) = delete;
+
+    LatencyHistogram& operator=(const LatencyHistogram& new_latency_histogram) = delete;
+    LatencyHistogram& operator=(LatencyHistogram&& new_latency_histogram) = delete;
+
+    ~LatencyHistogram() = default;
+
+    // The diagrams that were processed together have the same latency, they are added with one call
+    void Add(const std::chrono::steady_clock::duration& latency, const std::size_t& number_of_new_samples = 1)
+    {
+        uint64_t latency_in_nanoseconds = static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count()));
+        std::size_t bucket_index = 0;
+        while(((bucket_index + 1) < number_of_buckets) && (GetUpperBoundOfBucket(bucket_index).count() <= static_cast<int64_t>(latency_in_nanoseconds)))
+        {
+            ++bucket_index;
+        }
+
+        buckets[bucket_index].fetch_add(number_of_new_samples, std::memory_order_relaxed);
+        number_of_samples.fetch_add(number_of_new_samples, std::memory_order_relaxed);
+        sum_in_nanoseconds.fetch_add((latency_in_nanoseconds * number_of_new_samples), std::memory_order_relaxed);
+        uint64_t current_maximum = maximum_in_nanoseconds.load(std::memory_order_relaxed);
+        while((current_maximum < latency_in_nanoseconds) && (!maximum_in_nanoseconds.compare_exchange_weak(current_maximum, latency_in_nanoseconds, std::memory_order_relaxed))) {}
+    }
+
+    void Reset(void)
+    {
+        for(auto& i : buckets)
+        {
+            i.store(0, std::memory_order_relaxed);
+        }
+        number_of_samples.store(0, std::memory_order_relaxed);
+        sum_in_nanoseconds.store(0, std::memory_order_relaxed);
+        maximum_in_nanoseconds.store(0, std::memory_order_relaxed);
+    }
+
+    static std::chrono::nanoseconds GetUpperBoundOfBucket(const std::size_t& bucket_index) {return std::chrono::microseconds(int64_t(1) << bucket_index);}
+    std::size_t GetNumberOfSamplesInBucket(const std::size_t& bucket_index) const {return buckets.at(bucket_index).load(std::memory_order_relaxed);}
+    std::size_t GetNumberOfSamples(void) const {return number_of_samples.load(std::memory_order_relaxed);}
+    std::chrono::nanoseconds GetMaximum(void) const {return std::chrono::nanoseconds(maximum_in_nanoseconds.load(std::memory_order_relaxed));}
+    std::chrono::nanoseconds GetMean(void) const
+    {
+        std::size_t current_number_of_samples = GetNumberOfSamples();
+        return std::chrono::nanoseconds((0 < current_number_of_samples) ? (sum_in_nanoseconds.load(std::memory_order_relaxed) / current_number_of_samples) : 0);
+    }
+    // Returns the upper bound of the bucket that contains the percentile, but at most the maximum, the percentile is between 0.0 and 1.0
+    std::chrono::nanoseconds GetPercentile(const double& percentile) const
+    {
+        std::chrono::nanoseconds result(0);
+
+        std::size_t current_number_of_samples = GetNumberOfSamples();
+        if(0 < current_number_of_samples)
+        {
+            std::size_t rank = static_cast<std::size_t>(percentile * static_cast<double>(current_number_of_samples - 1)) + 1;
+            std::size_t number_of_counted_samples = 0;
+            std::size_t bucket_index = 0;
+            while(((bucket_index + 1) < number_of_buckets) && ((number_of_counted_samples + GetNumberOfSamplesInBucket(bucket_index)) < rank))
+            {
+                number_of_counted_samples += GetNumberOfSamplesInBucket(bucket_index);
+                ++bucket_index;
+            }
+            result = std::min(GetUpperBoundOfBucket(bucket_index), GetMaximum());
+        }
+
+        return result;
+    }
+
+    // For the status messages, for example: "1200 samples, mean 1.250 ms, median < 2.048 ms, 99th percentile < 8.192 ms, maximum 7.500 ms"
+    std::string ToString(void) const
+    {
+        auto to_milliseconds = [](const std::chrono::nanoseconds& duration){return std::to_string(std::chrono::duration<double, std::milli>(duration).count());};
+        return (std::to_string(GetNumberOfSamples()) + " samples, mean " + to_milliseconds(GetMean()) + " ms, median < " + to_milliseconds(GetPercentile(0.5)) +
+                " ms, 99th percentile < " + to_milliseconds(GetPercentile(0.99)) + " ms, maximum " + to_milliseconds(GetMaximum()) + " ms");
+    }
+
+    // Writes the non-empty buckets as CSV lines: name,upper bound of the bucket in microseconds,number of samples
+    void Write(std::ostream& output, const std::string& name) const
+    {
+        for(std::size_t i = 0; i < number_of_buckets; ++i)
+        {
+            std::size_t number_of_samples_in_bucket = GetNumberOfSamplesInBucket(i);
+            if(0 < number_of_samples_in_bucket)
+            {
+                output << name << "," << std::chrono::duration_cast<std::chrono::microseconds>(GetUpperBoundOfBucket(i)).count() << "," << number_of_samples_in_bucket << "\n";
+            }
+        }
+    }
+
+private:
+    std::array<std::atomic<std::size_t>, number_of_buckets> buckets;
+    std::atomic<std::size_t> number_of_samples;
+    std::atomic<uint64_t> sum_in_nanoseconds;
+    std::atomic<uint64_t> maximum_in_nanoseconds;
+};
+
+
+
+#endif // LATENCY_HISTOGRAM_HPP
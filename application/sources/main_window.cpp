@@ -28,16 +28,21 @@
 MainWindow::MainWindow() : QMainWindow(),
                            backend_signal_interface(nullptr)
 {
-    network_connection_is_open = false;
-
-    // Adding the object to the main window that will display the charts with anti-aliasing and the zooming turned off
+    // Adding the object to the main window that will display the charts with anti-aliasing, the X axis can be zoomed in with the rubber band and out with the right click
     pChartView = new QChartView();
     pChartView->setRenderHint(QPainter::Antialiasing);
-    pChartView->setRubberBand(QChartView::NoRubberBand);
+    pChartView->setRubberBand(QChartView::HorizontalRubberBand);
+    pChartView->installEventFilter(this);
+
+    // Adding the object to the main window that will filter the listed diagrams by their titles and the titles of their data lines
+    pLineEditDiagramFilter = new QLineEdit();
+    pLineEditDiagramFilter->setPlaceholderText(line_edit_diagram_filter_placeholder_text);
+    pLineEditDiagramFilter->setClearButtonEnabled(true);
 
     // Adding the object to the main window that will list the processed diagrams to be selected to display
     pTreeView = new QTreeView();
     pTreeView->setAnimated(true);
+    pTreeView->setContextMenuPolicy(Qt::CustomContextMenu);
 
     // Adding the object to the main window that will list the status messages
     pListWidgetStatus = new QListWidget();
@@ -55,6 +60,7 @@ MainWindow::MainWindow() : QMainWindow(),
     pStackedLayout->setCurrentWidget(pWidgetConnectionManager);
 
     QVBoxLayout *pRightVerticalLayout = new QVBoxLayout();
+    pRightVerticalLayout->addWidget(pLineEditDiagramFilter, line_edit_diagram_filter_size_percentage);
     pRightVerticalLayout->addWidget(pTreeView, tree_view_size_percentage);
     pRightVerticalLayout->addLayout(pStackedLayout, stacked_layout_size_percentage);
 
@@ -69,6 +75,12 @@ MainWindow::MainWindow() : QMainWindow(),
     pDiagramsMenu = menuBar()->addMenu(diagram_menu_text);
     pDiagramsMenu->addAction(diagram_menu_import_diagrams_text, this, &MainWindow::MenuActionDiagramsImportDiagrams);
     pDiagramsMenu->addAction(diagram_menu_export_diagrams_text, this, &MainWindow::MenuActionDiagramsExportDiagrams);
+    pDiagramsMenu->addSeparator();
+    pDiagramsMenu->addAction(diagram_menu_save_session_text, this, &MainWindow::MenuActionDiagramsSaveSession);
+    pDiagramsMenu->addAction(diagram_menu_load_session_text, this, &MainWindow::MenuActionDiagramsLoadSession);
+    pDiagramsMenu->addSeparator();
+    pDiagramsMenu->addAction(diagram_menu_show_ingest_latencies_text, this, &MainWindow::MenuActionDiagramsShowIngestLatencies);
+    pDiagramsMenu->addAction(diagram_menu_dump_ingest_latencies_text, this, &MainWindow::MenuActionDiagramsDumpIngestLatencies);
 
     // Setting the minimum size, and the title of the window
     setMinimumSize(main_window_minimum_width, main_window_minimum_height);
@@ -109,6 +121,46 @@ void MainWindow::MenuActionDiagramsExportDiagrams(void)
     emit ExportFileShowCheckBoxes();
 }
 
+void MainWindow::MenuActionDiagramsSaveSession(void)
+{
+    auto default_folder = backend_signal_interface->GetFileExportDefaultFolder();
+    QFileDialog *pSaveSessionFileSelectorDialog = new QFileDialog(this, diagram_menu_save_session_text, QString::fromStdString(default_folder), file_dialog_session_filter_string);
+    pSaveSessionFileSelectorDialog->setAcceptMode(QFileDialog::AcceptSave);
+    pSaveSessionFileSelectorDialog->setDefaultSuffix("rdbsnap");
+    pSaveSessionFileSelectorDialog->setModal(true);
+    pSaveSessionFileSelectorDialog->show();
+
+    QObject::connect(pSaveSessionFileSelectorDialog, &QFileDialog::fileSelected, [=](const QString &file){emit SaveSessionSnapshot(file.toStdString());});
+}
+
+void MainWindow::MenuActionDiagramsLoadSession(void)
+{
+    auto default_folder = backend_signal_interface->GetFileImportDefaultFolder();
+    QFileDialog *pLoadSessionFileSelectorDialog = new QFileDialog(this, diagram_menu_load_session_text, QString::fromStdString(default_folder), file_dialog_session_filter_string);
+    pLoadSessionFileSelectorDialog->setAcceptMode(QFileDialog::AcceptOpen);
+    pLoadSessionFileSelectorDialog->setModal(true);
+    pLoadSessionFileSelectorDialog->show();
+
+    QObject::connect(pLoadSessionFileSelectorDialog, &QFileDialog::fileSelected, [=](const QString &file){emit LoadSessionSnapshot(file.toStdString());});
+}
+
+void MainWindow::MenuActionDiagramsShowIngestLatencies(void)
+{
+    emit ShowIngestLatencies();
+}
+
+void MainWindow::MenuActionDiagramsDumpIngestLatencies(void)
+{
+    auto default_folder = backend_signal_interface->GetFileExportDefaultFolder();
+    QFileDialog *pDumpLatenciesFileSelectorDialog = new QFileDialog(this, diagram_menu_dump_ingest_latencies_text, QString::fromStdString(default_folder), file_dialog_latencies_filter_string);
+    pDumpLatenciesFileSelectorDialog->setAcceptMode(QFileDialog::AcceptSave);
+    pDumpLatenciesFileSelectorDialog->setDefaultSuffix("csv");
+    pDumpLatenciesFileSelectorDialog->setModal(true);
+    pDumpLatenciesFileSelectorDialog->show();
+
+    QObject::connect(pDumpLatenciesFileSelectorDialog, &QFileDialog::fileSelected, [=](const QString &file){emit DumpIngestLatencies(file.toStdString());});
+}
+
 void MainWindow::TreeviewCurrentSelectionChanged(const QModelIndex &current, const QModelIndex &previous)
 {
     (void) previous;
@@ -116,6 +168,18 @@ void MainWindow::TreeviewCurrentSelectionChanged(const QModelIndex &current, con
     emit RequestForDiagram(current);
 }
 
+void MainWindow::TreeviewContextMenuRequested(const QPoint& position)
+{
+    // The pinned diagrams are kept by the retention policies of the network connections
+    QModelIndex model_index = pTreeView->indexAt(position);
+    if(model_index.isValid())
+    {
+        QMenu context_menu(this);
+        context_menu.addAction(tree_view_context_menu_pin_text, [=](){emit TogglePinOfDiagram(model_index);});
+        context_menu.exec(pTreeView->viewport()->mapToGlobal(position));
+    }
+}
+
 void MainWindow::RegisterBackendSignalInterface(BackendSignalInterface* new_backend_signal_interface)
 {
     // If the backend signal interface is valid
@@ -131,16 +195,24 @@ void MainWindow::RegisterBackendSignalInterface(BackendSignalInterface* new_back
                          this,                                                   SLOT(DisplayStatusMessage(const std::string&)));
         QObject::connect(dynamic_cast<QObject*>(backend_signal_interface),       SIGNAL(NetworkOperationFinished(const std::string&, const bool&)),
                          this,                                                   SLOT(ProcessNetworkOperationResult(const std::string&, const bool&)));
-        QObject::connect(dynamic_cast<QObject*>(backend_signal_interface),       SIGNAL(ShowThisDiagram(const DiagramSpecialized&)),
-                         this,                                                   SLOT(DisplayDiagram(const DiagramSpecialized&)));
+        QObject::connect(dynamic_cast<QObject*>(backend_signal_interface),       SIGNAL(ShowThisDiagram(const QModelIndex&)),
+                         this,                                                   SLOT(DisplayDiagram(const QModelIndex&)));
         QObject::connect(pWidgetConnectionManager->button_open_close_connection, &QPushButton::clicked,
                          this,                                                   &MainWindow::ConnectionManagerButtonOpenCloseWasClicked);
+        QObject::connect(pWidgetConnectionManager->line_edit_port_name,          &QLineEdit::textChanged,
+                         this,                                                   &MainWindow::ConnectionManagerPortNameWasChanged);
+        QObject::connect(pWidgetConnectionManager->button_select_replay_file,    &QPushButton::clicked,
+                         this,                                                   &MainWindow::ConnectionManagerButtonReplayFileWasClicked);
         QObject::connect(pWidgetDiagramExport->button_export,                    &QPushButton::clicked,
                          this,                                                   &MainWindow::DiagramExportButtonExportWasClicked);
         QObject::connect(pWidgetDiagramExport->button_cancel,                    &QPushButton::clicked,
                          this,                                                   &MainWindow::DiagramExportButtonCancelWasClicked);
         QObject::connect(pTreeView->selectionModel(),                            &QItemSelectionModel::currentChanged,
                          this,                                                   &MainWindow::TreeviewCurrentSelectionChanged);
+        QObject::connect(pTreeView,                                              &QTreeView::customContextMenuRequested,
+                         this,                                                   &MainWindow::TreeviewContextMenuRequested);
+        QObject::connect(pLineEditDiagramFilter,                                 &QLineEdit::textChanged,
+                         [=](const QString& text){emit FilterDiagrams(text.toStdString());});
     }
     else
     {
@@ -160,7 +232,7 @@ void MainWindow::ConnectionManagerButtonOpenCloseWasClicked(void)
 {
     std::string network_port_name(pWidgetConnectionManager->line_edit_port_name->text().toStdString());
 
-    if(!network_connection_is_open)
+    if(0 == open_network_connections.count(network_port_name))
     {
         emit OpenNetworkConnection(network_port_name);
     }
@@ -170,6 +242,34 @@ void MainWindow::ConnectionManagerButtonOpenCloseWasClicked(void)
     }
 }
 
+void MainWindow::ConnectionManagerPortNameWasChanged(const QString& port_name)
+{
+    // The button shows what would happen with the port that is typed in
+    if(0 == open_network_connections.count(port_name.toStdString()))
+    {
+        pWidgetConnectionManager->button_open_close_connection->setText(ConnectionManagerWidget::button_open_connection_text);
+    }
+    else
+    {
+        pWidgetConnectionManager->button_open_close_connection->setText(ConnectionManagerWidget::button_close_connection_text);
+    }
+}
+
+void MainWindow::ConnectionManagerButtonReplayFileWasClicked(void)
+{
+    auto default_folder = backend_signal_interface->GetFileImportDefaultFolder();
+    QFileDialog *pReplayFileSelectorDialog = new QFileDialog(this, ConnectionManagerWidget::button_select_replay_file_text, QString::fromStdString(default_folder), file_dialog_replay_filter_string);
+    pReplayFileSelectorDialog->setAcceptMode(QFileDialog::AcceptOpen);
+    pReplayFileSelectorDialog->setModal(true);
+    pReplayFileSelectorDialog->show();
+
+    // The replay is opened like any other connection, so only its port name is assembled here
+    QObject::connect(pReplayFileSelectorDialog, &QFileDialog::fileSelected, [=](const QString &file)
+    {
+        pWidgetConnectionManager->line_edit_port_name->setText(QString(ConnectionManagerWidget::replay_port_name_prefix) + file + ConnectionManagerWidget::replay_port_name_default_settings);
+    });
+}
+
 void MainWindow::DiagramExportButtonExportWasClicked(void)
 {
     auto default_folder = backend_signal_interface->GetFileExportDefaultFolder();
@@ -199,94 +299,152 @@ void MainWindow::DiagramExportButtonCancelWasClicked(void)
 
 void MainWindow::ProcessNetworkOperationResult(const std::string& port_name, const bool& result)
 {
-    if(port_name == pWidgetConnectionManager->line_edit_port_name->text().toStdString())
+    if(result)
     {
-        if(result)
+        // A successful operation on an open connection closed it, otherwise it opened the connection
+        if(0 == open_network_connections.count(port_name))
         {
-            if(!network_connection_is_open)
-            {
-                pWidgetConnectionManager->line_edit_port_name->setReadOnly(true);
-                pWidgetConnectionManager->line_edit_port_name->setText(ConnectionManagerWidget::button_close_connection_text);
-                network_connection_is_open = true;
-            }
-            else
-            {
-                pWidgetConnectionManager->line_edit_port_name->setReadOnly(false);
-                pWidgetConnectionManager->line_edit_port_name->setText(ConnectionManagerWidget::button_open_connection_text);
-                network_connection_is_open = false;
-            }
+            open_network_connections.insert(port_name);
         }
+        else
+        {
+            open_network_connections.erase(port_name);
+        }
+        ConnectionManagerPortNameWasChanged(pWidgetConnectionManager->line_edit_port_name->text());
     }
-    else
+}
+
+void MainWindow::DisplayDiagram(const QModelIndex& diagram_index)
+{
+    // The diagram is asked from the backend, the index might point to a diagram that was removed meanwhile
+    const DiagramSpecialized* pDiagram = backend_signal_interface->GetDiagram(diagram_index);
+    if(pDiagram)
     {
-        std::string errorMessage = "A signal was received by MainWindow::ProcessNetworkOperationResult with a wrong port_name: " + port_name;
-        throw errorMessage;
+        const DiagramSpecialized& diagram = *pDiagram;
+
+        // Creating a new chart that will be displayed in the chartview after loading it with data
+        auto pNewChart = new QChart();
+
+        // Setting the title with the Diagram name
+        pNewChart->setTitle(QString::fromStdString(diagram.GetTitle()));
+        // Hiding the legend because the data lines will be recognisable from their Y axis
+        pNewChart->legend()->hide();
+        // Creating the X axis, giving it a title and addig it to the chart. The ranges will only be set after analyzing the data points.
+        auto pXAxis = new QValueAxis;
+        pXAxis->setTitleText(QString::fromStdString(diagram.GetAxisXTitle()));
+        pNewChart->addAxis(pXAxis, Qt::AlignBottom);
+
+        // We will add every DataLine of the Diagram to the chart
+        DataIndexType number_of_data_lines = diagram.GetTheNumberOfDataLines();
+        // Variables to store the min/max values of the diagram
+        auto diagram_extreme_values = diagram.GetExtremeValues();
+
+        // The diagram is followed for the zooming, the order of its data lines is only checked once
+        displayed_diagram_index = diagram_index;
+        displayed_data_lines_are_ordered_by_x.clear();
+        for(DataIndexType data_line_counter = 0; data_line_counter < number_of_data_lines; ++data_line_counter)
+        {
+            displayed_data_lines_are_ordered_by_x.push_back(ChartSeriesBuilder::IsOrderedByX(diagram.GetDataLine(data_line_counter)));
+        }
+
+        for(DataIndexType data_line_counter = 0; data_line_counter < number_of_data_lines; ++data_line_counter)
+        {
+            // Creating a line series and filling it with the data that needs to be displayed
+            auto pLineSeries = new QLineSeries();
+            // Setting the title with the current DataLine name
+            pLineSeries->setName(QString::fromStdString(diagram.GetDataLineTitle(data_line_counter)));
+            // Variable to store the min/max values of the DataLine
+            auto data_line_extreme_values = diagram.GetExtremeValues(data_line_counter);
+            // Setting the data with the DataPoints of the DataLine, all the points are handed over at once before the series is added to the chart
+            pLineSeries->replace(CreateDisplayedPoints(diagram, data_line_counter, diagram_extreme_values.first.GetX(), diagram_extreme_values.second.GetX()));
+
+            // Adding the line series to the chart
+            pNewChart->addSeries(pLineSeries);
+            auto pYAxis = new QValueAxis;
+            pYAxis->setTitleText(pLineSeries->name());
+            qreal y_axis_range_minimum = data_line_extreme_values.first.GetY() - (std::abs(data_line_extreme_values.first.GetY()) * y_axis_range_multiplicator);
+            qreal y_axis_range_maximum = data_line_extreme_values.second.GetY() + (std::abs(data_line_extreme_values.second.GetY()) * y_axis_range_multiplicator);
+            pYAxis->setTickCount(y_axis_tick_count);
+            pYAxis->setMinorTickCount(y_axis_minor_tick_count);
+            pYAxis->setRange(y_axis_range_minimum, y_axis_range_maximum);
+            pYAxis->setTitleBrush(pLineSeries->pen().color());
+            pNewChart->addAxis(pYAxis, Qt::AlignLeft);
+            pLineSeries->attachAxis(pXAxis);
+            pLineSeries->attachAxis(pYAxis);
+        }
+
+        // Setting up the X axis
+        pXAxis->setRange(diagram_extreme_values.first.GetX(), diagram_extreme_values.second.GetX());
+
+        // Saving the the current pChart from the pChartView
+        auto pOldChart = pChartView->chart();
+        // Adding the new chart to the chart view
+        pChartView->setChart(pNewChart);
+        // Deleting the old chart (if there was one) because chart view object is not its parent anymore
+        if(pOldChart)
+        {
+            delete pOldChart;
+        }
+        // The range is only followed after it was set up, so the series are not decimated twice
+        QObject::connect(pXAxis, &QValueAxis::rangeChanged, this, &MainWindow::DisplayedXRangeWasChanged);
     }
 }
 
-void MainWindow::DisplayDiagram(const DiagramSpecialized& diagram)
+void MainWindow::DisplayedXRangeWasChanged(qreal x_minimum, qreal x_maximum)
 {
-   // Creating a new chart that will be displayed in the chartview after loading it with data
-    auto pNewChart = new QChart();
-
-    // Setting the title with the Diagram name
-    pNewChart->setTitle(QString::fromStdString(diagram.GetTitle()));
-    // Hiding the legend because the data lines will be recognisable from their Y axis
-    pNewChart->legend()->hide();
-    // Creating the X axis, giving it a title and addig it to the chart. The ranges will only be set after analyzing the data points.
-    auto pXAxis = new QValueAxis;
-    pXAxis->setTitleText(QString::fromStdString(diagram.GetAxisXTitle()));
-    pNewChart->addAxis(pXAxis, Qt::AlignBottom);
-
-    // We will add every DataLine of the Diagram to the chart
-    DataIndexType number_of_data_lines = diagram.GetTheNumberOfDataLines();
-    // Variables to store the min/max values of the diagram
-    auto diagram_extreme_values = diagram.GetExtremeValues();
-
-    for(DataIndexType data_line_counter = 0; data_line_counter < number_of_data_lines; ++data_line_counter)
+    // A removed diagram keeps its last series until another diagram is displayed
+    const DiagramSpecialized* pDiagram = (displayed_diagram_index.isValid() ? backend_signal_interface->GetDiagram(displayed_diagram_index) : nullptr);
+    if(pDiagram)
     {
-        // Creating a line series and filling it with the data that needs to be displayed
-        auto pLineSeries = new QLineSeries();
-        // Setting the title with the current DataLine name
-        pLineSeries->setName(QString::fromStdString(diagram.GetDataLineTitle(data_line_counter)));
-        // Setting the data with the DataPoints of the DataLine
-        DataIndexType number_of_data_points = diagram.GetTheNumberOfDataPoints(data_line_counter);
-        // Variable to store the min/max values of the DataLine
-        auto data_line_extreme_values = diagram.GetExtremeValues(data_line_counter);
-
-        for(DataIndexType data_point_counter = 0; data_point_counter < number_of_data_points; ++data_point_counter)
+        // The series were added in the order of the data lines
+        auto series = pChartView->chart()->series();
+        for(int series_index = 0; series_index < series.size(); ++series_index)
         {
-            auto data_point = diagram.GetDataPoint(data_line_counter, data_point_counter);
-            pLineSeries->append(data_point.GetX(), data_point.GetY());
+            auto pLineSeries = qobject_cast<QLineSeries*>(series[series_index]);
+            if(pLineSeries && (static_cast<DataIndexType>(series_index) < pDiagram->GetTheNumberOfDataLines()))
+            {
+                pLineSeries->replace(CreateDisplayedPoints(*pDiagram, static_cast<DataIndexType>(series_index), x_minimum, x_maximum));
+            }
         }
+    }
+}
 
-        // Adding the line series to the chart
-        pNewChart->addSeries(pLineSeries);
-        auto pYAxis = new QValueAxis;
-        pYAxis->setTitleText(pLineSeries->name());
-        qreal y_axis_range_minimum = data_line_extreme_values.first.GetY() - (std::abs(data_line_extreme_values.first.GetY()) * y_axis_range_multiplicator);
-        qreal y_axis_range_maximum = data_line_extreme_values.second.GetY() + (std::abs(data_line_extreme_values.second.GetY()) * y_axis_range_multiplicator);
-        pYAxis->setTickCount(y_axis_tick_count);
-        pYAxis->setMinorTickCount(y_axis_minor_tick_count);
-        pYAxis->setRange(y_axis_range_minimum, y_axis_range_maximum);
-        pYAxis->setTitleBrush(pLineSeries->pen().color());
-        pNewChart->addAxis(pYAxis, Qt::AlignLeft);
-        pLineSeries->attachAxis(pXAxis);
-        pLineSeries->attachAxis(pYAxis);
+bool MainWindow::eventFilter(QObject* watched, QEvent* event)
+{
+    // The number of the buckets depends on the width, so only the change of the width needs a new decimation
+    if((watched == pChartView) && (QEvent::Resize == event->type()) && pChartView->chart())
+    {
+        auto pResizeEvent = static_cast<QResizeEvent*>(event);
+        auto horizontal_axes = pChartView->chart()->axes(Qt::Horizontal);
+        if((pResizeEvent->size().width() != pResizeEvent->oldSize().width()) && (!horizontal_axes.isEmpty()))
+        {
+            auto pXAxis = qobject_cast<QValueAxis*>(horizontal_axes.first());
+            if(pXAxis)
+            {
+                DisplayedXRangeWasChanged(pXAxis->min(), pXAxis->max());
+            }
+        }
     }
 
-    // Setting up the X axis
-    pXAxis->setRange(diagram_extreme_values.first.GetX(), diagram_extreme_values.second.GetX());
+    return QMainWindow::eventFilter(watched, event);
+}
+
+QVector<QPointF> MainWindow::CreateDisplayedPoints(const DiagramSpecialized& diagram, const DataIndexType& data_line_index, const qreal& x_minimum, const qreal& x_maximum)
+{
+    QVector<QPointF> result;
 
-    // Saving the the current pChart from the pChartView
-    auto pOldChart = pChartView->chart();
-    // Adding the new chart to the chart view
-    pChartView->setChart(pNewChart);
-    // Deleting the old chart (if there was one) because chart view object is not its parent anymore
-    if(pOldChart)
+    // Every pixel column of the chart view gets a bucket, the unordered data lines can not be decimated so all of their points are displayed
+    const auto& data_line = diagram.GetDataLine(data_line_index);
+    if(displayed_data_lines_are_ordered_by_x[data_line_index])
     {
-        delete pOldChart;
+        result = ChartSeriesBuilder::CreateDecimatedPoints(data_line, x_minimum, x_maximum, static_cast<std::size_t>(std::max(pChartView->width(), 1)));
     }
+    else
+    {
+        result = ChartSeriesBuilder::CreatePoints(data_line);
+    }
+
+    return result;
 }
 
 std::string MainWindow::CreateFileDialogFilterString(void)
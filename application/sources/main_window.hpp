@@ -24,6 +24,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <set>
 
 #include <QObject>
 #include <QtWidgets>
@@ -36,6 +37,7 @@
 #include "gui_signal_interface.hpp"
 #include "backend_signal_interface.hpp"
 #include "diagram.hpp"
+#include "chart_series_builder.hpp"
 #include "network_handler.hpp"
 
 
@@ -73,17 +75,35 @@ signals:
     void ExportFileShowCheckBoxes(void) override;
     void ExportFileHideCheckBoxes(void) override;
     void ExportFileStoreCheckedDiagrams(const std::string& path_to_file) override;
+    void FilterDiagrams(const std::string& filter) override;
+    void SaveSessionSnapshot(const std::string& path_to_file) override;
+    void LoadSessionSnapshot(const std::string& path_to_file) override;
+    void TogglePinOfDiagram(const QModelIndex& model_index) override;
+    void ShowIngestLatencies(void) override;
+    void DumpIngestLatencies(const std::string& path_to_file) override;
 
 private slots:
     void DisplayStatusMessage(const std::string& message_text);
     void ConnectionManagerButtonOpenCloseWasClicked(void);
+    void ConnectionManagerPortNameWasChanged(const QString& port_name);
+    void ConnectionManagerButtonReplayFileWasClicked(void);
     void DiagramExportButtonExportWasClicked(void);
     void DiagramExportButtonCancelWasClicked(void);
     void ProcessNetworkOperationResult(const std::string& port_name, const bool& result);
-    void DisplayDiagram(const DiagramSpecialized& diagram);
+    void DisplayDiagram(const QModelIndex& diagram_index);
+    void DisplayedXRangeWasChanged(qreal x_minimum, qreal x_maximum);
     void MenuActionDiagramsImportDiagrams(void);
     void MenuActionDiagramsExportDiagrams(void);
+    void MenuActionDiagramsSaveSession(void);
+    void MenuActionDiagramsLoadSession(void);
+    void MenuActionDiagramsShowIngestLatencies(void);
+    void MenuActionDiagramsDumpIngestLatencies(void);
     void TreeviewCurrentSelectionChanged(const QModelIndex &current, const QModelIndex &previous);
+    void TreeviewContextMenuRequested(const QPoint& position);
+
+protected:
+    // The chart view is watched, so its series are decimated again when its width changes
+    bool eventFilter(QObject* watched, QEvent* event) override;
 
 private:
     static constexpr int main_window_minimum_width = 800;
@@ -91,7 +111,8 @@ private:
 
     static constexpr int chart_view_size_percentage = 90;
     static constexpr int list_widget_status_size_percentage = 10;
-    static constexpr int tree_view_size_percentage = 90;
+    static constexpr int line_edit_diagram_filter_size_percentage = 5;
+    static constexpr int tree_view_size_percentage = 85;
     static constexpr int stacked_layout_size_percentage = 10;
     static constexpr int left_vertical_layout_size_percentage = 80;
     static constexpr int right_vertical_layout_size_percentage = 20;
@@ -99,14 +120,26 @@ private:
     static constexpr char diagram_menu_text[] = "Diagrams";
     static constexpr char diagram_menu_import_diagrams_text[] = "Import Diagrams";
     static constexpr char diagram_menu_export_diagrams_text[] = "Export Diagrams";
+    static constexpr char diagram_menu_save_session_text[] = "Save Session";
+    static constexpr char diagram_menu_load_session_text[] = "Load Session";
+    static constexpr char diagram_menu_show_ingest_latencies_text[] = "Show Ingest Latencies";
+    static constexpr char diagram_menu_dump_ingest_latencies_text[] = "Dump Ingest Latencies";
 
     static constexpr char file_dialog_filter_string_constant_part[] = "Diagram Files: ";
+    static constexpr char file_dialog_session_filter_string[] = "Session Snapshots (*.rdbsnap)";
+    static constexpr char file_dialog_latencies_filter_string[] = "Latency Histograms (*.csv)";
+    static constexpr char file_dialog_replay_filter_string[] = "Recordings (*)";
+
+    static constexpr char line_edit_diagram_filter_placeholder_text[] = "Search diagrams and data lines...";
+
+    static constexpr char tree_view_context_menu_pin_text[] = "Pin / Unpin Diagram";
 
     static constexpr qreal y_axis_range_multiplicator = 0.05;
     static constexpr int   y_axis_tick_count = 5;
     static constexpr int   y_axis_minor_tick_count = 0;
 
     std::string CreateFileDialogFilterString(void);
+    QVector<QPointF> CreateDisplayedPoints(const DiagramSpecialized& diagram, const DataIndexType& data_line_index, const qreal& x_minimum, const qreal& x_maximum);
 
     class ConnectionManagerWidget : public QWidget
     {
@@ -115,9 +148,12 @@ private:
         {
             layout = new QVBoxLayout(this);
             line_edit_port_name = new QLineEdit(SERIAL_PORT_DEFAULT_PORT_NAME, this);
+            line_edit_port_name->setToolTip(line_edit_port_name_tool_tip_text);
             button_open_close_connection = new QPushButton(button_open_connection_text, this);
+            button_select_replay_file = new QPushButton(button_select_replay_file_text, this);
             layout->addWidget(line_edit_port_name);
             layout->addWidget(button_open_close_connection);
+            layout->addWidget(button_select_replay_file);
         }
 
         ConnectionManagerWidget(const ConnectionManagerWidget&) = delete;
@@ -128,12 +164,19 @@ private:
         ConnectionManagerWidget& operator=(const ConnectionManagerWidget&) = delete;
         ConnectionManagerWidget& operator=(ConnectionManagerWidget&&) = delete;
 
-        static constexpr char button_open_connection_text[]  = "Open Serial Port";
-        static constexpr char button_close_connection_text[] = "Close Serial Port";
+        static constexpr char button_open_connection_text[]  = "Open Connection";
+        static constexpr char button_close_connection_text[] = "Close Connection";
+        static constexpr char button_select_replay_file_text[] = "Select File to Replay";
+        static constexpr char line_edit_port_name_tool_tip_text[] = "A serial port name, tcp://host:port, tcp-server://address:port, udp://address:port\n"
+                                                                    "or replay://path?speed=realtime|100x|max&chunk=bytes&rate=bytes_per_second";
+        // The selected file is replayed in real time by default, the settings can be edited before opening the connection
+        static constexpr char replay_port_name_prefix[] = "replay://";
+        static constexpr char replay_port_name_default_settings[] = "?speed=realtime";
 
         QVBoxLayout* layout;
         QLineEdit*   line_edit_port_name;
         QPushButton* button_open_close_connection;
+        QPushButton* button_select_replay_file;
     };
 
     class DiagramExportWidget : public QWidget
@@ -164,12 +207,19 @@ private:
         QPushButton* button_cancel;
     };
 
-    bool network_connection_is_open;
+    // Several connections can be open at the same time, the button of the connection manager opens or closes the port that was typed in
+    std::set<std::string> open_network_connections;
 
     BackendSignalInterface* backend_signal_interface;
 
+    // The visible range of the chart is decimated again from the data lines after zooming and resizing, so the displayed diagram is followed in the model
+    // The diagram is asked from the backend every time, so it is not copied and an evicted diagram is reloaded, a removed diagram makes the index invalid
+    QPersistentModelIndex displayed_diagram_index;
+    std::vector<bool> displayed_data_lines_are_ordered_by_x;
+
     QMenu*                   pDiagramsMenu;
     QChartView*              pChartView;
+    QLineEdit*               pLineEditDiagramFilter;
     QTreeView*               pTreeView;
     QListWidget*             pListWidgetStatus;
     ConnectionManagerWidget* pWidgetConnectionManager;
@@ -38,140 +38,125 @@ std::string MeasurementDataProtocol::GetProtocolName(void)
 std::vector<DiagramSpecialized> MeasurementDataProtocol::ProcessData(std::istream& input_data)
 {
     std::vector<DiagramSpecialized> assembled_diagrams;
-    std::string received_data;
-    std::string actual_line;
 
+    // The lines are read into a member, so its memory is reused and the processing of the lines does not allocate in the steady state
     while(std::getline(input_data, actual_line))
     {
-        std::smatch match_results;
-
         // Removing the whitespaces from the actual line
         actual_line.erase(std::remove_if(actual_line.begin(), actual_line.end(), isspace), actual_line.end());
 
-        try
+        switch(state)
         {
-            switch(state)
-            {
-                case Constants::States::WaitingForStartLine:
-                    // If a start line was found...
-                    if(std::regex_match(actual_line, std::regex(Constants::Regex::start_line)))
-                    {
-                        state = Constants::States::ProcessingTitleLine;
-                    }
+            case Constants::States::WaitingForStartLine:
+                // If a start line was found...
+                if(Constants::Syntax::start_line == actual_line)
+                {
+                    state = Constants::States::ProcessingTitleLine;
+                }
+                break;
+            case Constants::States::ProcessingTitleLine:
+                // In any case, we will switch to the next state
+                state = Constants::States::ProcessingHeadline;
+                // If this is a diagram title line
+                if((2 <= actual_line.size()) && (Constants::Syntax::title_start == actual_line.front()) && (Constants::Syntax::title_end == actual_line.back()))
+                {
+                    // Then we create a diagram object with the title
+                    actual_diagram = DiagramSpecialized(actual_line.substr(1, (actual_line.size() - 2)));
+                    // Switching to the next state with a break --> a new line will be fetched
                     break;
-                case Constants::States::ProcessingTitleLine:
-                    // In any case, we will switch to the next state
-                    state = Constants::States::ProcessingHeadline;
-                    // If this is a diagram title line
-                    if(std::regex_search(actual_line, match_results, std::regex(Constants::Regex::title_line)))
-                    {
-                        // Then we create a diagram object with the title
-                        actual_diagram = DiagramSpecialized(match_results[1]);
-                        // Switching to the next state with a break --> a new line will be fetched
-                        break;
-                    }
-                    else
-                    {
-                        // No title was found, we will generate a title from the current date and time and create a diagram object with it
-                        auto current_date_and_time = std::time(nullptr);
-                        std::string current_date_and_time_string = ctime(&current_date_and_time);
-                        // The ctime adds an extra newline to the string, this needs to be removed
-                        current_date_and_time_string.pop_back();
-                        actual_diagram = DiagramSpecialized(current_date_and_time_string);
-                        // Switching to the next state without a break --> a new line will NOT be fetched, because this line is the headline
-                    }
+                }
+                else
+                {
+                    // No title was found, we will generate a title from the current date and time and create a diagram object with it
+                    auto current_date_and_time = std::time(nullptr);
+                    std::string current_date_and_time_string = ctime(&current_date_and_time);
+                    // The ctime adds an extra newline to the string, this needs to be removed
+                    current_date_and_time_string.pop_back();
+                    actual_diagram = DiagramSpecialized(current_date_and_time_string);
+                    // Switching to the next state without a break --> a new line will NOT be fetched, because this line is the headline
+                }
 
-                    // The falltrough is not an error in this case, this behaviour needed because there was no diagram title found, the actual_line contains the headline
-                [[fallthrough]];
-                case Constants::States::ProcessingHeadline:
-                    // If this is a headline but not a dataline
-                    // (this is needed because with regex it is difficult to define the differences between the data and headlines)
-                    if((std::regex_match(actual_line, std::regex(Constants::Regex::headline))) &&
-                       (!std::regex_match(actual_line, std::regex(Constants::Regex::data_line))))
-                    {
-                        std::string headline = actual_line;
-                        DataIndexType column_index = 0;
+                // The falltrough is not an error in this case, this behaviour needed because there was no diagram title found, the actual_line contains the headline
+            [[fallthrough]];
+            case Constants::States::ProcessingHeadline:
+                // If this is a headline but not a dataline
+                // (this is needed because the words of the headline can also be numbers)
+                if((Constants::Syntax::minimum_number_of_elements <= CountElements(actual_line, IsWord)) &&
+                   (Constants::Syntax::minimum_number_of_elements > CountElements(actual_line, IsNumber)))
+                {
+                    DataIndexType column_index = 0;
 
-                        // Collecting the labels from the headline
-                        while(std::regex_search(headline, match_results, std::regex(Constants::Regex::headline_analyzer)))
+                    // Collecting the labels from the headline
+                    for(std::size_t element_begin = 0, element_end = 0; element_begin < actual_line.size(); element_begin = (element_end + 1))
+                    {
+                        element_end = actual_line.find(Constants::Syntax::element_separator, element_begin);
+                        if(0 == column_index)
                         {
-                            if(0 == column_index)
-                            {
-                                actual_diagram.SetAxisXTitle(match_results[1]);
-                            }
-                            else
-                            {
-                                actual_diagram.AddNewDataLine(match_results[1]);
-                            }
-
-                            ++column_index;
-                            headline = match_results.suffix().str();
+                            actual_diagram.SetAxisXTitle(actual_line.substr(element_begin, (element_end - element_begin)));
+                        }
+                        else
+                        {
+                            actual_diagram.AddNewDataLine(actual_line.substr(element_begin, (element_end - element_begin)));
                         }
 
-                        state = Constants::States::ProcessingDataLines;
-                    }
-                    else
-                    {
-                        state = Constants::States::WaitingForStartLine;
+                        ++column_index;
                     }
-                    break;
-                case Constants::States::ProcessingDataLines:
-                    if(std::regex_match(actual_line, std::regex(Constants::Regex::data_line)))
-                    {
-                        std::string data_line = actual_line;
-                        DataIndexType column_index = 0;
-                        DataPointType data_point_x_value = 0;
 
-                        // Collecting the data from the dataline
-                        while(std::regex_search(data_line, match_results, std::regex(Constants::Regex::data_line_analyzer)))
+                    state = Constants::States::ProcessingDataLines;
+                }
+                else
+                {
+                    state = Constants::States::WaitingForStartLine;
+                }
+                break;
+            case Constants::States::ProcessingDataLines:
+                if(Constants::Syntax::minimum_number_of_elements <= CountElements(actual_line, IsNumber))
+                {
+                    DataIndexType column_index = 0;
+                    DataPointType data_point_x_value = 0;
+
+                    // Collecting the data from the dataline, the numbers are converted in place, every number is terminated by a separator
+                    for(std::size_t element_begin = 0, element_end = 0; element_begin < actual_line.size(); element_begin = (element_end + 1))
+                    {
+                        element_end = actual_line.find(Constants::Syntax::element_separator, element_begin);
+                        DataPointType value = std::strtod(&actual_line[element_begin], nullptr);
+                        if(0 == column_index)
                         {
-                            if(0 == column_index)
+                            data_point_x_value = value;
+                        }
+                        else
+                        {
+                            if((column_index - 1) < actual_diagram.GetTheNumberOfDataLines())
                             {
-                                std::stringstream stringstream(match_results[1]);
-                                stringstream >> data_point_x_value;
+                                actual_diagram.AddNewDataPoint((column_index - 1), DataPointSpecialized(data_point_x_value, value));
                             }
                             else
                             {
-                                if((column_index - 1) < actual_diagram.GetTheNumberOfDataLines())
-                                {
-                                    std::stringstream stringstream(match_results[1]);
-                                    DataPointType data_point_y_value;
-                                    stringstream >> data_point_y_value;
-                                    actual_diagram.AddNewDataPoint((column_index - 1), DataPointSpecialized(data_point_x_value, data_point_y_value));
-                                }
-                                else
-                                {
-                                    state = Constants::States::WaitingForStartLine;
-                                    break;
-                                }
+                                state = Constants::States::WaitingForStartLine;
+                                break;
                             }
-
-                            ++column_index;
-                            data_line = match_results.suffix().str();
-                        }
-                        if((column_index - 1) != actual_diagram.GetTheNumberOfDataLines())
-                        {
-                            state = Constants::States::WaitingForStartLine;
                         }
+
+                        ++column_index;
                     }
-                    else
+                    if((column_index - 1) != actual_diagram.GetTheNumberOfDataLines())
                     {
-                        if(std::regex_match(actual_line, std::regex(Constants::Regex::end_line)))
-                        {
-                            assembled_diagrams.push_back(actual_diagram);
-                        }
                         state = Constants::States::WaitingForStartLine;
                     }
-                    break;
-                default:
+                }
+                else
+                {
+                    if(Constants::Syntax::end_line == actual_line)
+                    {
+                        assembled_diagrams.push_back(actual_diagram);
+                    }
                     state = Constants::States::WaitingForStartLine;
-                    throw("The DataProcessor::ProcessData's statemachine switched to an unexpected state: " + std::to_string(static_cast<std::underlying_type<Constants::States>::type>(state)));
-                    break;
-            }
-        }
-        catch(const std::regex_error& exception)
-        {
-            throw("A regex exception was caught: " + std::to_string(exception.code()) + ": " + exception.what());
+                }
+                break;
+            default:
+                state = Constants::States::WaitingForStartLine;
+                throw("The DataProcessor::ProcessData's statemachine switched to an unexpected state: " + std::to_string(static_cast<std::underlying_type<Constants::States>::type>(state)));
+                break;
         }
     }
 
@@ -228,3 +213,44 @@ std::stringstream MeasurementDataProtocol::ExportData(const std::vector<DiagramS
 
     return exported_data;
 }
+
+std::size_t MeasurementDataProtocol::CountElements(const std::string& line, bool (*element_is_valid)(const char* begin, const char* end))
+{
+    std::size_t result = 0;
+
+    // Every element needs to be terminated by a separator, even the last one
+    for(std::size_t element_begin = 0; element_begin < line.size(); )
+    {
+        std::size_t element_end = line.find(Constants::Syntax::element_separator, element_begin);
+        if((std::string::npos == element_end) || (!element_is_valid((line.data() + element_begin), (line.data() + element_end))))
+        {
+            result = 0;
+            break;
+        }
+
+        ++result;
+        element_begin = element_end + 1;
+    }
+
+    return result;
+}
+
+bool MeasurementDataProtocol::IsWord(const char* begin, const char* end)
+{
+    // The characters of a word are the ASCII letters, the digits and the underscore
+    return ((begin != end) && std::all_of(begin, end, [](const char& character){return ((('a' <= character) && ('z' >= character)) ||
+                                                                                        (('A' <= character) && ('Z' >= character)) ||
+                                                                                        (('0' <= character) && ('9' >= character)) ||
+                                                                                        ('_' == character));}));
+}
+
+bool MeasurementDataProtocol::IsNumber(const char* begin, const char* end)
+{
+    // An integer with an optional sign
+    if((begin != end) && (('+' == *begin) || ('-' == *begin)))
+    {
+        ++begin;
+    }
+
+    return ((begin != end) && std::all_of(begin, end, [](const char& character){return (('0' <= character) && ('9' >= character));}));
+}
@@ -29,7 +29,7 @@
 #include <functional>
 #include <ctime>
 #include <cctype>
-#include <regex>
+#include <cstdlib>
 #include <type_traits>
 
 #include <QFileInfo>
@@ -64,6 +64,10 @@ public:
     std::stringstream ExportData(const std::vector<DiagramSpecialized>& diagrams_to_export) override;
 
 private:
+    static std::size_t CountElements(const std::string& line, bool (*element_is_valid)(const char* begin, const char* end));
+    static bool IsWord(const char* begin, const char* end);
+    static bool IsNumber(const char* begin, const char* end);
+
     struct Constants
     {
         enum class States : uint8_t
@@ -74,16 +78,16 @@ private:
             ProcessingDataLines
         };
 
-        struct Regex
+        struct Syntax
         {
-            // REGEX strings to search the input data for valid measurement session
-            static constexpr char start_line[]         = R"(^\s*<<<START>>>$)";
-            static constexpr char title_line[]         = R"(^<(.*)>$)";
-            static constexpr char headline[]           = R"(^\s*(\w+,){2,}$)";
-            static constexpr char headline_analyzer[]  = R"(^\s*(\w+),)";
-            static constexpr char data_line[]          = R"(^\s*(((?:\+|\-)?\d+),){2,}$)";
-            static constexpr char data_line_analyzer[] = R"(^\s*((?:\+|\-)?\d+),)";
-            static constexpr char end_line[]           = R"(^\s*<<<END>>>$)";
+            // The elements of a valid measurement session, the lines are matched after their whitespaces were removed
+            // The headline consists of words, the data lines consist of integers with an optional sign, every element is terminated by a separator
+            static constexpr char start_line[]                        = "<<<START>>>";
+            static constexpr char title_start                         = '<';
+            static constexpr char title_end                           = '>';
+            static constexpr char element_separator                   = ',';
+            static constexpr std::size_t minimum_number_of_elements   = 2;
+            static constexpr char end_line[]                          = "<<<END>>>";
         };
 
         struct Export
@@ -98,6 +102,8 @@ private:
 
     Constants::States state;
     DiagramSpecialized actual_diagram;
+    // The line that is being processed, its memory is reused by the next lines
+    std::string actual_line;
 };
 
 
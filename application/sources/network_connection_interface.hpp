@@ -24,10 +24,12 @@
 #include <istream>
 #include <memory>
 #include <string>
+#include <chrono>
 
 #include <QtPlugin>
 
 #include "global.hpp"
+#include "ingest_queue_counters.hpp"
 
 
 
@@ -36,9 +38,14 @@
 
 
 
+class CaptureJournal;
+
 class NetworkConnectionInterface
 {
 public:
+    // The connections are owned through this interface, because the type of the connection depends on the port name
+    virtual ~NetworkConnectionInterface() {}
+
     virtual bool Open(const std::string& port_name) = 0;
 
     virtual void Close(void) = 0;
@@ -47,8 +54,23 @@ public:
 
     virtual bool StartListening(void) = 0;
 
-protected:
-    ~NetworkConnectionInterface() {}
+    // The received chunks are also written into the journal, this can only be called while the connection is closed, nullptr turns it off
+    virtual void SetCaptureJournal(CaptureJournal* capture_journal) = 0;
+
+    // While the delivery is paused, the received data waits in the bounded receive queue of the connection, and the receiving waits if it is full
+    // This can only be called on the thread of the connection, the data that arrived during the pause is delivered when it is resumed
+    virtual void SetDataDeliveryPaused(const bool& is_paused) = 0;
+
+    // The complete lines are collected until the oldest of them has waited for the latency budget or their size has reached the threshold
+    // So the receivers are called once for the lines of many small chunks, zeros turn the coalescing off, this can only be called while the connection is closed
+    virtual void SetDataDeliveryCoalescing(const std::chrono::milliseconds& latency_budget, const std::size_t& size_threshold_in_bytes) = 0;
+
+    virtual const IngestQueueCounters& GetReceiveQueueCounters(void) const = 0;
+    // The depth is the length of the line that is being received, the lines that are longer than the capacity are dropped
+    virtual const IngestQueueCounters& GetLineCounters(void) const = 0;
+
+    // The monotonic receive time of the oldest chunk in the data that is being delivered, this is only valid while the DataReceived is emitted
+    virtual std::chrono::steady_clock::time_point GetReceiveTimeOfReceivedData(void) const = 0;
 
 signals:
     virtual void DataReceived(std::istream& received_data) = 0;
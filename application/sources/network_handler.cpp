@@ -25,6 +25,12 @@
 
 
 
+NetworkHandler::~NetworkHandler()
+{
+    // The task of the worker_pool uses this object, so it needs to finish before this object is destroyed
+    WaitForParsing();
+}
+
 bool NetworkHandler::Run(const std::string& new_port_name)
 {
     bool result = false;
@@ -54,9 +60,85 @@ void NetworkHandler::Stop(void)
         QObject::disconnect(dynamic_cast<QObject*>(network_connection_interface), SIGNAL(DataReceived(std::istream&)),     this, SLOT(DataAvailable(std::istream&)));
         QObject::disconnect(dynamic_cast<QObject*>(network_connection_interface), SIGNAL(ErrorReport(const std::string&)), this, SLOT(ErrorReport(const std::string&)));
     }
+
+    // The data that is parsed at the moment is finished, the data that was not taken yet belongs to the closed connection
+    // The pending data is cleared before the waiting, otherwise the running task would take it with its next iteration
+    {
+        std::lock_guard<std::mutex> lock(parsing_mutex);
+        pending_data->Clear();
+    }
+    WaitForParsing();
+    std::lock_guard<std::mutex> lock(parsing_mutex);
+    parsing_is_deferred = false;
+    data_delivery_is_paused = false;
+    parse_queue_counters.SetDepth(0);
+}
+
+void NetworkHandler::ResumeParsing(void)
+{
+    bool parsing_needs_to_be_scheduled = false;
+
+    if(worker_pool && storage_queue_counters)
+    {
+        std::lock_guard<std::mutex> lock(parsing_mutex);
+        if(parsing_is_deferred && (!storage_queue_counters->IsFull()))
+        {
+            storage_queue_counters->AddStall(std::chrono::steady_clock::now() - parsing_deferral_start_time);
+            parsing_is_deferred = false;
+            parsing_is_scheduled = true;
+            parsing_needs_to_be_scheduled = true;
+        }
+    }
+
+    if(parsing_needs_to_be_scheduled)
+    {
+        worker_pool->Run([this](){ParsePendingData();});
+    }
 }
 
 void NetworkHandler::DataAvailable(std::istream& received_data)
+{
+    if(worker_pool)
+    {
+        bool parsing_needs_to_be_scheduled;
+        bool data_delivery_needs_to_be_paused;
+        {
+            std::lock_guard<std::mutex> lock(parsing_mutex);
+            pending_data->Append(received_data, network_connection_interface->GetReceiveTimeOfReceivedData());
+            parse_queue_counters.SetDepth(pending_data->GetSize());
+
+            // A deferred parsing is scheduled by ResumeParsing when the storage has room again
+            parsing_needs_to_be_scheduled = ((!parsing_is_scheduled) && (!parsing_is_deferred));
+            parsing_is_scheduled = (parsing_is_scheduled || parsing_needs_to_be_scheduled);
+
+            // The delivery is resumed by the parsing when it takes the pending data
+            data_delivery_needs_to_be_paused = ((!data_delivery_is_paused) && parse_queue_counters.IsFull());
+            if(data_delivery_needs_to_be_paused)
+            {
+                data_delivery_is_paused = true;
+                data_delivery_pause_start_time = std::chrono::steady_clock::now();
+            }
+        }
+
+        // This runs on the thread of the connection, so the delivery can be paused directly
+        if(data_delivery_needs_to_be_paused)
+        {
+            network_connection_interface->SetDataDeliveryPaused(true);
+        }
+
+        // The scheduled task takes every pending data, so only one task is scheduled at a time
+        if(parsing_needs_to_be_scheduled)
+        {
+            worker_pool->Run([this](){ParsePendingData();});
+        }
+    }
+    else
+    {
+        ProcessData(received_data, network_connection_interface->GetReceiveTimeOfReceivedData());
+    }
+}
+
+void NetworkHandler::ProcessData(std::istream& received_data, const std::chrono::steady_clock::time_point& receive_time)
 {
     if(diagram_collector)
     {
@@ -64,11 +146,95 @@ void NetworkHandler::DataAvailable(std::istream& received_data)
 
         if(!assembled_diagrams.empty())
         {
+            // The diagrams were completed by the parsed data, so the receive time of the oldest parsed data is the worst case for all of them
+            if(parse_latency_histogram && (std::chrono::steady_clock::time_point() != receive_time))
+            {
+                parse_latency_histogram->Add((std::chrono::steady_clock::now() - receive_time), assembled_diagrams.size());
+            }
+
             diagram_collector(port_name, assembled_diagrams);
         }
     }
 }
 
+void NetworkHandler::ParsePendingData(void)
+{
+    // This runs on the worker_pool, the data that arrives during the parsing is parsed by the next iteration of this task
+    while(true)
+    {
+        bool data_delivery_needs_to_be_resumed = false;
+        {
+            std::lock_guard<std::mutex> lock(parsing_mutex);
+            if(!pending_data->HasCompleteLines())
+            {
+                parsing_is_scheduled = false;
+                parsing_finished.notify_all();
+                break;
+            }
+
+            // The task ends instead of waiting for the storage, so it does not occupy a worker and the handler can be stopped meanwhile
+            if(storage_queue_counters && storage_queue_counters->IsFull())
+            {
+                parsing_is_deferred = true;
+                parsing_deferral_start_time = std::chrono::steady_clock::now();
+                parsing_is_scheduled = false;
+                parsing_finished.notify_all();
+                break;
+            }
+
+            std::swap(pending_data, parsed_data);
+            parse_queue_counters.SetDepth(0);
+            if(data_delivery_is_paused)
+            {
+                parse_queue_counters.AddStall(std::chrono::steady_clock::now() - data_delivery_pause_start_time);
+                data_delivery_is_paused = false;
+                data_delivery_needs_to_be_resumed = true;
+            }
+        }
+
+        // The delivery can only be resumed on the thread of the connection, the connection is the context, so this is dropped if it is destroyed
+        if(data_delivery_needs_to_be_resumed)
+        {
+            NetworkConnectionInterface* connection = network_connection_interface;
+            QMetaObject::invokeMethod(dynamic_cast<QObject*>(connection), [connection](){connection->SetDataDeliveryPaused(false);}, Qt::QueuedConnection);
+        }
+
+        // An error of the protocol can not leave the worker, it is reported on the thread of this object and the next data is parsed as usual
+        // The scheduled flag is still cleared by the next iteration, so the Stop() and the destructor do not wait forever
+        std::string error_message;
+        try
+        {
+            ProcessData(parsed_data->GetCompleteLines(), parsed_data->GetReceiveTime());
+        }
+        catch(const std::string& exception_text)
+        {
+            error_message = exception_text;
+        }
+        catch(const std::exception& exception)
+        {
+            error_message = exception.what();
+        }
+        catch(...)
+        {
+            error_message = "Unknown exception";
+        }
+        parsed_data->Clear();
+        if(!error_message.empty())
+        {
+            QMetaObject::invokeMethod(this, [this, error_message]()
+            {
+                ErrorReport("The data received on " + port_name + " could not be processed: " + error_message);
+            }, Qt::QueuedConnection);
+        }
+    }
+}
+
+void NetworkHandler::WaitForParsing(void)
+{
+    std::unique_lock<std::mutex> lock(parsing_mutex);
+    parsing_finished.wait(lock, [this](){return (!parsing_is_scheduled);});
+}
+
 void NetworkHandler::ErrorReport(const std::string& error_message)
 {
     if(error_collector)
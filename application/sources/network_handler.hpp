@@ -25,6 +25,9 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 #include <QObject>
 
@@ -32,6 +35,10 @@
 #include "network_connection_interface.hpp"
 #include "data_processing_interface.hpp"
 #include "diagram.hpp"
+#include "received_data_buffer.hpp"
+#include "worker_pool.hpp"
+#include "ingest_queue_counters.hpp"
+#include "latency_histogram.hpp"
 
 
 
@@ -40,6 +47,11 @@
 
 
 
+// If a worker pool is set, then the received data is parsed on the pool, so the connections of several handlers are parsed in parallel
+// The data of one handler is parsed by one task at a time, because the data processing interface has an internal state
+// The data that waits for the parsing is bounded: if it reaches the capacity of the parse queue, then the delivery of the connection is paused
+// If the counters of the storage queue are set, then the parsing waits while the storage is full, until ResumeParsing is called
+// If the parse latency histogram is set, then the time from the receiving of the data until its diagrams are parsed is added to it for every diagram
 class NetworkHandler : public QObject
 {
     Q_OBJECT
@@ -52,11 +64,23 @@ public:
     NetworkHandler(NetworkConnectionInterface *new_network_connection_interface,
                    DataProcessingInterface *new_data_processing_interface,
                    diagram_collector_type new_diagram_collector,
-                   error_collector_type new_error_collector)
+                   error_collector_type new_error_collector,
+                   WorkerPool *new_worker_pool = nullptr,
+                   IngestQueueCounters *new_storage_queue_counters = nullptr,
+                   LatencyHistogram *new_parse_latency_histogram = nullptr)
                               : network_connection_interface(new_network_connection_interface),
                                 data_processing_interface(new_data_processing_interface),
                                 diagram_collector(new_diagram_collector),
-                                error_collector(new_error_collector)
+                                error_collector(new_error_collector),
+                                worker_pool(new_worker_pool),
+                                pending_data(std::make_unique<ReceivedDataBuffer>(SERIAL_PORT_MAX_READ_LENGTH_IN_BYTES)),
+                                parsed_data(std::make_unique<ReceivedDataBuffer>(SERIAL_PORT_MAX_READ_LENGTH_IN_BYTES)),
+                                parsing_is_scheduled(false),
+                                parsing_is_deferred(false),
+                                data_delivery_is_paused(false),
+                                parse_queue_counters(INGEST_PARSE_QUEUE_CAPACITY_IN_BYTES),
+                                storage_queue_counters(new_storage_queue_counters),
+                                parse_latency_histogram(new_parse_latency_histogram)
     {
         if(!network_connection_interface)
         {
@@ -80,7 +104,7 @@ public:
         }
     }
 
-    ~NetworkHandler() = default;
+    ~NetworkHandler();
 
     NetworkHandler(const NetworkHandler&) = delete;
     NetworkHandler(NetworkHandler&&) = delete;
@@ -92,16 +116,41 @@ public:
 
     void Stop(void);
 
+    // Schedules the parsing that waited for the storage, this needs to be called when the storage queue was emptied, it can be called from any thread
+    void ResumeParsing(void);
+
+    const IngestQueueCounters& GetParseQueueCounters(void) const {return parse_queue_counters;}
+
 private slots:
     void DataAvailable(std::istream& received_data);
     void ErrorReport(const std::string& error_message);
 
 private:
+    void ProcessData(std::istream& received_data, const std::chrono::steady_clock::time_point& receive_time);
+    void ParsePendingData(void);
+    void WaitForParsing(void);
+
     NetworkConnectionInterface* network_connection_interface;
     DataProcessingInterface* data_processing_interface;
     diagram_collector_type diagram_collector;
     error_collector_type error_collector;
     std::string port_name;
+
+    // The connections deliver complete lines, these are collected in the pending_data until a task of the worker_pool takes them
+    // The task swaps the buffers, so the receiving can continue while the task is parsing the parsed_data
+    WorkerPool* worker_pool;
+    std::mutex parsing_mutex;
+    std::condition_variable parsing_finished;
+    std::unique_ptr<ReceivedDataBuffer> pending_data;
+    std::unique_ptr<ReceivedDataBuffer> parsed_data;
+    bool parsing_is_scheduled;
+    bool parsing_is_deferred;
+    bool data_delivery_is_paused;
+    std::chrono::steady_clock::time_point parsing_deferral_start_time;
+    std::chrono::steady_clock::time_point data_delivery_pause_start_time;
+    IngestQueueCounters parse_queue_counters;
+    IngestQueueCounters* storage_queue_counters;
+    LatencyHistogram* parse_latency_histogram;
 };
 
 
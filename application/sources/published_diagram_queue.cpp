@@ -0,0 +1,75 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include "published_diagram_queue.hpp"
+
+
+
+PublishedDiagramQueue::PublishedDiagramQueue(notifier_type new_notifier, const std::size_t& capacity_in_diagrams)
+    : notifier(new_notifier), number_of_diagrams(0), counters(capacity_in_diagrams)
+{
+
+}
+
+void PublishedDiagramQueue::Publish(Batch&& batch)
+{
+    // Publishing nothing does not need to wake up the owner
+    if(!batch.diagrams.empty())
+    {
+        bool queue_was_empty;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue_was_empty = batches.empty();
+            number_of_diagrams += batch.diagrams.size();
+            batches.push_back(std::move(batch));
+            counters.SetDepth(number_of_diagrams);
+        }
+
+        // The owner is only notified about the first batch, it will take the later batches together with the first one
+        // Every notification is sent after its batch was queued, so no batch can remain in the queue without a notification
+        if(queue_was_empty && notifier)
+        {
+            notifier();
+        }
+    }
+}
+
+std::vector<PublishedDiagramQueue::Batch> PublishedDiagramQueue::TakeAll(void)
+{
+    std::vector<Batch> result;
+
+    // The batches are swapped out, so the lock is only held for a moment and the publishers are not blocked while the owner processes them
+    std::lock_guard<std::mutex> lock(mutex);
+    result.swap(batches);
+    number_of_diagrams = 0;
+    counters.SetDepth(0);
+
+    return result;
+}
+
+std::size_t PublishedDiagramQueue::GetNumberOfDiagrams(void) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return number_of_diagrams;
+}
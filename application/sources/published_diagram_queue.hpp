@@ -0,0 +1,89 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <functional>
+#include <chrono>
+
+#include "global.hpp"
+#include "diagram.hpp"
+#include "ingest_queue_counters.hpp"
+
+
+
+#ifndef PUBLISHED_DIAGRAM_QUEUE_HPP
+#define PUBLISHED_DIAGRAM_QUEUE_HPP
+
+
+
+// Collects the diagrams that were published by any thread until the owner of the diagrams takes them
+// The owner is notified when the queue becomes non-empty, so it does not need to poll the queue
+// The publishing never waits and never drops, the publishers can check the counters and hold back their diagrams while the queue is full
+class PublishedDiagramQueue
+{
+public:
+    // The diagrams of one publication with their source (a file or a network connection) and the monotonic time of the publication
+    struct Batch
+    {
+        Batch(const std::string& new_source_name, const std::string& new_file_path, const bool& new_is_from_file, std::vector<DiagramSpecialized>&& new_diagrams)
+            : source_name(new_source_name), file_path(new_file_path), is_from_file(new_is_from_file), diagrams(std::move(new_diagrams)),
+              publish_time(std::chrono::steady_clock::now()) {}
+        std::string source_name;
+        std::string file_path;
+        bool is_from_file;
+        std::vector<DiagramSpecialized> diagrams;
+        std::chrono::steady_clock::time_point publish_time;
+    };
+
+    using notifier_type = std::function<void(void)>;
+
+    explicit PublishedDiagramQueue(notifier_type new_notifier = notifier_type(), const std::size_t& capacity_in_diagrams = INGEST_STORE_QUEUE_CAPACITY_IN_DIAGRAMS);
+
+    PublishedDiagramQueue(const PublishedDiagramQueue&) = delete;
+    PublishedDiagramQueue(PublishedDiagramQueue&&) = delete;
+
+    PublishedDiagramQueue& operator=(const PublishedDiagramQueue&) = delete;
+    PublishedDiagramQueue& operator=(PublishedDiagramQueue&&) = delete;
+
+    ~PublishedDiagramQueue() = default;
+
+    // These can be called from any thread
+    void Publish(Batch&& batch);
+    std::vector<Batch> TakeAll(void);
+    std::size_t GetNumberOfDiagrams(void) const;
+    // The publishers add the time they held back their diagrams to the stall time of the counters
+    IngestQueueCounters& GetCounters(void) {return counters;}
+
+private:
+    // The notifier is called by the publishing thread outside of the lock
+    notifier_type notifier;
+    mutable std::mutex mutex;
+    std::vector<Batch> batches;
+    std::size_t number_of_diagrams;
+    IngestQueueCounters counters;
+};
+
+#endif // PUBLISHED_DIAGRAM_QUEUE_HPP
@@ -0,0 +1,133 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include "received_chunk_queue.hpp"
+
+
+
+ReceivedChunkQueue::ReceivedChunkQueue(const std::size_t& capacity, const std::size_t& new_capacity_in_bytes) : received_chunks(capacity), free_chunks(capacity),
+                                                                                                               capacity_in_bytes(new_capacity_in_bytes), number_of_queued_bytes(0),
+                                                                                                               processing_is_scheduled(false), capture_journal(nullptr),
+                                                                                                               waiting_is_interrupted(false), counters(received_chunks.GetCapacity())
+{
+
+}
+
+ReceivedChunkQueue::chunk_type ReceivedChunkQueue::GetFreeChunk(void)
+{
+    chunk_type result;
+
+    // The chunk only grows if a larger burst arrives than the ones before
+    free_chunks.TryPop(result);
+
+    return result;
+}
+
+bool ReceivedChunkQueue::Push(chunk_type& chunk)
+{
+    // The receive time is taken before the waiting, so the time that the chunk waited for the processing is part of its latency
+    ReceivedChunk received_chunk{std::move(chunk), std::chrono::steady_clock::now()};
+    if(nullptr != capture_journal)
+    {
+        capture_journal->Write(received_chunk.data.data(), received_chunk.data.size(), received_chunk.receive_time);
+    }
+
+    // The ring buffer would count a drop for every failed attempt, so the free space is checked before pushing
+    std::size_t size_of_chunk = received_chunk.data.size();
+    if(IsFull(size_of_chunk) && (!waiting_is_interrupted.load()))
+    {
+        auto stall_start_time = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(waiting_mutex);
+        free_space_available.wait(lock, [&](){return ((!IsFull(size_of_chunk)) || waiting_is_interrupted.load());});
+        lock.unlock();
+        counters.AddStall(std::chrono::steady_clock::now() - stall_start_time);
+    }
+
+    // An interrupted waiting drops the chunk even if only the bytes were over the capacity
+    if((!IsFull(size_of_chunk)) && received_chunks.TryPush(received_chunk))
+    {
+        number_of_queued_bytes.fetch_add(size_of_chunk);
+    }
+    else
+    {
+        counters.CountDroppedElements(1);
+    }
+    counters.SetDepth(received_chunks.GetSize());
+
+    // The processing takes every chunk that is in the queue, so it only needs to be scheduled if it is not scheduled yet
+    return (!processing_is_scheduled.exchange(true));
+}
+
+void ReceivedChunkQueue::TakeChunks(ReceivedDataBuffer& received_data)
+{
+    // The flag is cleared before taking the chunks, so a chunk that arrives during the processing schedules the next processing
+    processing_is_scheduled.store(false);
+
+    // The chunks are copied once into the received data and their memory is given back to the I/O thread
+    ReceivedChunk received_chunk;
+    while(received_chunks.TryPop(received_chunk))
+    {
+        received_data.Append(received_chunk.data.data(), received_chunk.data.size(), received_chunk.receive_time);
+        number_of_queued_bytes.fetch_sub(received_chunk.data.size());
+        free_chunks.TryPush(received_chunk.data);
+    }
+    counters.SetDepth(received_chunks.GetSize());
+
+    NotifyWaiting();
+}
+
+void ReceivedChunkQueue::Clear(void)
+{
+    ReceivedChunk received_chunk;
+    while(received_chunks.TryPop(received_chunk))
+    {
+        number_of_queued_bytes.fetch_sub(received_chunk.data.size());
+    }
+    processing_is_scheduled.store(false);
+    waiting_is_interrupted.store(false);
+    counters.SetDepth(0);
+
+    NotifyWaiting();
+}
+
+void ReceivedChunkQueue::InterruptWaiting(void)
+{
+    waiting_is_interrupted.store(true);
+    NotifyWaiting();
+}
+
+void ReceivedChunkQueue::NotifyWaiting(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(waiting_mutex);
+    }
+    free_space_available.notify_all();
+}
+
+bool ReceivedChunkQueue::IsFull(const std::size_t& size_of_new_chunk) const
+{
+    std::size_t queued_bytes = number_of_queued_bytes.load();
+    return ((received_chunks.GetCapacity() <= received_chunks.GetSize()) ||
+            ((0 != queued_bytes) && (capacity_in_bytes < (queued_bytes + size_of_new_chunk))));
+}
@@ -0,0 +1,126 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+
+#include "global.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "received_data_buffer.hpp"
+#include "capture_journal.hpp"
+#include "ingest_queue_counters.hpp"
+
+
+
+#ifndef RECEIVED_CHUNK_QUEUE_HPP
+#define RECEIVED_CHUNK_QUEUE_HPP
+
+
+
+// Passes the data that was read by the I/O thread of a connection to the thread that processes it
+// The received chunks and their memory travel in two lock-free ring buffers, so the receiving does not allocate in the steady state
+// The queue also tells the I/O thread when the processing needs to be scheduled, so the processing is only scheduled once for many chunks
+// If the queue is full, then the I/O thread sleeps on a condition variable until the processing takes the chunks, so a slow processing slows down the reading
+// The waiting only moves the backlog to the source, a source that can not wait, for example a serial port, can still lose data in its own buffers
+// The queue is full if it has reached its number of chunks or its number of bytes, so the large chunks of the sockets can not fill the memory
+// Every chunk is tagged with a monotonic receive time when it is pushed, the time is passed on to the received data with the chunk
+class ReceivedChunkQueue
+{
+public:
+    using chunk_type = std::vector<char>;
+
+    // A single chunk that is larger than the capacity in bytes is still queued if the queue is empty
+    explicit ReceivedChunkQueue(const std::size_t& capacity, const std::size_t& new_capacity_in_bytes = INGEST_RECEIVE_QUEUE_CAPACITY_IN_BYTES);
+
+    ReceivedChunkQueue(const ReceivedChunkQueue& new_received_chunk_queue) = delete;
+    ReceivedChunkQueue(ReceivedChunkQueue&& new_received_chunk_queue) = delete;
+
+    ReceivedChunkQueue& operator=(const ReceivedChunkQueue& new_received_chunk_queue) = delete;
+    ReceivedChunkQueue& operator=(ReceivedChunkQueue&& new_received_chunk_queue) = delete;
+
+    ~ReceivedChunkQueue() = default;
+
+    // These can only be called by the I/O thread
+    // Returns the memory of a processed chunk if there is one, otherwise an empty chunk
+    chunk_type GetFreeChunk(void);
+    // Returns true if the processing needs to be scheduled, if the queue is full, then this waits until the processing takes the chunks
+    // The chunk is only dropped and counted if the waiting was interrupted
+    // The chunk is written into the capture journal before it is queued, so the journal also has the chunks that were dropped here
+    // The chunk is moved into the queue, its memory comes back through GetFreeChunk after the processing
+    bool Push(chunk_type& chunk);
+    // The journal is not owned by the queue, nullptr turns the capturing off
+    void SetCaptureJournal(CaptureJournal* new_capture_journal) {capture_journal = new_capture_journal;}
+
+    // These can only be called by the processing thread
+    // Appends the queued chunks to the received data, a chunk that is pushed during this call schedules the next processing
+    void TakeChunks(ReceivedDataBuffer& received_data);
+    // Drops the queued chunks, this can only be called after the I/O thread has stopped pushing
+    // The waiting of the I/O thread can be interrupted again after this
+    void Clear(void);
+
+    // Stops the waiting of the I/O thread, this needs to be called before the processing thread waits for the I/O thread to stop
+    void InterruptWaiting(void);
+
+    // These can be called from any thread
+    std::size_t GetCapacity(void) const {return received_chunks.GetCapacity();}
+    std::size_t GetNumberOfQueuedChunks(void) const {return received_chunks.GetSize();}
+    std::size_t GetCapacityInBytes(void) const {return capacity_in_bytes;}
+    std::size_t GetNumberOfQueuedBytes(void) const {return number_of_queued_bytes.load();}
+    std::size_t GetNumberOfDroppedChunks(void) const {return counters.GetNumberOfDroppedElements();}
+    std::size_t GetHighWaterMark(void) const {return received_chunks.GetHighWaterMark();}
+    const IngestQueueCounters& GetCounters(void) const {return counters;}
+
+private:
+    struct ReceivedChunk
+    {
+        chunk_type data;
+        std::chrono::steady_clock::time_point receive_time;
+    };
+
+    bool IsFull(const std::size_t& size_of_new_chunk) const;
+    // Wakes the waiting I/O thread, the mutex is locked before the notification, so the I/O thread can not miss it between its check and its waiting
+    void NotifyWaiting(void);
+
+    SpscRingBuffer<ReceivedChunk> received_chunks;
+    SpscRingBuffer<chunk_type> free_chunks;
+    const std::size_t capacity_in_bytes;
+    // Increased by the I/O thread after a chunk was queued and decreased by the processing after a chunk was taken
+    std::atomic<std::size_t> number_of_queued_bytes;
+    // Set by the I/O thread when it schedules the processing and cleared by the processing
+    std::atomic<bool> processing_is_scheduled;
+    CaptureJournal* capture_journal;
+    std::atomic<bool> waiting_is_interrupted;
+    // The I/O thread waits on this while the queue is full, the processing only locks the mutex once for every taking of the chunks
+    std::mutex waiting_mutex;
+    std::condition_variable free_space_available;
+    IngestQueueCounters counters;
+};
+
+
+
+#endif // RECEIVED_CHUNK_QUEUE_HPP
@@ -0,0 +1,166 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include "received_data_buffer.hpp"
+
+
+
+ReceivedDataBuffer::ReceivedDataBuffer(const std::size_t& initial_capacity, const std::size_t& maximum_line_length) :
+                                            size_of_complete_lines(0), oldest_receive_time(), newest_receive_time(), latency_budget(0), size_threshold_in_bytes(0),
+                                            line_counters(maximum_line_length), line_is_being_dropped(false), stream(&stream_buffer)
+{
+    data.reserve(initial_capacity);
+}
+
+void ReceivedDataBuffer::Append(const char* received_data, const std::size_t& size_of_received_data, const std::chrono::steady_clock::time_point& receive_time)
+{
+    std::size_t previous_size = data.size();
+    data.append(received_data, size_of_received_data);
+
+    DiscardRestOfDroppedLine(previous_size);
+    FindEndOfCompleteLines(previous_size);
+    DropTooLongLine();
+    UpdateReceiveTime(previous_size, receive_time);
+}
+
+void ReceivedDataBuffer::Append(std::istream& received_data, const std::chrono::steady_clock::time_point& receive_time)
+{
+    std::size_t previous_size = data.size();
+
+    // The data is read into the end of the buffer, so it is not copied through a temporary buffer
+    std::streamsize number_of_read_bytes;
+    do
+    {
+        std::size_t size_before_reading = data.size();
+        data.resize(size_before_reading + stream_read_block_size);
+        number_of_read_bytes = received_data.rdbuf()->sgetn(&data[size_before_reading], static_cast<std::streamsize>(stream_read_block_size));
+        data.resize(size_before_reading + static_cast<std::size_t>(number_of_read_bytes));
+    } while(static_cast<std::streamsize>(stream_read_block_size) == number_of_read_bytes);
+
+    DiscardRestOfDroppedLine(previous_size);
+    FindEndOfCompleteLines(previous_size);
+    DropTooLongLine();
+    UpdateReceiveTime(previous_size, receive_time);
+}
+
+void ReceivedDataBuffer::UpdateReceiveTime(const std::size_t& previous_size, const std::chrono::steady_clock::time_point& receive_time)
+{
+    // Only the first data of an empty buffer sets the oldest receive time, the data with an unknown receive time does not change the times
+    if((previous_size < data.size()) && (std::chrono::steady_clock::time_point() != receive_time))
+    {
+        if((0 == previous_size) || (std::chrono::steady_clock::time_point() == oldest_receive_time))
+        {
+            oldest_receive_time = receive_time;
+        }
+        newest_receive_time = receive_time;
+    }
+}
+
+void ReceivedDataBuffer::DiscardRestOfDroppedLine(const std::size_t& previous_size)
+{
+    // The new data is dropped until the end of the dropped line, so its rest is not passed on as a line
+    if(line_is_being_dropped)
+    {
+        std::size_t end_of_dropped_line = data.find('\n', previous_size);
+        if(std::string::npos == end_of_dropped_line)
+        {
+            data.resize(previous_size);
+        }
+        else
+        {
+            data.erase(previous_size, (end_of_dropped_line + 1 - previous_size));
+            line_is_being_dropped = false;
+        }
+    }
+}
+
+void ReceivedDataBuffer::FindEndOfCompleteLines(const std::size_t& previous_size)
+{
+    // Only the new data needs to be searched for the end of the last line
+    for(std::size_t i = data.size(); i > previous_size; i--)
+    {
+        if('\n' == data[i - 1])
+        {
+            size_of_complete_lines = i;
+            break;
+        }
+    }
+}
+
+void ReceivedDataBuffer::DropTooLongLine(void)
+{
+    std::size_t length_of_incomplete_line = (data.size() - size_of_complete_lines);
+    if(line_counters.GetCapacity() < length_of_incomplete_line)
+    {
+        data.resize(size_of_complete_lines);
+        line_is_being_dropped = true;
+        line_counters.CountDroppedElements(1);
+        length_of_incomplete_line = 0;
+    }
+    line_counters.SetDepth(length_of_incomplete_line);
+}
+
+std::istream& ReceivedDataBuffer::GetCompleteLines(void)
+{
+    // The stream is reused, so only its position and its state need to be reset
+    stream_buffer.SetData(&data[0], (&data[0] + size_of_complete_lines));
+    stream.clear();
+
+    return stream;
+}
+
+void ReceivedDataBuffer::SetDeliveryCoalescing(const std::chrono::steady_clock::duration& new_latency_budget, const std::size_t& new_size_threshold_in_bytes)
+{
+    latency_budget = std::max(std::chrono::steady_clock::duration(0), new_latency_budget);
+    size_threshold_in_bytes = new_size_threshold_in_bytes;
+}
+
+bool ReceivedDataBuffer::IsDeliveryDue(const std::chrono::steady_clock::time_point& current_time) const
+{
+    // The data with an unknown receive time is old enough, so it is not held back
+    return (HasCompleteLines() && ((size_threshold_in_bytes <= size_of_complete_lines) || (std::chrono::steady_clock::duration(0) == GetTimeUntilDelivery(current_time))));
+}
+
+std::chrono::steady_clock::duration ReceivedDataBuffer::GetTimeUntilDelivery(const std::chrono::steady_clock::time_point& current_time) const
+{
+    return std::max(std::chrono::steady_clock::duration(0), ((oldest_receive_time + latency_budget) - current_time));
+}
+
+void ReceivedDataBuffer::DiscardCompleteLines(void)
+{
+    // The incomplete line is moved to the front, the capacity of the string is kept
+    data.erase(0, size_of_complete_lines);
+    size_of_complete_lines = 0;
+    line_counters.SetDepth(data.size());
+    oldest_receive_time = (data.empty() ? std::chrono::steady_clock::time_point() : newest_receive_time);
+}
+
+void ReceivedDataBuffer::Clear(void)
+{
+    data.clear();
+    size_of_complete_lines = 0;
+    oldest_receive_time = std::chrono::steady_clock::time_point();
+    newest_receive_time = std::chrono::steady_clock::time_point();
+    line_counters.SetDepth(0);
+    line_is_being_dropped = false;
+}
@@ -0,0 +1,117 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <string>
+#include <istream>
+#include <streambuf>
+#include <cstddef>
+#include <chrono>
+#include <algorithm>
+
+#include "global.hpp"
+#include "ingest_queue_counters.hpp"
+
+
+
+#ifndef RECEIVED_DATA_BUFFER_HPP
+#define RECEIVED_DATA_BUFFER_HPP
+
+
+
+// Collects the received data and provides the complete lines as a stream that reads the collected data in place
+// The memory of the buffer is reused, so once it has grown to the size of the received bursts, the collection does not allocate anymore
+// The buffer also keeps the receive time of its oldest data, so the latency of the processing can be measured from the arrival of the data
+// The delivery of the complete lines can be coalesced, so the receivers are called once for the lines of many small chunks
+// The incomplete line is dropped if it grows over the maximum line length, the rest of it is dropped too until the next line end arrives
+class ReceivedDataBuffer
+{
+public:
+    explicit ReceivedDataBuffer(const std::size_t& initial_capacity = 0, const std::size_t& maximum_line_length = INGEST_MAX_LINE_LENGTH_IN_BYTES);
+
+    ReceivedDataBuffer(const ReceivedDataBuffer& new_received_data_buffer) = delete;
+    ReceivedDataBuffer(ReceivedDataBuffer&& new_received_data_buffer) = delete;
+
+    ReceivedDataBuffer& operator=(const ReceivedDataBuffer& new_received_data_buffer) = delete;
+    ReceivedDataBuffer& operator=(ReceivedDataBuffer&& new_received_data_buffer) = delete;
+
+    ~ReceivedDataBuffer() = default;
+
+    // The default receive time means that the receive time of the data is not known
+    void Append(const char* received_data, const std::size_t& size_of_received_data,
+                const std::chrono::steady_clock::time_point& receive_time = std::chrono::steady_clock::time_point());
+    // Reads the stream until its end directly into the buffer
+    void Append(std::istream& received_data, const std::chrono::steady_clock::time_point& receive_time = std::chrono::steady_clock::time_point());
+    bool HasCompleteLines(void) const {return (0 != size_of_complete_lines);}
+    std::size_t GetSizeOfCompleteLines(void) const {return size_of_complete_lines;}
+    std::size_t GetSize(void) const {return data.size();}
+    std::size_t GetCapacity(void) const {return data.capacity();}
+    // The receive time of the oldest data in the buffer, the default time point if it is not known
+    const std::chrono::steady_clock::time_point& GetReceiveTime(void) const {return oldest_receive_time;}
+    // The stream is valid until the buffer is changed, it does not copy the complete lines
+    std::istream& GetCompleteLines(void);
+    // The complete lines are due when the oldest data has waited for the latency budget or their size has reached the threshold
+    // The default zero budget and zero threshold make the complete lines due at once
+    void SetDeliveryCoalescing(const std::chrono::steady_clock::duration& new_latency_budget, const std::size_t& new_size_threshold_in_bytes);
+    bool IsDeliveryDue(const std::chrono::steady_clock::time_point& current_time) const;
+    // The time until the latency budget of the oldest data elapses, zero if it has already elapsed
+    std::chrono::steady_clock::duration GetTimeUntilDelivery(const std::chrono::steady_clock::time_point& current_time) const;
+    // Removes the complete lines, the incomplete line that follows them is kept
+    // The incomplete line gets the receive time of the newest data, because the buffer does not know which appended data it started in
+    void DiscardCompleteLines(void);
+    void Clear(void);
+    // The depth is the length of the incomplete line, the capacity is the maximum line length and the dropped elements are the dropped lines
+    const IngestQueueCounters& GetLineCounters(void) const {return line_counters;}
+
+private:
+    void DiscardRestOfDroppedLine(const std::size_t& previous_size);
+    void FindEndOfCompleteLines(const std::size_t& previous_size);
+    void DropTooLongLine(void);
+    void UpdateReceiveTime(const std::size_t& previous_size, const std::chrono::steady_clock::time_point& receive_time);
+
+    // The stream is read in blocks of this size, because its size is not known in advance
+    static constexpr std::size_t stream_read_block_size = 4096;
+
+    // A stream buffer that reads the memory of the buffer directly
+    class InPlaceStreamBuffer : public std::streambuf
+    {
+    public:
+        void SetData(char* begin, char* end) {setg(begin, begin, end);}
+    };
+
+    std::string data;
+    std::size_t size_of_complete_lines;
+    std::chrono::steady_clock::time_point oldest_receive_time;
+    std::chrono::steady_clock::time_point newest_receive_time;
+    std::chrono::steady_clock::duration latency_budget;
+    std::size_t size_threshold_in_bytes;
+    IngestQueueCounters line_counters;
+    // The line end of a dropped line has not arrived yet, so the received data is dropped until then
+    bool line_is_being_dropped;
+    InPlaceStreamBuffer stream_buffer;
+    std::istream stream;
+};
+
+
+
+#endif // RECEIVED_DATA_BUFFER_HPP
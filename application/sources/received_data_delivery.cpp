@@ -0,0 +1,115 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include "received_data_delivery.hpp"
+
+
+
+ReceivedDataDelivery::ReceivedDataDelivery(QObject* new_context, const std::size_t& chunk_capacity, const std::size_t& initial_data_capacity,
+                                           data_receiver_type new_data_receiver, error_reporter_type new_error_reporter) :
+                                                context(new_context),
+                                                data_receiver(new_data_receiver),
+                                                error_reporter(new_error_reporter),
+                                                received_chunks(chunk_capacity),
+                                                received_data(initial_data_capacity),
+                                                number_of_reported_dropped_chunks(0),
+                                                number_of_reported_dropped_lines(0),
+                                                data_delivery_is_paused(false)
+{
+    // The lines that wait for the coalescing are delivered on the thread of the context
+    delivery_timer.setSingleShot(true);
+    delivery_timer.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&delivery_timer, &QTimer::timeout, context, [this](){ProcessReceivedChunks();});
+}
+
+void ReceivedDataDelivery::Push(ReceivedChunkQueue::chunk_type& chunk)
+{
+    // If the queue is full, then this waits for the processing, a chunk is only dropped if the waiting was interrupted by the closing
+    // The queued invocation is discarded if the context is destroyed before it is executed
+    if(received_chunks.Push(chunk))
+    {
+        QMetaObject::invokeMethod(context, [this](){ProcessReceivedChunks();}, Qt::QueuedConnection);
+    }
+}
+
+void ReceivedDataDelivery::SetDataDeliveryPaused(const bool& is_paused)
+{
+    // The chunks that arrived during the pause are delivered at once when the delivery is resumed
+    data_delivery_is_paused = is_paused;
+    if(!data_delivery_is_paused)
+    {
+        ProcessReceivedChunks();
+    }
+}
+
+void ReceivedDataDelivery::ProcessReceivedChunks(void)
+{
+    // The chunks stay in the queue while the delivery is paused, the flag of the queue prevents the scheduling of more processing until then
+    if(!data_delivery_is_paused)
+    {
+        received_chunks.TakeChunks(received_data);
+
+        // Only the complete lines are passed on, they are read in place by the receivers, the rest is kept until the end of its line arrives
+        // The complete lines are held back until they are due, the timer delivers them if no more chunks arrive until then
+        auto current_time = std::chrono::steady_clock::now();
+        if(received_data.IsDeliveryDue(current_time))
+        {
+            delivery_timer.stop();
+            data_receiver(received_data.GetCompleteLines());
+            received_data.DiscardCompleteLines();
+        }
+        else if(received_data.HasCompleteLines() && (!delivery_timer.isActive()))
+        {
+            delivery_timer.start(std::chrono::ceil<std::chrono::milliseconds>(received_data.GetTimeUntilDelivery(current_time)));
+        }
+
+        // A dropped chunk corrupts the data that was being received, so it is reported as an error
+        std::size_t number_of_dropped_chunks = received_chunks.GetNumberOfDroppedChunks();
+        if(number_of_reported_dropped_chunks < number_of_dropped_chunks)
+        {
+            error_reporter("The processing could not keep up with the " + connection_name + ", " +
+                           std::to_string(number_of_dropped_chunks - number_of_reported_dropped_chunks) + " received chunk was dropped!");
+            number_of_reported_dropped_chunks = number_of_dropped_chunks;
+        }
+
+        // A line that grew over the maximum line length is dropped, so the memory is not filled by a sender that does not end its lines
+        std::size_t number_of_dropped_lines = received_data.GetLineCounters().GetNumberOfDroppedElements();
+        if(number_of_reported_dropped_lines < number_of_dropped_lines)
+        {
+            error_reporter("The " + connection_name + " received a line that is longer than " + std::to_string(received_data.GetLineCounters().GetCapacity()) + " bytes, " +
+                           std::to_string(number_of_dropped_lines - number_of_reported_dropped_lines) + " line was dropped!");
+            number_of_reported_dropped_lines = number_of_dropped_lines;
+        }
+    }
+}
+
+void ReceivedDataDelivery::Clear(void)
+{
+    // The chunks that were dropped by the interrupted waiting of the closing belonged to the closed connection, they are not reported
+    received_chunks.Clear();
+    received_data.Clear();
+    delivery_timer.stop();
+    number_of_reported_dropped_chunks = received_chunks.GetNumberOfDroppedChunks();
+    number_of_reported_dropped_lines = received_data.GetLineCounters().GetNumberOfDroppedElements();
+    data_delivery_is_paused = false;
+}
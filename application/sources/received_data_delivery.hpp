@@ -0,0 +1,113 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <istream>
+#include <string>
+#include <cstddef>
+#include <chrono>
+#include <functional>
+
+#include <QObject>
+#include <QTimer>
+
+#include "global.hpp"
+#include "received_chunk_queue.hpp"
+#include "received_data_buffer.hpp"
+#include "capture_journal.hpp"
+#include "ingest_queue_counters.hpp"
+
+
+
+#ifndef RECEIVED_DATA_DELIVERY_HPP
+#define RECEIVED_DATA_DELIVERY_HPP
+
+
+
+// The receiving side that is common in the connections: it takes the chunks from the I/O thread and delivers the complete lines on the thread of the connection
+// It owns the queue of the received chunks, the buffer that assembles the lines from them and the timer of the coalesced delivery
+// The connection only reads the chunks on its I/O thread and pushes them here, the delivery and the errors are passed back through the callbacks
+class ReceivedDataDelivery
+{
+public:
+    using data_receiver_type = std::function<void(std::istream&)>;
+    using error_reporter_type = std::function<void(const std::string&)>;
+
+    // The processing is scheduled on the thread of the context, the context is the connection that owns this object
+    ReceivedDataDelivery(QObject* new_context, const std::size_t& chunk_capacity, const std::size_t& initial_data_capacity,
+                         data_receiver_type new_data_receiver, error_reporter_type new_error_reporter);
+
+    ReceivedDataDelivery(const ReceivedDataDelivery& new_received_data_delivery) = delete;
+    ReceivedDataDelivery(ReceivedDataDelivery&& new_received_data_delivery) = delete;
+
+    ReceivedDataDelivery& operator=(const ReceivedDataDelivery& new_received_data_delivery) = delete;
+    ReceivedDataDelivery& operator=(ReceivedDataDelivery&& new_received_data_delivery) = delete;
+
+    ~ReceivedDataDelivery() = default;
+
+    // These can only be called by the I/O thread
+    ReceivedChunkQueue::chunk_type GetFreeChunk(void) {return received_chunks.GetFreeChunk();}
+    // Queues the chunk and schedules its processing on the thread of the context if it is not scheduled yet
+    void Push(ReceivedChunkQueue::chunk_type& chunk);
+
+    // These can only be called on the thread of the context
+    // The name is used in the reports of the dropped chunks and lines, for example "TCP connection tcp://localhost:1234"
+    void SetConnectionName(const std::string& new_connection_name) {connection_name = new_connection_name;}
+    void SetCaptureJournal(CaptureJournal* capture_journal) {received_chunks.SetCaptureJournal(capture_journal);}
+    void SetDataDeliveryPaused(const bool& is_paused);
+    void SetDataDeliveryCoalescing(const std::chrono::milliseconds& latency_budget, const std::size_t& size_threshold_in_bytes)
+    {
+        received_data.SetDeliveryCoalescing(latency_budget, size_threshold_in_bytes);
+    }
+    std::chrono::steady_clock::time_point GetReceiveTimeOfReceivedData(void) const {return received_data.GetReceiveTime();}
+    // Takes the queued chunks and delivers the complete lines that are due
+    void ProcessReceivedChunks(void);
+    // Stops the waiting of the I/O thread, this needs to be called before the connection waits for its I/O thread to stop
+    void InterruptWaiting(void) {received_chunks.InterruptWaiting();}
+    // Drops the data that was not delivered yet, this can only be called after the I/O thread has stopped pushing
+    void Clear(void);
+
+    // These can be called from any thread
+    const IngestQueueCounters& GetCounters(void) const {return received_chunks.GetCounters();}
+    std::size_t GetNumberOfDroppedChunks(void) const {return received_chunks.GetNumberOfDroppedChunks();}
+    std::size_t GetHighWaterMark(void) const {return received_chunks.GetHighWaterMark();}
+    const IngestQueueCounters& GetLineCounters(void) const {return received_data.GetLineCounters();}
+
+private:
+    QObject* context;
+    std::string connection_name;
+    data_receiver_type data_receiver;
+    error_reporter_type error_reporter;
+
+    ReceivedChunkQueue received_chunks;
+    // The received data that is passed on as complete lines, the incomplete line at its end is completed by the next chunks
+    ReceivedDataBuffer received_data;
+    // Delivers the complete lines when their latency budget has elapsed and no new chunk has delivered them before
+    QTimer delivery_timer;
+    std::size_t number_of_reported_dropped_chunks;
+    std::size_t number_of_reported_dropped_lines;
+    bool data_delivery_is_paused;
+};
+
+
+
+#endif // RECEIVED_DATA_DELIVERY_HPP
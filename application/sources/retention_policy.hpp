@@ -0,0 +1,61 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <cstddef>
+#include <chrono>
+
+#include "global.hpp"
+
+
+
+#ifndef RETENTION_POLICY_HPP
+#define RETENTION_POLICY_HPP
+
+
+
+// Limits of the diagrams that are kept from a network connection, the oldest diagrams above any of the limits are removed
+// Every limit is disabled if its value is zero
+struct RetentionPolicy
+{
+    RetentionPolicy() = default;
+    RetentionPolicy(const std::size_t& new_maximum_number_of_diagrams, const std::size_t& new_maximum_memory_usage_in_bytes, const std::chrono::seconds& new_maximum_age)
+        : maximum_number_of_diagrams(new_maximum_number_of_diagrams), maximum_memory_usage_in_bytes(new_maximum_memory_usage_in_bytes), maximum_age(new_maximum_age) {}
+
+    bool IsUnlimited(void) const {return ((0 == maximum_number_of_diagrams) && (0 == maximum_memory_usage_in_bytes) && (0 == maximum_age.count()));}
+    bool operator==(const RetentionPolicy& other) const
+    {
+        return ((maximum_number_of_diagrams == other.maximum_number_of_diagrams) &&
+                (maximum_memory_usage_in_bytes == other.maximum_memory_usage_in_bytes) &&
+                (maximum_age == other.maximum_age));
+    }
+
+    std::size_t maximum_number_of_diagrams = 0;
+    // The memory usage of the connection as it is shown in the tree, so the diagrams evicted to the diagram cache only count with their metadata
+    std::size_t maximum_memory_usage_in_bytes = 0;
+    std::chrono::seconds maximum_age = std::chrono::seconds(0);
+};
+
+
+
+#endif /* RETENTION_POLICY_HPP */
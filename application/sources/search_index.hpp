@@ -0,0 +1,260 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <cctype>
+#include <algorithm>
+
+#include "global.hpp"
+
+
+
+#ifndef SEARCH_INDEX_HPP
+#define SEARCH_INDEX_HPP
+
+
+
+// Inverted index that maps the words of the texts belonging to the documents to the documents, so a search does not need to visit every document
+// Every word is indexed from its start and from every camel case or letter-digit boundary inside it, for example "i16CurrentSetValue" can be found
+// with "i16Current", "CurrentSet" or "Value" as well, the search is case insensitive
+template <typename T_DOCUMENT>
+class SearchIndex
+{
+public:
+    SearchIndex() = default;
+
+    SearchIndex(const SearchIndex& new_search_index) = delete;
+    SearchIndex(SearchIndex&& new_search_index) = delete;
+
+    SearchIndex& operator=(const SearchIndex& new_search_index) = delete;
+    SearchIndex& operator=(SearchIndex&& new_search_index) = delete;
+
+    ~SearchIndex() = default;
+
+    std::size_t GetNumberOfDocuments(void) const {return tokens_of_the_documents.size();}
+    std::size_t GetNumberOfTokens(void) const {return documents_of_the_tokens.size();}
+
+    // Adds the document with the words of the texts, if the document was already added, then its previous texts will be replaced
+    void AddDocument(const T_DOCUMENT& document, const std::vector<std::string>& texts)
+    {
+        RemoveDocument(document);
+
+        std::vector<std::string> tokens;
+        for(const auto& text : texts)
+        {
+            for(auto& token : Tokenize(text, true))
+            {
+                tokens.push_back(std::move(token));
+            }
+        }
+
+        for(const auto& token : tokens)
+        {
+            documents_of_the_tokens[token][document]++;
+        }
+        tokens_of_the_documents[document] = std::move(tokens);
+    }
+
+    void RemoveDocument(const T_DOCUMENT& document)
+    {
+        auto document_iterator = tokens_of_the_documents.find(document);
+        if(tokens_of_the_documents.end() != document_iterator)
+        {
+            for(const auto& token : document_iterator->second)
+            {
+                auto token_iterator = documents_of_the_tokens.find(token);
+                auto occurrence_iterator = token_iterator->second.find(document);
+                // The same token can occur more than once in the texts of a document
+                if(0 == --(occurrence_iterator->second))
+                {
+                    token_iterator->second.erase(occurrence_iterator);
+                    if(token_iterator->second.empty())
+                    {
+                        documents_of_the_tokens.erase(token_iterator);
+                    }
+                }
+            }
+            tokens_of_the_documents.erase(document_iterator);
+        }
+    }
+
+    void Clear(void)
+    {
+        documents_of_the_tokens.clear();
+        tokens_of_the_documents.clear();
+    }
+
+    // Returns the documents that contain every word of the query at least as a prefix of an indexed token
+    // A query without any word does not match anything
+    std::unordered_set<T_DOCUMENT> Search(const std::string& query) const
+    {
+        std::unordered_set<T_DOCUMENT> result;
+
+        auto words = Tokenize(query, false);
+        if(!words.empty())
+        {
+            // Selecting the word with the fewest occurrences, only the documents of this word need to be checked against the other words
+            // The tokens starting with a word are next to each other in the ordered map
+            auto most_selective_word = words.end();
+            std::size_t fewest_occurrences = 0;
+            for(auto word = words.begin(); words.end() != word; word++)
+            {
+                std::size_t occurrences = 0;
+                for(auto token_iterator = documents_of_the_tokens.lower_bound(*word); IsPrefixOf(*word, token_iterator); token_iterator++)
+                {
+                    occurrences += token_iterator->second.size();
+                }
+
+                if((words.end() == most_selective_word) || (fewest_occurrences > occurrences))
+                {
+                    most_selective_word = word;
+                    fewest_occurrences = occurrences;
+                }
+            }
+
+            for(auto token_iterator = documents_of_the_tokens.lower_bound(*most_selective_word); IsPrefixOf(*most_selective_word, token_iterator); token_iterator++)
+            {
+                for(const auto& i : token_iterator->second)
+                {
+                    if(ContainsEveryWord(tokens_of_the_documents.at(i.first), words))
+                    {
+                        result.insert(i.first);
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    // Tells whether the already indexed document contains every word of the query, this does not need to search the whole index
+    bool IsMatching(const T_DOCUMENT& document, const std::string& query) const
+    {
+        bool result = false;
+
+        auto document_iterator = tokens_of_the_documents.find(document);
+        auto words = Tokenize(query, false);
+        if((tokens_of_the_documents.end() != document_iterator) && (!words.empty()))
+        {
+            result = ContainsEveryWord(document_iterator->second, words);
+        }
+
+        return result;
+    }
+
+    // Splits the text into lower case words at the characters that are not letters, digits or underscores
+    // If the boundaries are requested, then the suffixes starting at the camel case and letter-digit boundaries are added as well
+    static std::vector<std::string> Tokenize(const std::string& text, const bool& add_the_suffixes_at_the_boundaries)
+    {
+        std::vector<std::string> result;
+
+        std::size_t position = 0;
+        while(text.size() > position)
+        {
+            // Skipping the separators
+            while((text.size() > position) && (!IsWordCharacter(text[position])))
+            {
+                position++;
+            }
+
+            std::size_t start_of_the_word = position;
+            while((text.size() > position) && IsWordCharacter(text[position]))
+            {
+                position++;
+            }
+
+            if(start_of_the_word < position)
+            {
+                std::string word = text.substr(start_of_the_word, (position - start_of_the_word));
+                if(add_the_suffixes_at_the_boundaries)
+                {
+                    for(std::size_t i = 1; word.size() > i; i++)
+                    {
+                        if(IsBoundary(word[i - 1], word[i]))
+                        {
+                            result.push_back(ToLower(word.substr(i)));
+                        }
+                    }
+                }
+                result.push_back(ToLower(word));
+            }
+        }
+
+        return result;
+    }
+
+private:
+    using TokenIterator = typename std::map<std::string, std::unordered_map<T_DOCUMENT, std::size_t> >::const_iterator;
+
+    bool IsPrefixOf(const std::string& word, const TokenIterator& token_iterator) const
+    {
+        return ((documents_of_the_tokens.end() != token_iterator) && (0 == token_iterator->first.compare(0, word.size(), word)));
+    }
+
+    static bool ContainsEveryWord(const std::vector<std::string>& tokens, const std::vector<std::string>& words)
+    {
+        return std::all_of(words.begin(), words.end(),
+                           [&](const std::string& word) -> bool
+                           {
+                               return std::any_of(tokens.begin(), tokens.end(),
+                                                  [&](const std::string& token) -> bool {return (0 == token.compare(0, word.size(), word));});
+                           });
+    }
+
+    static bool IsWordCharacter(const char& character)
+    {
+        return ((0 != std::isalnum(static_cast<unsigned char>(character))) || ('_' == character));
+    }
+
+    static bool IsBoundary(const char& previous_character, const char& character)
+    {
+        auto previous = static_cast<unsigned char>(previous_character);
+        auto current = static_cast<unsigned char>(character);
+
+        return ((std::islower(previous) && std::isupper(current)) ||
+                (std::isalpha(previous) && std::isdigit(current)) ||
+                (std::isdigit(previous) && std::isalpha(current)) ||
+                (('_' == previous) && std::isalnum(current)));
+    }
+
+    static std::string ToLower(std::string text)
+    {
+        for(auto& i : text)
+        {
+            i = static_cast<char>(std::tolower(static_cast<unsigned char>(i)));
+        }
+        return text;
+    }
+
+    // The indexed tokens with the documents that contain them and the number of their occurrences in the document
+    std::map<std::string, std::unordered_map<T_DOCUMENT, std::size_t> > documents_of_the_tokens;
+    // The tokens of every indexed document, these are needed to remove the document from the index
+    std::unordered_map<T_DOCUMENT, std::vector<std::string> > tokens_of_the_documents;
+};
+
+#endif // SEARCH_INDEX_HPP
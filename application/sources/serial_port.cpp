@@ -25,54 +25,73 @@
 
 
 
-SerialPort::SerialPort() : QObject()
+SerialPort::SerialPort() : QObject(),
+                           io_thread_context(std::make_unique<QObject>()),
+                           received_data_delivery(this, received_chunks_capacity, SERIAL_PORT_MAX_READ_LENGTH_IN_BYTES,
+                                                  [this](std::istream& received_data){emit DataReceived(received_data);},
+                                                  [this](const std::string& error_message){emit ErrorReport(error_message);})
 {
-
+    // Every function that is invoked with the context is executed on the I/O thread
+    io_thread_context->moveToThread(&io_thread);
+    io_thread.start();
 }
 
 SerialPort::~SerialPort()
 {
-    if(port)
-    {
-        port->close();
-        port.reset();
-    }
+    Close();
+    io_thread.quit();
+    io_thread.wait();
 }
 
 bool SerialPort::Open(const std::string& port_name = SERIAL_PORT_DEFAULT_PORT_NAME)
 {
     bool result = false;
 
-    if(!port)
+    if(opened_port_name.empty())
     {
-        try
+        // The port is created on the I/O thread so that its notifiers belong to that thread, this thread waits for the result
+        std::string error_message;
+        QMetaObject::invokeMethod(io_thread_context.get(), [&]()
         {
-            port = std::make_unique<QSerialPort>();
-            port->setPortName(QString::fromStdString(port_name));
-            port->setBaudRate(SERIAL_PORT_DEFAULT_BAUDRATE);
-            port->setDataBits(QSerialPort::Data8);
-            port->setStopBits(QSerialPort::OneStop);
-            port->setParity(QSerialPort::NoParity);
-            port->setFlowControl(QSerialPort::NoFlowControl);
-
-            if(port->open(QIODevice::ReadOnly))
+            try
             {
-                result = true;
+                port = std::make_unique<QSerialPort>();
+                port->setPortName(QString::fromStdString(port_name));
+                port->setBaudRate(SERIAL_PORT_DEFAULT_BAUDRATE);
+                port->setDataBits(QSerialPort::Data8);
+                port->setStopBits(QSerialPort::OneStop);
+                port->setParity(QSerialPort::NoParity);
+                port->setFlowControl(QSerialPort::NoFlowControl);
+
+                if(port->open(QIODevice::ReadOnly))
+                {
+                    result = true;
+                }
+                else
+                {
+                    port.reset();
+                }
             }
-            else
+            catch(...)
             {
                 port.reset();
+                error_message = "Could not open port (" + port_name + "), probably a bad allocation in std::make_unique().";
             }
+        }, Qt::BlockingQueuedConnection);
+
+        if(!error_message.empty())
+        {
+            throw(error_message);
         }
-        catch(...)
+        if(result)
         {
-            port.reset();
-            throw("Could not open port (" + port_name + "), probably a bad allocation in std::make_unique().");
+            opened_port_name = port_name;
+            received_data_delivery.SetConnectionName("serial port " + port_name);
         }
     }
     else
     {
-        if(port_name == port->portName().toStdString())
+        if(port_name == opened_port_name)
         {
             result = true;
         }
@@ -87,18 +106,27 @@ bool SerialPort::Open(const std::string& port_name = SERIAL_PORT_DEFAULT_PORT_NA
 
 void SerialPort::Close()
 {
-    QObject::disconnect(port.get(), &QSerialPort::readyRead, this, &SerialPort::ReadLineFromPort);
-
-    if(port)
+    if(IsOpen())
     {
-        port->close();
-        port.reset();
+        // The I/O thread can wait for the processing of this thread, so its waiting is interrupted before it is stopped
+        received_data_delivery.InterruptWaiting();
+
+        // After the port was closed on the I/O thread, no more chunks will be received
+        QMetaObject::invokeMethod(io_thread_context.get(), [&]()
+        {
+            port->close();
+            port.reset();
+        }, Qt::BlockingQueuedConnection);
+        opened_port_name.clear();
+
+        // The data that was not processed yet belongs to the closed connection
+        received_data_delivery.Clear();
     }
 }
 
 bool SerialPort::IsOpen()
 {
-    return (nullptr != port);
+    return (!opened_port_name.empty());
 }
 
 bool SerialPort::StartListening(void)
@@ -107,34 +135,45 @@ bool SerialPort::StartListening(void)
 
     if(IsOpen())
     {
-        QObject::connect(port.get(), &QSerialPort::readyRead,       this, &SerialPort::ReadLineFromPort);
-        QObject::connect(port.get(), &QSerialPort::errorOccurred,   this, &SerialPort::HandleErrors);
+        // The signals of the port are handled on the I/O thread, because the context of the connections lives there
+        QMetaObject::invokeMethod(io_thread_context.get(), [&]()
+        {
+            QObject::connect(port.get(), &QSerialPort::readyRead,       io_thread_context.get(), [this](){ReadFromPort();});
+            QObject::connect(port.get(), &QSerialPort::errorOccurred,   io_thread_context.get(), [this](QSerialPort::SerialPortError error){HandleErrors(error);});
+        }, Qt::BlockingQueuedConnection);
         result = true;
     }
 
     return result;
 }
 
-void SerialPort::ReadLineFromPort(void)
+void SerialPort::ReadFromPort(void)
 {
-    bool at_least_one_line_was_received = false;
-    std::string received_lines;
-    while(port->canReadLine())
+    // This runs on the I/O thread, the received data is only read into chunks here, the lines are assembled by the thread of this object
+    qint64 number_of_available_bytes;
+    while(0 < (number_of_available_bytes = port->bytesAvailable()))
     {
-        at_least_one_line_was_received = true;
-        received_lines += port->readLine().toStdString();
-    }
-    if(at_least_one_line_was_received)
-    {
-        std::stringstream received_data_stream(received_lines);
-        emit DataReceived(received_data_stream);
+        // The memory of a processed chunk is reused if there is one
+        auto chunk = received_data_delivery.GetFreeChunk();
+        chunk.resize(static_cast<std::size_t>(std::min(number_of_available_bytes, static_cast<qint64>(SERIAL_PORT_MAX_READ_LENGTH_IN_BYTES))));
+        qint64 number_of_read_bytes = port->read(chunk.data(), static_cast<qint64>(chunk.size()));
+        if(0 >= number_of_read_bytes)
+        {
+            break;
+        }
+        chunk.resize(static_cast<std::size_t>(number_of_read_bytes));
+
+        // If the queue is full, then this waits for the processing, a chunk is only dropped if the closing interrupts the waiting
+        received_data_delivery.Push(chunk);
     }
 }
 
 void SerialPort::HandleErrors(QSerialPort::SerialPortError error)
 {
+    // This runs on the I/O thread, the error is reported from the thread of this object
     if(QSerialPort::ReadError == error)
     {
-        emit ErrorReport((QObject::tr("An I/O error occurred while reading the data from port %1, error: %2").arg(port->portName()).arg(port->errorString())).toStdString());
+        std::string error_message = (QObject::tr("An I/O error occurred while reading the data from port %1, error: %2").arg(port->portName()).arg(port->errorString())).toStdString();
+        QMetaObject::invokeMethod(this, [this, error_message](){emit ErrorReport(error_message);}, Qt::QueuedConnection);
     }
 }
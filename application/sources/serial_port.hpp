@@ -24,13 +24,18 @@
 #include <iostream>
 #include <sstream>
 #include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
 
 #include <QObject>
+#include <QThread>
 #include <QSerialPort>
 #include <QSerialPortInfo>
 
 #include "global.hpp"
 #include "network_connection_interface.hpp"
+#include "received_data_delivery.hpp"
 
 
 
@@ -39,6 +44,12 @@
 
 
 
+// The port is read on a dedicated thread, so a busy GUI thread can not delay the reading until the buffer of the operating system overflows
+// The received chunks are passed to the thread of this object through a lock-free ring buffer
+// If the ring buffer is full, then the I/O thread blocks until the processing catches up, and QSerialPort is not read during that time
+// The sender of a serial port can not be slowed down without flow control, so a long stall can overflow the tty buffer of the kernel and lose data there
+// These losses are not visible here, the dropped chunks and the stalls of the receive queue counters are the signals of such an overrun
+// The memory of the chunks is returned to the I/O thread through another ring buffer, so the receiving does not allocate in the steady state
 class SerialPort : public QObject, public NetworkConnectionInterface
 {
     Q_OBJECT
@@ -62,17 +73,44 @@ public:
 
     bool StartListening(void) override;
 
+    void SetCaptureJournal(CaptureJournal* capture_journal) override {received_data_delivery.SetCaptureJournal(capture_journal);}
+
+    void SetDataDeliveryPaused(const bool& is_paused) override {received_data_delivery.SetDataDeliveryPaused(is_paused);}
+
+    void SetDataDeliveryCoalescing(const std::chrono::milliseconds& latency_budget, const std::size_t& size_threshold_in_bytes) override
+    {
+        received_data_delivery.SetDataDeliveryCoalescing(latency_budget, size_threshold_in_bytes);
+    }
+
+    const IngestQueueCounters& GetReceiveQueueCounters(void) const override {return received_data_delivery.GetCounters();}
+    const IngestQueueCounters& GetLineCounters(void) const override {return received_data_delivery.GetLineCounters();}
+
+    std::chrono::steady_clock::time_point GetReceiveTimeOfReceivedData(void) const override {return received_data_delivery.GetReceiveTimeOfReceivedData();}
+
+    // These can be called from any thread
+    std::size_t GetNumberOfDroppedChunks(void) const {return received_data_delivery.GetNumberOfDroppedChunks();}
+    std::size_t GetHighWaterMarkOfReceivedChunks(void) const {return received_data_delivery.GetHighWaterMark();}
+
 signals:
     void DataReceived(std::istream& received_data) override;
     void ErrorReport(const std::string& error_message) override;
 
-private slots:
-    void ReadLineFromPort(void);
+private:
+    void ReadFromPort(void);
     void HandleErrors(QSerialPort::SerialPortError error);
 
-private:
+    // The number of chunks that can wait for the processing, a chunk is the data that was available when the port signalled readyRead
+    static constexpr std::size_t received_chunks_capacity = 4096;
 
+    // The port and the context of its connections live on the I/O thread, they are only accessed from there
+    QThread io_thread;
+    std::unique_ptr<QObject> io_thread_context;
     std::unique_ptr<QSerialPort> port;
+    // The name of the opened port, this is empty if no port is open, only accessed from the thread of this object
+    std::string opened_port_name;
+
+    // Owns the received chunks until their complete lines are delivered on the thread of this object
+    ReceivedDataDelivery received_data_delivery;
 };
 
 
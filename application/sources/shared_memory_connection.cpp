@@ -0,0 +1,163 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include "shared_memory_connection.hpp"
+
+
+
+bool SharedMemoryConnection::IsSharedMemoryPortName(const std::string& port_name)
+{
+    std::size_t scheme_length = std::char_traits<char>::length(scheme);
+    return ((0 == port_name.compare(0, scheme_length, scheme)) && (scheme_length < port_name.size()));
+}
+
+SharedMemoryConnection::SharedMemoryConnection() : QObject(),
+                                                   reading_needs_to_stop(false),
+                                                   number_of_received_bytes(0),
+                                                   received_data_delivery(this, received_chunks_capacity, SHARED_MEMORY_MAX_READ_LENGTH_IN_BYTES,
+                                                                          [this](std::istream& received_data){emit DataReceived(received_data);},
+                                                                          [this](const std::string& error_message){emit ErrorReport(error_message);})
+{
+
+}
+
+SharedMemoryConnection::~SharedMemoryConnection()
+{
+    Close();
+}
+
+bool SharedMemoryConnection::Open(const std::string& port_name)
+{
+    bool result = false;
+
+    if(opened_port_name.empty())
+    {
+        // The ring needs to be created by the producer before the connection can be opened
+        if(IsSharedMemoryPortName(port_name) && ring.Attach(port_name.substr(std::char_traits<char>::length(scheme))))
+        {
+            opened_port_name = port_name;
+            received_data_delivery.SetConnectionName("shared memory " + port_name);
+            number_of_received_bytes = 0;
+            result = true;
+        }
+    }
+    else
+    {
+        if(port_name == opened_port_name)
+        {
+            result = true;
+        }
+        else
+        {
+            throw("Another shared memory was already openend with this object: " + port_name);
+        }
+    }
+
+    return result;
+}
+
+void SharedMemoryConnection::Close()
+{
+    if(IsOpen())
+    {
+        // After the reader thread has stopped, no more chunks will be received
+        reading_needs_to_stop = true;
+        received_data_delivery.InterruptWaiting();
+        ring.InterruptWaiting();
+        if(reader_thread.joinable())
+        {
+            reader_thread.join();
+        }
+        reading_needs_to_stop = false;
+        ring.Detach();
+        opened_port_name.clear();
+
+        // The data that was not processed yet belongs to the closed connection
+        received_data_delivery.Clear();
+    }
+}
+
+bool SharedMemoryConnection::IsOpen()
+{
+    return (!opened_port_name.empty());
+}
+
+bool SharedMemoryConnection::StartListening(void)
+{
+    bool result = false;
+
+    if(IsOpen())
+    {
+        if(!reader_thread.joinable())
+        {
+            reader_thread = std::thread(&SharedMemoryConnection::ReadFromRing, this);
+        }
+        result = true;
+    }
+
+    return result;
+}
+
+void SharedMemoryConnection::ReadFromRing(void)
+{
+    // The memory of a processed chunk is reused if there is one, a chunk that could not be filled is kept for the next reading
+    auto chunk = received_data_delivery.GetFreeChunk();
+    bool producer_detachment_was_reported = false;
+
+    while(!reading_needs_to_stop)
+    {
+        chunk.resize(SHARED_MEMORY_MAX_READ_LENGTH_IN_BYTES);
+        std::size_t number_of_read_bytes = ring.TryRead(chunk.data(), chunk.size());
+        if(0 < number_of_read_bytes)
+        {
+            chunk.resize(number_of_read_bytes);
+            number_of_received_bytes += number_of_read_bytes;
+
+            // If the queue is full, then this waits for the processing, the producer waits for the free space of the ring meanwhile
+            received_data_delivery.Push(chunk);
+            chunk = received_data_delivery.GetFreeChunk();
+        }
+        else if(ring.IsCorrupted())
+        {
+            // The data of a corrupted ring can not be trusted, the connection needs to be reopened after the producer was restarted
+            std::string error_message = "The shared memory " + opened_port_name + " was corrupted, the reading was stopped!";
+            QMetaObject::invokeMethod(this, [this, error_message](){emit ErrorReport(error_message);}, Qt::QueuedConnection);
+            break;
+        }
+        else if(ring.IsProducerAttached())
+        {
+            ring.WaitForData(maximum_waiting_step);
+        }
+        else
+        {
+            // The ring of a detached producer does not get new data, the connection needs to be reopened after the producer was restarted
+            if(!producer_detachment_was_reported)
+            {
+                std::string error_message = "The producer of the shared memory " + opened_port_name + " has detached!";
+                QMetaObject::invokeMethod(this, [this, error_message](){emit ErrorReport(error_message);}, Qt::QueuedConnection);
+                producer_detachment_was_reported = true;
+            }
+            std::this_thread::sleep_for(maximum_waiting_step);
+        }
+    }
+}
@@ -0,0 +1,122 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include <QObject>
+
+#include "global.hpp"
+#include "network_connection_interface.hpp"
+#include "received_data_delivery.hpp"
+#include "shared_memory_ring.hpp"
+
+
+
+#ifndef SHARED_MEMORY_CONNECTION_HPP
+#define SHARED_MEMORY_CONNECTION_HPP
+
+
+
+// Receives the stream of a producer process on the same machine through a shared memory ring (shm://name), this is only available on Linux
+// The producer creates the ring with the name, see the tools/shared_memory_producer for a reference producer
+// The ring is read on a dedicated thread in large chunks, the chunks are passed to the thread of this object like in the SerialPort
+// If the processing falls behind, then the reading waits and the producer waits for the free space of the ring, so the data is never dropped
+class SharedMemoryConnection : public QObject, public NetworkConnectionInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(NetworkConnectionInterface)
+
+public:
+    static constexpr char scheme[] = "shm://";
+
+    static bool IsSharedMemoryPortName(const std::string& port_name);
+
+    SharedMemoryConnection();
+    ~SharedMemoryConnection() override;
+
+    SharedMemoryConnection(const SharedMemoryConnection&) = delete;
+    SharedMemoryConnection(SharedMemoryConnection&&) = delete;
+
+    SharedMemoryConnection& operator=(const SharedMemoryConnection&) = delete;
+    SharedMemoryConnection& operator=(SharedMemoryConnection&&) = delete;
+
+    bool Open(const std::string& port_name) override;
+
+    void Close(void) override;
+
+    bool IsOpen(void) override;
+
+    bool StartListening(void) override;
+
+    void SetCaptureJournal(CaptureJournal* capture_journal) override {received_data_delivery.SetCaptureJournal(capture_journal);}
+
+    void SetDataDeliveryPaused(const bool& is_paused) override {received_data_delivery.SetDataDeliveryPaused(is_paused);}
+
+    void SetDataDeliveryCoalescing(const std::chrono::milliseconds& latency_budget, const std::size_t& size_threshold_in_bytes) override
+    {
+        received_data_delivery.SetDataDeliveryCoalescing(latency_budget, size_threshold_in_bytes);
+    }
+
+    const IngestQueueCounters& GetReceiveQueueCounters(void) const override {return received_data_delivery.GetCounters();}
+    const IngestQueueCounters& GetLineCounters(void) const override {return received_data_delivery.GetLineCounters();}
+
+    std::chrono::steady_clock::time_point GetReceiveTimeOfReceivedData(void) const override {return received_data_delivery.GetReceiveTimeOfReceivedData();}
+
+    // These can be called from any thread
+    std::size_t GetNumberOfReceivedBytes(void) const {return number_of_received_bytes.load();}
+    std::size_t GetNumberOfWakeUps(void) const {return ring.GetNumberOfWakeUps();}
+
+signals:
+    void DataReceived(std::istream& received_data) override;
+    void ErrorReport(const std::string& error_message) override;
+
+private:
+    // This runs on the reader thread
+    void ReadFromRing(void);
+
+    // The number of chunks that can wait for the processing, the reading waits if the queue is full
+    static constexpr std::size_t received_chunks_capacity = 256;
+    // The waiting for the data is repeated in steps, so the stopping is noticed even if its wake-up was missed
+    static constexpr std::chrono::milliseconds maximum_waiting_step = std::chrono::milliseconds(100);
+
+    // The name of the opened port, this is empty if no port is open, it is only changed while the reader thread is not running
+    std::string opened_port_name;
+    // Attached and detached by the thread of this object, only read by the reader thread while it is running
+    SharedMemoryRing ring;
+    std::thread reader_thread;
+    std::atomic<bool> reading_needs_to_stop;
+    std::atomic<std::size_t> number_of_received_bytes;
+
+    // Owns the received chunks until their complete lines are delivered on the thread of this object
+    ReceivedDataDelivery received_data_delivery;
+};
+
+
+
+#endif // SHARED_MEMORY_CONNECTION_HPP
@@ -0,0 +1,373 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include "shared_memory_ring.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+
+// The futexes and the positions are shared between processes, so they can not fall back to locks
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free, "The atomics of the shared memory need to be lock-free!");
+
+SharedMemoryRing::SharedMemoryRing() : is_producer(false),
+                                       is_corrupted(false),
+                                       header(nullptr),
+                                       data(nullptr),
+                                       size_of_mapping(0),
+                                       own_position(0),
+                                       cached_other_position(0),
+                                       number_of_wake_ups(0)
+{
+
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    Detach();
+}
+
+bool SharedMemoryRing::Create(const std::string& name, const std::size_t& minimum_capacity_in_bytes)
+{
+    bool result = false;
+
+    if((!IsAttached()) && (!name.empty()) && (std::string::npos == name.find('/')))
+    {
+        // The positions are wrapped with a mask, and the ring is at least one page
+        std::size_t capacity = 4096;
+        while(capacity < minimum_capacity_in_bytes)
+        {
+            capacity <<= 1;
+        }
+
+        std::string new_object_name = GetObjectName(name);
+        shm_unlink(new_object_name.c_str());
+        int file_descriptor = shm_open(new_object_name.c_str(), (O_CREAT | O_EXCL | O_RDWR), 0600);
+        if(0 <= file_descriptor)
+        {
+            // The new object is filled with zeros, so only the non-zero fields need to be set
+            if((0 == ftruncate(file_descriptor, static_cast<off_t>(data_offset + capacity))) && Map(file_descriptor, (data_offset + capacity)))
+            {
+                header = new(header) Header();
+                header->version = header_version;
+                header->capacity = capacity;
+                header->producer_is_attached.store(1);
+                header->magic.store(header_magic, std::memory_order_release);
+                object_name = new_object_name;
+                is_producer = true;
+                is_corrupted = false;
+                result = true;
+            }
+            else
+            {
+                shm_unlink(new_object_name.c_str());
+            }
+            close(file_descriptor);
+        }
+    }
+
+    return result;
+}
+
+bool SharedMemoryRing::Attach(const std::string& name)
+{
+    bool result = false;
+
+    if((!IsAttached()) && (!name.empty()) && (std::string::npos == name.find('/')))
+    {
+        std::string new_object_name = GetObjectName(name);
+        int file_descriptor = shm_open(new_object_name.c_str(), O_RDWR, 0);
+        if(0 <= file_descriptor)
+        {
+            struct stat status;
+            if((0 == fstat(file_descriptor, &status)) && (data_offset < static_cast<std::size_t>(status.st_size)) &&
+               Map(file_descriptor, static_cast<std::size_t>(status.st_size)))
+            {
+                // The ring has only one consumer, the second one can not attach
+                // The positions are wrapped with a mask, so the capacity needs to be a power of two
+                if((header_magic == header->magic.load(std::memory_order_acquire)) && (header_version == header->version) &&
+                   ((data_offset + header->capacity) == size_of_mapping) && (0 < header->capacity) && (0 == (header->capacity & (header->capacity - 1))) &&
+                   (0 == header->consumer_is_attached.exchange(1)))
+                {
+                    own_position = header->read_position.load();
+                    cached_other_position = header->write_position.load(std::memory_order_acquire);
+                    object_name = new_object_name;
+                    is_producer = false;
+                    is_corrupted = false;
+                    result = true;
+                }
+                else
+                {
+                    munmap(header, size_of_mapping);
+                    header = nullptr;
+                    data = nullptr;
+                    size_of_mapping = 0;
+                }
+            }
+            close(file_descriptor);
+        }
+    }
+
+    return result;
+}
+
+void SharedMemoryRing::Detach(void)
+{
+    if(IsAttached())
+    {
+        // The other side is woken up, so it does not wait for data or space that will never come
+        if(is_producer)
+        {
+            header->producer_is_attached.store(0);
+            WakeUpFutex(header->data_sequence);
+            shm_unlink(object_name.c_str());
+        }
+        else
+        {
+            header->consumer_is_attached.store(0);
+            WakeUpFutex(header->space_sequence);
+        }
+
+        munmap(header, size_of_mapping);
+        header = nullptr;
+        data = nullptr;
+        size_of_mapping = 0;
+        own_position = 0;
+        cached_other_position = 0;
+        object_name.clear();
+        is_producer = false;
+    }
+}
+
+std::size_t SharedMemoryRing::GetCapacity(void) const
+{
+    return (IsAttached() ? static_cast<std::size_t>(header->capacity) : 0);
+}
+
+std::size_t SharedMemoryRing::TryWrite(const char* new_data, const std::size_t& size)
+{
+    std::size_t result = 0;
+
+    if(IsAttached() && is_producer)
+    {
+        // The read position of the consumer is only read again if the last seen one does not leave enough space
+        std::size_t capacity = static_cast<std::size_t>(header->capacity);
+        std::size_t free_space = capacity - static_cast<std::size_t>(own_position - cached_other_position);
+        if(free_space < size)
+        {
+            cached_other_position = header->read_position.load(std::memory_order_acquire);
+            free_space = capacity - static_cast<std::size_t>(own_position - cached_other_position);
+        }
+
+        result = std::min(size, free_space);
+        if(0 < result)
+        {
+            std::size_t offset = static_cast<std::size_t>(own_position & (capacity - 1));
+            std::size_t size_until_end = std::min(result, (capacity - offset));
+            std::memcpy((data + offset), new_data, size_until_end);
+            std::memcpy(data, (new_data + size_until_end), (result - size_until_end));
+            own_position += result;
+
+            // The sequentially consistent store and load pair with the ones of WaitForData, so either the consumer sees the data or this sees the waiting
+            header->write_position.store(own_position, std::memory_order_seq_cst);
+            if(0 != header->consumer_is_waiting.load(std::memory_order_seq_cst))
+            {
+                WakeUpFutex(header->data_sequence);
+            }
+        }
+    }
+
+    return result;
+}
+
+bool SharedMemoryRing::WaitForSpace(const std::chrono::milliseconds& timeout)
+{
+    bool result = false;
+
+    if(IsAttached() && is_producer)
+    {
+        uint32_t sequence = header->space_sequence.load(std::memory_order_acquire);
+        header->producer_is_waiting.store(1, std::memory_order_seq_cst);
+        cached_other_position = header->read_position.load(std::memory_order_seq_cst);
+        if((own_position - cached_other_position) == header->capacity)
+        {
+            WaitOnFutex(header->space_sequence, sequence, timeout);
+        }
+        header->producer_is_waiting.store(0, std::memory_order_relaxed);
+
+        cached_other_position = header->read_position.load(std::memory_order_acquire);
+        result = ((own_position - cached_other_position) < header->capacity);
+    }
+
+    return result;
+}
+
+bool SharedMemoryRing::Write(const char* new_data, const std::size_t& size, const std::chrono::milliseconds& timeout)
+{
+    std::size_t number_of_written_bytes = TryWrite(new_data, size);
+    bool result = (IsAttached() && is_producer);
+    while(result && (number_of_written_bytes < size))
+    {
+        result = WaitForSpace(timeout);
+        if(result)
+        {
+            number_of_written_bytes += TryWrite((new_data + number_of_written_bytes), (size - number_of_written_bytes));
+        }
+    }
+
+    return result;
+}
+
+bool SharedMemoryRing::IsConsumerAttached(void) const
+{
+    return (IsAttached() && (0 != header->consumer_is_attached.load(std::memory_order_acquire)));
+}
+
+std::size_t SharedMemoryRing::TryRead(char* destination, const std::size_t& maximum_size)
+{
+    std::size_t result = 0;
+
+    if(IsAttached() && (!is_producer) && (!is_corrupted))
+    {
+        // The write position of the producer is only read again if all the data that was seen last time has been read
+        if(own_position == cached_other_position)
+        {
+            cached_other_position = header->write_position.load(std::memory_order_acquire);
+        }
+
+        // The capacity was checked against the size of the mapping when attaching, the header could have been overwritten since then
+        // The producer can not be ahead by more than the capacity, a larger distance would make the copying read outside of the data
+        std::size_t capacity = (size_of_mapping - data_offset);
+        std::size_t distance = static_cast<std::size_t>(cached_other_position - own_position);
+        if(capacity < distance)
+        {
+            // The consumer side is released, but the mapping is only removed by Detach, so the other threads of the process can still interrupt the waiting
+            is_corrupted = true;
+            header->consumer_is_attached.store(0);
+            WakeUpFutex(header->space_sequence);
+        }
+        else
+        {
+            result = std::min(maximum_size, distance);
+        }
+
+        if(0 < result)
+        {
+            std::size_t offset = static_cast<std::size_t>(own_position & (capacity - 1));
+            std::size_t size_until_end = std::min(result, (capacity - offset));
+            std::memcpy(destination, (data + offset), size_until_end);
+            std::memcpy((destination + size_until_end), data, (result - size_until_end));
+            own_position += result;
+
+            // The sequentially consistent store and load pair with the ones of WaitForSpace
+            header->read_position.store(own_position, std::memory_order_seq_cst);
+            if(0 != header->producer_is_waiting.load(std::memory_order_seq_cst))
+            {
+                WakeUpFutex(header->space_sequence);
+            }
+        }
+    }
+
+    return result;
+}
+
+bool SharedMemoryRing::WaitForData(const std::chrono::milliseconds& timeout)
+{
+    bool result = false;
+
+    if(IsAttached() && (!is_producer) && (!is_corrupted))
+    {
+        // If the producer changes the sequence after it was read here, then the futex does not wait
+        uint32_t sequence = header->data_sequence.load(std::memory_order_acquire);
+        header->consumer_is_waiting.store(1, std::memory_order_seq_cst);
+        cached_other_position = header->write_position.load(std::memory_order_seq_cst);
+        if((own_position == cached_other_position) && IsProducerAttached())
+        {
+            WaitOnFutex(header->data_sequence, sequence, timeout);
+        }
+        header->consumer_is_waiting.store(0, std::memory_order_relaxed);
+
+        cached_other_position = header->write_position.load(std::memory_order_acquire);
+        result = (own_position != cached_other_position);
+    }
+
+    return result;
+}
+
+bool SharedMemoryRing::IsProducerAttached(void) const
+{
+    return (IsAttached() && (0 != header->producer_is_attached.load(std::memory_order_acquire)));
+}
+
+void SharedMemoryRing::InterruptWaiting(void)
+{
+    if(IsAttached())
+    {
+        WakeUpFutex(is_producer ? header->space_sequence : header->data_sequence);
+    }
+}
+
+void SharedMemoryRing::WaitOnFutex(std::atomic<uint32_t>& futex, const uint32_t& expected_value, const std::chrono::milliseconds& timeout)
+{
+    // The futex returns early if its value has changed, if it was interrupted by a signal or if the timeout has elapsed, the callers check the ring again in every case
+    struct timespec relative_timeout;
+    relative_timeout.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+    relative_timeout.tv_nsec = static_cast<long>((timeout.count() % 1000) * 1000000);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&futex), FUTEX_WAIT, expected_value, &relative_timeout, nullptr, 0);
+}
+
+void SharedMemoryRing::WakeUpFutex(std::atomic<uint32_t>& futex)
+{
+    // The futex is shared between processes, so the private futex operations can not be used
+    futex.fetch_add(1, std::memory_order_seq_cst);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&futex), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    number_of_wake_ups.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool SharedMemoryRing::Map(const int& file_descriptor, const std::size_t& size)
+{
+    bool result = false;
+
+    void* mapping = mmap(nullptr, size, (PROT_READ | PROT_WRITE), MAP_SHARED, file_descriptor, 0);
+    if(MAP_FAILED != mapping)
+    {
+        header = static_cast<Header*>(mapping);
+        data = static_cast<char*>(mapping) + data_offset;
+        size_of_mapping = size;
+        own_position = 0;
+        cached_other_position = 0;
+        result = true;
+    }
+
+    return result;
+}
@@ -0,0 +1,135 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#include "global.hpp"
+
+
+
+#ifndef SHARED_MEMORY_RING_HPP
+#define SHARED_MEMORY_RING_HPP
+
+
+
+// A byte stream from a producer process to a consumer process through a ring buffer in a POSIX shared memory object
+// The producer creates the shared memory object, the consumer attaches to it by its name, every process uses only one side of the ring
+// The positions are only exchanged through atomics, so the data is handed over without system calls while the other side is awake
+// A side only calls the futex of the other side if that side has announced that it sleeps, so a busy stream does not make system calls at all
+// The futexes live in the shared memory, so they work between processes, this is only available on Linux
+class SharedMemoryRing
+{
+public:
+    SharedMemoryRing();
+    ~SharedMemoryRing();
+
+    SharedMemoryRing(const SharedMemoryRing& new_shared_memory_ring) = delete;
+    SharedMemoryRing(SharedMemoryRing&& new_shared_memory_ring) = delete;
+
+    SharedMemoryRing& operator=(const SharedMemoryRing& new_shared_memory_ring) = delete;
+    SharedMemoryRing& operator=(SharedMemoryRing&& new_shared_memory_ring) = delete;
+
+    // The name is the name of the shared memory object without the leading slash, the capacity is rounded up to a power of two
+    // A stale object with the same name is replaced, the object is removed when the producer detaches
+    bool Create(const std::string& name, const std::size_t& minimum_capacity_in_bytes = SHARED_MEMORY_DEFAULT_CAPACITY_IN_BYTES);
+    // Only succeeds if the object was created by a producer with the same layout
+    bool Attach(const std::string& name);
+    void Detach(void);
+    bool IsAttached(void) const {return (nullptr != header);}
+    // The consumer stops reading and releases its side if the producer has published an impossible write position, the ring can not be trusted after that
+    bool IsCorrupted(void) const {return is_corrupted;}
+    bool IsProducer(void) const {return is_producer;}
+    std::size_t GetCapacity(void) const;
+
+    // These can only be called by the producer
+    // Writes as much of the data as fits into the ring, returns the number of written bytes
+    std::size_t TryWrite(const char* new_data, const std::size_t& size);
+    // Waits until there is free space in the ring or the timeout has elapsed, the waiting is interrupted by InterruptWaiting
+    bool WaitForSpace(const std::chrono::milliseconds& timeout);
+    // Writes all the data, waiting for the consumer while the ring is full, returns false if a waiting has timed out or was interrupted
+    bool Write(const char* new_data, const std::size_t& size, const std::chrono::milliseconds& timeout);
+    bool IsConsumerAttached(void) const;
+
+    // These can only be called by the consumer
+    // Reads at most maximum_size bytes, returns the number of read bytes, nothing is read after the ring was found to be corrupted
+    std::size_t TryRead(char* destination, const std::size_t& maximum_size);
+    // Waits until there is data in the ring, the waiting is interrupted when the producer detaches or by InterruptWaiting
+    bool WaitForData(const std::chrono::milliseconds& timeout);
+    bool IsProducerAttached(void) const;
+
+    // Wakes up the waiting of this side, this can be called from any thread of the process
+    void InterruptWaiting(void);
+
+    // The number of futex wake-ups that this side has made, this shows how rarely the stream needs system calls
+    std::size_t GetNumberOfWakeUps(void) const {return number_of_wake_ups.load(std::memory_order_relaxed);}
+
+private:
+    // The layout of the beginning of the shared memory, the positions of the two sides are on separate cache lines
+    struct Header
+    {
+        // The magic is written last by the producer, so a consumer does not attach to a half initialized ring
+        std::atomic<uint64_t> magic;
+        uint32_t version;
+        std::atomic<uint32_t> producer_is_attached;
+        std::atomic<uint32_t> consumer_is_attached;
+        uint64_t capacity;
+
+        // Written by the producer
+        alignas(64) std::atomic<uint64_t> write_position;
+        std::atomic<uint32_t> data_sequence;
+        std::atomic<uint32_t> producer_is_waiting;
+
+        // Written by the consumer
+        alignas(64) std::atomic<uint64_t> read_position;
+        std::atomic<uint32_t> space_sequence;
+        std::atomic<uint32_t> consumer_is_waiting;
+    };
+
+    static constexpr uint64_t header_magic = 0x4752494E47424452;
+    static constexpr uint32_t header_version = 1;
+    static constexpr std::size_t data_offset = ((sizeof(Header) + 63) / 64) * 64;
+
+    static std::string GetObjectName(const std::string& name) {return ("/" + name);}
+    static void WaitOnFutex(std::atomic<uint32_t>& futex, const uint32_t& expected_value, const std::chrono::milliseconds& timeout);
+    void WakeUpFutex(std::atomic<uint32_t>& futex);
+    bool Map(const int& file_descriptor, const std::size_t& size);
+
+    std::string object_name;
+    bool is_producer;
+    bool is_corrupted;
+    Header* header;
+    char* data;
+    std::size_t size_of_mapping;
+    // The position of this side, and the last seen position of the other side, these spare the reading of the cache line of the other side
+    uint64_t own_position;
+    uint64_t cached_other_position;
+    std::atomic<std::size_t> number_of_wake_ups;
+};
+
+
+
+#endif // SHARED_MEMORY_RING_HPP
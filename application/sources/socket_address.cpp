@@ -0,0 +1,65 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include "socket_address.hpp"
+
+
+
+bool SocketAddress::Parse(const std::string& port_name, const std::string& scheme, SocketAddress& address)
+{
+    bool result = false;
+
+    if(0 == port_name.compare(0, scheme.size(), scheme))
+    {
+        // The port number follows the last colon, so the colons of an IPv6 host do not matter
+        std::string host_and_port = port_name.substr(scheme.size());
+        auto port_separator = host_and_port.rfind(':');
+        if(std::string::npos != port_separator)
+        {
+            std::string new_host = host_and_port.substr(0, port_separator);
+            std::string port_text = host_and_port.substr(port_separator + 1);
+
+            if((2 <= new_host.size()) && ('[' == new_host.front()) && (']' == new_host.back()))
+            {
+                new_host = new_host.substr(1, (new_host.size() - 2));
+            }
+
+            // The port number can only contain digits and it needs to fit into 16 bits, the port zero lets the operating system choose a free port for listening
+            constexpr std::size_t maximum_length_of_port_number = 5;
+            if((!port_text.empty()) &&
+               (maximum_length_of_port_number >= port_text.size()) &&
+               (std::string::npos == port_text.find_first_not_of("0123456789")))
+            {
+                unsigned long new_port = std::stoul(port_text);
+                if(UINT16_MAX >= new_port)
+                {
+                    address = SocketAddress(new_host, static_cast<uint16_t>(new_port));
+                    result = true;
+                }
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,58 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <string>
+#include <cstdint>
+
+#include "global.hpp"
+
+
+
+#ifndef SOCKET_ADDRESS_HPP
+#define SOCKET_ADDRESS_HPP
+
+
+
+// The address of a socket connection that is given as a port name, for example: tcp://192.168.1.10:5000
+// The host can be empty, that means every local address, an IPv6 host needs to be written in brackets: udp://[::1]:5000
+class SocketAddress
+{
+public:
+    SocketAddress() : port(0) {}
+    SocketAddress(const std::string& new_host, const uint16_t& new_port) : host(new_host), port(new_port) {}
+
+    // Returns false if the port_name does not start with the scheme or it does not end with a valid port number
+    static bool Parse(const std::string& port_name, const std::string& scheme, SocketAddress& address);
+
+    const std::string& GetHost(void) const {return host;}
+    uint16_t GetPort(void) const {return port;}
+
+private:
+    std::string host;
+    uint16_t port;
+};
+
+
+
+#endif // SOCKET_ADDRESS_HPP
@@ -0,0 +1,133 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+#include "global.hpp"
+
+
+
+#ifndef SPSC_RING_BUFFER_HPP
+#define SPSC_RING_BUFFER_HPP
+
+
+
+// Bounded queue between exactly one producer thread and exactly one consumer thread without locks
+// The producer never waits for the consumer: if the buffer is full, then the new element is dropped and counted
+// The capacity is rounded up to a power of two so that the positions can be wrapped with a mask
+template <typename T_ELEMENT>
+class SpscRingBuffer
+{
+public:
+    explicit SpscRingBuffer(const std::size_t& minimum_capacity) : elements(CalculateCapacity(minimum_capacity)), mask(elements.size() - 1),
+                                                                   write_position(0), read_position(0), number_of_dropped_elements(0), high_water_mark(0) {}
+
+    SpscRingBuffer(const SpscRingBuffer& new_spsc_ring_buffer) = delete;
+    SpscRingBuffer(SpscRingBuffer&& new_spsc_ring_buffer) = delete;
+
+    SpscRingBuffer& operator=(const SpscRingBuffer& new_spsc_ring_buffer) = delete;
+    SpscRingBuffer& operator=(SpscRingBuffer&& new_spsc_ring_buffer) = delete;
+
+    ~SpscRingBuffer() = default;
+
+    // Can only be called by the producer thread, the element is only moved from if it was pushed
+    bool TryPush(T_ELEMENT& element)
+    {
+        bool result = false;
+
+        // The producer owns the write position, only the read position of the consumer needs to be synchronized
+        std::size_t current_write_position = write_position.load(std::memory_order_relaxed);
+        std::size_t size = current_write_position - read_position.load(std::memory_order_acquire);
+        if(size < elements.size())
+        {
+            elements[current_write_position & mask] = std::move(element);
+            write_position.store((current_write_position + 1), std::memory_order_release);
+
+            // Only the producer writes the high water mark, so it does not need a compare-exchange loop
+            if(high_water_mark.load(std::memory_order_relaxed) < (size + 1))
+            {
+                high_water_mark.store((size + 1), std::memory_order_relaxed);
+            }
+            result = true;
+        }
+        else
+        {
+            number_of_dropped_elements.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return result;
+    }
+
+    // Can only be called by the consumer thread
+    bool TryPop(T_ELEMENT& element)
+    {
+        bool result = false;
+
+        // The consumer owns the read position, only the write position of the producer needs to be synchronized
+        std::size_t current_read_position = read_position.load(std::memory_order_relaxed);
+        if(current_read_position != write_position.load(std::memory_order_acquire))
+        {
+            element = std::move(elements[current_read_position & mask]);
+            read_position.store((current_read_position + 1), std::memory_order_release);
+            result = true;
+        }
+
+        return result;
+    }
+
+    // These can be called from any thread, the size is only a snapshot while the other threads are working
+    std::size_t GetCapacity(void) const {return elements.size();}
+    std::size_t GetSize(void) const {return (write_position.load(std::memory_order_acquire) - read_position.load(std::memory_order_acquire));}
+    std::size_t GetNumberOfDroppedElements(void) const {return number_of_dropped_elements.load(std::memory_order_relaxed);}
+    std::size_t GetHighWaterMark(void) const {return high_water_mark.load(std::memory_order_relaxed);}
+
+private:
+    static std::size_t CalculateCapacity(const std::size_t& minimum_capacity)
+    {
+        std::size_t result = 1;
+        while(result < minimum_capacity)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    // The size of a cache line on the supported platforms, the positions are kept on separate cache lines
+    // so that the producer and the consumer do not invalidate the cache line of each other on every operation
+    static constexpr std::size_t cache_line_size = 64;
+
+    std::vector<T_ELEMENT> elements;
+    const std::size_t mask;
+    // The positions are only increased, the index of an element is the position masked with the capacity
+    alignas(cache_line_size) std::atomic<std::size_t> write_position;
+    alignas(cache_line_size) std::atomic<std::size_t> read_position;
+    alignas(cache_line_size) std::atomic<std::size_t> number_of_dropped_elements;
+    std::atomic<std::size_t> high_water_mark;
+};
+
+
+
+#endif // SPSC_RING_BUFFER_HPP
@@ -0,0 +1,278 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include "tcp_connection.hpp"
+
+
+
+bool TcpConnection::IsTcpPortName(const std::string& port_name)
+{
+    SocketAddress address;
+    return (SocketAddress::Parse(port_name, client_scheme, address) || SocketAddress::Parse(port_name, server_scheme, address));
+}
+
+TcpConnection::TcpConnection() : QObject(),
+                                 io_thread_context(std::make_unique<QObject>()),
+                                 listening_port(0),
+                                 received_data_delivery(this, received_chunks_capacity, SOCKET_MAX_READ_LENGTH_IN_BYTES,
+                                                        [this](std::istream& received_data){emit DataReceived(received_data);},
+                                                        [this](const std::string& error_message){emit ErrorReport(error_message);})
+{
+    // Every function that is invoked with the context is executed on the I/O thread
+    io_thread_context->moveToThread(&io_thread);
+    io_thread.start();
+}
+
+TcpConnection::~TcpConnection()
+{
+    Close();
+    io_thread.quit();
+    io_thread.wait();
+}
+
+bool TcpConnection::Open(const std::string& port_name)
+{
+    bool result = false;
+
+    if(opened_port_name.empty())
+    {
+        SocketAddress address;
+        bool is_server = SocketAddress::Parse(port_name, server_scheme, address);
+        if(is_server || SocketAddress::Parse(port_name, client_scheme, address))
+        {
+            // The server and the socket are created on the I/O thread so that their notifiers belong to that thread, this thread waits for the result
+            uint16_t new_listening_port = 0;
+            QMetaObject::invokeMethod(io_thread_context.get(), [&]()
+            {
+                if(is_server)
+                {
+                    QHostAddress host_address(QHostAddress::Any);
+                    if(!address.GetHost().empty())
+                    {
+                        host_address = QHostAddress(QString::fromStdString(address.GetHost()));
+                    }
+
+                    server = std::make_unique<QTcpServer>();
+                    if(server->listen(host_address, address.GetPort()))
+                    {
+                        new_listening_port = server->serverPort();
+                        result = true;
+                    }
+                    else
+                    {
+                        server.reset();
+                    }
+                }
+                else
+                {
+                    socket = std::make_unique<QTcpSocket>();
+                    socket->connectToHost(QString::fromStdString(address.GetHost()), address.GetPort());
+                    if(socket->waitForConnected(SOCKET_CONNECT_TIMEOUT_IN_MILLISECONDS))
+                    {
+                        result = true;
+                    }
+                    else
+                    {
+                        socket.reset();
+                    }
+                }
+            }, Qt::BlockingQueuedConnection);
+
+            if(result)
+            {
+                opened_port_name = port_name;
+                received_data_delivery.SetConnectionName("TCP connection " + port_name);
+                listening_port = new_listening_port;
+            }
+        }
+    }
+    else
+    {
+        if(port_name == opened_port_name)
+        {
+            result = true;
+        }
+        else
+        {
+            throw("Another TCP connection was already openend with this object: " + port_name);
+        }
+    }
+
+    return result;
+}
+
+void TcpConnection::Close()
+{
+    if(IsOpen())
+    {
+        // The I/O thread can wait for the processing of this thread, so its waiting is interrupted before it is stopped
+        received_data_delivery.InterruptWaiting();
+
+        // After the socket and the server were closed on the I/O thread, no more chunks will be received
+        QMetaObject::invokeMethod(io_thread_context.get(), [&]()
+        {
+            // The signals are disconnected first, so the closing is not reported as a disconnection of the peer
+            if(socket)
+            {
+                socket->disconnect(io_thread_context.get());
+                socket->abort();
+                socket.reset();
+            }
+            if(server)
+            {
+                server->disconnect(io_thread_context.get());
+                server->close();
+                server.reset();
+            }
+        }, Qt::BlockingQueuedConnection);
+        opened_port_name.clear();
+        listening_port = 0;
+
+        // The data that was not processed yet belongs to the closed connection
+        received_data_delivery.Clear();
+    }
+}
+
+bool TcpConnection::IsOpen()
+{
+    return (!opened_port_name.empty());
+}
+
+bool TcpConnection::StartListening(void)
+{
+    bool result = false;
+
+    if(IsOpen())
+    {
+        // The signals are handled on the I/O thread, because the context of the connections lives there
+        QMetaObject::invokeMethod(io_thread_context.get(), [&]()
+        {
+            if(server)
+            {
+                QObject::connect(server.get(), &QTcpServer::newConnection, io_thread_context.get(), [this](){AcceptConnections();});
+
+                // A client could have connected since the opening, its newConnection signal was emitted before this connection
+                AcceptConnections();
+            }
+            else
+            {
+                SetUpSocket();
+            }
+        }, Qt::BlockingQueuedConnection);
+        result = true;
+    }
+
+    return result;
+}
+
+void TcpConnection::AcceptConnections(void)
+{
+    while(server->hasPendingConnections())
+    {
+        // The socket is owned by this object and not by the server
+        QTcpSocket* new_socket = server->nextPendingConnection();
+        new_socket->setParent(nullptr);
+
+        if(!socket)
+        {
+            socket.reset(new_socket);
+            SetUpSocket();
+        }
+        else
+        {
+            // Only one client is served at a time, because the lines of several clients would be mixed in the received data
+            ReportErrorFromIoThread("The client " + new_socket->peerAddress().toString().toStdString() + " was rejected, because another client is already connected!");
+            new_socket->abort();
+            new_socket->deleteLater();
+        }
+    }
+}
+
+void TcpConnection::SetUpSocket(void)
+{
+    // A large receive buffer lets the operating system hold the stream while this thread is not scheduled
+    socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, SOCKET_RECEIVE_BUFFER_SIZE_IN_BYTES);
+
+    QObject::connect(socket.get(), &QTcpSocket::readyRead,       io_thread_context.get(), [this](){ReadFromSocket();});
+    QObject::connect(socket.get(), &QTcpSocket::disconnected,    io_thread_context.get(), [this](){HandleDisconnection();});
+    QObject::connect(socket.get(), &QTcpSocket::errorOccurred,   io_thread_context.get(), [this](QAbstractSocket::SocketError error){HandleErrors(error);});
+
+    // The data that arrived before the signals were connected did not signal readyRead
+    ReadFromSocket();
+}
+
+void TcpConnection::ReadFromSocket(void)
+{
+    // This runs on the I/O thread, the received data is read into chunks here, the lines are assembled by the thread of this object
+    // Everything that is available is read at once, so a fast stream is passed on in large chunks instead of many small ones
+    qint64 number_of_available_bytes;
+    while(socket && (0 < (number_of_available_bytes = socket->bytesAvailable())))
+    {
+        // The memory of a processed chunk is reused if there is one
+        auto chunk = received_data_delivery.GetFreeChunk();
+        chunk.resize(static_cast<std::size_t>(std::min(number_of_available_bytes, static_cast<qint64>(SOCKET_MAX_READ_LENGTH_IN_BYTES))));
+        qint64 number_of_read_bytes = socket->read(chunk.data(), static_cast<qint64>(chunk.size()));
+        if(0 >= number_of_read_bytes)
+        {
+            break;
+        }
+        chunk.resize(static_cast<std::size_t>(number_of_read_bytes));
+
+        // If the queue is full, then this waits for the processing, a chunk is only dropped if the closing interrupts the waiting
+        received_data_delivery.Push(chunk);
+    }
+}
+
+void TcpConnection::HandleDisconnection(void)
+{
+    // The data that arrived with the closing of the connection is still passed on
+    ReadFromSocket();
+
+    if(server)
+    {
+        // The server waits for the next client, the socket is deleted later, because this is called by one of its signals
+        ReportErrorFromIoThread("The client " + socket->peerAddress().toString().toStdString() + " has disconnected, waiting for the next client.");
+        socket->disconnect(io_thread_context.get());
+        socket.release()->deleteLater();
+        AcceptConnections();
+    }
+    else
+    {
+        ReportErrorFromIoThread("The server " + socket->peerName().toStdString() + " has closed the connection!");
+    }
+}
+
+void TcpConnection::HandleErrors(QAbstractSocket::SocketError error)
+{
+    // The closing of the connection by the peer is reported by HandleDisconnection()
+    if(QAbstractSocket::RemoteHostClosedError != error)
+    {
+        ReportErrorFromIoThread((QObject::tr("A network error occurred on the TCP connection, error: %1").arg(socket->errorString())).toStdString());
+    }
+}
+
+void TcpConnection::ReportErrorFromIoThread(const std::string& error_message)
+{
+    // The error is reported from the thread of this object
+    QMetaObject::invokeMethod(this, [this, error_message](){emit ErrorReport(error_message);}, Qt::QueuedConnection);
+}
@@ -0,0 +1,130 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <QObject>
+#include <QThread>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+
+#include "global.hpp"
+#include "network_connection_interface.hpp"
+#include "received_data_delivery.hpp"
+#include "socket_address.hpp"
+
+
+
+#ifndef TCP_CONNECTION_HPP
+#define TCP_CONNECTION_HPP
+
+
+
+// Receives a stream over TCP, either as a client (tcp://host:port) or as a server that serves one client at a time (tcp-server://address:port)
+// The socket is read on a dedicated thread in large chunks, the chunks are passed to the thread of this object like in the SerialPort
+class TcpConnection : public QObject, public NetworkConnectionInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(NetworkConnectionInterface)
+
+public:
+    static constexpr char client_scheme[] = "tcp://";
+    static constexpr char server_scheme[] = "tcp-server://";
+
+    static bool IsTcpPortName(const std::string& port_name);
+
+    TcpConnection();
+    ~TcpConnection() override;
+
+    TcpConnection(const TcpConnection&) = delete;
+    TcpConnection(TcpConnection&&) = delete;
+
+    TcpConnection& operator=(const TcpConnection&) = delete;
+    TcpConnection& operator=(TcpConnection&&) = delete;
+
+    bool Open(const std::string& port_name) override;
+
+    void Close(void) override;
+
+    bool IsOpen(void) override;
+
+    bool StartListening(void) override;
+
+    void SetCaptureJournal(CaptureJournal* capture_journal) override {received_data_delivery.SetCaptureJournal(capture_journal);}
+
+    void SetDataDeliveryPaused(const bool& is_paused) override {received_data_delivery.SetDataDeliveryPaused(is_paused);}
+
+    void SetDataDeliveryCoalescing(const std::chrono::milliseconds& latency_budget, const std::size_t& size_threshold_in_bytes) override
+    {
+        received_data_delivery.SetDataDeliveryCoalescing(latency_budget, size_threshold_in_bytes);
+    }
+
+    const IngestQueueCounters& GetReceiveQueueCounters(void) const override {return received_data_delivery.GetCounters();}
+    const IngestQueueCounters& GetLineCounters(void) const override {return received_data_delivery.GetLineCounters();}
+
+    std::chrono::steady_clock::time_point GetReceiveTimeOfReceivedData(void) const override {return received_data_delivery.GetReceiveTimeOfReceivedData();}
+
+    // The port that the server listens on, this is useful if the operating system has chosen the port, zero if this is not a server
+    uint16_t GetListeningPort(void) const {return listening_port;}
+
+    // These can be called from any thread
+    std::size_t GetNumberOfDroppedChunks(void) const {return received_data_delivery.GetNumberOfDroppedChunks();}
+    std::size_t GetHighWaterMarkOfReceivedChunks(void) const {return received_data_delivery.GetHighWaterMark();}
+
+signals:
+    void DataReceived(std::istream& received_data) override;
+    void ErrorReport(const std::string& error_message) override;
+
+private:
+    // These run on the I/O thread
+    void AcceptConnections(void);
+    void SetUpSocket(void);
+    void ReadFromSocket(void);
+    void HandleDisconnection(void);
+    void HandleErrors(QAbstractSocket::SocketError error);
+    void ReportErrorFromIoThread(const std::string& error_message);
+
+    // The number of chunks that can wait for the processing, a chunk is the data that was available when the socket signalled readyRead
+    static constexpr std::size_t received_chunks_capacity = 4096;
+
+    // The server, the socket and the context of their connections live on the I/O thread, they are only accessed from there
+    QThread io_thread;
+    std::unique_ptr<QObject> io_thread_context;
+    std::unique_ptr<QTcpServer> server;
+    std::unique_ptr<QTcpSocket> socket;
+    // The name of the opened port, this is empty if no port is open, only accessed from the thread of this object
+    std::string opened_port_name;
+    uint16_t listening_port;
+
+    // Owns the received chunks until their complete lines are delivered on the thread of this object
+    ReceivedDataDelivery received_data_delivery;
+};
+
+
+
+#endif // TCP_CONNECTION_HPP
@@ -0,0 +1,197 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include "udp_connection.hpp"
+
+
+
+bool UdpConnection::IsUdpPortName(const std::string& port_name)
+{
+    SocketAddress address;
+    return SocketAddress::Parse(port_name, scheme, address);
+}
+
+UdpConnection::UdpConnection() : QObject(),
+                                 io_thread_context(std::make_unique<QObject>()),
+                                 listening_port(0),
+                                 received_data_delivery(this, received_chunks_capacity, SOCKET_MAX_READ_LENGTH_IN_BYTES,
+                                                        [this](std::istream& received_data){emit DataReceived(received_data);},
+                                                        [this](const std::string& error_message){emit ErrorReport(error_message);})
+{
+    // Every function that is invoked with the context is executed on the I/O thread
+    io_thread_context->moveToThread(&io_thread);
+    io_thread.start();
+}
+
+UdpConnection::~UdpConnection()
+{
+    Close();
+    io_thread.quit();
+    io_thread.wait();
+}
+
+bool UdpConnection::Open(const std::string& port_name)
+{
+    bool result = false;
+
+    if(opened_port_name.empty())
+    {
+        SocketAddress address;
+        if(SocketAddress::Parse(port_name, scheme, address))
+        {
+            // The socket is created on the I/O thread so that its notifiers belong to that thread, this thread waits for the result
+            uint16_t new_listening_port = 0;
+            QMetaObject::invokeMethod(io_thread_context.get(), [&]()
+            {
+                QHostAddress host_address(QHostAddress::Any);
+                if(!address.GetHost().empty())
+                {
+                    host_address = QHostAddress(QString::fromStdString(address.GetHost()));
+                }
+
+                socket = std::make_unique<QUdpSocket>();
+                if(socket->bind(host_address, address.GetPort()))
+                {
+                    // A large receive buffer lets the operating system hold the datagrams while this thread is not scheduled
+                    socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, SOCKET_RECEIVE_BUFFER_SIZE_IN_BYTES);
+                    new_listening_port = socket->localPort();
+                    result = true;
+                }
+                else
+                {
+                    socket.reset();
+                }
+            }, Qt::BlockingQueuedConnection);
+
+            if(result)
+            {
+                opened_port_name = port_name;
+                received_data_delivery.SetConnectionName("UDP connection " + port_name);
+                listening_port = new_listening_port;
+            }
+        }
+    }
+    else
+    {
+        if(port_name == opened_port_name)
+        {
+            result = true;
+        }
+        else
+        {
+            throw("Another UDP connection was already openend with this object: " + port_name);
+        }
+    }
+
+    return result;
+}
+
+void UdpConnection::Close()
+{
+    if(IsOpen())
+    {
+        // The I/O thread can wait for the processing of this thread, so its waiting is interrupted before it is stopped
+        received_data_delivery.InterruptWaiting();
+
+        // After the socket was closed on the I/O thread, no more chunks will be received
+        QMetaObject::invokeMethod(io_thread_context.get(), [&]()
+        {
+            socket->disconnect(io_thread_context.get());
+            socket->close();
+            socket.reset();
+        }, Qt::BlockingQueuedConnection);
+        opened_port_name.clear();
+        listening_port = 0;
+
+        // The data that was not processed yet belongs to the closed connection
+        received_data_delivery.Clear();
+    }
+}
+
+bool UdpConnection::IsOpen()
+{
+    return (!opened_port_name.empty());
+}
+
+bool UdpConnection::StartListening(void)
+{
+    bool result = false;
+
+    if(IsOpen())
+    {
+        // The signals of the socket are handled on the I/O thread, because the context of the connections lives there
+        QMetaObject::invokeMethod(io_thread_context.get(), [&]()
+        {
+            QObject::connect(socket.get(), &QUdpSocket::readyRead,       io_thread_context.get(), [this](){ReadFromSocket();});
+            QObject::connect(socket.get(), &QUdpSocket::errorOccurred,   io_thread_context.get(), [this](QAbstractSocket::SocketError error){HandleErrors(error);});
+
+            // The datagrams that arrived before the signals were connected did not signal readyRead
+            ReadFromSocket();
+        }, Qt::BlockingQueuedConnection);
+        result = true;
+    }
+
+    return result;
+}
+
+void UdpConnection::ReadFromSocket(void)
+{
+    // This runs on the I/O thread, the datagrams are read into chunks here, the lines are assembled by the thread of this object
+    while(socket->hasPendingDatagrams())
+    {
+        // The pending datagrams are collected into one chunk until it is full, so a burst of small datagrams is passed on at once
+        auto chunk = received_data_delivery.GetFreeChunk();
+        chunk.clear();
+        while(socket->hasPendingDatagrams())
+        {
+            qint64 datagram_size = socket->pendingDatagramSize();
+            if(0 > datagram_size)
+            {
+                break;
+            }
+            std::size_t size_before_reading = chunk.size();
+            if((0 != size_before_reading) && (SOCKET_MAX_READ_LENGTH_IN_BYTES < (size_before_reading + static_cast<std::size_t>(datagram_size))))
+            {
+                break;
+            }
+            chunk.resize(size_before_reading + static_cast<std::size_t>(datagram_size));
+            qint64 number_of_read_bytes = socket->readDatagram((chunk.data() + size_before_reading), datagram_size);
+            chunk.resize(size_before_reading + static_cast<std::size_t>(std::max(number_of_read_bytes, static_cast<qint64>(0))));
+        }
+
+        if(chunk.empty())
+        {
+            break;
+        }
+
+        // If the queue is full, then this waits for the processing, a chunk is only dropped if the closing interrupts the waiting
+        received_data_delivery.Push(chunk);
+    }
+}
+
+void UdpConnection::HandleErrors(QAbstractSocket::SocketError error)
+{
+    // This runs on the I/O thread, the error is reported from the thread of this object
+    std::string error_message = (QObject::tr("A network error (%1) occurred on the UDP connection, error: %2").arg(static_cast<int>(error)).arg(socket->errorString())).toStdString();
+    QMetaObject::invokeMethod(this, [this, error_message](){emit ErrorReport(error_message);}, Qt::QueuedConnection);
+}
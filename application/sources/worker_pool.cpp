@@ -0,0 +1,104 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include "worker_pool.hpp"
+
+
+
+WorkerPool::WorkerPool(const std::size_t& new_number_of_workers) : is_stopping(false)
+{
+    std::size_t number_of_workers = new_number_of_workers;
+    if(0 == number_of_workers)
+    {
+        // The hardware_concurrency() returns zero if the number of hardware threads can not be determined
+        number_of_workers = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    workers.reserve(number_of_workers);
+    for(std::size_t i = 0; i < number_of_workers; ++i)
+    {
+        workers.emplace_back(&WorkerPool::Work, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        is_stopping = true;
+    }
+    task_available.notify_all();
+
+    for(auto& i : workers)
+    {
+        i.join();
+    }
+}
+
+void WorkerPool::Run(task_type task)
+{
+    if(task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        task_available.notify_one();
+    }
+    else
+    {
+        std::string errorMessage = "There was no task set in WorkerPool::Run!";
+        throw errorMessage;
+    }
+}
+
+void WorkerPool::Work(void)
+{
+    while(true)
+    {
+        task_type task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            task_available.wait(lock, [this](){return (is_stopping || !tasks.empty());});
+
+            // The remaining tasks are executed even if the pool is stopping, because their submitters might wait for them
+            if(tasks.empty())
+            {
+                break;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        // The task is executed outside of the lock, so the other workers can take the next tasks in the meantime
+        // The tasks report their own errors, an exception that still escapes is dropped so it does not terminate the application
+        try
+        {
+            task();
+        }
+        catch(...)
+        {
+        }
+    }
+}
@@ -0,0 +1,79 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstddef>
+#include <algorithm>
+
+#include "global.hpp"
+
+
+
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+
+
+// A fixed number of threads that execute the tasks in the order of their submission
+// The tasks of the pool do not wait for each other, so the tasks that must not run in parallel need to be serialized by their submitter
+class WorkerPool
+{
+public:
+    using task_type = std::function<void(void)>;
+
+    // Zero workers means one worker for every hardware thread
+    explicit WorkerPool(const std::size_t& new_number_of_workers = 0);
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    // The tasks that were already submitted are executed before the workers are stopped
+    ~WorkerPool();
+
+    // This can be called from any thread, also from a task of the pool
+    void Run(task_type task);
+    std::size_t GetNumberOfWorkers(void) const {return workers.size();}
+
+private:
+    void Work(void);
+
+    std::mutex mutex;
+    std::condition_variable task_available;
+    std::deque<task_type> tasks;
+    bool is_stopping;
+    std::vector<std::thread> workers;
+};
+
+
+
+#endif // WORKER_POOL_HPP
@@ -0,0 +1,72 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <cstdlib>
+#include <new>
+
+#include "allocation_counter.hpp"
+
+
+
+// The counter of the current thread, the allocations of the threads without a counter are not counted
+static thread_local AllocationCounter* active_counter = nullptr;
+
+AllocationCounter::AllocationCounter() : number_of_allocations(0), previous_counter(active_counter)
+{
+    active_counter = this;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+    active_counter = previous_counter;
+}
+
+void AllocationCounter::CountAllocation(void)
+{
+    if(nullptr != active_counter)
+    {
+        active_counter->number_of_allocations++;
+    }
+}
+
+// The array and the nothrow forms of the operator new call this one, so they are counted as well
+void* operator new(std::size_t size)
+{
+    AllocationCounter::CountAllocation();
+    void* memory = std::malloc((0 == size) ? 1 : size);
+    if(nullptr == memory)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
@@ -0,0 +1,63 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <cstddef>
+
+
+
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+
+
+// Counts the allocations of the current thread while the counter exists
+// The global operator new is replaced in allocation_counter.cpp for the whole test binary, but it only counts on a thread that has a counter
+// So the replacement does not change the behaviour of the other tests, it only adds a thread local check to every allocation
+class AllocationCounter
+{
+public:
+    AllocationCounter();
+    ~AllocationCounter();
+
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter(AllocationCounter&&) = delete;
+
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(AllocationCounter&&) = delete;
+
+    std::size_t GetNumberOfAllocations(void) const {return number_of_allocations;}
+    // The warm-up of the measured code can be excluded with this
+    void Reset(void) {number_of_allocations = 0;}
+
+    // Called by the replaced operator new
+    static void CountAllocation(void);
+
+private:
+    std::size_t number_of_allocations;
+    // The counter that was active before this one on the thread, the counters can be nested
+    AllocationCounter* previous_counter;
+};
+
+
+
+#endif // ALLOCATION_COUNTER_HPP
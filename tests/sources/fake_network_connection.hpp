@@ -0,0 +1,105 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <sstream>
+#include <chrono>
+
+#include <QObject>
+
+#include "../application/sources/network_connection_interface.hpp"
+#include "../application/sources/ingest_queue_counters.hpp"
+
+
+
+#ifndef FAKE_NETWORK_CONNECTION_HPP
+#define FAKE_NETWORK_CONNECTION_HPP
+
+
+
+// A connection without I/O, the test thread delivers the data as if it was received, so the users of the connections can be tested alone
+// The pausing of the delivery is only recorded, the data is delivered anyway
+class FakeNetworkConnection : public QObject, public NetworkConnectionInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(NetworkConnectionInterface)
+
+public:
+    FakeNetworkConnection() : QObject(), is_open(false), data_delivery_is_paused(false), number_of_pauses(0), receive_queue_counters(1), line_counters(1) {}
+
+    FakeNetworkConnection(const FakeNetworkConnection&) = delete;
+    FakeNetworkConnection(FakeNetworkConnection&&) = delete;
+
+    FakeNetworkConnection& operator=(const FakeNetworkConnection&) = delete;
+    FakeNetworkConnection& operator=(FakeNetworkConnection&&) = delete;
+
+    // An empty port name can not be opened
+    bool Open(const std::string& port_name) override {is_open = (!port_name.empty()); return is_open;}
+    void Close(void) override {is_open = false;}
+    bool IsOpen(void) override {return is_open;}
+    bool StartListening(void) override {return is_open;}
+    void SetCaptureJournal(CaptureJournal*) override {}
+    void SetDataDeliveryPaused(const bool& is_paused) override
+    {
+        data_delivery_is_paused = is_paused;
+        if(is_paused)
+        {
+            ++number_of_pauses;
+        }
+    }
+    void SetDataDeliveryCoalescing(const std::chrono::milliseconds&, const std::size_t&) override {}
+    const IngestQueueCounters& GetReceiveQueueCounters(void) const override {return receive_queue_counters;}
+    const IngestQueueCounters& GetLineCounters(void) const override {return line_counters;}
+    std::chrono::steady_clock::time_point GetReceiveTimeOfReceivedData(void) const override {return receive_time;}
+
+    // This needs to be called on the thread of the connection, like the delivery of a real connection
+    void Deliver(const std::string& data)
+    {
+        std::istringstream received_data(data);
+        receive_time = std::chrono::steady_clock::now();
+        emit DataReceived(received_data);
+    }
+    void ReportError(const std::string& error_message)
+    {
+        emit ErrorReport(error_message);
+    }
+
+    bool IsDataDeliveryPaused(void) const {return data_delivery_is_paused;}
+    std::size_t GetNumberOfPauses(void) const {return number_of_pauses;}
+
+signals:
+    void DataReceived(std::istream& received_data) override;
+    void ErrorReport(const std::string& error_message) override;
+
+private:
+    bool is_open;
+    bool data_delivery_is_paused;
+    std::size_t number_of_pauses;
+    IngestQueueCounters receive_queue_counters;
+    IngestQueueCounters line_counters;
+    std::chrono::steady_clock::time_point receive_time;
+};
+
+
+
+#endif // FAKE_NETWORK_CONNECTION_HPP
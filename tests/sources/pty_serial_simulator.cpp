@@ -0,0 +1,271 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <fstream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+
+#include "pty_serial_simulator.hpp"
+
+
+
+PtySerialSimulator::PtySerialSimulator() : master_file_descriptor(-1),
+                                           slave_file_descriptor(-1),
+                                           generator_needs_to_stop(false),
+                                           generation_is_finished(false),
+                                           number_of_written_diagrams(0),
+                                           number_of_written_bytes(0)
+{
+    std::string error_message;
+
+    master_file_descriptor = posix_openpt(O_RDWR | O_NOCTTY);
+    if((0 <= master_file_descriptor) && (0 == grantpt(master_file_descriptor)) && (0 == unlockpt(master_file_descriptor)) && (nullptr != ptsname(master_file_descriptor)))
+    {
+        slave_path = ptsname(master_file_descriptor);
+        slave_file_descriptor = open(slave_path.c_str(), (O_RDWR | O_NOCTTY));
+    }
+
+    // The terminal is switched to raw mode, so the data is not changed and not echoed back by the line discipline
+    termios terminal_settings;
+    if((0 <= slave_file_descriptor) && (0 == tcgetattr(slave_file_descriptor, &terminal_settings)))
+    {
+        cfmakeraw(&terminal_settings);
+        if(0 != tcsetattr(slave_file_descriptor, TCSANOW, &terminal_settings))
+        {
+            error_message = "The pseudo-terminal could not be switched to raw mode: " + slave_path;
+        }
+    }
+    else
+    {
+        error_message = "The pseudo-terminal pair could not be created!";
+    }
+
+    // The master end is not blocking, the generator waits for it with poll() to be able to stop
+    if(error_message.empty() && (0 != fcntl(master_file_descriptor, F_SETFL, (fcntl(master_file_descriptor, F_GETFL) | O_NONBLOCK))))
+    {
+        error_message = "The master end of the pseudo-terminal could not be set to non-blocking mode!";
+    }
+
+    if(!error_message.empty())
+    {
+        if(0 <= slave_file_descriptor)
+        {
+            close(slave_file_descriptor);
+        }
+        if(0 <= master_file_descriptor)
+        {
+            close(master_file_descriptor);
+        }
+        throw(error_message);
+    }
+}
+
+PtySerialSimulator::~PtySerialSimulator()
+{
+    Stop();
+    close(slave_file_descriptor);
+    close(master_file_descriptor);
+}
+
+void PtySerialSimulator::Start(const Options& new_options)
+{
+    Stop();
+
+    options = new_options;
+    generation_is_finished = false;
+    number_of_written_diagrams = 0;
+    number_of_written_bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(diagram_write_times_mutex);
+        diagram_write_times.clear();
+    }
+    generator_thread = std::thread(&PtySerialSimulator::Generate, this);
+}
+
+void PtySerialSimulator::Stop(void)
+{
+    if(generator_thread.joinable())
+    {
+        generator_needs_to_stop = true;
+        generator_thread.join();
+        generator_needs_to_stop = false;
+    }
+}
+
+std::chrono::steady_clock::time_point PtySerialSimulator::GetWriteTimeOfDiagram(const std::size_t& diagram_index) const
+{
+    std::lock_guard<std::mutex> lock(diagram_write_times_mutex);
+    return diagram_write_times.at(diagram_index);
+}
+
+std::string PtySerialSimulator::CreateDiagram(const std::size_t& diagram_index, const std::size_t& number_of_channels, const std::size_t& number_of_lines)
+{
+    std::string result = CreateDiagramBegin(diagram_index, number_of_channels);
+    for(std::size_t line_index = 0; line_index < number_of_lines; ++line_index)
+    {
+        result += CreateDataLine(line_index, number_of_channels);
+    }
+    result += diagram_end;
+
+    return result;
+}
+
+std::string PtySerialSimulator::CreateDiagramBegin(const std::size_t& diagram_index, const std::size_t& number_of_channels)
+{
+    std::string result = "<<<START>>>\n<Simulated diagram " + std::to_string(diagram_index) + ">\nTime,";
+    for(std::size_t channel_index = 0; channel_index < number_of_channels; ++channel_index)
+    {
+        result += "Channel" + std::to_string(channel_index) + ",";
+    }
+    result += "\n";
+
+    return result;
+}
+
+std::string PtySerialSimulator::CreateDataLine(const std::size_t& line_index, const std::size_t& number_of_channels)
+{
+    std::string result = std::to_string(line_index) + ",";
+    for(std::size_t channel_index = 0; channel_index < number_of_channels; ++channel_index)
+    {
+        result += std::to_string(GetExpectedValue(line_index, channel_index)) + ",";
+    }
+    result += "\n";
+
+    return result;
+}
+
+long long PtySerialSimulator::GetExpectedValue(const std::size_t& line_index, const std::size_t& channel_index)
+{
+    // The values are signed and have different lengths, like the values of a real measurement
+    return (static_cast<long long>((line_index * (channel_index + 1)) % 20001) - 10000);
+}
+
+std::size_t PtySerialSimulator::GetResidentMemoryInBytes(void)
+{
+    // The second number of the statm is the number of the resident pages
+    std::size_t result = 0;
+    std::size_t number_of_pages = 0;
+    std::ifstream statm("/proc/self/statm");
+    if(statm >> number_of_pages >> number_of_pages)
+    {
+        result = number_of_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    return result;
+}
+
+void PtySerialSimulator::Generate(void)
+{
+    std::string batch;
+    std::size_t number_of_generated_lines = 0;
+    auto start_time = std::chrono::steady_clock::now();
+    bool generation_is_running = true;
+
+    for(std::size_t diagram_index = 0; generation_is_running && ((0 == options.number_of_diagrams) || (diagram_index < options.number_of_diagrams)); ++diagram_index)
+    {
+        batch += CreateDiagramBegin(diagram_index, options.number_of_channels);
+
+        for(std::size_t line_index = 0; generation_is_running && (line_index < options.number_of_lines_per_diagram); ++line_index)
+        {
+            // The paced lines are written when they are due, the batch is written before the waiting so the receiver gets the earlier lines on time
+            if(0 < options.number_of_lines_per_second)
+            {
+                auto due_time = start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(static_cast<double>(number_of_generated_lines) / static_cast<double>(options.number_of_lines_per_second)));
+                if(std::chrono::steady_clock::now() < due_time)
+                {
+                    generation_is_running = WriteToMaster(batch);
+                    batch.clear();
+                }
+                while(generation_is_running && (std::chrono::steady_clock::now() < due_time))
+                {
+                    std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>((due_time - std::chrono::steady_clock::now()),
+                                                                                              std::chrono::milliseconds(maximum_waiting_step_in_milliseconds)));
+                    generation_is_running = (!generator_needs_to_stop);
+                }
+            }
+
+            batch += CreateDataLine(line_index, options.number_of_channels);
+            ++number_of_generated_lines;
+            if(generation_is_running && (write_batch_size_in_bytes <= batch.size()))
+            {
+                generation_is_running = WriteToMaster(batch);
+                batch.clear();
+            }
+        }
+
+        // The write time is stored before the writing, so it is available when the receiver has parsed the diagram
+        batch += diagram_end;
+        {
+            std::lock_guard<std::mutex> lock(diagram_write_times_mutex);
+            diagram_write_times.push_back(std::chrono::steady_clock::now());
+        }
+        if(generation_is_running && WriteToMaster(batch))
+        {
+            batch.clear();
+            ++number_of_written_diagrams;
+        }
+        else
+        {
+            generation_is_running = false;
+        }
+    }
+
+    generation_is_finished = generation_is_running;
+}
+
+bool PtySerialSimulator::WriteToMaster(const std::string& data)
+{
+    std::size_t number_of_written_bytes_of_data = 0;
+    bool result = true;
+
+    while(result && (number_of_written_bytes_of_data < data.size()))
+    {
+        // The pseudo-terminal is full if the receiver does not keep up, then the writing waits until it has space
+        pollfd poll_settings = {master_file_descriptor, POLLOUT, 0};
+        if(generator_needs_to_stop)
+        {
+            result = false;
+        }
+        else if(0 < poll(&poll_settings, 1, maximum_waiting_step_in_milliseconds))
+        {
+            ssize_t number_of_bytes = write(master_file_descriptor, (data.data() + number_of_written_bytes_of_data), (data.size() - number_of_written_bytes_of_data));
+            if(0 < number_of_bytes)
+            {
+                number_of_written_bytes_of_data += static_cast<std::size_t>(number_of_bytes);
+                number_of_written_bytes += static_cast<std::size_t>(number_of_bytes);
+            }
+            else if((EAGAIN != errno) && (EINTR != errno))
+            {
+                result = false;
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,115 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstddef>
+
+
+
+#ifndef PTY_SERIAL_SIMULATOR_HPP
+#define PTY_SERIAL_SIMULATOR_HPP
+
+
+
+// Simulates a device on a serial port with a Linux pseudo-terminal pair, so the SerialPort can be tested without hardware
+// The SerialPort opens the slave end, the generator thread writes Measurement Data Protocol traffic into the master end
+// The writing waits if the pseudo-terminal is full, so the generator can not be faster than the receiving
+class PtySerialSimulator
+{
+public:
+    struct Options
+    {
+        std::size_t number_of_channels = 4;
+        // The number of data lines in a diagram, this is the length of a measurement session
+        std::size_t number_of_lines_per_diagram = 1000;
+        // Zero means that the diagrams are generated until the generator is stopped
+        std::size_t number_of_diagrams = 100;
+        // Zero means that the lines are written as fast as the pseudo-terminal accepts them
+        std::size_t number_of_lines_per_second = 0;
+    };
+
+    // Throws a string if the pseudo-terminal pair could not be created
+    PtySerialSimulator();
+    ~PtySerialSimulator();
+
+    PtySerialSimulator(const PtySerialSimulator&) = delete;
+    PtySerialSimulator(PtySerialSimulator&&) = delete;
+
+    PtySerialSimulator& operator=(const PtySerialSimulator&) = delete;
+    PtySerialSimulator& operator=(PtySerialSimulator&&) = delete;
+
+    // This is the port name that can be opened with the SerialPort
+    const std::string& GetSlavePath(void) const {return slave_path;}
+
+    void Start(const Options& new_options);
+    void Stop(void);
+
+    // These can be called from any thread
+    bool IsFinished(void) const {return generation_is_finished;}
+    std::size_t GetNumberOfWrittenDiagrams(void) const {return number_of_written_diagrams;}
+    std::size_t GetNumberOfWrittenBytes(void) const {return number_of_written_bytes;}
+    // The time when the writing of the end line of the diagram started, the latency of the receiving is measured from this
+    std::chrono::steady_clock::time_point GetWriteTimeOfDiagram(const std::size_t& diagram_index) const;
+
+    // The generated diagram with the index, the values of the data lines are derived from the indexes, so the receiver can check them
+    static std::string CreateDiagram(const std::size_t& diagram_index, const std::size_t& number_of_channels, const std::size_t& number_of_lines);
+    static std::string CreateDiagramBegin(const std::size_t& diagram_index, const std::size_t& number_of_channels);
+    static std::string CreateDataLine(const std::size_t& line_index, const std::size_t& number_of_channels);
+    static long long GetExpectedValue(const std::size_t& line_index, const std::size_t& channel_index);
+    // The resident memory of this process, this is used to detect the memory growth in the soak tests
+    static std::size_t GetResidentMemoryInBytes(void);
+
+private:
+    void Generate(void);
+    // Returns false if the generator was stopped before everything was written
+    bool WriteToMaster(const std::string& data);
+
+    static constexpr char diagram_end[] = "<<<END>>>\n";
+    // The waiting for the pseudo-terminal and the pacing is done in short steps, so the generator can be stopped at any time
+    static constexpr int maximum_waiting_step_in_milliseconds = 10;
+    // The lines are collected into a batch before writing, so a fast generator does not make a system call for every line
+    static constexpr std::size_t write_batch_size_in_bytes = 4096;
+
+    int master_file_descriptor;
+    // The slave end is kept open, so the closing of the SerialPort does not hang up the pseudo-terminal
+    int slave_file_descriptor;
+    std::string slave_path;
+
+    Options options;
+    std::thread generator_thread;
+    std::atomic<bool> generator_needs_to_stop;
+    std::atomic<bool> generation_is_finished;
+    std::atomic<std::size_t> number_of_written_diagrams;
+    std::atomic<std::size_t> number_of_written_bytes;
+    mutable std::mutex diagram_write_times_mutex;
+    std::vector<std::chrono::steady_clock::time_point> diagram_write_times;
+};
+
+
+
+#endif // PTY_SERIAL_SIMULATOR_HPP
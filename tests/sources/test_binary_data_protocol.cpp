@@ -0,0 +1,308 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "../application/sources/global.hpp"
+#include "../application/sources/binary_data_protocol.hpp"
+#include "../application/sources/measurement_data_protocol.hpp"
+
+
+
+class TestBinaryDataProtocol : public ::testing::Test
+{
+protected:
+    static void AppendSample(std::string& row_data, const void* sample, const std::size_t& size)
+    {
+        // The tests run on little-endian machines, so the bytes of the samples are already in the order of the protocol
+        row_data.append(static_cast<const char*>(sample), size);
+    }
+
+    // A diagram with two data lines and the rows (x, x * 2, x * 3) with int16 X and float32 Y values
+    static std::string CreateTestMeasurement(const std::string& title, const int16_t& number_of_rows)
+    {
+        std::string result = BinaryDataProtocol::CreateSchemaFrame(title, {{"Time", BinaryDataProtocol::SampleTypes::Int16},
+                                                                           {"Double", BinaryDataProtocol::SampleTypes::Float32},
+                                                                           {"Triple", BinaryDataProtocol::SampleTypes::Float32}});
+        std::string row_data;
+        for(int16_t x = 0; x < number_of_rows; ++x)
+        {
+            float double_value = static_cast<float>(x * 2);
+            float triple_value = static_cast<float>(x * 3);
+            AppendSample(row_data, &x, sizeof(x));
+            AppendSample(row_data, &double_value, sizeof(double_value));
+            AppendSample(row_data, &triple_value, sizeof(triple_value));
+        }
+        result += BinaryDataProtocol::CreateRowsFrame(row_data);
+        result += BinaryDataProtocol::CreateEndFrame();
+
+        return result;
+    }
+
+    static void CheckTestDiagram(const DiagramSpecialized& diagram, const std::string& title, const std::size_t& number_of_rows)
+    {
+        EXPECT_EQ(diagram.GetTitle(), title);
+        EXPECT_EQ(diagram.GetAxisXTitle(), "Time");
+        ASSERT_EQ(diagram.GetTheNumberOfDataLines(), 2);
+        EXPECT_EQ(diagram.GetDataLineTitle(0), "Double");
+        EXPECT_EQ(diagram.GetDataLineTitle(1), "Triple");
+        ASSERT_EQ(diagram.GetTheNumberOfDataPoints(0), number_of_rows);
+        for(std::size_t i = 0; i < number_of_rows; ++i)
+        {
+            EXPECT_EQ(diagram.GetDataPoint(0, i).GetX(), static_cast<DataPointType>(i));
+            EXPECT_EQ(diagram.GetDataPoint(0, i).GetY(), static_cast<DataPointType>(i * 2));
+            EXPECT_EQ(diagram.GetDataPoint(1, i).GetY(), static_cast<DataPointType>(i * 3));
+        }
+    }
+
+    BinaryDataProtocol test_bdp_processor;
+};
+
+TEST_F(TestBinaryDataProtocol, ConstructorAndDataProcessingInterface)
+{
+    EXPECT_EQ(test_bdp_processor.GetProtocolName(), "Binary Data Protocol BDP");
+    EXPECT_EQ(test_bdp_processor.GetSupportedFileType(), "bdp");
+    EXPECT_TRUE(test_bdp_processor.CanThisFileBeProcessed("myfile.bdp"));
+    EXPECT_FALSE(test_bdp_processor.CanThisFileBeProcessed("myfile.mdp"));
+    EXPECT_EQ(test_bdp_processor.GetNumberOfCorruptedInputs(), 0);
+}
+
+TEST_F(TestBinaryDataProtocol, CalculateCrc)
+{
+    // The check value of the CRC-16/CCITT-FALSE
+    std::string check_data = "123456789";
+    EXPECT_EQ(BinaryDataProtocol::CalculateCrc(reinterpret_cast<const uint8_t*>(check_data.data()), check_data.size()), 0x29B1);
+    EXPECT_EQ(BinaryDataProtocol::CalculateCrc(nullptr, 0), 0xFFFF);
+}
+
+TEST_F(TestBinaryDataProtocol, FrameEncoding)
+{
+    // Only the last byte of a frame is the delimiter, even if the packet contains delimiters and zeros that would be delimiters after the XOR
+    std::string row_data(600, '\0');
+    for(std::size_t i = 0; i < row_data.size(); i += 3)
+    {
+        row_data[i] = '\n';
+    }
+    std::string frame = BinaryDataProtocol::CreateRowsFrame(row_data);
+    EXPECT_EQ(frame.back(), '\n');
+    EXPECT_EQ(frame.find('\n'), (frame.size() - 1));
+}
+
+TEST_F(TestBinaryDataProtocol, ProcessData)
+{
+    std::stringstream input_data(CreateTestMeasurement("First", 100) + CreateTestMeasurement("Second", 1));
+    auto diagrams = test_bdp_processor.ProcessData(input_data);
+    ASSERT_EQ(diagrams.size(), 2);
+    CheckTestDiagram(diagrams[0], "First", 100);
+    CheckTestDiagram(diagrams[1], "Second", 1);
+    EXPECT_EQ(test_bdp_processor.GetNumberOfCorruptedInputs(), 0);
+}
+
+TEST_F(TestBinaryDataProtocol, ProcessData_SplitDelivery)
+{
+    // The frames can be split at any byte between the deliveries of the connections
+    std::string measurement = CreateTestMeasurement("Split", 50);
+    std::vector<DiagramSpecialized> diagrams;
+    for(std::size_t i = 0; i < measurement.size(); i += 7)
+    {
+        std::stringstream input_data(measurement.substr(i, 7));
+        auto new_diagrams = test_bdp_processor.ProcessData(input_data);
+        diagrams.insert(diagrams.end(), new_diagrams.begin(), new_diagrams.end());
+    }
+    ASSERT_EQ(diagrams.size(), 1);
+    CheckTestDiagram(diagrams[0], "Split", 50);
+}
+
+TEST_F(TestBinaryDataProtocol, ProcessData_AllSampleTypes)
+{
+    std::vector<BinaryDataProtocol::Column> columns = {{"X", BinaryDataProtocol::SampleTypes::UInt32},
+                                                       {"Int8", BinaryDataProtocol::SampleTypes::Int8},
+                                                       {"UInt8", BinaryDataProtocol::SampleTypes::UInt8},
+                                                       {"Int16", BinaryDataProtocol::SampleTypes::Int16},
+                                                       {"UInt16", BinaryDataProtocol::SampleTypes::UInt16},
+                                                       {"Int32", BinaryDataProtocol::SampleTypes::Int32},
+                                                       {"UInt32", BinaryDataProtocol::SampleTypes::UInt32},
+                                                       {"Float32", BinaryDataProtocol::SampleTypes::Float32},
+                                                       {"Float64", BinaryDataProtocol::SampleTypes::Float64}};
+    uint32_t x = 4000000000U;
+    int8_t int8 = -100;
+    uint8_t uint8 = 200;
+    int16_t int16 = -30000;
+    uint16_t uint16 = 60000;
+    int32_t int32 = -2000000000;
+    uint32_t uint32 = 4000000001U;
+    float float32 = -1.5F;
+    double float64 = 12345.0625;
+    std::string row_data;
+    AppendSample(row_data, &x, sizeof(x));
+    AppendSample(row_data, &int8, sizeof(int8));
+    AppendSample(row_data, &uint8, sizeof(uint8));
+    AppendSample(row_data, &int16, sizeof(int16));
+    AppendSample(row_data, &uint16, sizeof(uint16));
+    AppendSample(row_data, &int32, sizeof(int32));
+    AppendSample(row_data, &uint32, sizeof(uint32));
+    AppendSample(row_data, &float32, sizeof(float32));
+    AppendSample(row_data, &float64, sizeof(float64));
+
+    std::stringstream input_data(BinaryDataProtocol::CreateSchemaFrame("Types", columns) + BinaryDataProtocol::CreateRowsFrame(row_data) + BinaryDataProtocol::CreateEndFrame());
+    auto diagrams = test_bdp_processor.ProcessData(input_data);
+    ASSERT_EQ(diagrams.size(), 1);
+    ASSERT_EQ(diagrams[0].GetTheNumberOfDataLines(), 8);
+    EXPECT_EQ(diagrams[0].GetDataPoint(0, 0).GetX(), static_cast<DataPointType>(x));
+    EXPECT_EQ(diagrams[0].GetDataPoint(0, 0).GetY(), static_cast<DataPointType>(int8));
+    EXPECT_EQ(diagrams[0].GetDataPoint(1, 0).GetY(), static_cast<DataPointType>(uint8));
+    EXPECT_EQ(diagrams[0].GetDataPoint(2, 0).GetY(), static_cast<DataPointType>(int16));
+    EXPECT_EQ(diagrams[0].GetDataPoint(3, 0).GetY(), static_cast<DataPointType>(uint16));
+    EXPECT_EQ(diagrams[0].GetDataPoint(4, 0).GetY(), static_cast<DataPointType>(int32));
+    EXPECT_EQ(diagrams[0].GetDataPoint(5, 0).GetY(), static_cast<DataPointType>(uint32));
+    EXPECT_EQ(diagrams[0].GetDataPoint(6, 0).GetY(), static_cast<DataPointType>(float32));
+    EXPECT_EQ(diagrams[0].GetDataPoint(7, 0).GetY(), static_cast<DataPointType>(float64));
+}
+
+TEST_F(TestBinaryDataProtocol, ProcessData_CorruptedFrames)
+{
+    std::string first_rows;
+    std::string second_rows;
+    for(int16_t x = 0; x < 2; ++x)
+    {
+        float double_value = static_cast<float>(x * 2);
+        float triple_value = static_cast<float>(x * 3);
+        std::string& row_data = (0 == x) ? first_rows : second_rows;
+        AppendSample(row_data, &x, sizeof(x));
+        AppendSample(row_data, &double_value, sizeof(double_value));
+        AppendSample(row_data, &triple_value, sizeof(triple_value));
+    }
+
+    // A flipped bit is detected by the CRC, the frame is dropped and the rest of the diagram is still received
+    std::string corrupted_frame = BinaryDataProtocol::CreateRowsFrame(second_rows);
+    corrupted_frame[3] = static_cast<char>(corrupted_frame[3] ^ 0x04);
+    std::string measurement = BinaryDataProtocol::CreateSchemaFrame("Corrupted", {{"Time", BinaryDataProtocol::SampleTypes::Int16},
+                                                                                  {"Double", BinaryDataProtocol::SampleTypes::Float32},
+                                                                                  {"Triple", BinaryDataProtocol::SampleTypes::Float32}});
+    measurement += BinaryDataProtocol::CreateRowsFrame(first_rows) + corrupted_frame + BinaryDataProtocol::CreateEndFrame();
+
+    // The garbage before a delimiter is dropped together with the frame that it is merged with, the receiver is synchronized again after that
+    std::string garbage("\x01\x02\x00\x03\x04\n", 6);
+    std::stringstream input_data(garbage + "merged" + BinaryDataProtocol::CreateEndFrame() + measurement + CreateTestMeasurement("Valid", 3));
+    auto diagrams = test_bdp_processor.ProcessData(input_data);
+    ASSERT_EQ(diagrams.size(), 2);
+    EXPECT_EQ(diagrams[0].GetTitle(), "Corrupted");
+    ASSERT_EQ(diagrams[0].GetTheNumberOfDataPoints(0), 1);
+    EXPECT_EQ(diagrams[0].GetDataPoint(0, 0).GetX(), 0);
+    CheckTestDiagram(diagrams[1], "Valid", 3);
+    EXPECT_EQ(test_bdp_processor.GetNumberOfCorruptedInputs(), 3);
+}
+
+TEST_F(TestBinaryDataProtocol, ProcessData_InvalidPackets)
+{
+    // The rows without a schema are ignored, the rows that do not match the schema are corrupted
+    std::string measurement = BinaryDataProtocol::CreateRowsFrame(std::string(10, '\x01'));
+    measurement += BinaryDataProtocol::CreateSchemaFrame("Invalid", {{"X", BinaryDataProtocol::SampleTypes::UInt8}, {"Y", BinaryDataProtocol::SampleTypes::UInt16}});
+    measurement += BinaryDataProtocol::CreateRowsFrame(std::string(4, '\x01'));
+    measurement += BinaryDataProtocol::CreateRowsFrame(std::string(3, '\x01'));
+    measurement += BinaryDataProtocol::CreateEndFrame();
+    // A schema needs at least two columns and the known sample types
+    measurement += BinaryDataProtocol::CreateSchemaFrame("OneColumn", {{"X", BinaryDataProtocol::SampleTypes::UInt8}});
+    measurement += BinaryDataProtocol::CreateSchemaFrame("UnknownType", {{"X", BinaryDataProtocol::SampleTypes::UInt8}, {"Y", static_cast<BinaryDataProtocol::SampleTypes>(8)}});
+    measurement += BinaryDataProtocol::CreateEndFrame();
+
+    std::stringstream input_data(measurement);
+    auto diagrams = test_bdp_processor.ProcessData(input_data);
+    ASSERT_EQ(diagrams.size(), 1);
+    ASSERT_EQ(diagrams[0].GetTheNumberOfDataPoints(0), 1);
+    EXPECT_EQ(diagrams[0].GetDataPoint(0, 0).GetX(), 1);
+    EXPECT_EQ(diagrams[0].GetDataPoint(0, 0).GetY(), 0x0101);
+    EXPECT_EQ(test_bdp_processor.GetNumberOfCorruptedInputs(), 3);
+}
+
+TEST_F(TestBinaryDataProtocol, ExportData)
+{
+    std::stringstream input_data(CreateTestMeasurement("First", 1000) + CreateTestMeasurement("Second", 0));
+    auto diagrams = test_bdp_processor.ProcessData(input_data);
+    ASSERT_EQ(diagrams.size(), 2);
+
+    // The exported diagrams can be imported again without losing precision
+    auto exported_data = test_bdp_processor.ExportData(diagrams);
+    BinaryDataProtocol import_processor;
+    auto imported_diagrams = import_processor.ProcessData(exported_data);
+    ASSERT_EQ(imported_diagrams.size(), 2);
+    CheckTestDiagram(imported_diagrams[0], "First", 1000);
+    CheckTestDiagram(imported_diagrams[1], "Second", 0);
+    EXPECT_EQ(import_processor.GetNumberOfCorruptedInputs(), 0);
+}
+
+TEST_F(TestBinaryDataProtocol, ExportData_MaximumNumberOfColumns)
+{
+    // The number of columns is stored in one byte, so the X axis and 254 data lines are the most that can be exported
+    DiagramSpecialized diagram("Wide", "X");
+    for(std::size_t i = 0; i < (UINT8_MAX - 1); ++i)
+    {
+        diagram.AddNewDataLine("Line " + std::to_string(i));
+        for(std::size_t x = 0; x < 10; ++x)
+        {
+            diagram.AddNewDataPoint(i, DataPointSpecialized(static_cast<DataPointType>(x), static_cast<DataPointType>(x * i)));
+        }
+    }
+
+    std::vector<DiagramSpecialized> diagrams(1, diagram);
+    auto exported_data = test_bdp_processor.ExportData(diagrams);
+    BinaryDataProtocol import_processor;
+    auto imported_diagrams = import_processor.ProcessData(exported_data);
+    EXPECT_EQ(import_processor.GetNumberOfCorruptedInputs(), 0);
+    ASSERT_EQ(imported_diagrams.size(), 1);
+    ASSERT_EQ(imported_diagrams[0].GetTheNumberOfDataLines(), (UINT8_MAX - 1));
+    EXPECT_EQ(imported_diagrams[0].GetDataLineTitle(UINT8_MAX - 2), "Line 253");
+    ASSERT_EQ(imported_diagrams[0].GetTheNumberOfDataPoints(UINT8_MAX - 2), 10);
+    EXPECT_EQ(imported_diagrams[0].GetDataPoint((UINT8_MAX - 2), 9).GetX(), 9);
+    EXPECT_EQ(imported_diagrams[0].GetDataPoint((UINT8_MAX - 2), 9).GetY(), (9 * 253));
+
+    // One more data line does not fit into the schema, so the export is refused instead of writing rows that do not match it
+    diagrams[0].AddNewDataLine("Line 254");
+    for(std::size_t x = 0; x < 10; ++x)
+    {
+        diagrams[0].AddNewDataPoint((UINT8_MAX - 1), DataPointSpecialized(static_cast<DataPointType>(x), 0));
+    }
+    EXPECT_THROW(test_bdp_processor.ExportData(diagrams), std::string);
+
+    // The receivers would drop a schema frame that is longer than the maximum frame size
+    std::vector<BinaryDataProtocol::Column> columns(UINT8_MAX, BinaryDataProtocol::Column{std::string(UINT8_MAX, 'c'), BinaryDataProtocol::SampleTypes::Float64});
+    EXPECT_THROW(BinaryDataProtocol::CreateSchemaFrame("Long titles", columns), std::string);
+}
+
+TEST_F(TestBinaryDataProtocol, SizeComparedToMeasurementDataProtocol)
+{
+    // The samples of the binary protocol take less space than the numbers in text with the separators
+    std::stringstream input_data(CreateTestMeasurement("Size", 1000));
+    auto diagrams = test_bdp_processor.ProcessData(input_data);
+    ASSERT_EQ(diagrams.size(), 1);
+
+    MeasurementDataProtocol mdp_processor;
+    std::size_t mdp_size = mdp_processor.ExportData(diagrams).str().size();
+    std::size_t bdp_size = CreateTestMeasurement("Size", 1000).size();
+    EXPECT_LT(bdp_size, mdp_size);
+}
@@ -0,0 +1,190 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <thread>
+#include <chrono>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QDir>
+
+#include "../application/sources/capture_journal.hpp"
+
+
+
+class TestCaptureJournal : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        for(const auto& file_path : file_paths)
+        {
+            std::remove(file_path.c_str());
+        }
+    }
+
+    std::vector<std::vector<char>> ReadJournalFile(const std::string& file_path, std::vector<uint64_t>& receive_times)
+    {
+        std::vector<std::vector<char>> chunks;
+        std::ifstream journal(file_path, std::ios::in | std::ios::binary);
+        EXPECT_TRUE(CaptureJournal::ReadSignature(journal));
+
+        uint64_t receive_time = 0;
+        std::vector<char> chunk;
+        while(CaptureJournal::ReadRecord(journal, receive_time, chunk))
+        {
+            chunks.push_back(chunk);
+            receive_times.push_back(receive_time);
+        }
+        return chunks;
+    }
+
+    std::string file_path_prefix = QDir(QDir::tempPath()).filePath("rdb_capture_journal_test").toStdString();
+    std::vector<std::string> file_paths;
+};
+
+
+
+TEST_F(TestCaptureJournal, Write_Flush_ReadRecord)
+{
+    std::vector<std::string> written_chunks = {"first line\nsec", "ond line\n", std::string(1, '\0') + "binary"};
+
+    {
+        CaptureJournal journal(file_path_prefix, 0, 0);
+        auto start_time = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i < written_chunks.size(); ++i)
+        {
+            journal.Write(written_chunks[i].data(), written_chunks[i].size(), (start_time + std::chrono::milliseconds(10 * i)));
+        }
+        journal.Flush();
+
+        file_paths = journal.GetFilePaths();
+        ASSERT_EQ(file_paths.size(), std::size_t(1));
+        EXPECT_EQ(journal.GetNumberOfStoredBytes(), std::size_t(30));
+        EXPECT_EQ(journal.GetNumberOfDroppedChunks(), std::size_t(0));
+        EXPECT_FALSE(journal.HasWriteError());
+    }
+
+    std::vector<uint64_t> receive_times;
+    auto chunks = ReadJournalFile(file_paths.front(), receive_times);
+    ASSERT_EQ(chunks.size(), written_chunks.size());
+    for(std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        EXPECT_EQ(std::string(chunks[i].begin(), chunks[i].end()), written_chunks[i]);
+    }
+
+    // The receive times keep their distances
+    EXPECT_EQ(receive_times[1] - receive_times[0], uint64_t(10000000));
+    EXPECT_EQ(receive_times[2] - receive_times[1], uint64_t(10000000));
+}
+
+TEST_F(TestCaptureJournal, Rotation)
+{
+    std::vector<char> chunk(1000, 'a');
+
+    {
+        // Every file has room for two records, and only the newest two files are kept
+        CaptureJournal journal(file_path_prefix, 2100, 2);
+        for(int i = 0; i < 7; ++i)
+        {
+            journal.Write(chunk.data(), chunk.size());
+            journal.Flush();
+        }
+        file_paths = journal.GetFilePaths();
+    }
+
+    ASSERT_EQ(file_paths.size(), std::size_t(2));
+    EXPECT_EQ(file_paths[0], (file_path_prefix + "_000003.rdbj"));
+    EXPECT_EQ(file_paths[1], (file_path_prefix + "_000004.rdbj"));
+    EXPECT_FALSE(std::ifstream(file_path_prefix + "_000001.rdbj").is_open());
+
+    std::vector<uint64_t> receive_times;
+    EXPECT_EQ(ReadJournalFile(file_paths[0], receive_times).size(), std::size_t(2));
+    EXPECT_EQ(ReadJournalFile(file_paths[1], receive_times).size(), std::size_t(1));
+}
+
+TEST_F(TestCaptureJournal, FullBuffer)
+{
+    std::vector<char> chunk(1000, 'b');
+
+    {
+        // The buffer only has room for one chunk, so the chunks that arrive while the writer is busy are dropped, but never the stored ones
+        CaptureJournal journal(file_path_prefix, 0, 0, 1100);
+        for(int i = 0; i < 1000; ++i)
+        {
+            journal.Write(chunk.data(), chunk.size());
+        }
+        journal.Flush();
+        file_paths = journal.GetFilePaths();
+
+        EXPECT_EQ((journal.GetNumberOfStoredBytes() / chunk.size()) + journal.GetNumberOfDroppedChunks(), std::size_t(1000));
+        EXPECT_GT(journal.GetNumberOfStoredBytes(), std::size_t(0));
+    }
+
+    std::vector<uint64_t> receive_times;
+    for(const auto& chunk : ReadJournalFile(file_paths.front(), receive_times))
+    {
+        EXPECT_EQ(chunk.size(), std::size_t(1000));
+    }
+}
+
+TEST_F(TestCaptureJournal, ReadSignature_NotAJournal)
+{
+    file_paths.push_back(file_path_prefix + "_not_a_journal.txt");
+    {
+        std::ofstream file(file_paths.front());
+        file << "1,2,3\n";
+    }
+
+    std::ifstream file(file_paths.front());
+    EXPECT_FALSE(CaptureJournal::ReadSignature(file));
+}
+
+TEST_F(TestCaptureJournal, ReadRecord_SizeLargerThanMaximum)
+{
+    // A corrupted size is rejected before the memory is allocated for it
+    std::string record(8, '\0');
+    record += std::string("\xFF\xFF\xFF\xFF", 4);
+    std::istringstream journal(record);
+    uint64_t receive_time = 0;
+    std::vector<char> chunk;
+
+    EXPECT_FALSE(CaptureJournal::ReadRecord(journal, receive_time, chunk));
+    EXPECT_TRUE(chunk.empty());
+
+    // A size within the maximum is read as usual
+    std::string small_record(8, '\0');
+    small_record += std::string("\x03\x00\x00\x00", 4) + "1,2";
+    std::istringstream small_journal(small_record);
+    EXPECT_TRUE(CaptureJournal::ReadRecord(small_journal, receive_time, chunk, 3));
+    EXPECT_EQ(std::string(chunk.begin(), chunk.end()), "1,2");
+    small_journal.clear();
+    small_journal.seekg(0);
+    EXPECT_FALSE(CaptureJournal::ReadRecord(small_journal, receive_time, chunk, 2));
+}
@@ -0,0 +1,146 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/chart_series_builder.hpp"
+
+
+
+TEST(TestChartSeriesBuilder, CreatePoints)
+{
+    EXPECT_TRUE(ChartSeriesBuilder::CreatePoints(DataLineSpecialized("Empty")).isEmpty());
+
+    DataLineSpecialized data_line("Current");
+    data_line << DataPointSpecialized(0.0, 1.5) << DataPointSpecialized(1.0, -2.25) << DataPointSpecialized(2.5, 1e9);
+    auto points = ChartSeriesBuilder::CreatePoints(data_line);
+    ASSERT_EQ(points.size(), 3);
+    EXPECT_EQ(points[0], QPointF(0.0, 1.5));
+    EXPECT_EQ(points[1], QPointF(1.0, -2.25));
+    EXPECT_EQ(points[2], QPointF(2.5, 1e9));
+}
+
+TEST(TestChartSeriesBuilder, CreatePoints_Benchmark)
+{
+    // The conversion is a small part of the construction of a chart, the tools/chart_series_benchmark measures the whole construction
+    for(std::size_t number_of_points : {std::size_t(10000), std::size_t(1000000)})
+    {
+        std::vector<DataPointSpecialized> data_points;
+        data_points.reserve(number_of_points);
+        for(std::size_t i = 0; i < number_of_points; ++i)
+        {
+            data_points.emplace_back(static_cast<DataPointType>(i), static_cast<DataPointType>(i % 1000));
+        }
+        DataLineSpecialized data_line("Benchmark");
+        data_line.SetDataPoints(std::move(data_points));
+
+        auto start_of_the_conversion = std::chrono::steady_clock::now();
+        auto points = ChartSeriesBuilder::CreatePoints(data_line);
+        auto end_of_the_conversion = std::chrono::steady_clock::now();
+
+        ASSERT_EQ(static_cast<std::size_t>(points.size()), number_of_points);
+        EXPECT_EQ(points.back(), QPointF(static_cast<qreal>(number_of_points - 1), static_cast<qreal>((number_of_points - 1) % 1000)));
+        RecordProperty("ConversionTimeInMicrosecondsOf" + std::to_string(number_of_points) + "Points",
+                       static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(end_of_the_conversion - start_of_the_conversion).count()));
+    }
+}
+
+TEST(TestChartSeriesBuilder, IsOrderedByX)
+{
+    EXPECT_TRUE(ChartSeriesBuilder::IsOrderedByX(DataLineSpecialized("Empty")));
+
+    DataLineSpecialized data_line("Current");
+    data_line << DataPointSpecialized(0.0, 1.0) << DataPointSpecialized(1.0, 2.0) << DataPointSpecialized(1.0, 3.0);
+    EXPECT_TRUE(ChartSeriesBuilder::IsOrderedByX(data_line));
+    data_line << DataPointSpecialized(0.5, 4.0);
+    EXPECT_FALSE(ChartSeriesBuilder::IsOrderedByX(data_line));
+}
+
+TEST(TestChartSeriesBuilder, CreateDecimatedPoints)
+{
+    DataLineSpecialized data_line("Current");
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        data_line << DataPointSpecialized(static_cast<DataPointType>(i), 0.0);
+    }
+    // A single spike needs to survive the decimation
+    data_line.SetDataPoint(503, DataPointSpecialized(503.0, 100.0));
+    data_line.SetDataPoint(702, DataPointSpecialized(702.0, -100.0));
+
+    auto points = ChartSeriesBuilder::CreateDecimatedPoints(data_line, 0.0, 999.0, 10);
+    EXPECT_LE(points.size(), 20);
+    EXPECT_NE(std::find(points.begin(), points.end(), QPointF(503.0, 100.0)), points.end());
+    EXPECT_NE(std::find(points.begin(), points.end(), QPointF(702.0, -100.0)), points.end());
+    EXPECT_EQ(points.front(), QPointF(0.0, 0.0));
+    EXPECT_TRUE(std::is_sorted(points.begin(), points.end(), [](const QPointF& a, const QPointF& b){return (a.x() < b.x());}));
+
+    // The range is cut by the X values, the neighbouring points are kept so the line reaches the edges
+    points = ChartSeriesBuilder::CreateDecimatedPoints(data_line, 500.5, 509.5, 100);
+    ASSERT_EQ(points.size(), 11);
+    EXPECT_EQ(points.front(), QPointF(500.0, 0.0));
+    EXPECT_EQ(points[3], QPointF(503.0, 100.0));
+    EXPECT_EQ(points.back(), QPointF(510.0, 0.0));
+
+    // Without buckets or with a range that holds only a few points nothing is decimated
+    EXPECT_EQ(ChartSeriesBuilder::CreateDecimatedPoints(data_line, 0.0, 999.0, 0).size(), 1000);
+    EXPECT_EQ(ChartSeriesBuilder::CreateDecimatedPoints(data_line, 0.0, 999.0, 500).size(), 1000);
+    EXPECT_TRUE(ChartSeriesBuilder::CreateDecimatedPoints(DataLineSpecialized("Empty"), 0.0, 1.0, 10).isEmpty());
+}
+
+TEST(TestChartSeriesBuilder, CreateDecimatedPoints_Benchmark)
+{
+    // The number of the displayed points only depends on the width of the chart, the decimation itself is a single pass over the visible points
+    constexpr std::size_t number_of_buckets = 1500;
+    for(std::size_t number_of_points : {std::size_t(10000), std::size_t(1000000), std::size_t(10000000)})
+    {
+        std::vector<DataPointSpecialized> data_points;
+        data_points.reserve(number_of_points);
+        for(std::size_t i = 0; i < number_of_points; ++i)
+        {
+            data_points.emplace_back(static_cast<DataPointType>(i), static_cast<DataPointType>(i % 1000));
+        }
+        DataLineSpecialized data_line("Benchmark");
+        data_line.SetDataPoints(std::move(data_points));
+        auto x_maximum = static_cast<qreal>(number_of_points - 1);
+
+        auto start_of_the_decimation = std::chrono::steady_clock::now();
+        auto points = ChartSeriesBuilder::CreateDecimatedPoints(data_line, 0.0, x_maximum, number_of_buckets);
+        auto end_of_the_decimation = std::chrono::steady_clock::now();
+        // A zoomed in range only visits its own points
+        auto start_of_the_zoomed_decimation = std::chrono::steady_clock::now();
+        auto zoomed_points = ChartSeriesBuilder::CreateDecimatedPoints(data_line, (x_maximum / 2.0), ((x_maximum / 2.0) + 5000.0), number_of_buckets);
+        auto end_of_the_zoomed_decimation = std::chrono::steady_clock::now();
+
+        EXPECT_LE(static_cast<std::size_t>(points.size()), ((2 * number_of_buckets) + 4));
+        EXPECT_LE(static_cast<std::size_t>(zoomed_points.size()), ((2 * number_of_buckets) + 4));
+        RecordProperty("DecimationTimeInMicrosecondsOf" + std::to_string(number_of_points) + "Points",
+                       static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(end_of_the_decimation - start_of_the_decimation).count()));
+        RecordProperty("ZoomedDecimationTimeInMicrosecondsOf" + std::to_string(number_of_points) + "Points",
+                       static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(end_of_the_zoomed_decimation - start_of_the_zoomed_decimation).count()));
+    }
+}
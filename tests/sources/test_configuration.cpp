@@ -194,3 +194,127 @@ TEST_F(TestConfiguration, OutdatedConfiguration)
     ASSERT_TRUE(config_file_content.contains(key_to_add));
     ASSERT_EQ(config_file_content[key_to_add], value_to_add);
 }
+
+TEST_F(TestConfiguration, DiagramCacheFolder_DiagramMemoryBudgetInMegabytes)
+{
+    // Constructing a Configuration object
+    std::unique_ptr<Configuration> test_configuration = std::make_unique<Configuration>(test_configuration_path);
+
+    // Checking the default values
+    ASSERT_EQ(test_configuration->DiagramCacheFolder(), QDir::tempPath().toStdString());
+    ASSERT_GT(test_configuration->DiagramMemoryBudgetInMegabytes(), std::size_t(0));
+
+    // Write back updated values and check whether they were changed correctly
+    auto diagram_cache_folder_value = test_configuration->DiagramCacheFolder();
+    diagram_cache_folder_value.append("modification");
+    test_configuration->DiagramCacheFolder(diagram_cache_folder_value);
+    ASSERT_EQ(test_configuration->DiagramCacheFolder(), diagram_cache_folder_value);
+
+    std::size_t diagram_memory_budget_value = 16 * 1024;
+    test_configuration->DiagramMemoryBudgetInMegabytes(diagram_memory_budget_value);
+    ASSERT_EQ(test_configuration->DiagramMemoryBudgetInMegabytes(), diagram_memory_budget_value);
+}
+
+TEST_F(TestConfiguration, SessionSnapshotFile)
+{
+    std::unique_ptr<Configuration> test_configuration = std::make_unique<Configuration>(test_configuration_path);
+
+    // By default there is no snapshot to load at the startup
+    ASSERT_TRUE(test_configuration->SessionSnapshotFile().empty());
+
+    std::string session_snapshot_file_value = "/path/to/session.rdbsnap";
+    test_configuration->SessionSnapshotFile(session_snapshot_file_value);
+    ASSERT_EQ(test_configuration->SessionSnapshotFile(), session_snapshot_file_value);
+}
+
+TEST_F(TestConfiguration, CaptureJournal)
+{
+    std::unique_ptr<Configuration> test_configuration = std::make_unique<Configuration>(test_configuration_path);
+
+    // By default the raw data is not captured
+    ASSERT_TRUE(test_configuration->CaptureJournalFolder().empty());
+    ASSERT_GT(test_configuration->CaptureJournalMaximumFileSizeInMegabytes(), std::size_t(0));
+    ASSERT_GT(test_configuration->CaptureJournalMaximumNumberOfFiles(), std::size_t(0));
+
+    std::string capture_journal_folder_value = "/path/to/journals";
+    test_configuration->CaptureJournalFolder(capture_journal_folder_value);
+    ASSERT_EQ(test_configuration->CaptureJournalFolder(), capture_journal_folder_value);
+
+    test_configuration->CaptureJournalMaximumFileSizeInMegabytes(256);
+    ASSERT_EQ(test_configuration->CaptureJournalMaximumFileSizeInMegabytes(), std::size_t(256));
+
+    test_configuration->CaptureJournalMaximumNumberOfFiles(0);
+    ASSERT_EQ(test_configuration->CaptureJournalMaximumNumberOfFiles(), std::size_t(0));
+}
+
+TEST_F(TestConfiguration, DataDeliveryCoalescing)
+{
+    std::unique_ptr<Configuration> test_configuration = std::make_unique<Configuration>(test_configuration_path);
+
+    // By default the received lines are coalesced for a few milliseconds
+    ASSERT_EQ(test_configuration->DataDeliveryLatencyBudgetInMilliseconds(), std::size_t(5));
+    ASSERT_EQ(test_configuration->DataDeliverySizeThresholdInKilobytes(), std::size_t(64));
+
+    test_configuration->DataDeliveryLatencyBudgetInMilliseconds(0);
+    ASSERT_EQ(test_configuration->DataDeliveryLatencyBudgetInMilliseconds(), std::size_t(0));
+
+    test_configuration->DataDeliverySizeThresholdInKilobytes(1024);
+    ASSERT_EQ(test_configuration->DataDeliverySizeThresholdInKilobytes(), std::size_t(1024));
+}
+
+TEST_F(TestConfiguration, DisplayOverloadPolicy)
+{
+    std::unique_ptr<Configuration> test_configuration = std::make_unique<Configuration>(test_configuration_path);
+
+    // By default the display updates are coalesced
+    ASSERT_EQ(test_configuration->DisplayOverloadPolicy(), OverloadPolicy::Coalesce);
+
+    test_configuration->DisplayOverloadPolicy(OverloadPolicy::Block);
+    ASSERT_EQ(test_configuration->DisplayOverloadPolicy(), OverloadPolicy::Block);
+
+    test_configuration->DisplayOverloadPolicy(OverloadPolicy::DropOldestDisplayUpdates);
+    ASSERT_EQ(test_configuration->DisplayOverloadPolicy(), OverloadPolicy::DropOldestDisplayUpdates);
+}
+
+TEST_F(TestConfiguration, NetworkProtocol)
+{
+    std::unique_ptr<Configuration> test_configuration = std::make_unique<Configuration>(test_configuration_path);
+
+    // By default every connection uses the Measurement Data Protocol
+    ASSERT_EQ(test_configuration->NetworkProtocol("/dev/ttyACM0"), "mdp");
+
+    // The connections without their own protocol use the default protocol
+    test_configuration->NetworkProtocol("/dev/ttyACM0", "bdp");
+    ASSERT_EQ(test_configuration->NetworkProtocol("/dev/ttyACM0"), "bdp");
+    ASSERT_EQ(test_configuration->NetworkProtocol("/dev/ttyACM1"), "mdp");
+    test_configuration->NetworkProtocol("default", "bdp");
+    ASSERT_EQ(test_configuration->NetworkProtocol("/dev/ttyACM1"), "bdp");
+
+    // The protocols are saved into the configuration file
+    test_configuration.reset();
+    test_configuration = std::make_unique<Configuration>(test_configuration_path);
+    ASSERT_EQ(test_configuration->NetworkProtocol("/dev/ttyACM0"), "bdp");
+    ASSERT_EQ(test_configuration->NetworkProtocol("/dev/ttyACM1"), "bdp");
+}
+
+TEST_F(TestConfiguration, NetworkRetentionPolicy)
+{
+    std::unique_ptr<Configuration> test_configuration = std::make_unique<Configuration>(test_configuration_path);
+
+    // By default every diagram is kept
+    ASSERT_TRUE(test_configuration->NetworkRetentionPolicy("/dev/ttyACM0").IsUnlimited());
+
+    // The connections without their own policy use the default policy
+    RetentionPolicy default_policy(10000, (512 * 1024 * 1024), std::chrono::seconds(0));
+    test_configuration->NetworkRetentionPolicy("default", default_policy);
+    RetentionPolicy connection_policy(0, 0, std::chrono::seconds(3600));
+    test_configuration->NetworkRetentionPolicy("/dev/ttyACM0", connection_policy);
+    ASSERT_EQ(test_configuration->NetworkRetentionPolicy("/dev/ttyACM0"), connection_policy);
+    ASSERT_EQ(test_configuration->NetworkRetentionPolicy("/dev/ttyACM1"), default_policy);
+
+    // The policies are saved into the configuration file
+    test_configuration.reset();
+    test_configuration = std::make_unique<Configuration>(test_configuration_path);
+    ASSERT_EQ(test_configuration->NetworkRetentionPolicy("/dev/ttyACM0"), connection_policy);
+    ASSERT_EQ(test_configuration->NetworkRetentionPolicy("/dev/ttyACM1"), default_policy);
+}
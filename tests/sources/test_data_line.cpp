@@ -161,3 +161,20 @@ TEST(TestDataLine, CheckDataPointIndex)
     // Testing the error checking for a non existing data point
     ASSERT_THROW(data_line.GetDataPoint(2), std::string);
 }
+
+TEST(TestDataLine, GetMemoryUsage)
+{
+    DataLine<int, std::size_t> data_line;
+    EXPECT_EQ(data_line.GetMemoryUsage(), sizeof(data_line));
+
+    // A long title is allocated on the heap, this has to be accounted for
+    std::string long_title(100, 'T');
+    data_line.SetTitle(long_title);
+    EXPECT_GE(data_line.GetMemoryUsage(), (sizeof(data_line) + long_title.size()));
+
+    // The data points are counted with the capacity of the storage and not with the number of the data points
+    std::size_t memory_usage_before_the_data_points = data_line.GetMemoryUsage();
+    data_line << DataPoint<int>(1, 2) << DataPoint<int>(3, 4) << DataPoint<int>(5, 6);
+    EXPECT_GE(data_line.GetMemoryUsage(), (memory_usage_before_the_data_points + (3 * sizeof(DataPoint<int>))));
+    EXPECT_EQ((data_line.GetMemoryUsage() - memory_usage_before_the_data_points) % sizeof(DataPoint<int>), std::size_t(0));
+}
@@ -257,3 +257,23 @@ TEST(TestDiagram, EraseContent)
     EXPECT_THROW(diagram.GetTheNumberOfDataPoints(0), std::string);
     EXPECT_THROW(diagram.GetTheNumberOfDataPoints(1), std::string);
 }
+
+TEST(TestDiagram, GetMemoryUsage)
+{
+    Diagram<data_type, index_type> diagram;
+    EXPECT_EQ(diagram.GetMemoryUsage(), sizeof(diagram));
+
+    // Long titles are allocated on the heap, these have to be accounted for
+    std::string long_title(100, 'T');
+    diagram.SetTitle(long_title);
+    diagram.SetAxisXTitle(long_title);
+    EXPECT_GE(diagram.GetMemoryUsage(), (sizeof(diagram) + (2 * long_title.size())));
+
+    // The memory usage of the data lines is contained by the memory usage of the diagram
+    diagram.AddNewDataLine(long_title);
+    diagram.AddNewDataPoint(0, DataPoint<data_type>(1, 2));
+    diagram.AddNewDataPoint(0, DataPoint<data_type>(3, 4));
+    DataLine<data_type, index_type> equivalent_data_line(long_title);
+    equivalent_data_line << DataPoint<data_type>(1, 2) << DataPoint<data_type>(3, 4);
+    EXPECT_GE(diagram.GetMemoryUsage(), (sizeof(diagram) + (2 * long_title.size()) + equivalent_data_line.GetMemoryUsage()));
+}
@@ -0,0 +1,175 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <cstdio>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/diagram_cache.hpp"
+
+
+
+class TestDiagramCache : public ::testing::Test
+{
+protected:
+    DiagramSpecialized CreateDiagram(const std::string& title, const int& number_of_data_points)
+    {
+        DiagramSpecialized diagram(title, "AxisXTitle");
+        diagram.AddNewDataLine("First DataLine");
+        diagram.AddNewDataLine("Second DataLine");
+        for(int i = 0; i < number_of_data_points; i++)
+        {
+            diagram.AddNewDataPoint(0, DataPointSpecialized(i, (i * 2)));
+            diagram.AddNewDataPoint(1, DataPointSpecialized(i, (-i * 0.5)));
+        }
+        return diagram;
+    }
+
+    std::string test_cache_file_path = "test_diagram_cache.bin";
+};
+
+TEST_F(TestDiagramCache, Constructor_Destructor)
+{
+    auto cache = std::make_unique<DiagramCache>(test_cache_file_path);
+    EXPECT_EQ(cache->GetCacheFilePath(), test_cache_file_path);
+    EXPECT_EQ(cache->GetCacheFileSize(), std::uint64_t(0));
+    EXPECT_TRUE(std::ifstream(test_cache_file_path).is_open());
+
+    // The cache file is removed together with the cache
+    cache.reset();
+    EXPECT_FALSE(std::ifstream(test_cache_file_path).is_open());
+}
+
+TEST_F(TestDiagramCache, Store_Load)
+{
+    DiagramCache cache(test_cache_file_path);
+    auto first_diagram = CreateDiagram("First", 100);
+    auto second_diagram = CreateDiagram("Second", 1000);
+
+    auto first_entry = cache.Store(first_diagram);
+    auto second_entry = cache.Store(second_diagram);
+    EXPECT_EQ(first_entry.offset, std::uint64_t(0));
+    EXPECT_EQ(second_entry.offset, first_entry.size);
+    EXPECT_EQ(cache.GetCacheFileSize(), (first_entry.size + second_entry.size));
+
+    // Only the data points are released, the titles are kept
+    auto evicted_diagram = second_diagram;
+    evicted_diagram.EraseDataPoints();
+    EXPECT_EQ(evicted_diagram.GetTheNumberOfDataLines(), second_diagram.GetTheNumberOfDataLines());
+    EXPECT_EQ(evicted_diagram.GetTheNumberOfDataPoints(0), DataIndexType(0));
+    EXPECT_LT(evicted_diagram.GetMemoryUsage(), second_diagram.GetMemoryUsage());
+
+    // Reloading the data points
+    cache.Load(second_entry, evicted_diagram);
+    for(DataIndexType data_line_index = 0; data_line_index < second_diagram.GetTheNumberOfDataLines(); data_line_index++)
+    {
+        EXPECT_EQ(evicted_diagram.GetDataLine(data_line_index).GetDataPoints(), second_diagram.GetDataLine(data_line_index).GetDataPoints());
+    }
+}
+
+TEST_F(TestDiagramCache, Release)
+{
+    DiagramCache cache(test_cache_file_path);
+    auto diagram = CreateDiagram("Diagram", 100);
+    auto first_entry = cache.Store(diagram);
+    auto second_entry = cache.Store(diagram);
+    auto third_entry = cache.Store(diagram);
+    std::uint64_t file_size = cache.GetCacheFileSize();
+
+    // A released extent in the middle of the file is reused by the next entry that fits into it
+    cache.Release(second_entry);
+    cache.Release(second_entry);
+    EXPECT_EQ(cache.GetSizeOfReleasedEntries(), second_entry.size);
+    auto smaller_entry = cache.Store(CreateDiagram("Smaller", 10));
+    EXPECT_EQ(smaller_entry.offset, second_entry.offset);
+    EXPECT_EQ(cache.GetSizeOfReleasedEntries(), (second_entry.size - smaller_entry.size));
+    EXPECT_EQ(cache.GetCacheFileSize(), file_size);
+
+    // The neighbouring extents are merged and an extent at the end of the file shrinks the file
+    cache.Release(smaller_entry);
+    cache.Release(first_entry);
+    EXPECT_EQ(cache.GetSizeOfReleasedEntries(), (first_entry.size + second_entry.size));
+    cache.Release(third_entry);
+    EXPECT_EQ(cache.GetSizeOfReleasedEntries(), std::uint64_t(0));
+    EXPECT_EQ(cache.GetCacheFileSize(), std::uint64_t(0));
+
+    // Storing and releasing diagrams continuously does not grow the file
+    first_entry = cache.Store(diagram);
+    for(int i = 0; i < 1000; i++)
+    {
+        auto entry = cache.Store(diagram);
+        cache.Release(first_entry);
+        first_entry = entry;
+    }
+    EXPECT_LE(cache.GetCacheFileSize(), (2 * first_entry.size));
+    auto evicted_diagram = diagram;
+    evicted_diagram.EraseDataPoints();
+    cache.Load(first_entry, evicted_diagram);
+    EXPECT_EQ(evicted_diagram.GetDataLine(0).GetDataPoints(), diagram.GetDataLine(0).GetDataPoints());
+}
+
+TEST_F(TestDiagramCache, Load_Errors)
+{
+    DiagramCache cache(test_cache_file_path);
+    auto diagram = CreateDiagram("Diagram", 10);
+    auto entry = cache.Store(diagram);
+
+    // The entry can not point outside of the file
+    DiagramCache::Entry invalid_entry(entry.offset, (entry.size + 1));
+    EXPECT_THROW(cache.Load(invalid_entry, diagram), std::string);
+
+    // The number of the data lines needs to match
+    DiagramSpecialized other_diagram("Other");
+    EXPECT_THROW(cache.Load(entry, other_diagram), std::string);
+}
+
+TEST_F(TestDiagramCache, OpenExistingFile)
+{
+    auto diagram = CreateDiagram("Diagram", 100);
+    auto serialized_diagram = DiagramCache::Serialize(diagram);
+    {
+        std::ofstream existing_file(test_cache_file_path, (std::ofstream::binary | std::ofstream::trunc));
+        existing_file.write(serialized_diagram.data(), static_cast<std::streamsize>(serialized_diagram.size()));
+    }
+
+    {
+        // The existing file can only be read
+        DiagramCache cache(test_cache_file_path, true);
+        EXPECT_TRUE(cache.IsReadOnly());
+        EXPECT_EQ(cache.GetCacheFileSize(), std::uint64_t(serialized_diagram.size()));
+        EXPECT_EQ(cache.Read(DiagramCache::Entry(0, serialized_diagram.size())), serialized_diagram);
+        EXPECT_THROW(cache.Store(diagram), std::string);
+
+        auto evicted_diagram = diagram;
+        evicted_diagram.EraseDataPoints();
+        cache.Load(DiagramCache::Entry(0, serialized_diagram.size()), evicted_diagram);
+        EXPECT_EQ(evicted_diagram.GetDataLine(1).GetDataPoints(), diagram.GetDataLine(1).GetDataPoints());
+    }
+
+    // The existing file is kept after the cache was destroyed
+    EXPECT_TRUE(std::ifstream(test_cache_file_path).is_open());
+    std::remove(test_cache_file_path.c_str());
+    EXPECT_THROW(DiagramCache(test_cache_file_path, true), std::string);
+}
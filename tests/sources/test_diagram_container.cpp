@@ -21,6 +21,12 @@
 
 
 
+#include <chrono>
+#include <functional>
+#include <fstream>
+#include <cstdio>
+#include <thread>
+
 #include <gtest/gtest.h>
 #include <gmock/gmock-matchers.h>
 
@@ -32,3 +38,798 @@ TEST(TestDiagramContainer, Constructor)
 {
     DiagramContainer myContainer();
 }
+
+TEST(TestDiagramContainer, GetMemoryUsage)
+{
+    DiagramContainer container;
+    EXPECT_GT(container.GetMemoryUsage(), std::size_t(0));
+
+    DiagramSpecialized diagram("DiagramTitle", "AxisXTitle");
+    diagram.AddNewDataLine("DataLineTitle");
+    for(int i = 0; i < 1000; i++)
+    {
+        diagram.AddNewDataPoint(0, DataPointSpecialized(i, i));
+    }
+
+    // The memory usage of the diagram needs to be accounted for the diagram, the file and the root as well
+    auto diagram_index = container.AddDiagramFromFile("file.mdp", "/path/to/file.mdp", diagram);
+    auto file_index = container.parent(diagram_index);
+    std::size_t memory_usage_of_the_stored_diagram = container.GetDiagram(diagram_index)->GetMemoryUsage();
+    EXPECT_GE(container.GetMemoryUsage(diagram_index), memory_usage_of_the_stored_diagram);
+    EXPECT_GT(container.GetMemoryUsage(file_index), container.GetMemoryUsage(diagram_index));
+    EXPECT_GT(container.GetMemoryUsage(), memory_usage_of_the_stored_diagram);
+    EXPECT_EQ(container.GetMemoryUsage(), container.GetMemoryUsage(QModelIndex()));
+
+    // Adding the same diagram again to the same file doubles the memory usage of the diagrams
+    std::size_t memory_usage_with_one_diagram = container.GetMemoryUsage(file_index);
+    container.AddDiagramFromFile("file.mdp", "/path/to/file.mdp", diagram);
+    EXPECT_GE(container.GetMemoryUsage(file_index), (memory_usage_with_one_diagram + memory_usage_of_the_stored_diagram));
+
+    // The tooltip shows the memory usage
+    EXPECT_TRUE(container.data(file_index, Qt::ToolTipRole).isValid());
+}
+
+TEST(TestDiagramContainer, DiagramCache)
+{
+    DiagramContainer container;
+    std::string test_cache_file_path = "test_diagram_container_cache.bin";
+
+    DiagramSpecialized diagram("DiagramTitle", "AxisXTitle");
+    diagram.AddNewDataLine("DataLineTitle");
+    for(int i = 0; i < 10000; i++)
+    {
+        diagram.AddNewDataPoint(0, DataPointSpecialized(i, (i * 3)));
+    }
+
+    // Without a memory budget every diagram remains in the memory
+    std::vector<QModelIndex> diagram_indexes;
+    for(int i = 0; i < 10; i++)
+    {
+        diagram_indexes.push_back(container.AddDiagramFromFile("file.mdp", "/path/to/file.mdp", diagram));
+    }
+    std::size_t memory_usage_without_budget = container.GetMemoryUsage();
+
+    // Setting a budget for roughly three diagrams, the rest has to be evicted
+    std::size_t memory_budget = memory_usage_without_budget * 3 / 10;
+    container.ConfigureDiagramCache(test_cache_file_path, memory_budget);
+    EXPECT_LE(container.GetMemoryUsage(), memory_budget);
+
+    // The evicted diagrams are reloaded transparently
+    for(const auto& i : diagram_indexes)
+    {
+        auto stored_diagram = container.GetDiagram(i);
+        ASSERT_NE(stored_diagram, nullptr);
+        EXPECT_EQ(stored_diagram->GetTitle(), diagram.GetTitle());
+        EXPECT_EQ(stored_diagram->GetDataLine(0).GetDataPoints(), diagram.GetDataLine(0).GetDataPoints());
+        EXPECT_LE(container.GetMemoryUsage(), memory_budget);
+    }
+
+    // The checked diagrams are exported with their data points even if they are evicted
+    container.ShowCheckBoxes();
+    EXPECT_TRUE(container.setData(container.parent(diagram_indexes.front()), QVariant(Qt::Checked), Qt::CheckStateRole));
+    auto checked_diagrams = container.GetCheckedDiagrams();
+    ASSERT_EQ(checked_diagrams.size(), diagram_indexes.size());
+    for(const auto& i : checked_diagrams)
+    {
+        EXPECT_EQ(i.GetDataLine(0).GetDataPoints(), diagram.GetDataLine(0).GetDataPoints());
+    }
+    EXPECT_LE(container.GetMemoryUsage(), memory_budget);
+}
+
+TEST(TestDiagramContainer, DiagramCache_RetentionPolicy)
+{
+    std::string test_cache_file_path = "test_diagram_container_cache.bin";
+    std::size_t size_of_the_cache_file = 0;
+    {
+        DiagramContainer container;
+        DiagramSpecialized diagram("DiagramTitle", "AxisXTitle");
+        diagram.AddNewDataLine("DataLineTitle");
+        for(int i = 0; i < 1000; i++)
+        {
+            diagram.AddNewDataPoint(0, DataPointSpecialized(i, (i * 3)));
+        }
+
+        // Only a few diagrams fit into the memory, the retention policy removes the oldest diagrams during the long capture
+        container.AddDiagramsFromNetwork("/dev/ttyACM0", std::vector<DiagramSpecialized>(1, diagram));
+        container.ConfigureDiagramCache(test_cache_file_path, (container.GetMemoryUsage() * 5));
+        container.SetRetentionPolicy("/dev/ttyACM0", RetentionPolicy(20, 0, std::chrono::seconds(0)));
+        for(int i = 0; i < 1000; i++)
+        {
+            container.AddDiagramsFromNetwork("/dev/ttyACM0", std::vector<DiagramSpecialized>(1, diagram));
+        }
+        EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(20));
+
+        // The extents of the removed diagrams are reused, so the cache file only holds about the retained diagrams
+        std::ifstream cache_file(test_cache_file_path, (std::ifstream::binary | std::ifstream::ate));
+        ASSERT_TRUE(cache_file.is_open());
+        size_of_the_cache_file = static_cast<std::size_t>(cache_file.tellg());
+        EXPECT_LT(size_of_the_cache_file, (25 * DiagramCache::Serialize(diagram).size()));
+    }
+    EXPECT_GT(size_of_the_cache_file, std::size_t(0));
+}
+
+TEST(TestDiagramContainer, DiagramCache_RetentionPolicyBeforeEviction)
+{
+    std::string test_cache_file_path = "test_diagram_container_cache.bin";
+    DiagramContainer container;
+    DiagramSpecialized diagram("DiagramTitle", "AxisXTitle");
+    diagram.AddNewDataLine("DataLineTitle");
+    for(int i = 0; i < 1000; i++)
+    {
+        diagram.AddNewDataPoint(0, DataPointSpecialized(i, (i * 3)));
+    }
+    container.AddDiagramsFromNetwork("/dev/ttyACM0", std::vector<DiagramSpecialized>(1, diagram));
+    container.ConfigureDiagramCache(test_cache_file_path, (container.GetMemoryUsage() * 5));
+    container.SetRetentionPolicy("/dev/ttyACM0", RetentionPolicy(20, 0, std::chrono::seconds(0)));
+
+    // Only the retained diagrams can be evicted, the ones removed by the retention policy are never written to the cache
+    container.AddDiagramsFromNetwork("/dev/ttyACM0", std::vector<DiagramSpecialized>(1000, diagram));
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(20));
+    std::ifstream cache_file(test_cache_file_path, (std::ifstream::binary | std::ifstream::ate));
+    ASSERT_TRUE(cache_file.is_open());
+    EXPECT_LE(static_cast<std::size_t>(cache_file.tellg()), (20 * DiagramCache::Serialize(diagram).size()));
+}
+
+TEST(TestDiagramContainer, SaveSnapshot_LoadSnapshot)
+{
+    std::string test_snapshot_file_path = "test_diagram_container_snapshot.bin";
+    std::string test_cache_file_path = "test_diagram_container_snapshot_cache.bin";
+
+    DiagramSpecialized diagram("DiagramTitle", "AxisXTitle");
+    diagram.AddNewDataLine("First DataLine");
+    diagram.AddNewDataLine("Second DataLine");
+    for(int i = 0; i < 1000; i++)
+    {
+        diagram.AddNewDataPoint(0, DataPointSpecialized(i, (i * 2)));
+        diagram.AddNewDataPoint(1, DataPointSpecialized(i, (i * 3)));
+    }
+
+    {
+        // Some of the saved diagrams are evicted, their data points are copied from the diagram cache
+        DiagramContainer container;
+        for(int i = 0; i < 10; i++)
+        {
+            container.AddDiagramFromFile("file.mdp", "/path/to/file.mdp", diagram);
+        }
+        auto network_diagram_index = container.AddDiagramFromNetwork("/dev/ttyACM0", DiagramSpecialized("NetworkDiagram", "Time"));
+        container.ConfigureDiagramCache(test_cache_file_path, (container.GetMemoryUsage() / 2));
+        container.ShowCheckBoxes();
+        EXPECT_TRUE(container.setData(network_diagram_index, QVariant(Qt::Checked), Qt::CheckStateRole));
+        container.SaveSnapshot(test_snapshot_file_path);
+    }
+
+    // Only the metadata is loaded, the data points remain in the snapshot until they are requested
+    DiagramContainer container;
+    EXPECT_EQ(container.LoadSnapshot(test_snapshot_file_path), std::size_t(11));
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(11));
+    EXPECT_LT(container.GetMemoryUsage(), (10 * diagram.GetMemoryUsage()));
+    EXPECT_TRUE(container.IsThisFileAlreadyStored("file.mdp", "/path/to/file.mdp"));
+
+    auto file_index = container.index(0, 0, container.index(0, 0));
+    ASSERT_EQ(container.rowCount(file_index), 10);
+    for(int i = 0; i < 10; i++)
+    {
+        auto loaded_diagram = container.GetDiagram(container.index(i, 0, file_index));
+        ASSERT_NE(loaded_diagram, nullptr);
+        EXPECT_EQ(loaded_diagram->GetTitle(), diagram.GetTitle());
+        EXPECT_EQ(loaded_diagram->GetAxisXTitle(), diagram.GetAxisXTitle());
+        EXPECT_EQ(loaded_diagram->GetDataLineTitle(1), diagram.GetDataLineTitle(1));
+        EXPECT_EQ(loaded_diagram->GetDataLine(0).GetDataPoints(), diagram.GetDataLine(0).GetDataPoints());
+        EXPECT_EQ(loaded_diagram->GetDataLine(1).GetDataPoints(), diagram.GetDataLine(1).GetDataPoints());
+    }
+
+    // The check states are restored
+    auto checked_diagrams = container.GetCheckedDiagrams();
+    ASSERT_EQ(checked_diagrams.size(), std::size_t(1));
+    EXPECT_EQ(checked_diagrams.front().GetTitle(), "NetworkDiagram");
+
+    // The already stored files are not loaded again
+    EXPECT_EQ(container.LoadSnapshot(test_snapshot_file_path), std::size_t(1));
+    EXPECT_EQ(container.rowCount(file_index), 10);
+
+    // A file that is not a snapshot is rejected
+    {
+        std::ofstream invalid_snapshot_file(test_cache_file_path, std::ofstream::trunc);
+        invalid_snapshot_file << "This is not a snapshot of the diagrams.";
+    }
+    EXPECT_THROW(container.LoadSnapshot(test_cache_file_path), std::string);
+    EXPECT_THROW(container.LoadSnapshot("this_file_does_not_exist.bin"), std::string);
+    std::remove(test_cache_file_path.c_str());
+
+    // Saving a snapshot that was loaded into the container, the diagrams are read from the new file afterwards
+    container.SaveSnapshot(test_snapshot_file_path);
+    // (The network diagram was loaded by both of the loadings)
+    checked_diagrams = container.GetCheckedDiagrams();
+    ASSERT_EQ(checked_diagrams.size(), std::size_t(2));
+    EXPECT_EQ(checked_diagrams.back().GetTitle(), "NetworkDiagram");
+    DiagramContainer other_container;
+    EXPECT_EQ(other_container.LoadSnapshot(test_snapshot_file_path), std::size_t(12));
+    EXPECT_EQ(other_container.GetDiagram(other_container.index(9, 0, other_container.index(0, 0, other_container.index(0, 0))))->GetDataLine(1).GetDataPoints(),
+              diagram.GetDataLine(1).GetDataPoints());
+    std::remove(test_snapshot_file_path.c_str());
+}
+
+TEST(TestDiagramContainer, LoadSnapshot_Corrupted)
+{
+    std::string test_snapshot_file_path = "test_diagram_container_corrupted_snapshot.bin";
+
+    // A snapshot with one file whose metadata is created by the function
+    auto write_snapshot = [&](const std::function<void(std::vector<char>&)>& append_diagrams)
+    {
+        std::vector<char> metadata;
+        std::uint64_t number_of_files = 1;
+        std::uint64_t empty_string_size = 0;
+        std::uint64_t number_of_connections = 0;
+        DiagramCache::AppendToBuffer(metadata, &number_of_files, sizeof(number_of_files));
+        DiagramCache::AppendToBuffer(metadata, &empty_string_size, sizeof(empty_string_size));
+        DiagramCache::AppendToBuffer(metadata, &empty_string_size, sizeof(empty_string_size));
+        append_diagrams(metadata);
+        DiagramCache::AppendToBuffer(metadata, &number_of_connections, sizeof(number_of_connections));
+
+        std::vector<char> file_content(std::begin("RDBSNAP1"), (std::end("RDBSNAP1") - 1));
+        std::uint64_t metadata_offset = file_content.size() + (2 * sizeof(std::uint64_t));
+        std::uint64_t metadata_size = metadata.size();
+        DiagramCache::AppendToBuffer(file_content, &metadata_offset, sizeof(metadata_offset));
+        DiagramCache::AppendToBuffer(file_content, &metadata_size, sizeof(metadata_size));
+        file_content.insert(file_content.end(), metadata.begin(), metadata.end());
+        std::ofstream snapshot_file(test_snapshot_file_path, (std::ofstream::binary | std::ofstream::trunc));
+        snapshot_file.write(file_content.data(), static_cast<std::streamsize>(file_content.size()));
+    };
+
+    // A count that is larger than the metadata is rejected before anything is allocated for it
+    write_snapshot([](std::vector<char>& metadata)
+    {
+        std::uint64_t number_of_diagrams = std::numeric_limits<std::uint64_t>::max() / 2;
+        DiagramCache::AppendToBuffer(metadata, &number_of_diagrams, sizeof(number_of_diagrams));
+    });
+    DiagramContainer container;
+    EXPECT_THROW(container.LoadSnapshot(test_snapshot_file_path), std::string);
+
+    // An invalid check state is rejected
+    write_snapshot([](std::vector<char>& metadata)
+    {
+        std::uint64_t values[] = {1, 0, 0, 0};
+        std::uint8_t check_state = 7;
+        std::uint64_t entry[] = {0, 0};
+        DiagramCache::AppendToBuffer(metadata, values, sizeof(values));
+        DiagramCache::AppendToBuffer(metadata, &check_state, sizeof(check_state));
+        DiagramCache::AppendToBuffer(metadata, entry, sizeof(entry));
+    });
+    EXPECT_THROW(container.LoadSnapshot(test_snapshot_file_path), std::string);
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(0));
+    std::remove(test_snapshot_file_path.c_str());
+}
+
+TEST(TestDiagramContainer, LoadSnapshot_RetentionPolicy)
+{
+    std::string test_snapshot_file_path = "test_diagram_container_retention_snapshot.bin";
+
+    {
+        // The fourth diagram of the first connection is checked, the second connection has no checked diagrams
+        DiagramContainer container;
+        std::vector<DiagramSpecialized> diagrams;
+        for(int i = 0; i < 30; i++)
+        {
+            diagrams.emplace_back(("Diagram " + std::to_string(i)), "Time");
+        }
+        container.AddDiagramsFromNetwork("/dev/ttyACM0", std::vector<DiagramSpecialized>(diagrams));
+        container.AddDiagramsFromNetwork("/dev/ttyACM1", std::move(diagrams));
+        container.ShowCheckBoxes();
+        auto checked_diagram_index = container.index(3, 0, container.index(0, 0, container.index(1, 0)));
+        ASSERT_EQ(container.GetDiagram(checked_diagram_index)->GetTitle(), "Diagram 3");
+        EXPECT_TRUE(container.setData(checked_diagram_index, QVariant(Qt::Checked), Qt::CheckStateRole));
+        container.SaveSnapshot(test_snapshot_file_path);
+    }
+
+    // The retention policies remove most of the loaded diagrams, even every diagram of the second connection, but the checked diagram is protected
+    DiagramContainer container;
+    container.SetRetentionPolicy("/dev/ttyACM0", RetentionPolicy(10, 0, std::chrono::seconds(0)));
+    container.SetRetentionPolicy("/dev/ttyACM1", RetentionPolicy(0, 1, std::chrono::seconds(0)));
+    EXPECT_EQ(container.LoadSnapshot(test_snapshot_file_path), std::size_t(60));
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(10));
+    auto checked_diagrams = container.GetCheckedDiagrams();
+    ASSERT_EQ(checked_diagrams.size(), std::size_t(1));
+    EXPECT_EQ(checked_diagrams.front().GetTitle(), "Diagram 3");
+    std::remove(test_snapshot_file_path.c_str());
+}
+
+TEST(TestDiagramContainer, IsThisFileAlreadyStored_AddDiagramFromNetwork)
+{
+    DiagramContainer container;
+    DiagramSpecialized diagram("DiagramTitle", "AxisXTitle");
+    constexpr int number_of_files = 2000;
+
+    // Importing many files, every one of them needs to be found with the index
+    for(int i = 0; i < number_of_files; i++)
+    {
+        std::string file_name = "file_" + std::to_string(i) + ".mdp";
+        std::string file_path = "/path/to/" + file_name;
+        EXPECT_FALSE(container.IsThisFileAlreadyStored(file_name, file_path));
+        auto diagram_index = container.AddDiagramFromFile(file_name, file_path, diagram);
+        EXPECT_TRUE(container.IsThisFileAlreadyStored(file_name, file_path));
+        EXPECT_EQ(diagram_index.row(), 0);
+    }
+    EXPECT_FALSE(container.IsThisFileAlreadyStored("file_0.mdp", "/another/path/to/file_0.mdp"));
+
+    // The diagrams of the same connection are collected below the same element
+    auto first_diagram_index = container.AddDiagramFromNetwork("/dev/ttyACM0", diagram);
+    auto second_diagram_index = container.AddDiagramFromNetwork("/dev/ttyACM0", diagram);
+    auto third_diagram_index = container.AddDiagramFromNetwork("/dev/ttyACM1", diagram);
+    EXPECT_EQ(container.parent(first_diagram_index), container.parent(second_diagram_index));
+    EXPECT_NE(container.parent(first_diagram_index), container.parent(third_diagram_index));
+    EXPECT_EQ(second_diagram_index.row(), 1);
+    EXPECT_EQ(container.rowCount(container.parent(container.parent(first_diagram_index))), 2);
+}
+
+TEST(TestDiagramContainer, GetNumberOfDiagrams)
+{
+    DiagramContainer container;
+    DiagramSpecialized diagram("DiagramTitle", "AxisXTitle");
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(0));
+
+    container.AddDiagramFromFile("file.mdp", "/path/to/file.mdp", diagram);
+    container.AddDiagramFromFile("file.mdp", "/path/to/file.mdp", diagram);
+    container.AddDiagramFromFile("other_file.mdp", "/path/to/other_file.mdp", diagram);
+    container.AddDiagramFromNetwork("/dev/ttyACM0", diagram);
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(4));
+}
+
+TEST(TestDiagramContainer, ModelTraversal_100kElements)
+{
+    DiagramContainer container;
+    DiagramSpecialized diagram("DiagramTitle", "AxisXTitle");
+    constexpr int number_of_files = 100;
+    constexpr int number_of_diagrams_per_file = 1000;
+
+    auto start_of_the_insertion = std::chrono::steady_clock::now();
+    for(int file = 0; file < number_of_files; file++)
+    {
+        std::string file_name = "file_" + std::to_string(file) + ".mdp";
+        for(int i = 0; i < number_of_diagrams_per_file; i++)
+        {
+            container.AddDiagramFromFile(file_name, "/path/to/" + file_name, diagram);
+        }
+    }
+    auto end_of_the_insertion = std::chrono::steady_clock::now();
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(number_of_files * number_of_diagrams_per_file));
+
+    // Walking trough the whole model the same way as the views do and checking that the parent of every index is the index it was created from
+    std::size_t number_of_visited_elements = 0;
+    std::function<void(const QModelIndex&)> traverse = [&](const QModelIndex& parent_index)
+    {
+        while(container.canFetchMore(parent_index))
+        {
+            container.fetchMore(parent_index);
+        }
+        int number_of_rows = container.rowCount(parent_index);
+        for(int row = 0; row < number_of_rows; row++)
+        {
+            auto child_index = container.index(row, 0, parent_index);
+            ASSERT_TRUE(child_index.isValid());
+            ASSERT_EQ(child_index.row(), row);
+            ASSERT_EQ(container.parent(child_index), parent_index);
+            number_of_visited_elements++;
+            traverse(child_index);
+        }
+    };
+    auto start_of_the_traversal = std::chrono::steady_clock::now();
+    traverse(QModelIndex());
+    auto end_of_the_traversal = std::chrono::steady_clock::now();
+
+    // Two top level elements, the network connection has its empty element, then the files and their diagrams
+    EXPECT_EQ(number_of_visited_elements, std::size_t(2 + 1 + number_of_files + (number_of_files * number_of_diagrams_per_file)));
+
+    RecordProperty("InsertionTimeInMilliseconds", static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end_of_the_insertion - start_of_the_insertion).count()));
+    RecordProperty("TraversalTimeInMilliseconds", static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end_of_the_traversal - start_of_the_traversal).count()));
+}
+
+TEST(TestDiagramContainer, AddDiagramsFromFile_AddDiagramsFromNetwork)
+{
+    DiagramContainer container;
+    constexpr int number_of_diagrams = 2000;
+    std::vector<DiagramSpecialized> diagrams;
+    for(int i = 0; i < number_of_diagrams; i++)
+    {
+        diagrams.emplace_back("Diagram " + std::to_string(i), "AxisXTitle");
+    }
+
+    // Counting the insertion notifications below the parent of the diagrams
+    int number_of_insertions = 0;
+    int number_of_inserted_rows = 0;
+    QObject::connect(&container, &QAbstractItemModel::rowsInserted,
+                     [&](const QModelIndex& parent, int first, int last)
+                     {
+                         if(parent.isValid() && container.parent(parent).isValid())
+                         {
+                             number_of_insertions++;
+                             number_of_inserted_rows += (last - first + 1);
+                         }
+                     });
+
+    // All the diagrams are inserted with a single notification and they are moved into the container
+    // (Only the first part of the diagrams is exposed to the views, the rest needs to be fetched)
+    auto first_diagram_index = container.AddDiagramsFromFile("file.mdp", "/path/to/file.mdp", std::move(diagrams));
+    EXPECT_TRUE(diagrams.empty());
+    EXPECT_EQ(number_of_insertions, 1);
+    EXPECT_LT(number_of_inserted_rows, number_of_diagrams);
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(number_of_diagrams));
+    ASSERT_TRUE(first_diagram_index.isValid());
+    EXPECT_EQ(first_diagram_index.row(), 0);
+    EXPECT_EQ(container.GetDiagram(first_diagram_index)->GetTitle(), "Diagram 0");
+    auto file_index = container.parent(first_diagram_index);
+    while(container.canFetchMore(file_index))
+    {
+        container.fetchMore(file_index);
+    }
+    EXPECT_EQ(number_of_inserted_rows, number_of_diagrams);
+    EXPECT_EQ(container.rowCount(file_index), number_of_diagrams);
+
+    // The next batch is appended after the already stored diagrams
+    number_of_insertions = 0;
+    std::vector<DiagramSpecialized> next_diagrams(2, DiagramSpecialized("Next", "AxisXTitle"));
+    auto next_diagram_index = container.AddDiagramsFromFile("file.mdp", "/path/to/file.mdp", std::move(next_diagrams));
+    EXPECT_EQ(next_diagram_index.row(), number_of_diagrams);
+    EXPECT_EQ(number_of_insertions, 1);
+
+    // An empty batch does not create anything
+    EXPECT_FALSE(container.AddDiagramsFromNetwork("/dev/ttyACM0", std::vector<DiagramSpecialized>()).isValid());
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(number_of_diagrams + 2));
+}
+
+TEST(TestDiagramContainer, CheckStateNotifications_50kElements)
+{
+    DiagramContainer container;
+    constexpr int number_of_diagrams = 50000;
+    std::vector<DiagramSpecialized> diagrams(number_of_diagrams, DiagramSpecialized("Diagram", "AxisXTitle"));
+    auto first_diagram_index = container.AddDiagramsFromFile("file.mdp", "/path/to/file.mdp", std::move(diagrams));
+    auto file_index = container.parent(first_diagram_index);
+    auto files_index = container.parent(file_index);
+    container.ShowCheckBoxes();
+    while(container.canFetchMore(file_index))
+    {
+        container.fetchMore(file_index);
+    }
+
+    // Collecting the reported ranges, every range has to be below a single parent and has to contain only check state changes
+    std::vector<std::pair<QModelIndex, QModelIndex>> reported_ranges;
+    QObject::connect(&container, &QAbstractItemModel::dataChanged,
+                     [&](const QModelIndex& top_left, const QModelIndex& bottom_right, const QVector<int>& roles)
+                     {
+                         ASSERT_TRUE(top_left.isValid());
+                         ASSERT_EQ(container.parent(top_left), container.parent(bottom_right));
+                         ASSERT_EQ(roles.size(), 1);
+                         ASSERT_EQ(roles.front(), Qt::CheckStateRole);
+                         reported_ranges.emplace_back(top_left, bottom_right);
+                     });
+
+    // Checking the file: the diagrams below it are reported as one range, then the file and the files element
+    auto start_of_the_check = std::chrono::steady_clock::now();
+    EXPECT_TRUE(container.setData(file_index, QVariant(Qt::Checked), Qt::CheckStateRole));
+    auto end_of_the_check = std::chrono::steady_clock::now();
+    ASSERT_EQ(reported_ranges.size(), std::size_t(3));
+    EXPECT_EQ(container.data(container.index(number_of_diagrams - 1, 0, file_index), Qt::CheckStateRole).toInt(), int(Qt::Checked));
+    EXPECT_EQ(container.data(files_index, Qt::CheckStateRole).toInt(), int(Qt::Checked));
+    bool diagrams_were_reported = false;
+    for(const auto& range : reported_ranges)
+    {
+        if((file_index == container.parent(range.first)) && (0 == range.first.row()) && ((number_of_diagrams - 1) == range.second.row()))
+        {
+            diagrams_were_reported = true;
+        }
+    }
+    EXPECT_TRUE(diagrams_were_reported);
+
+    // Unchecking a single diagram only reports the diagram and its parents whose state has really changed
+    reported_ranges.clear();
+    auto diagram_index = container.index(number_of_diagrams / 2, 0, file_index);
+    EXPECT_TRUE(container.setData(diagram_index, QVariant(Qt::Unchecked), Qt::CheckStateRole));
+    ASSERT_EQ(reported_ranges.size(), std::size_t(3));
+    EXPECT_EQ(reported_ranges.front().first, reported_ranges.front().second);
+    EXPECT_EQ(container.data(file_index, Qt::CheckStateRole).toInt(), int(Qt::PartiallyChecked));
+
+    // Unchecking an other diagram does not change the state of the parents, so only the diagram is reported
+    reported_ranges.clear();
+    EXPECT_TRUE(container.setData(container.index(0, 0, file_index), QVariant(Qt::Unchecked), Qt::CheckStateRole));
+    ASSERT_EQ(reported_ranges.size(), std::size_t(1));
+    EXPECT_EQ(reported_ranges.front().first.row(), 0);
+
+    // Setting the same state again does not report anything
+    reported_ranges.clear();
+    EXPECT_TRUE(container.setData(diagram_index, QVariant(Qt::Unchecked), Qt::CheckStateRole));
+    EXPECT_TRUE(reported_ranges.empty());
+
+    RecordProperty("CheckTimeInMilliseconds", static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end_of_the_check - start_of_the_check).count()));
+}
+
+TEST(TestDiagramContainer, SetFilter_IsAcceptedByFilter_100kDiagrams)
+{
+    DiagramContainer container;
+    constexpr int number_of_files = 10;
+    constexpr int number_of_diagrams_per_file = 10000;
+    for(int file = 0; file < number_of_files; file++)
+    {
+        std::vector<DiagramSpecialized> diagrams;
+        diagrams.reserve(number_of_diagrams_per_file);
+        for(int i = 0; i < number_of_diagrams_per_file; i++)
+        {
+            diagrams.emplace_back("Test " + std::to_string((file * number_of_diagrams_per_file) + i), "Time");
+            diagrams.back().AddNewDataLine(((0 == (i % 1000)) ? "i16CurrentSetValue" : "u16Voltage"));
+        }
+        std::string file_name = "file_" + std::to_string(file) + ".mdp";
+        container.AddDiagramsFromFile(file_name, "/path/to/" + file_name, std::move(diagrams));
+    }
+    auto files_index = container.index(0, 0);
+    auto first_file_index = container.index(0, 0, files_index);
+    auto network_index = container.index(1, 0);
+
+    // Without a filter everything is accepted
+    EXPECT_TRUE(container.IsAcceptedByFilter(network_index));
+    EXPECT_TRUE(container.IsAcceptedByFilter(container.index(1, 0, first_file_index)));
+
+    // The diagrams can be found by the titles of their data lines, the elements above them are accepted as well
+    auto start_of_the_query = std::chrono::steady_clock::now();
+    EXPECT_EQ(container.SetFilter("CurrentSet"), std::size_t(number_of_files * number_of_diagrams_per_file / 1000));
+    auto end_of_the_query = std::chrono::steady_clock::now();
+    EXPECT_EQ(container.GetFilter(), "CurrentSet");
+    EXPECT_TRUE(container.IsAcceptedByFilter(files_index));
+    EXPECT_TRUE(container.IsAcceptedByFilter(first_file_index));
+    EXPECT_TRUE(container.IsAcceptedByFilter(container.index(1000, 0, first_file_index)));
+    EXPECT_FALSE(container.IsAcceptedByFilter(container.index(1001, 0, first_file_index)));
+    EXPECT_FALSE(container.IsAcceptedByFilter(network_index));
+
+    // The diagrams can be found by their titles
+    EXPECT_EQ(container.SetFilter("test 54321"), std::size_t(1));
+    EXPECT_TRUE(container.IsAcceptedByFilter(container.index(4321, 0, container.index(5, 0, files_index))));
+    EXPECT_FALSE(container.IsAcceptedByFilter(first_file_index));
+
+    // The new diagrams are checked against the active filter and the views are notified about their newly accepted parents
+    int number_of_changes = 0;
+    QObject::connect(&container, &QAbstractItemModel::dataChanged, [&](const QModelIndex&, const QModelIndex&, const QVector<int>&){number_of_changes++;});
+    auto network_diagram_index = container.AddDiagramFromNetwork("/dev/ttyACM0", DiagramSpecialized("Test 54321 again", "Time"));
+    EXPECT_TRUE(container.IsAcceptedByFilter(network_diagram_index));
+    EXPECT_TRUE(container.IsAcceptedByFilter(network_index));
+    EXPECT_EQ(number_of_changes, 2);
+
+    // Renaming a diagram updates the search index and the filter
+    container.setData(container.index(0, 0, first_file_index), QVariant(QString("Test 54321 renamed")), Qt::EditRole);
+    EXPECT_TRUE(container.IsAcceptedByFilter(container.index(0, 0, first_file_index)));
+    EXPECT_TRUE(container.IsAcceptedByFilter(first_file_index));
+    container.setData(container.index(0, 0, first_file_index), QVariant(QString("Renamed again")), Qt::EditRole);
+    EXPECT_FALSE(container.IsAcceptedByFilter(container.index(0, 0, first_file_index)));
+    EXPECT_EQ(container.SetFilter("renamed"), std::size_t(1));
+
+    // Clearing the filter accepts everything again
+    EXPECT_EQ(container.SetFilter(""), std::size_t(0));
+    EXPECT_TRUE(container.IsAcceptedByFilter(container.index(1001, 0, first_file_index)));
+
+    RecordProperty("QueryTimeInMicroseconds", static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(end_of_the_query - start_of_the_query).count()));
+}
+
+TEST(TestDiagramContainer, canFetchMore_fetchMore)
+{
+    DiagramContainer container;
+    constexpr int number_of_diagrams = 5000;
+    std::vector<DiagramSpecialized> diagrams(number_of_diagrams, DiagramSpecialized("Diagram", "AxisXTitle"));
+    auto first_diagram_index = container.AddDiagramsFromFile("file.mdp", "/path/to/file.mdp", std::move(diagrams));
+    auto file_index = container.parent(first_diagram_index);
+    auto files_index = container.parent(file_index);
+
+    // The top level elements and the file element are exposed completely
+    EXPECT_FALSE(container.canFetchMore(QModelIndex()));
+    EXPECT_FALSE(container.canFetchMore(files_index));
+    EXPECT_EQ(container.rowCount(files_index), 1);
+
+    // Only the first part of the diagrams is exposed, but the file can be expanded
+    int number_of_fetched_rows = container.rowCount(file_index);
+    EXPECT_GT(number_of_fetched_rows, 0);
+    EXPECT_LT(number_of_fetched_rows, number_of_diagrams);
+    EXPECT_TRUE(container.hasChildren(file_index));
+    EXPECT_TRUE(container.canFetchMore(file_index));
+    EXPECT_FALSE(container.index(number_of_fetched_rows, 0, file_index).isValid());
+
+    // The notifications are only sent about the rows that are known by the views
+    std::vector<std::pair<int, int>> inserted_rows;
+    QObject::connect(&container, &QAbstractItemModel::rowsInserted, [&](const QModelIndex&, int first, int last){inserted_rows.emplace_back(first, last);});
+    int last_changed_row = -1;
+    QObject::connect(&container, &QAbstractItemModel::dataChanged,
+                     [&](const QModelIndex& top_left, const QModelIndex& bottom_right, const QVector<int>&)
+                     {
+                         if(container.parent(top_left) == file_index)
+                         {
+                             last_changed_row = std::max(last_changed_row, bottom_right.row());
+                         }
+                     });
+    container.ShowCheckBoxes();
+    EXPECT_TRUE(container.setData(file_index, QVariant(Qt::Checked), Qt::CheckStateRole));
+    EXPECT_EQ(last_changed_row, (number_of_fetched_rows - 1));
+
+    // New diagrams are not exposed while the earlier diagrams were not fetched
+    container.AddDiagramFromFile("file.mdp", "/path/to/file.mdp", DiagramSpecialized("Diagram", "AxisXTitle"));
+    EXPECT_TRUE(inserted_rows.empty());
+    EXPECT_EQ(container.rowCount(file_index), number_of_fetched_rows);
+
+    // Fetching exposes the next rows with one insertion and the checked state was already set for them
+    container.fetchMore(file_index);
+    ASSERT_EQ(inserted_rows.size(), std::size_t(1));
+    EXPECT_EQ(inserted_rows.front().first, number_of_fetched_rows);
+    EXPECT_EQ(container.rowCount(file_index), (inserted_rows.front().second + 1));
+    EXPECT_EQ(container.data(container.index(inserted_rows.front().second, 0, file_index), Qt::CheckStateRole).toInt(), int(Qt::Checked));
+    while(container.canFetchMore(file_index))
+    {
+        container.fetchMore(file_index);
+    }
+    EXPECT_EQ(container.rowCount(file_index), (number_of_diagrams + 1));
+
+    // A filter exposes the matching diagrams even if they were not fetched yet
+    std::vector<DiagramSpecialized> more_diagrams(number_of_diagrams, DiagramSpecialized("Diagram", "AxisXTitle"));
+    more_diagrams.back().SetTitle("Needle");
+    container.AddDiagramsFromFile("other.mdp", "/path/to/other.mdp", std::move(more_diagrams));
+    auto other_file_index = container.index(1, 0, files_index);
+    EXPECT_LT(container.rowCount(other_file_index), number_of_diagrams);
+    EXPECT_EQ(container.SetFilter("needle"), std::size_t(1));
+    EXPECT_EQ(container.rowCount(other_file_index), number_of_diagrams);
+    EXPECT_TRUE(container.IsAcceptedByFilter(container.index((number_of_diagrams - 1), 0, other_file_index)));
+}
+
+TEST(TestDiagramContainer, PublishDiagrams_AddPublishedDiagrams)
+{
+    DiagramContainer container;
+    constexpr int number_of_threads = 4;
+    constexpr int number_of_batches_per_thread = 100;
+    constexpr int number_of_diagrams_per_batch = 10;
+
+    std::size_t number_of_added_diagrams = 0;
+    QObject::connect(&container, &DiagramContainer::PublishedDiagramsWereAdded,
+                     [&](const QModelIndex& first_new_diagram, const std::size_t& number_of_new_diagrams)
+                     {
+                         EXPECT_TRUE(first_new_diagram.isValid());
+                         number_of_added_diagrams += number_of_new_diagrams;
+                     });
+
+    // The threads publish their diagrams concurrently, the container is not changed until its own thread adds them
+    std::vector<std::thread> threads;
+    for(int thread_index = 0; thread_index < number_of_threads; thread_index++)
+    {
+        threads.emplace_back([&, thread_index]()
+        {
+            for(int batch = 0; batch < number_of_batches_per_thread; batch++)
+            {
+                std::vector<DiagramSpecialized> diagrams(number_of_diagrams_per_batch, DiagramSpecialized("Diagram", "AxisXTitle"));
+                if(0 == (thread_index % 2))
+                {
+                    container.PublishDiagramsFromNetwork(("/dev/ttyACM" + std::to_string(thread_index)), std::move(diagrams));
+                }
+                else
+                {
+                    std::string file_name = "file_" + std::to_string(thread_index) + ".mdp";
+                    container.PublishDiagramsFromFile(file_name, ("/path/to/" + file_name), std::move(diagrams));
+                }
+            }
+        });
+    }
+    for(auto& i : threads)
+    {
+        i.join();
+    }
+    constexpr std::size_t number_of_diagrams = number_of_threads * number_of_batches_per_thread * number_of_diagrams_per_batch;
+    EXPECT_EQ(container.GetNumberOfPublishedDiagrams(), number_of_diagrams);
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(0));
+
+    // Adding the published diagrams, every source gets its own element
+    container.AddPublishedDiagrams();
+    EXPECT_EQ(container.GetNumberOfPublishedDiagrams(), std::size_t(0));
+    EXPECT_EQ(container.GetNumberOfDiagrams(), number_of_diagrams);
+    EXPECT_EQ(number_of_added_diagrams, number_of_diagrams);
+    EXPECT_EQ(container.rowCount(container.index(0, 0)), (number_of_threads / 2));
+    EXPECT_EQ(container.rowCount(container.index(1, 0)), (number_of_threads / 2));
+
+    // Adding again does nothing, since every published diagram was already added
+    container.AddPublishedDiagrams();
+    EXPECT_EQ(container.GetNumberOfDiagrams(), number_of_diagrams);
+}
+
+TEST(TestDiagramContainer, AddDiagramsFromNetwork_SmallBatches)
+{
+    // A network connection adds one or a few diagrams per batch, the children of the connection must not be moved for every batch
+    DiagramContainer container;
+    constexpr int number_of_batches = 100000;
+    auto start_of_the_capture = std::chrono::high_resolution_clock::now();
+    for(int i = 0; i < number_of_batches; i++)
+    {
+        container.AddDiagramsFromNetwork("/dev/ttyACM0", std::vector<DiagramSpecialized>(1, DiagramSpecialized("Diagram", "AxisXTitle")));
+    }
+    auto end_of_the_capture = std::chrono::high_resolution_clock::now();
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(number_of_batches));
+
+    // With an exact reservation the capture would move about five billion pointers
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::seconds>(end_of_the_capture - start_of_the_capture).count(), 10);
+    RecordProperty("CaptureTimeInMilliseconds", static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end_of_the_capture - start_of_the_capture).count()));
+}
+
+TEST(TestDiagramContainer, RetentionPolicy_SetPinned)
+{
+    DiagramContainer container;
+    container.SetRetentionPolicy("/dev/ttyACM0", RetentionPolicy(100, 0, std::chrono::seconds(0)));
+    EXPECT_EQ(container.GetRetentionPolicy("/dev/ttyACM0"), RetentionPolicy(100, 0, std::chrono::seconds(0)));
+    EXPECT_TRUE(container.GetRetentionPolicy("/dev/ttyACM1").IsUnlimited());
+
+    // Only the rows that were exposed to the views are reported as removed
+    int number_of_removed_rows = 0;
+    QObject::connect(&container, &QAbstractItemModel::rowsRemoved, [&](const QModelIndex&, int first, int last){number_of_removed_rows += (last - first + 1);});
+
+    // Only the newest diagrams of a batch are kept if there are too many of them
+    std::vector<DiagramSpecialized> diagrams;
+    for(int i = 0; i < 1000; i++)
+    {
+        diagrams.emplace_back("Diagram " + std::to_string(i), "AxisXTitle");
+    }
+    auto first_diagram_index = container.AddDiagramsFromNetwork("/dev/ttyACM0", std::move(diagrams));
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(100));
+    ASSERT_TRUE(first_diagram_index.isValid());
+    EXPECT_EQ(first_diagram_index.row(), 0);
+    EXPECT_EQ(container.GetDiagram(first_diagram_index)->GetTitle(), "Diagram 900");
+    EXPECT_GT(number_of_removed_rows, 0);
+    EXPECT_LT(number_of_removed_rows, 900);
+
+    // The pinned and the checked diagrams are protected, only the diagrams can be pinned
+    // (The exposed diagrams were removed, so the remaining ones need to be fetched)
+    auto connection_index = container.parent(first_diagram_index);
+    while(container.canFetchMore(connection_index))
+    {
+        container.fetchMore(connection_index);
+    }
+    EXPECT_EQ(container.rowCount(connection_index), 100);
+    EXPECT_FALSE(container.SetPinned(connection_index, true));
+    EXPECT_TRUE(container.SetPinned(first_diagram_index, true));
+    EXPECT_TRUE(container.IsPinned(first_diagram_index));
+    EXPECT_EQ(container.data(first_diagram_index, Qt::DisplayRole).toString().toStdString(), "Diagram 900 (pinned)");
+    container.ShowCheckBoxes();
+    EXPECT_TRUE(container.setData(container.index(1, 0, connection_index), QVariant(Qt::Checked), Qt::CheckStateRole));
+    container.HideCheckBoxes();
+
+    // The next diagrams push out the oldest unprotected diagrams, the connection element remains partially checked
+    std::vector<DiagramSpecialized> new_diagrams;
+    for(int i = 0; i < 100; i++)
+    {
+        new_diagrams.emplace_back("New " + std::to_string(i), "AxisXTitle");
+    }
+    auto first_new_diagram_index = container.AddDiagramsFromNetwork("/dev/ttyACM0", std::move(new_diagrams));
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(100));
+    EXPECT_EQ(first_new_diagram_index.row(), 2);
+    EXPECT_EQ(container.GetDiagram(first_new_diagram_index)->GetTitle(), "New 2");
+    EXPECT_EQ(container.GetDiagram(container.index(0, 0, connection_index))->GetTitle(), "Diagram 900");
+    EXPECT_EQ(container.GetDiagram(container.index(1, 0, connection_index))->GetTitle(), "Diagram 901");
+    EXPECT_EQ(container.GetCheckedDiagrams().size(), std::size_t(1));
+
+    // The connections without a retention policy keep every diagram
+    container.AddDiagramsFromNetwork("/dev/ttyACM1", std::vector<DiagramSpecialized>(1000, DiagramSpecialized("Other", "AxisXTitle")));
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(1100));
+
+    // The maximum age is enforced periodically, only the protected diagrams remain
+    container.SetRetentionPolicy("/dev/ttyACM0", RetentionPolicy(0, 0, std::chrono::seconds(60)));
+    EXPECT_EQ(container.EnforceRetentionPolicies(std::chrono::steady_clock::now()), std::size_t(0));
+    EXPECT_EQ(container.EnforceRetentionPolicies(std::chrono::steady_clock::now() + std::chrono::minutes(2)), std::size_t(98));
+    EXPECT_EQ(container.GetNumberOfDiagrams(), std::size_t(1002));
+    EXPECT_EQ(container.rowCount(connection_index), 2);
+
+    // The memory usage of a connection stays below its limit during a long capture
+    constexpr std::size_t memory_limit = 1024 * 1024;
+    container.SetRetentionPolicy("/dev/ttyACM2", RetentionPolicy(0, memory_limit, std::chrono::seconds(0)));
+    QModelIndex last_diagram_index;
+    auto start_of_the_capture = std::chrono::high_resolution_clock::now();
+    for(int batch = 0; batch < 100; batch++)
+    {
+        DiagramSpecialized diagram("Capture", "AxisXTitle");
+        diagram.AddNewDataLine("Data");
+        for(int i = 0; i < 100; i++)
+        {
+            diagram.AddNewDataPoint(0, DataPointSpecialized(i, i));
+        }
+        last_diagram_index = container.AddDiagramsFromNetwork("/dev/ttyACM2", std::vector<DiagramSpecialized>(100, diagram));
+        ASSERT_TRUE(last_diagram_index.isValid());
+        EXPECT_LE(container.GetMemoryUsage(container.parent(last_diagram_index)), memory_limit);
+    }
+    auto end_of_the_capture = std::chrono::high_resolution_clock::now();
+    EXPECT_LT(container.rowCount(container.parent(last_diagram_index)), 10000);
+    RecordProperty("CaptureTimeInMilliseconds", static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end_of_the_capture - start_of_the_capture).count()));
+}
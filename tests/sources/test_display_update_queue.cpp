@@ -0,0 +1,153 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <vector>
+#include <cstddef>
+#include <chrono>
+
+#include <QObject>
+#include <QEvent>
+#include <QModelIndex>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/display_update_queue.hpp"
+#include "test_utilities.hpp"
+
+
+
+// The queued display is scheduled as a queued call on the context, so the context counts how often it was scheduled
+class DisplayContext : public QObject
+{
+public:
+    DisplayContext() : QObject(), number_of_queued_calls(0) {}
+
+    bool event(QEvent* event) override
+    {
+        if(QEvent::MetaCall == event->type())
+        {
+            ++number_of_queued_calls;
+        }
+        return QObject::event(event);
+    }
+
+    std::size_t number_of_queued_calls;
+};
+
+class TestDisplayUpdateQueue : public ::testing::Test
+{
+protected:
+    TestDisplayUpdateQueue() : display_update_queue(&context, [this](const DisplayUpdate& display_update){displayed_updates.push_back(display_update);}, 3) {}
+
+    void Push(const std::size_t& number_of_new_diagrams, const bool& container_was_empty = false)
+    {
+        display_update_queue.Push(DisplayUpdate(QModelIndex(), number_of_new_diagrams, container_was_empty));
+    }
+
+    std::vector<std::size_t> GetDisplayedNumbersOfDiagrams(void) const
+    {
+        std::vector<std::size_t> result;
+        for(const auto& i : displayed_updates)
+        {
+            result.push_back(i.number_of_new_diagrams);
+        }
+        return result;
+    }
+
+    DisplayContext context;
+    std::vector<DisplayUpdate> displayed_updates;
+    DisplayUpdateQueue display_update_queue;
+};
+
+TEST_F(TestDisplayUpdateQueue, Block)
+{
+    // Every update is displayed at once, nothing is queued or scheduled
+    EXPECT_EQ(display_update_queue.GetOverloadPolicy(), OverloadPolicy::Block);
+    Push(1);
+    Push(2);
+    EXPECT_THAT(GetDisplayedNumbersOfDiagrams(), ::testing::ElementsAre(1, 2));
+    EXPECT_EQ(display_update_queue.GetNumberOfQueuedUpdates(), std::size_t(0));
+    EXPECT_FALSE(display_update_queue.IsDisplayScheduled());
+
+    WaitFor([](){return false;}, std::chrono::seconds(1));
+    EXPECT_EQ(context.number_of_queued_calls, std::size_t(0));
+    EXPECT_EQ(display_update_queue.GetCounters().GetNumberOfDroppedElements(), std::size_t(0));
+}
+
+TEST_F(TestDisplayUpdateQueue, DropOldestDisplayUpdates)
+{
+    // The updates wait for the event loop, the oldest ones are dropped and counted when the queue is over its capacity
+    display_update_queue.SetOverloadPolicy(OverloadPolicy::DropOldestDisplayUpdates);
+    for(std::size_t i = 1; i <= 5; i++)
+    {
+        Push(i);
+    }
+    EXPECT_TRUE(displayed_updates.empty());
+    EXPECT_EQ(display_update_queue.GetNumberOfQueuedUpdates(), std::size_t(3));
+    EXPECT_EQ(display_update_queue.GetCounters().GetNumberOfDroppedElements(), std::size_t(2));
+    EXPECT_EQ(display_update_queue.GetCounters().GetDepth(), std::size_t(3));
+    EXPECT_EQ(display_update_queue.GetCounters().GetHighWaterMark(), std::size_t(3));
+
+    EXPECT_TRUE(WaitFor([&](){return (!displayed_updates.empty());}));
+    EXPECT_THAT(GetDisplayedNumbersOfDiagrams(), ::testing::ElementsAre(3, 4, 5));
+    EXPECT_EQ(display_update_queue.GetCounters().GetDepth(), std::size_t(0));
+    EXPECT_FALSE(display_update_queue.IsDisplayScheduled());
+}
+
+TEST_F(TestDisplayUpdateQueue, Coalesce)
+{
+    // The waiting updates are merged into the earliest one, so its first diagram and its store time are kept and the numbers are summed
+    display_update_queue.SetOverloadPolicy(OverloadPolicy::Coalesce);
+    Push(1, true);
+    auto first_store_time = std::chrono::steady_clock::now();
+    Push(2);
+    Push(3);
+    EXPECT_EQ(display_update_queue.GetNumberOfQueuedUpdates(), std::size_t(1));
+    EXPECT_EQ(display_update_queue.GetCounters().GetNumberOfDroppedElements(), std::size_t(2));
+
+    EXPECT_TRUE(WaitFor([&](){return (!displayed_updates.empty());}));
+    ASSERT_THAT(GetDisplayedNumbersOfDiagrams(), ::testing::ElementsAre(6));
+    EXPECT_TRUE(displayed_updates.front().container_was_empty);
+    EXPECT_LE(displayed_updates.front().store_time, first_store_time);
+}
+
+TEST_F(TestDisplayUpdateQueue, DisplayIsScheduledOnce)
+{
+    // The updates that arrive before the display only schedule it once
+    display_update_queue.SetOverloadPolicy(OverloadPolicy::DropOldestDisplayUpdates);
+    Push(1);
+    EXPECT_TRUE(display_update_queue.IsDisplayScheduled());
+    Push(2);
+    Push(3);
+
+    WaitFor([](){return false;}, std::chrono::seconds(1));
+    EXPECT_EQ(context.number_of_queued_calls, std::size_t(1));
+    EXPECT_THAT(GetDisplayedNumbersOfDiagrams(), ::testing::ElementsAre(1, 2, 3));
+
+    // An update after the display schedules the next one
+    Push(4);
+    EXPECT_TRUE(display_update_queue.IsDisplayScheduled());
+    EXPECT_TRUE(WaitFor([&](){return (4 == displayed_updates.size());}));
+    EXPECT_EQ(context.number_of_queued_calls, std::size_t(2));
+}
@@ -0,0 +1,298 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <iterator>
+#include <cstdio>
+
+#include <QCoreApplication>
+#include <QDir>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/file_replay_connection.hpp"
+#include "../application/sources/measurement_data_protocol.hpp"
+#include "test_utilities.hpp"
+
+
+
+static std::string GetTestFilePath(const std::string& file_name)
+{
+    QString test_files_path = QDir(QCoreApplication::applicationDirPath()).filePath("test_files");
+    return QDir(test_files_path).filePath(QString::fromStdString(file_name)).toStdString();
+}
+
+static std::string ReadFile(const std::string& file_path)
+{
+    std::ifstream file(file_path, std::ios::in | std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+TEST(TestFileReplayConnection, ParsePortName)
+{
+    FileReplayConnection::Options options;
+
+    ASSERT_TRUE(FileReplayConnection::ParsePortName("replay:///home/user/MotorTestOutput.txt", options));
+    EXPECT_EQ(options.file_path, "/home/user/MotorTestOutput.txt");
+    EXPECT_DOUBLE_EQ(options.speed, 1.0);
+    EXPECT_EQ(options.chunk_size_in_bytes, FileReplayConnection::default_chunk_size_in_bytes);
+    EXPECT_EQ(options.real_time_rate_in_bytes_per_second, std::size_t(SERIAL_PORT_DEFAULT_BAUDRATE / 10));
+
+    ASSERT_TRUE(FileReplayConnection::ParsePortName("replay://C:/recordings/bench 3.txt?speed=100x&chunk=4096&rate=20000", options));
+    EXPECT_EQ(options.file_path, "C:/recordings/bench 3.txt");
+    EXPECT_DOUBLE_EQ(options.speed, 100.0);
+    EXPECT_EQ(options.chunk_size_in_bytes, std::size_t(4096));
+    EXPECT_EQ(options.real_time_rate_in_bytes_per_second, std::size_t(20000));
+
+    ASSERT_TRUE(FileReplayConnection::ParsePortName("replay://file.txt?speed=max", options));
+    EXPECT_DOUBLE_EQ(options.speed, 0.0);
+    ASSERT_TRUE(FileReplayConnection::ParsePortName("replay://file.txt?speed=0.5", options));
+    EXPECT_DOUBLE_EQ(options.speed, 0.5);
+    ASSERT_TRUE(FileReplayConnection::ParsePortName("replay://file.txt?speed=realtime", options));
+    EXPECT_DOUBLE_EQ(options.speed, 1.0);
+}
+
+TEST(TestFileReplayConnection, ParsePortName_Invalid)
+{
+    FileReplayConnection::Options options;
+    options.file_path = "unchanged";
+
+    EXPECT_FALSE(FileReplayConnection::ParsePortName("/dev/ttyACM0", options));
+    EXPECT_FALSE(FileReplayConnection::ParsePortName("tcp://127.0.0.1:5000", options));
+    EXPECT_FALSE(FileReplayConnection::ParsePortName("replay://", options));
+    EXPECT_FALSE(FileReplayConnection::ParsePortName("replay://file.txt?speed=fast", options));
+    EXPECT_FALSE(FileReplayConnection::ParsePortName("replay://file.txt?speed=0", options));
+    EXPECT_FALSE(FileReplayConnection::ParsePortName("replay://file.txt?speed=-2x", options));
+    EXPECT_FALSE(FileReplayConnection::ParsePortName("replay://file.txt?chunk=0", options));
+    EXPECT_FALSE(FileReplayConnection::ParsePortName("replay://file.txt?chunk=1k", options));
+    EXPECT_FALSE(FileReplayConnection::ParsePortName("replay://file.txt?rate=", options));
+    EXPECT_FALSE(FileReplayConnection::ParsePortName("replay://file.txt?loop=1", options));
+    EXPECT_EQ(options.file_path, "unchanged");
+
+    // The invalid settings do not make the port name a serial port, the replay fails to open instead
+    EXPECT_TRUE(FileReplayConnection::IsFileReplayPortName("replay://file.txt?speed=fast"));
+    EXPECT_FALSE(FileReplayConnection::IsFileReplayPortName("/dev/ttyACM0"));
+    FileReplayConnection connection;
+    EXPECT_FALSE(connection.Open("replay://file.txt?speed=fast"));
+}
+
+TEST(TestFileReplayConnection, Replay_MaximumSpeed)
+{
+    std::string file_path = GetTestFilePath("MotorTestOutput.txt");
+    std::string expected_data = ReadFile(file_path);
+    ASSERT_FALSE(expected_data.empty());
+
+    // The odd chunk size splits the lines at different positions
+    FileReplayConnection connection;
+    EXPECT_FALSE(connection.Open("replay://" + GetTestFilePath("NotExistingFile.txt")));
+    ASSERT_TRUE(connection.Open("replay://" + file_path + "?speed=max&chunk=7"));
+
+    std::string received_data;
+    QObject::connect(&connection, &FileReplayConnection::DataReceived, [&](std::istream& data)
+    {
+        received_data.append(std::istreambuf_iterator<char>(data), std::istreambuf_iterator<char>());
+    });
+    ASSERT_TRUE(connection.StartListening());
+
+    EXPECT_TRUE(WaitFor([&](){return (expected_data == received_data);}));
+    EXPECT_TRUE(connection.IsReplayFinished());
+    EXPECT_EQ(connection.GetNumberOfReplayedBytes(), expected_data.size());
+
+    // A closed connection can replay the file again
+    connection.Close();
+    received_data.clear();
+    ASSERT_TRUE(connection.Open("replay://" + file_path + "?speed=max&chunk=4096"));
+    ASSERT_TRUE(connection.StartListening());
+    EXPECT_TRUE(WaitFor([&](){return (expected_data == received_data);}));
+}
+
+TEST(TestFileReplayConnection, Replay_Paced)
+{
+    std::string file_path = GetTestFilePath("MotorTestOutput.txt");
+    std::size_t file_size = ReadFile(file_path).size();
+
+    // The file would take a second at the given rate, at ten times the speed it takes a tenth of a second
+    FileReplayConnection connection;
+    ASSERT_TRUE(connection.Open("replay://" + file_path + "?speed=10x&chunk=512&rate=" + std::to_string(file_size)));
+    auto start_time = std::chrono::steady_clock::now();
+    ASSERT_TRUE(connection.StartListening());
+    ASSERT_TRUE(WaitFor([&](){return connection.IsReplayFinished();}));
+    auto elapsed_time = std::chrono::steady_clock::now() - start_time;
+
+    // The last chunk is sent when the bytes before it would have been transferred
+    std::size_t last_chunk_start = ((file_size - 1) / 512) * 512;
+    EXPECT_GE(elapsed_time, std::chrono::duration<double>((static_cast<double>(last_chunk_start) / static_cast<double>(file_size)) / 10.0));
+
+    // A slow replay can be closed before it finishes
+    FileReplayConnection slow_connection;
+    ASSERT_TRUE(slow_connection.Open("replay://" + file_path + "?chunk=1&rate=1"));
+    ASSERT_TRUE(slow_connection.StartListening());
+    start_time = std::chrono::steady_clock::now();
+    slow_connection.Close();
+    EXPECT_LT(std::chrono::steady_clock::now() - start_time, std::chrono::seconds(1));
+    EXPECT_FALSE(slow_connection.IsReplayFinished());
+}
+
+TEST(TestFileReplayConnection, Replay_DeliveryCoalescing)
+{
+    std::string file_path = GetTestFilePath("MotorTestOutput.txt");
+    std::string expected_data = ReadFile(file_path);
+    ASSERT_FALSE(expected_data.empty());
+
+    // The file is replayed in small chunks for a fifth of a second, first without and then with coalescing
+    std::size_t number_of_deliveries[2] = {0, 0};
+    std::chrono::steady_clock::duration replay_durations[2];
+    constexpr auto latency_budget = std::chrono::milliseconds(20);
+    for(std::size_t i = 0; i < 2; ++i)
+    {
+        FileReplayConnection connection;
+        connection.SetDataDeliveryCoalescing(((0 == i) ? std::chrono::milliseconds(0) : latency_budget), ((0 == i) ? 0 : (1024 * 1024)));
+        ASSERT_TRUE(connection.Open("replay://" + file_path + "?speed=realtime&chunk=16&rate=" + std::to_string(expected_data.size() * 5)));
+
+        std::string received_data;
+        QObject::connect(&connection, &FileReplayConnection::DataReceived, [&](std::istream& data)
+        {
+            received_data.append(std::istreambuf_iterator<char>(data), std::istreambuf_iterator<char>());
+            ++number_of_deliveries[i];
+        });
+        auto start_time = std::chrono::steady_clock::now();
+        ASSERT_TRUE(connection.StartListening());
+        EXPECT_TRUE(WaitFor([&](){return (expected_data == received_data);}));
+        replay_durations[i] = std::chrono::steady_clock::now() - start_time;
+    }
+
+    // The coalesced lines are delivered at most about once per latency budget, the last lines are delivered by the timer
+    EXPECT_LT(number_of_deliveries[1], number_of_deliveries[0]);
+    EXPECT_LE(number_of_deliveries[1], static_cast<std::size_t>(2 * (replay_durations[1] / latency_budget) + 2));
+    RecordProperty("NumberOfDeliveriesWithoutCoalescing", static_cast<int>(number_of_deliveries[0]));
+    RecordProperty("NumberOfDeliveriesWithCoalescing", static_cast<int>(number_of_deliveries[1]));
+}
+
+TEST(TestFileReplayConnection, Replay_MeasurementDataProtocol)
+{
+    // The replayed data is processed like the data of a real connection, it needs to result in the same diagrams as the file import
+    std::string file_path = GetTestFilePath("MotorTestOutput.txt");
+    MeasurementDataProtocol file_protocol;
+    std::ifstream file_stream(file_path);
+    auto diagrams_from_file = file_protocol.ProcessData(file_stream);
+    ASSERT_FALSE(diagrams_from_file.empty());
+
+    MeasurementDataProtocol replay_protocol;
+    std::vector<DiagramSpecialized> diagrams_from_replay;
+    FileReplayConnection connection;
+    QObject::connect(&connection, &FileReplayConnection::DataReceived, [&](std::istream& data)
+    {
+        auto new_diagrams = replay_protocol.ProcessData(data);
+        diagrams_from_replay.insert(diagrams_from_replay.end(), new_diagrams.begin(), new_diagrams.end());
+    });
+    ASSERT_TRUE(connection.Open("replay://" + file_path + "?speed=max&chunk=100"));
+    ASSERT_TRUE(connection.StartListening());
+    ASSERT_TRUE(WaitFor([&](){return (connection.IsReplayFinished() && (diagrams_from_file.size() == diagrams_from_replay.size()));}));
+
+    for(std::size_t i = 0; i < diagrams_from_file.size(); i++)
+    {
+        EXPECT_EQ(diagrams_from_replay[i].GetTitle(), diagrams_from_file[i].GetTitle());
+        EXPECT_EQ(diagrams_from_replay[i].GetTheNumberOfDataLines(), diagrams_from_file[i].GetTheNumberOfDataLines());
+        EXPECT_EQ(diagrams_from_replay[i].GetTheNumberOfDataPoints(0), diagrams_from_file[i].GetTheNumberOfDataPoints(0));
+    }
+}
+
+TEST(TestFileReplayConnection, Replay_CaptureJournal)
+{
+    // The raw data of a replay is captured into a journal, then the journal is replayed with its recorded pacing
+    std::string file_path = GetTestFilePath("MotorTestOutput.txt");
+    std::string expected_data = ReadFile(file_path);
+    std::vector<std::string> journal_file_paths;
+    {
+        CaptureJournal journal(QDir(QDir::tempPath()).filePath("rdb_replay_journal_test").toStdString(), 0, 0);
+        FileReplayConnection connection;
+        connection.SetCaptureJournal(&journal);
+        ASSERT_TRUE(connection.Open("replay://" + file_path + "?speed=10x&chunk=512&rate=" + std::to_string(expected_data.size())));
+        ASSERT_TRUE(connection.StartListening());
+        ASSERT_TRUE(WaitFor([&](){return connection.IsReplayFinished();}));
+        connection.Close();
+        journal.Flush();
+        journal_file_paths = journal.GetFilePaths();
+    }
+    ASSERT_EQ(journal_file_paths.size(), std::size_t(1));
+
+    std::string received_data;
+    FileReplayConnection connection;
+    QObject::connect(&connection, &FileReplayConnection::DataReceived, [&](std::istream& data)
+    {
+        received_data.append(std::istreambuf_iterator<char>(data), std::istreambuf_iterator<char>());
+    });
+    ASSERT_TRUE(connection.Open("replay://" + journal_file_paths.front() + "?speed=realtime"));
+    auto start_time = std::chrono::steady_clock::now();
+    ASSERT_TRUE(connection.StartListening());
+    EXPECT_TRUE(WaitFor([&](){return (connection.IsReplayFinished() && (expected_data == received_data));}));
+
+    // The recorded chunks were spread over a tenth of a second, the journal keeps their distances
+    EXPECT_GE(std::chrono::steady_clock::now() - start_time, std::chrono::milliseconds(80));
+    connection.Close();
+
+    for(const auto& journal_file_path : journal_file_paths)
+    {
+        std::remove(journal_file_path.c_str());
+    }
+}
+
+TEST(TestFileReplayConnection, Throughput)
+{
+    // A long recording is replayed as fast as possible through the parser, this shows how many times the real time the processing can take
+    std::string recording_path = QDir(QDir::tempPath()).filePath("rdb_replay_throughput_test.txt").toStdString();
+    {
+        std::ofstream recording(recording_path, std::ios::out | std::ios::binary);
+        recording << "<<<START>>>\n<Long recording>\ntime,current,voltage,\n";
+        for(int i = 0; i < 500000; i++)
+        {
+            recording << i << ",+" << (i % 1000) << ",-" << (i % 500) << ",\n";
+        }
+        recording << "<<<END>>>\n";
+    }
+    std::size_t recording_size = ReadFile(recording_path).size();
+
+    MeasurementDataProtocol replay_protocol;
+    std::size_t number_of_diagrams = 0;
+    FileReplayConnection connection;
+    QObject::connect(&connection, &FileReplayConnection::DataReceived, [&](std::istream& data)
+    {
+        number_of_diagrams += replay_protocol.ProcessData(data).size();
+    });
+
+    auto start_time = std::chrono::steady_clock::now();
+    ASSERT_TRUE(connection.Open("replay://" + recording_path + "?speed=max&chunk=4096"));
+    ASSERT_TRUE(connection.StartListening());
+    ASSERT_TRUE(WaitFor([&](){return (1 == number_of_diagrams);}, std::chrono::seconds(60)));
+    double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    connection.Close();
+    std::remove(recording_path.c_str());
+
+    double real_time_seconds = static_cast<double>(recording_size) / static_cast<double>(SERIAL_PORT_DEFAULT_BAUDRATE / 10);
+    RecordProperty("ThroughputInKilobytesPerSecond", static_cast<int>((static_cast<double>(recording_size) / 1024.0) / elapsed_seconds));
+    RecordProperty("SpeedUpComparedToTheSerialPort", static_cast<int>(real_time_seconds / elapsed_seconds));
+}
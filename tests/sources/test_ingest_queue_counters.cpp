@@ -0,0 +1,90 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/ingest_queue_counters.hpp"
+
+
+
+TEST(TestIngestQueueCounters, Depth_HighWaterMark)
+{
+    IngestQueueCounters counters(10);
+
+    EXPECT_EQ(counters.GetCapacity(), std::size_t(10));
+    EXPECT_FALSE(counters.IsFull());
+
+    counters.SetDepth(7);
+    counters.SetDepth(3);
+    EXPECT_EQ(counters.GetDepth(), std::size_t(3));
+    EXPECT_EQ(counters.GetHighWaterMark(), std::size_t(7));
+
+    // The depth can exceed the capacity, because the queues of the pipeline do not drop their data
+    counters.SetDepth(12);
+    EXPECT_TRUE(counters.IsFull());
+    EXPECT_EQ(counters.GetHighWaterMark(), std::size_t(12));
+}
+
+TEST(TestIngestQueueCounters, Drops_Stalls)
+{
+    IngestQueueCounters counters(4);
+
+    counters.CountDroppedElements(2);
+    counters.CountDroppedElements(1);
+    counters.AddStall(std::chrono::milliseconds(250));
+    counters.AddStall(std::chrono::milliseconds(500));
+
+    EXPECT_EQ(counters.GetNumberOfDroppedElements(), std::size_t(3));
+    EXPECT_EQ(counters.GetNumberOfStalls(), std::size_t(2));
+    EXPECT_EQ(counters.GetStallTime(), std::chrono::milliseconds(750));
+    EXPECT_EQ(counters.ToString(), "depth 0/4 (max 0), 3 dropped, 2 stalls for 0.750000 s");
+}
+
+TEST(TestIngestQueueCounters, ConcurrentHighWaterMark)
+{
+    IngestQueueCounters counters(1000);
+
+    std::vector<std::thread> producers;
+    for(std::size_t i = 0; i < 4; ++i)
+    {
+        producers.emplace_back([&counters, i]()
+        {
+            for(std::size_t j = 0; j < 1000; ++j)
+            {
+                counters.SetDepth((j * 4) + i);
+            }
+        });
+    }
+    for(auto& i : producers)
+    {
+        i.join();
+    }
+
+    EXPECT_EQ(counters.GetHighWaterMark(), std::size_t(3999));
+}
@@ -0,0 +1,115 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/latency_histogram.hpp"
+
+
+
+TEST(TestLatencyHistogram, Add_Buckets)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.GetNumberOfSamples(), std::size_t(0));
+    EXPECT_EQ(histogram.GetPercentile(0.5), std::chrono::nanoseconds(0));
+
+    // The bucket N counts the latencies below 2^N microseconds
+    histogram.Add(std::chrono::nanoseconds(500));
+    histogram.Add(std::chrono::microseconds(1));
+    histogram.Add(std::chrono::microseconds(3), 2);
+    histogram.Add(std::chrono::microseconds(-5));
+    EXPECT_EQ(histogram.GetNumberOfSamplesInBucket(0), std::size_t(2));
+    EXPECT_EQ(histogram.GetNumberOfSamplesInBucket(1), std::size_t(1));
+    EXPECT_EQ(histogram.GetNumberOfSamplesInBucket(2), std::size_t(2));
+    EXPECT_EQ(histogram.GetNumberOfSamples(), std::size_t(5));
+    EXPECT_EQ(histogram.GetMaximum(), std::chrono::microseconds(3));
+    EXPECT_EQ(histogram.GetMean(), std::chrono::nanoseconds(1500));
+
+    // The too long latencies are counted by the last bucket
+    histogram.Add(std::chrono::hours(2));
+    EXPECT_EQ(histogram.GetNumberOfSamplesInBucket(LatencyHistogram::number_of_buckets - 1), std::size_t(1));
+
+    histogram.Reset();
+    EXPECT_EQ(histogram.GetNumberOfSamples(), std::size_t(0));
+    EXPECT_EQ(histogram.GetMaximum(), std::chrono::nanoseconds(0));
+    EXPECT_EQ(histogram.GetNumberOfSamplesInBucket(LatencyHistogram::number_of_buckets - 1), std::size_t(0));
+}
+
+TEST(TestLatencyHistogram, GetPercentile)
+{
+    LatencyHistogram histogram;
+    histogram.Add(std::chrono::microseconds(100), 98);
+    histogram.Add(std::chrono::milliseconds(3));
+    histogram.Add(std::chrono::milliseconds(5));
+
+    EXPECT_EQ(histogram.GetPercentile(0.5), std::chrono::microseconds(128));
+    EXPECT_EQ(histogram.GetPercentile(0.99), std::chrono::microseconds(4096));
+    // The percentile is not more than the maximum
+    EXPECT_EQ(histogram.GetPercentile(1.0), std::chrono::milliseconds(5));
+}
+
+TEST(TestLatencyHistogram, ToString_Write)
+{
+    LatencyHistogram histogram;
+    histogram.Add(std::chrono::microseconds(1500), 3);
+    histogram.Add(std::chrono::microseconds(3000));
+
+    EXPECT_EQ(histogram.ToString(), "4 samples, mean 1.875000 ms, median < 2.048000 ms, 99th percentile < 2.048000 ms, maximum 3.000000 ms");
+
+    // Only the non-empty buckets are written
+    std::ostringstream output;
+    histogram.Write(output, "stage");
+    EXPECT_EQ(output.str(), "stage,2048,3\nstage,4096,1\n");
+}
+
+TEST(TestLatencyHistogram, ConcurrentAdd)
+{
+    LatencyHistogram histogram;
+
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&histogram, i]()
+        {
+            for(std::size_t j = 0; j < 1000; ++j)
+            {
+                histogram.Add(std::chrono::microseconds(i * 1000 + j));
+            }
+        });
+    }
+    for(auto& i : threads)
+    {
+        i.join();
+    }
+
+    EXPECT_EQ(histogram.GetNumberOfSamples(), std::size_t(4000));
+    EXPECT_EQ(histogram.GetMaximum(), std::chrono::microseconds(3999));
+    EXPECT_EQ(histogram.GetMean(), std::chrono::nanoseconds(1999500));
+}
@@ -0,0 +1,380 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <istream>
+#include <sstream>
+
+#include <QObject>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/network_handler.hpp"
+#include "../application/sources/diagram_container.hpp"
+#include "fake_network_connection.hpp"
+#include "test_utilities.hpp"
+
+
+
+// Creates a diagram for every "diagram <title>" line, waits on the "wait" lines until it is released and throws on the "throw" lines, the other lines are ignored
+// The calls of ProcessData that run at the same time are counted for every protocol and for all the protocols together
+class FakeProtocol : public DataProcessingInterface
+{
+public:
+    FakeProtocol() : DataProcessingInterface("Fake Protocol", ".fake"), waiting_is_released(false), number_of_active_calls(0), maximum_number_of_active_calls(0) {}
+
+    std::string GetProtocolName(void) override {return protocol_name;}
+    bool CanThisFileBeProcessed(const std::string) override {return false;}
+    std::string GetSupportedFileType(void) override {return native_file_extension;}
+    std::stringstream ExportData(const std::vector<DiagramSpecialized>&) override {return std::stringstream();}
+
+    std::vector<DiagramSpecialized> ProcessData(std::istream& input_data) override
+    {
+        std::vector<DiagramSpecialized> result;
+
+        RecordMaximum(maximum_number_of_active_calls, ++number_of_active_calls);
+        RecordMaximum(maximum_number_of_all_active_calls, ++number_of_all_active_calls);
+        std::string line;
+        try
+        {
+            while(std::getline(input_data, line))
+            {
+                if(0 == line.rfind("diagram ", 0))
+                {
+                    result.emplace_back(line.substr(std::char_traits<char>::length("diagram ")), "Time");
+                }
+                else if("wait" == line)
+                {
+                    while(!waiting_is_released)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+                else if("throw" == line)
+                {
+                    std::string errorMessage = "The fake protocol has thrown!";
+                    throw errorMessage;
+                }
+            }
+        }
+        catch(...)
+        {
+            --number_of_all_active_calls;
+            --number_of_active_calls;
+            throw;
+        }
+        --number_of_all_active_calls;
+        --number_of_active_calls;
+
+        return result;
+    }
+
+    void ReleaseWaiting(void) {waiting_is_released = true;}
+    std::size_t GetNumberOfActiveCalls(void) const {return number_of_active_calls;}
+    std::size_t GetMaximumNumberOfActiveCalls(void) const {return maximum_number_of_active_calls;}
+
+    static std::atomic<std::size_t> number_of_all_active_calls;
+    static std::atomic<std::size_t> maximum_number_of_all_active_calls;
+
+private:
+    static void RecordMaximum(std::atomic<std::size_t>& maximum, const std::size_t& value)
+    {
+        std::size_t current_maximum = maximum;
+        while((current_maximum < value) && (!maximum.compare_exchange_weak(current_maximum, value))) {}
+    }
+
+    std::atomic<bool> waiting_is_released;
+    std::atomic<std::size_t> number_of_active_calls;
+    std::atomic<std::size_t> maximum_number_of_active_calls;
+};
+
+std::atomic<std::size_t> FakeProtocol::number_of_all_active_calls(0);
+std::atomic<std::size_t> FakeProtocol::maximum_number_of_all_active_calls(0);
+
+// The test thread plays the thread of the connections and of the handlers, the diagrams are collected on the threads of the worker pool
+class TestNetworkHandler : public ::testing::Test
+{
+protected:
+    TestNetworkHandler() : worker_pool(4)
+    {
+        FakeProtocol::maximum_number_of_all_active_calls = 0;
+    }
+
+    NetworkHandler::diagram_collector_type CreateDiagramCollector(void)
+    {
+        return [this](const std::string port_name, std::vector<DiagramSpecialized>& diagrams)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for(const auto& i : diagrams)
+            {
+                collected_titles[port_name].push_back(i.GetTitle());
+            }
+        };
+    }
+
+    NetworkHandler::error_collector_type CreateErrorCollector(void)
+    {
+        return [this](const std::string& error_message){errors.push_back(error_message);};
+    }
+
+    std::vector<std::string> GetCollectedTitles(const std::string& port_name)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return collected_titles[port_name];
+    }
+
+    WorkerPool worker_pool;
+    std::mutex mutex;
+    std::map<std::string, std::vector<std::string> > collected_titles;
+    std::vector<std::string> errors;
+};
+
+TEST_F(TestNetworkHandler, Run_Stop)
+{
+    FakeNetworkConnection connection;
+    FakeProtocol protocol;
+    EXPECT_THROW(NetworkHandler(nullptr, &protocol, CreateDiagramCollector(), CreateErrorCollector()), std::string);
+    EXPECT_THROW(NetworkHandler(&connection, nullptr, CreateDiagramCollector(), CreateErrorCollector()), std::string);
+
+    // Without a worker pool the data is parsed on the thread of the connection
+    NetworkHandler network_handler(&connection, &protocol, CreateDiagramCollector(), CreateErrorCollector());
+    EXPECT_FALSE(network_handler.Run(""));
+    ASSERT_TRUE(network_handler.Run("fake0"));
+    connection.Deliver("diagram first\ndiagram second\n");
+    EXPECT_THAT(GetCollectedTitles("fake0"), ::testing::ElementsAre("first", "second"));
+
+    // The errors of the connection are reported until the handler is stopped
+    connection.ReportError("The connection has failed!");
+    network_handler.Stop();
+    EXPECT_FALSE(connection.IsOpen());
+    connection.ReportError("This is not reported.");
+    connection.Deliver("diagram third\n");
+    EXPECT_THAT(errors, ::testing::ElementsAre("The connection has failed!"));
+    EXPECT_THAT(GetCollectedTitles("fake0"), ::testing::ElementsAre("first", "second"));
+}
+
+TEST_F(TestNetworkHandler, ParallelParsing_OneTaskPerHandler)
+{
+    FakeNetworkConnection first_connection;
+    FakeNetworkConnection second_connection;
+    FakeProtocol first_protocol;
+    FakeProtocol second_protocol;
+    NetworkHandler first_network_handler(&first_connection, &first_protocol, CreateDiagramCollector(), CreateErrorCollector(), &worker_pool);
+    NetworkHandler second_network_handler(&second_connection, &second_protocol, CreateDiagramCollector(), CreateErrorCollector(), &worker_pool);
+    ASSERT_TRUE(first_network_handler.Run("fake0"));
+    ASSERT_TRUE(second_network_handler.Run("fake1"));
+
+    // The handlers are parsed in parallel, the data that arrives meanwhile waits for the running task instead of starting another one
+    first_connection.Deliver("diagram a1\nwait\n");
+    second_connection.Deliver("diagram b1\nwait\n");
+    ASSERT_TRUE(WaitFor([](){return (2 == FakeProtocol::number_of_all_active_calls);}));
+    for(int i = 2; i <= 100; i++)
+    {
+        first_connection.Deliver("diagram a" + std::to_string(i) + "\n");
+    }
+    second_connection.Deliver("diagram b2\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(first_protocol.GetNumberOfActiveCalls(), std::size_t(1));
+    EXPECT_EQ(second_protocol.GetNumberOfActiveCalls(), std::size_t(1));
+
+    first_protocol.ReleaseWaiting();
+    second_protocol.ReleaseWaiting();
+    ASSERT_TRUE(WaitFor([this](){return ((100 == GetCollectedTitles("fake0").size()) && (2 == GetCollectedTitles("fake1").size()));}));
+
+    // The diagrams of a handler are collected in the order of their arrival
+    auto first_titles = GetCollectedTitles("fake0");
+    for(std::size_t i = 0; i < first_titles.size(); i++)
+    {
+        EXPECT_EQ(first_titles[i], ("a" + std::to_string(i + 1)));
+    }
+    EXPECT_THAT(GetCollectedTitles("fake1"), ::testing::ElementsAre("b1", "b2"));
+    EXPECT_EQ(first_protocol.GetMaximumNumberOfActiveCalls(), std::size_t(1));
+    EXPECT_EQ(second_protocol.GetMaximumNumberOfActiveCalls(), std::size_t(1));
+    EXPECT_EQ(FakeProtocol::maximum_number_of_all_active_calls, std::size_t(2));
+    EXPECT_TRUE(errors.empty());
+}
+
+TEST_F(TestNetworkHandler, StorageQueueFull_ResumeParsing)
+{
+    FakeNetworkConnection connection;
+    FakeProtocol protocol;
+    IngestQueueCounters storage_queue_counters(1);
+    NetworkHandler network_handler(&connection, &protocol, CreateDiagramCollector(), CreateErrorCollector(), &worker_pool, &storage_queue_counters);
+    ASSERT_TRUE(network_handler.Run("fake0"));
+
+    // While the storage is full, the parsing is deferred and the data waits in the handler
+    storage_queue_counters.SetDepth(1);
+    connection.Deliver("diagram first\n");
+    connection.Deliver("diagram second\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(GetCollectedTitles("fake0").empty());
+
+    // The parsing is only resumed when the storage has room again
+    network_handler.ResumeParsing();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(GetCollectedTitles("fake0").empty());
+    storage_queue_counters.SetDepth(0);
+    network_handler.ResumeParsing();
+    ASSERT_TRUE(WaitFor([this](){return (2 == GetCollectedTitles("fake0").size());}));
+    EXPECT_THAT(GetCollectedTitles("fake0"), ::testing::ElementsAre("first", "second"));
+    EXPECT_EQ(storage_queue_counters.GetNumberOfStalls(), std::size_t(1));
+
+    // A resuming without a deferred parsing does nothing
+    network_handler.ResumeParsing();
+    EXPECT_EQ(storage_queue_counters.GetNumberOfStalls(), std::size_t(1));
+}
+
+TEST_F(TestNetworkHandler, ParseQueueFull_DataDeliveryPaused)
+{
+    FakeNetworkConnection connection;
+    FakeProtocol protocol;
+    NetworkHandler network_handler(&connection, &protocol, CreateDiagramCollector(), CreateErrorCollector(), &worker_pool);
+    ASSERT_TRUE(network_handler.Run("fake0"));
+
+    // The data that reaches the capacity of the parse queue while the parsing is busy pauses the delivery of the connection
+    connection.Deliver("wait\n");
+    ASSERT_TRUE(WaitFor([&protocol](){return (1 == protocol.GetNumberOfActiveCalls());}));
+    connection.Deliver("diagram before\n");
+    EXPECT_FALSE(connection.IsDataDeliveryPaused());
+    connection.Deliver(std::string(INGEST_PARSE_QUEUE_CAPACITY_IN_BYTES, 'x') + "\ndiagram after\n");
+    EXPECT_TRUE(connection.IsDataDeliveryPaused());
+    EXPECT_TRUE(network_handler.GetParseQueueCounters().IsFull());
+
+    // The parsing takes the pending data and resumes the delivery on the thread of the connection
+    protocol.ReleaseWaiting();
+    ASSERT_TRUE(WaitFor([&connection](){return (!connection.IsDataDeliveryPaused());}));
+    ASSERT_TRUE(WaitFor([this](){return (2 == GetCollectedTitles("fake0").size());}));
+    EXPECT_THAT(GetCollectedTitles("fake0"), ::testing::ElementsAre("before", "after"));
+    EXPECT_EQ(connection.GetNumberOfPauses(), std::size_t(1));
+    EXPECT_EQ(network_handler.GetParseQueueCounters().GetNumberOfStalls(), std::size_t(1));
+    EXPECT_FALSE(network_handler.GetParseQueueCounters().IsFull());
+}
+
+TEST_F(TestNetworkHandler, ProcessingError_Reported)
+{
+    FakeNetworkConnection connection;
+    FakeProtocol protocol;
+    NetworkHandler network_handler(&connection, &protocol, CreateDiagramCollector(), CreateErrorCollector(), &worker_pool);
+    ASSERT_TRUE(network_handler.Run("fake0"));
+
+    // The error of the protocol is reported on the thread of the handler and the parsing continues with the next data
+    connection.Deliver("throw\n");
+    ASSERT_TRUE(WaitFor([this](){return (!errors.empty());}));
+    EXPECT_THAT(errors, ::testing::ElementsAre("The data received on fake0 could not be processed: The fake protocol has thrown!"));
+    connection.Deliver("diagram after\n");
+    ASSERT_TRUE(WaitFor([this](){return (1 == GetCollectedTitles("fake0").size());}));
+    EXPECT_EQ(GetCollectedTitles("fake0").front(), "after");
+}
+
+TEST_F(TestNetworkHandler, Stop_TaskInFlight)
+{
+    FakeNetworkConnection connection;
+    FakeProtocol protocol;
+    NetworkHandler network_handler(&connection, &protocol, CreateDiagramCollector(), CreateErrorCollector(), &worker_pool);
+    ASSERT_TRUE(network_handler.Run("fake0"));
+
+    connection.Deliver("diagram first\nwait\n");
+    ASSERT_TRUE(WaitFor([&protocol](){return (1 == protocol.GetNumberOfActiveCalls());}));
+    connection.Deliver("diagram pending\n");
+
+    // The stopping waits for the running task, the data that was not taken by the task belongs to the closed connection
+    std::atomic<bool> network_handler_is_stopped(false);
+    std::thread stopper([&]()
+    {
+        network_handler.Stop();
+        network_handler_is_stopped = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(network_handler_is_stopped);
+    protocol.ReleaseWaiting();
+    stopper.join();
+    EXPECT_EQ(protocol.GetNumberOfActiveCalls(), std::size_t(0));
+    EXPECT_FALSE(connection.IsOpen());
+    EXPECT_THAT(GetCollectedTitles("fake0"), ::testing::ElementsAre("first"));
+    EXPECT_EQ(network_handler.GetParseQueueCounters().GetDepth(), std::size_t(0));
+}
+
+TEST_F(TestNetworkHandler, SeveralConnections_OwnElements)
+{
+    constexpr std::size_t number_of_connections = 3;
+    constexpr std::size_t number_of_diagrams_per_connection = 20;
+
+    // The handlers publish into the container from the worker pool like the backend, the container adds them on the test thread
+    DiagramContainer diagram_container;
+    FakeProtocol protocols[number_of_connections];
+    std::vector<std::unique_ptr<FakeNetworkConnection> > connections;
+    std::vector<std::unique_ptr<NetworkHandler> > network_handlers;
+    for(std::size_t i = 0; i < number_of_connections; i++)
+    {
+        connections.push_back(std::make_unique<FakeNetworkConnection>());
+        network_handlers.push_back(std::make_unique<NetworkHandler>(connections.back().get(), &protocols[i],
+                                                                    [&diagram_container](const std::string port_name, std::vector<DiagramSpecialized>& diagrams)
+                                                                    {
+                                                                        diagram_container.PublishDiagramsFromNetwork(port_name, std::move(diagrams));
+                                                                    },
+                                                                    CreateErrorCollector(), &worker_pool, &diagram_container.GetPublishedDiagramCounters()));
+        ASSERT_TRUE(network_handlers.back()->Run("fake" + std::to_string(i)));
+    }
+    for(std::size_t diagram_index = 0; diagram_index < number_of_diagrams_per_connection; diagram_index++)
+    {
+        for(std::size_t i = 0; i < number_of_connections; i++)
+        {
+            connections[i]->Deliver("diagram " + std::to_string(i) + "_" + std::to_string(diagram_index) + "\n");
+        }
+    }
+    ASSERT_TRUE(WaitFor([&](){return ((number_of_connections * number_of_diagrams_per_connection) == diagram_container.GetNumberOfPublishedDiagrams());}));
+    diagram_container.AddPublishedDiagrams();
+
+    // Every connection has its own element below the network element, with its diagrams in the order of their arrival
+    auto network_index = diagram_container.index(1, 0);
+    ASSERT_EQ(diagram_container.rowCount(network_index), static_cast<int>(number_of_connections));
+    std::set<std::string> connection_names;
+    for(int row = 0; row < static_cast<int>(number_of_connections); row++)
+    {
+        auto connection_index = diagram_container.index(row, 0, network_index);
+        std::string connection_name = diagram_container.data(connection_index, Qt::DisplayRole).toString().toStdString();
+        connection_names.insert(connection_name);
+        ASSERT_EQ(diagram_container.rowCount(connection_index), static_cast<int>(number_of_diagrams_per_connection));
+        for(int diagram_row = 0; diagram_row < static_cast<int>(number_of_diagrams_per_connection); diagram_row++)
+        {
+            EXPECT_EQ(diagram_container.GetDiagram(diagram_container.index(diagram_row, 0, connection_index))->GetTitle(),
+                      (connection_name.substr(std::char_traits<char>::length("fake")) + "_" + std::to_string(diagram_row)));
+        }
+    }
+    EXPECT_THAT(connection_names, ::testing::ElementsAre("fake0", "fake1", "fake2"));
+    EXPECT_TRUE(errors.empty());
+
+    // The handlers are stopped before the container is destroyed, like in the backend
+    for(auto& i : network_handlers)
+    {
+        i->Stop();
+    }
+}
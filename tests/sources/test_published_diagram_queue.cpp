@@ -0,0 +1,131 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/published_diagram_queue.hpp"
+
+
+
+TEST(TestPublishedDiagramQueue, Publish_TakeAll)
+{
+    int number_of_notifications = 0;
+    PublishedDiagramQueue queue([&](){++number_of_notifications;});
+
+    // Empty batches are ignored
+    queue.Publish(PublishedDiagramQueue::Batch("empty", "", false, std::vector<DiagramSpecialized>()));
+    EXPECT_EQ(number_of_notifications, 0);
+    EXPECT_TRUE(queue.TakeAll().empty());
+
+    // Only the first batch of a non-empty queue notifies the owner
+    queue.Publish(PublishedDiagramQueue::Batch("COM1", "", false, std::vector<DiagramSpecialized>(2, DiagramSpecialized("First"))));
+    queue.Publish(PublishedDiagramQueue::Batch("file.mdp", "/path/file.mdp", true, std::vector<DiagramSpecialized>(3, DiagramSpecialized("Second"))));
+    EXPECT_EQ(number_of_notifications, 1);
+    EXPECT_EQ(queue.GetNumberOfDiagrams(), 5);
+    EXPECT_EQ(queue.GetCounters().GetDepth(), 5);
+
+    auto batches = queue.TakeAll();
+    ASSERT_EQ(batches.size(), 2);
+    EXPECT_EQ(batches[0].source_name, "COM1");
+    EXPECT_FALSE(batches[0].is_from_file);
+    EXPECT_EQ(batches[0].diagrams.size(), 2);
+    EXPECT_EQ(batches[1].file_path, "/path/file.mdp");
+    EXPECT_TRUE(batches[1].is_from_file);
+    EXPECT_EQ(batches[1].diagrams.size(), 3);
+    EXPECT_LE(batches[0].publish_time, batches[1].publish_time);
+    EXPECT_EQ(queue.GetNumberOfDiagrams(), 0);
+    EXPECT_EQ(queue.GetCounters().GetDepth(), 0);
+    EXPECT_EQ(queue.GetCounters().GetHighWaterMark(), 5);
+
+    // After the queue was emptied, the next batch notifies again
+    queue.Publish(PublishedDiagramQueue::Batch("COM1", "", false, std::vector<DiagramSpecialized>(1, DiagramSpecialized("Third"))));
+    EXPECT_EQ(number_of_notifications, 2);
+}
+
+TEST(TestPublishedDiagramQueue, Capacity)
+{
+    // The publishing never drops, the publishers can see that the queue is full
+    PublishedDiagramQueue queue(PublishedDiagramQueue::notifier_type(), 4);
+    queue.Publish(PublishedDiagramQueue::Batch("COM1", "", false, std::vector<DiagramSpecialized>(3, DiagramSpecialized("First"))));
+    EXPECT_FALSE(queue.GetCounters().IsFull());
+    queue.Publish(PublishedDiagramQueue::Batch("COM1", "", false, std::vector<DiagramSpecialized>(3, DiagramSpecialized("Second"))));
+    EXPECT_TRUE(queue.GetCounters().IsFull());
+    EXPECT_EQ(queue.GetNumberOfDiagrams(), 6);
+
+    queue.TakeAll();
+    EXPECT_FALSE(queue.GetCounters().IsFull());
+}
+
+TEST(TestPublishedDiagramQueue, Publish_ConcurrentPublishers)
+{
+    constexpr std::size_t number_of_publishers = 4;
+    constexpr std::size_t batches_per_publisher = 1000;
+
+    std::atomic<std::size_t> number_of_notifications(0);
+    PublishedDiagramQueue queue([&](){++number_of_notifications;});
+
+    std::vector<std::thread> publishers;
+    for(std::size_t i = 0; i < number_of_publishers; ++i)
+    {
+        publishers.emplace_back([&queue, i]()
+        {
+            for(std::size_t j = 0; j < batches_per_publisher; ++j)
+            {
+                queue.Publish(PublishedDiagramQueue::Batch("COM" + std::to_string(i), "", false, std::vector<DiagramSpecialized>(1, DiagramSpecialized("Diagram"))));
+            }
+        });
+    }
+
+    // Taking the batches while they are published, no batch can be lost or taken twice
+    std::size_t number_of_taken_diagrams = 0;
+    std::size_t number_of_takes_with_data = 0;
+    while(number_of_taken_diagrams < (number_of_publishers * batches_per_publisher))
+    {
+        auto batches = queue.TakeAll();
+        if(!batches.empty())
+        {
+            ++number_of_takes_with_data;
+        }
+        for(const auto& i : batches)
+        {
+            number_of_taken_diagrams += i.diagrams.size();
+        }
+    }
+
+    for(auto& i : publishers)
+    {
+        i.join();
+    }
+
+    EXPECT_EQ(number_of_taken_diagrams, (number_of_publishers * batches_per_publisher));
+    EXPECT_TRUE(queue.TakeAll().empty());
+    // Every non-empty take was preceded by a notification
+    EXPECT_GE(number_of_notifications, number_of_takes_with_data);
+}
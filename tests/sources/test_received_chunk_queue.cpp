@@ -0,0 +1,333 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include <QDir>
+
+#include "../application/sources/received_chunk_queue.hpp"
+#include "allocation_counter.hpp"
+
+
+
+TEST(TestReceivedChunkQueue, Push_TakeChunks)
+{
+    ReceivedChunkQueue queue(4);
+    ReceivedDataBuffer received_data;
+
+    // Only the first chunk schedules the processing
+    std::string text = "first line\nsec";
+    auto chunk = queue.GetFreeChunk();
+    chunk.assign(text.begin(), text.end());
+    EXPECT_TRUE(queue.Push(chunk));
+    text = "ond line\n";
+    chunk = queue.GetFreeChunk();
+    chunk.assign(text.begin(), text.end());
+    EXPECT_FALSE(queue.Push(chunk));
+
+    queue.TakeChunks(received_data);
+    std::string line;
+    std::vector<std::string> lines;
+    auto& complete_lines = received_data.GetCompleteLines();
+    while(std::getline(complete_lines, line))
+    {
+        lines.push_back(line);
+    }
+    EXPECT_THAT(lines, ::testing::ElementsAre("first line", "second line"));
+
+    // The chunks were stamped with their receive time when they were pushed
+    EXPECT_NE(received_data.GetReceiveTime(), std::chrono::steady_clock::time_point());
+    EXPECT_LE(received_data.GetReceiveTime(), std::chrono::steady_clock::now());
+
+    // The memory of the taken chunks is given back, and the next chunk schedules the processing again
+    chunk = queue.GetFreeChunk();
+    EXPECT_NE(chunk.capacity(), std::size_t(0));
+    chunk.assign(5, 'x');
+    EXPECT_TRUE(queue.Push(chunk));
+}
+
+TEST(TestReceivedChunkQueue, Push_Full_Clear)
+{
+    ReceivedChunkQueue queue(2);
+    ReceivedDataBuffer received_data;
+
+    // A full queue only drops the chunk if the waiting was interrupted
+    queue.InterruptWaiting();
+    for(int i = 0; i < 3; i++)
+    {
+        std::vector<char> chunk(1, 'a');
+        queue.Push(chunk);
+    }
+    EXPECT_EQ(queue.GetNumberOfDroppedChunks(), std::size_t(1));
+    EXPECT_EQ(queue.GetHighWaterMark(), std::size_t(2));
+    EXPECT_EQ(queue.GetCounters().GetNumberOfDroppedElements(), std::size_t(1));
+    EXPECT_EQ(queue.GetCounters().GetDepth(), std::size_t(2));
+    EXPECT_TRUE(queue.GetCounters().IsFull());
+
+    // The cleared chunks are not taken, and the next chunk schedules the processing
+    queue.Clear();
+    queue.TakeChunks(received_data);
+    EXPECT_EQ(received_data.GetSize(), std::size_t(0));
+    std::vector<char> chunk(1, 'b');
+    EXPECT_TRUE(queue.Push(chunk));
+}
+
+TEST(TestReceivedChunkQueue, Push_WaitsForProcessing)
+{
+    ReceivedChunkQueue queue(2);
+    ReceivedDataBuffer received_data;
+
+    for(int i = 0; i < 2; i++)
+    {
+        std::vector<char> chunk(1, 'a');
+        queue.Push(chunk);
+    }
+
+    // The third chunk waits until the processing takes the first two, so nothing is dropped
+    std::thread producer([&]()
+    {
+        std::vector<char> chunk(1, 'b');
+        queue.Push(chunk);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.TakeChunks(received_data);
+    producer.join();
+    queue.TakeChunks(received_data);
+
+    EXPECT_EQ(received_data.GetSize(), std::size_t(3));
+    EXPECT_EQ(queue.GetNumberOfDroppedChunks(), std::size_t(0));
+    EXPECT_EQ(queue.GetCounters().GetNumberOfStalls(), std::size_t(1));
+    EXPECT_GE(queue.GetCounters().GetStallTime(), std::chrono::milliseconds(10));
+    EXPECT_EQ(queue.GetCounters().GetDepth(), std::size_t(0));
+
+    // The waiting of a closing connection can be interrupted
+    for(int i = 0; i < 2; i++)
+    {
+        std::vector<char> chunk(1, 'c');
+        queue.Push(chunk);
+    }
+    std::thread blocked_producer([&]()
+    {
+        std::vector<char> chunk(1, 'd');
+        queue.Push(chunk);
+    });
+    queue.InterruptWaiting();
+    blocked_producer.join();
+    EXPECT_EQ(queue.GetNumberOfDroppedChunks(), std::size_t(1));
+}
+
+TEST(TestReceivedChunkQueue, Push_WaitsForBytes)
+{
+    // The queue has room for many chunks, but not for their bytes
+    ReceivedChunkQueue queue(16, 100);
+    ReceivedDataBuffer received_data;
+
+    std::vector<char> first_chunk(60, 'a');
+    queue.Push(first_chunk);
+    EXPECT_EQ(queue.GetNumberOfQueuedBytes(), std::size_t(60));
+
+    // The second chunk would exceed the bytes, so it waits until the processing takes the first one
+    std::thread producer([&]()
+    {
+        std::vector<char> chunk(60, 'b');
+        queue.Push(chunk);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(queue.GetNumberOfQueuedChunks(), std::size_t(1));
+    queue.TakeChunks(received_data);
+    producer.join();
+    EXPECT_EQ(queue.GetNumberOfQueuedBytes(), std::size_t(60));
+    queue.TakeChunks(received_data);
+
+    EXPECT_EQ(received_data.GetSize(), std::size_t(120));
+    EXPECT_EQ(queue.GetNumberOfQueuedBytes(), std::size_t(0));
+    EXPECT_EQ(queue.GetNumberOfDroppedChunks(), std::size_t(0));
+    EXPECT_EQ(queue.GetCounters().GetNumberOfStalls(), std::size_t(1));
+
+    // A chunk that is larger than the capacity in bytes is queued if the queue is empty, so it can not wait forever
+    std::vector<char> large_chunk(1000, 'c');
+    queue.Push(large_chunk);
+    EXPECT_EQ(queue.GetNumberOfQueuedBytes(), std::size_t(1000));
+
+    // The interrupted waiting drops the chunk that did not fit into the bytes
+    queue.InterruptWaiting();
+    std::vector<char> dropped_chunk(1, 'd');
+    queue.Push(dropped_chunk);
+    EXPECT_EQ(queue.GetNumberOfDroppedChunks(), std::size_t(1));
+    queue.Clear();
+    EXPECT_EQ(queue.GetNumberOfQueuedBytes(), std::size_t(0));
+}
+
+TEST(TestReceivedChunkQueue, ReadPath_SteadyStateAllocations)
+{
+    // The read path of the connections: the I/O thread fills a free chunk and pushes it, the processing appends the chunks to the received data and discards the complete lines
+    // Allowed allocations: a chunk is allocated until the processed chunks come back through GetFreeChunk, a recycled chunk and the received data grow when a larger burst arrives than before
+    // After every chunk and the received data have held the largest burst, the read path must not allocate at all
+    // (The path runs on one thread here, so only its own allocations are counted)
+    constexpr std::size_t capacity = 8;
+    constexpr std::size_t chunks_per_processing = 4;
+    constexpr std::size_t largest_burst = 1000;
+    std::string data;
+    for(std::size_t i = 0; data.size() < (100 * largest_burst); i++)
+    {
+        data += std::to_string(i) + ",+" + std::to_string(i % 1000) + ",\n";
+    }
+
+    ReceivedChunkQueue queue(capacity);
+    ReceivedDataBuffer received_data(largest_burst);
+    std::size_t position = 0;
+    std::size_t number_of_received_bytes = 0;
+    auto receive = [&](const std::size_t& burst_size)
+    {
+        auto chunk = queue.GetFreeChunk();
+        chunk.resize(burst_size);
+        std::size_t copied_size = std::min(burst_size, (data.size() - position));
+        std::memcpy(chunk.data(), (data.data() + position), copied_size);
+        std::memcpy((chunk.data() + copied_size), data.data(), (burst_size - copied_size));
+        position = (position + burst_size) % data.size();
+        queue.Push(chunk);
+        number_of_received_bytes += burst_size;
+    };
+    auto process = [&]()
+    {
+        queue.TakeChunks(received_data);
+        if(received_data.HasCompleteLines())
+        {
+            received_data.DiscardCompleteLines();
+        }
+    };
+
+    // The warm-up: every chunk in the rotation holds the largest burst once
+    AllocationCounter allocation_counter;
+    for(std::size_t round = 0; round < (2 * capacity); round++)
+    {
+        for(std::size_t i = 0; i < chunks_per_processing; i++)
+        {
+            receive(largest_burst);
+        }
+        process();
+    }
+    EXPECT_GT(allocation_counter.GetNumberOfAllocations(), std::size_t(0));
+
+    // The steady state with bursts of different sizes
+    allocation_counter.Reset();
+    for(std::size_t round = 0; round < 10000; round++)
+    {
+        for(std::size_t i = 0; i < chunks_per_processing; i++)
+        {
+            receive(1 + ((round * 37 + i * 101) % largest_burst));
+        }
+        process();
+    }
+    EXPECT_EQ(allocation_counter.GetNumberOfAllocations(), std::size_t(0));
+    EXPECT_EQ(queue.GetNumberOfDroppedChunks(), std::size_t(0));
+    EXPECT_GT(number_of_received_bytes, (10000 * chunks_per_processing));
+}
+
+TEST(TestReceivedChunkQueue, Push_CaptureJournal)
+{
+    ReceivedChunkQueue queue(1);
+    std::vector<std::string> journal_file_paths;
+
+    {
+        CaptureJournal journal(QDir(QDir::tempPath()).filePath("rdb_received_chunk_queue_test").toStdString(), 0, 0);
+        queue.SetCaptureJournal(&journal);
+
+        // The chunk that is dropped by the full queue is still captured
+        queue.InterruptWaiting();
+        for(char character : {'a', 'b'})
+        {
+            std::vector<char> chunk(1, character);
+            queue.Push(chunk);
+        }
+        EXPECT_EQ(queue.GetNumberOfDroppedChunks(), std::size_t(1));
+
+        queue.SetCaptureJournal(nullptr);
+        std::vector<char> chunk(1, 'c');
+        queue.Push(chunk);
+
+        journal.Flush();
+        EXPECT_EQ(journal.GetNumberOfStoredBytes(), std::size_t(2));
+        journal_file_paths = journal.GetFilePaths();
+    }
+
+    for(const auto& file_path : journal_file_paths)
+    {
+        std::remove(file_path.c_str());
+    }
+}
+
+TEST(TestReceivedChunkQueue, Transfer)
+{
+    // Every processing that is scheduled by the producer takes the chunks, no chunk may remain without a scheduled processing
+    constexpr int number_of_chunks = 100000;
+    ReceivedChunkQueue queue(1024);
+    ReceivedDataBuffer received_data;
+    std::atomic<int> number_of_scheduled_processings(0);
+
+    std::thread producer([&]()
+    {
+        for(int i = 0; i < number_of_chunks; i++)
+        {
+            auto chunk = queue.GetFreeChunk();
+            chunk.assign(1, 'c');
+            if(queue.Push(chunk))
+            {
+                number_of_scheduled_processings++;
+            }
+            if(0 == (i % 512))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int number_of_executed_processings = 0;
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while(((received_data.GetSize() + queue.GetNumberOfDroppedChunks()) < static_cast<std::size_t>(number_of_chunks)) && (std::chrono::steady_clock::now() < timeout))
+    {
+        if(number_of_executed_processings < number_of_scheduled_processings.load())
+        {
+            number_of_executed_processings++;
+            queue.TakeChunks(received_data);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_EQ((received_data.GetSize() + queue.GetNumberOfDroppedChunks()), static_cast<std::size_t>(number_of_chunks));
+}
@@ -0,0 +1,264 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <chrono>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/received_data_buffer.hpp"
+#include "../application/sources/measurement_data_protocol.hpp"
+#include "allocation_counter.hpp"
+
+
+
+TEST(TestReceivedDataBuffer, Append_GetCompleteLines_DiscardCompleteLines)
+{
+    ReceivedDataBuffer received_data_buffer(64);
+    EXPECT_FALSE(received_data_buffer.HasCompleteLines());
+
+    // The incomplete line is not provided until its end arrives
+    std::string chunk = "first li";
+    received_data_buffer.Append(chunk.data(), chunk.size());
+    EXPECT_FALSE(received_data_buffer.HasCompleteLines());
+    chunk = "ne\nsecond line\nthi";
+    received_data_buffer.Append(chunk.data(), chunk.size());
+    ASSERT_TRUE(received_data_buffer.HasCompleteLines());
+
+    std::vector<std::string> lines;
+    std::string line;
+    auto& complete_lines = received_data_buffer.GetCompleteLines();
+    while(std::getline(complete_lines, line))
+    {
+        lines.push_back(line);
+    }
+    EXPECT_THAT(lines, ::testing::ElementsAre("first line", "second line"));
+
+    // The incomplete line remains in the buffer
+    received_data_buffer.DiscardCompleteLines();
+    EXPECT_FALSE(received_data_buffer.HasCompleteLines());
+    EXPECT_EQ(received_data_buffer.GetSize(), std::size_t(3));
+    chunk = "rd line\n";
+    received_data_buffer.Append(chunk.data(), chunk.size());
+    ASSERT_TRUE(received_data_buffer.HasCompleteLines());
+    EXPECT_TRUE(std::getline(received_data_buffer.GetCompleteLines(), line));
+    EXPECT_EQ(line, "third line");
+
+    received_data_buffer.Clear();
+    EXPECT_FALSE(received_data_buffer.HasCompleteLines());
+    EXPECT_EQ(received_data_buffer.GetSize(), std::size_t(0));
+}
+
+TEST(TestReceivedDataBuffer, Append_Stream)
+{
+    ReceivedDataBuffer received_data_buffer;
+
+    // The stream is longer than one read block, and its last line is incomplete
+    std::string received_data;
+    for(int i = 0; i < 1000; i++)
+    {
+        received_data += "line " + std::to_string(i) + "\n";
+    }
+    std::istringstream received_stream(received_data + "incomplete");
+    received_data_buffer.Append(received_stream);
+    EXPECT_EQ(received_data_buffer.GetSize(), (received_data.size() + std::string("incomplete").size()));
+    ASSERT_TRUE(received_data_buffer.HasCompleteLines());
+
+    std::string complete_lines((std::istreambuf_iterator<char>(received_data_buffer.GetCompleteLines())), std::istreambuf_iterator<char>());
+    EXPECT_EQ(complete_lines, received_data);
+
+    // The data of the next stream is appended to the incomplete line
+    std::istringstream next_received_stream(" line\n");
+    received_data_buffer.DiscardCompleteLines();
+    received_data_buffer.Append(next_received_stream);
+    std::string line;
+    EXPECT_TRUE(std::getline(received_data_buffer.GetCompleteLines(), line));
+    EXPECT_EQ(line, "incomplete line");
+}
+
+TEST(TestReceivedDataBuffer, GetReceiveTime)
+{
+    ReceivedDataBuffer received_data_buffer;
+    EXPECT_EQ(received_data_buffer.GetReceiveTime(), std::chrono::steady_clock::time_point());
+
+    // The buffer keeps the receive time of its oldest data
+    auto first_receive_time = std::chrono::steady_clock::time_point(std::chrono::seconds(10));
+    auto second_receive_time = std::chrono::steady_clock::time_point(std::chrono::seconds(11));
+    std::string chunk = "first line\nsec";
+    received_data_buffer.Append(chunk.data(), chunk.size(), first_receive_time);
+    chunk = "ond";
+    received_data_buffer.Append(chunk.data(), chunk.size(), second_receive_time);
+    EXPECT_EQ(received_data_buffer.GetReceiveTime(), first_receive_time);
+
+    // The incomplete line that remains gets the receive time of the newest data
+    received_data_buffer.DiscardCompleteLines();
+    EXPECT_EQ(received_data_buffer.GetReceiveTime(), second_receive_time);
+
+    // An empty buffer takes the receive time of the next data
+    chunk = " line\n";
+    std::istringstream received_stream(chunk);
+    auto third_receive_time = std::chrono::steady_clock::time_point(std::chrono::seconds(12));
+    received_data_buffer.Append(received_stream, third_receive_time);
+    received_data_buffer.DiscardCompleteLines();
+    EXPECT_EQ(received_data_buffer.GetReceiveTime(), std::chrono::steady_clock::time_point());
+    received_data_buffer.Append(chunk.data(), chunk.size(), third_receive_time);
+    EXPECT_EQ(received_data_buffer.GetReceiveTime(), third_receive_time);
+
+    received_data_buffer.Clear();
+    EXPECT_EQ(received_data_buffer.GetReceiveTime(), std::chrono::steady_clock::time_point());
+}
+
+TEST(TestReceivedDataBuffer, IsDeliveryDue)
+{
+    ReceivedDataBuffer received_data_buffer;
+    auto receive_time = std::chrono::steady_clock::time_point(std::chrono::seconds(10));
+
+    // Without coalescing the complete lines are due at once
+    std::string chunk = "first line\nsec";
+    EXPECT_FALSE(received_data_buffer.IsDeliveryDue(receive_time));
+    received_data_buffer.Append(chunk.data(), chunk.size(), receive_time);
+    EXPECT_EQ(received_data_buffer.GetSizeOfCompleteLines(), std::size_t(11));
+    EXPECT_TRUE(received_data_buffer.IsDeliveryDue(receive_time));
+
+    // The complete lines are due when the oldest data has waited for the latency budget
+    received_data_buffer.SetDeliveryCoalescing(std::chrono::milliseconds(5), 32);
+    EXPECT_FALSE(received_data_buffer.IsDeliveryDue(receive_time + std::chrono::milliseconds(2)));
+    EXPECT_EQ(received_data_buffer.GetTimeUntilDelivery(receive_time + std::chrono::milliseconds(2)), std::chrono::milliseconds(3));
+    EXPECT_TRUE(received_data_buffer.IsDeliveryDue(receive_time + std::chrono::milliseconds(5)));
+    EXPECT_EQ(received_data_buffer.GetTimeUntilDelivery(receive_time + std::chrono::milliseconds(7)), std::chrono::steady_clock::duration(0));
+
+    // Or when their size has reached the threshold
+    chunk = "ond line\nthird line\nfourth line\n";
+    received_data_buffer.Append(chunk.data(), chunk.size(), (receive_time + std::chrono::milliseconds(1)));
+    EXPECT_TRUE(received_data_buffer.IsDeliveryDue(receive_time + std::chrono::milliseconds(2)));
+
+    // The data without complete lines is never due
+    received_data_buffer.DiscardCompleteLines();
+    chunk = "incomplete";
+    received_data_buffer.Append(chunk.data(), chunk.size(), receive_time);
+    EXPECT_FALSE(received_data_buffer.IsDeliveryDue(receive_time + std::chrono::seconds(1)));
+}
+
+TEST(TestReceivedDataBuffer, MaximumLineLength)
+{
+    ReceivedDataBuffer received_data_buffer(0, 16);
+    EXPECT_EQ(received_data_buffer.GetLineCounters().GetCapacity(), std::size_t(16));
+
+    // A line that fits the maximum line length is kept until its end arrives
+    std::string chunk = "first line\n0123456789abcdef";
+    received_data_buffer.Append(chunk.data(), chunk.size());
+    EXPECT_EQ(received_data_buffer.GetLineCounters().GetDepth(), std::size_t(16));
+    EXPECT_EQ(received_data_buffer.GetLineCounters().GetNumberOfDroppedElements(), std::size_t(0));
+
+    // A longer one is dropped, but the complete lines before it are kept
+    chunk = "g";
+    received_data_buffer.Append(chunk.data(), chunk.size());
+    EXPECT_EQ(received_data_buffer.GetSize(), std::size_t(11));
+    EXPECT_EQ(received_data_buffer.GetLineCounters().GetDepth(), std::size_t(0));
+    EXPECT_EQ(received_data_buffer.GetLineCounters().GetNumberOfDroppedElements(), std::size_t(1));
+
+    // The rest of the dropped line is dropped too until its end, the lines after it are received again
+    chunk = std::string(100, 'x');
+    received_data_buffer.Append(chunk.data(), chunk.size());
+    EXPECT_EQ(received_data_buffer.GetSize(), std::size_t(11));
+    chunk = "xxx\nsecond line\nthi";
+    received_data_buffer.Append(chunk.data(), chunk.size());
+    EXPECT_EQ(received_data_buffer.GetLineCounters().GetNumberOfDroppedElements(), std::size_t(1));
+
+    std::vector<std::string> lines;
+    std::string line;
+    auto& complete_lines = received_data_buffer.GetCompleteLines();
+    while(std::getline(complete_lines, line))
+    {
+        lines.push_back(line);
+    }
+    EXPECT_THAT(lines, ::testing::ElementsAre("first line", "second line"));
+    received_data_buffer.DiscardCompleteLines();
+    EXPECT_EQ(received_data_buffer.GetLineCounters().GetDepth(), std::size_t(3));
+
+    // The stream is limited in the same way
+    std::istringstream received_stream("rd line\n" + std::string(5000, 'y'));
+    received_data_buffer.Append(received_stream);
+    EXPECT_TRUE(std::getline(received_data_buffer.GetCompleteLines(), line));
+    EXPECT_EQ(line, "third line");
+    EXPECT_EQ(received_data_buffer.GetLineCounters().GetNumberOfDroppedElements(), std::size_t(2));
+    EXPECT_EQ(received_data_buffer.GetLineCounters().GetHighWaterMark(), std::size_t(16));
+
+    // The clearing ends the dropping of the line
+    received_data_buffer.Clear();
+    chunk = "fourth line\n";
+    received_data_buffer.Append(chunk.data(), chunk.size());
+    EXPECT_EQ(received_data_buffer.GetSizeOfCompleteLines(), chunk.size());
+}
+
+TEST(TestReceivedDataBuffer, MeasurementDataProtocol_SteadyStateAllocations)
+{
+    // A long measurement session that is received in chunks whose boundaries do not match the lines
+    constexpr std::size_t number_of_data_lines = 200000;
+    constexpr std::size_t chunk_size = 1000;
+    std::string session = "<<<START>>>\n<Long measurement>\ntime,current,voltage,\n";
+    for(std::size_t i = 0; i < number_of_data_lines; i++)
+    {
+        session += std::to_string(i) + ",+" + std::to_string(i % 1000) + ",-" + std::to_string(i % 500) + ",\n";
+    }
+    session += "<<<END>>>\n";
+
+    ReceivedDataBuffer received_data_buffer(chunk_size);
+    MeasurementDataProtocol measurement_data_protocol;
+    std::vector<DiagramSpecialized> diagrams;
+    std::size_t number_of_chunks = 0;
+    AllocationCounter allocation_counter;
+    for(std::size_t position = 0; position < session.size(); position += chunk_size)
+    {
+        // The first chunks warm up the buffers
+        if(10 == number_of_chunks)
+        {
+            allocation_counter.Reset();
+        }
+
+        received_data_buffer.Append((session.data() + position), std::min(chunk_size, (session.size() - position)));
+        if(received_data_buffer.HasCompleteLines())
+        {
+            auto new_diagrams = measurement_data_protocol.ProcessData(received_data_buffer.GetCompleteLines());
+            received_data_buffer.DiscardCompleteLines();
+            for(auto& i : new_diagrams)
+            {
+                diagrams.push_back(std::move(i));
+            }
+        }
+        number_of_chunks++;
+    }
+    std::size_t number_of_steady_state_allocations = allocation_counter.GetNumberOfAllocations();
+
+    ASSERT_EQ(diagrams.size(), std::size_t(1));
+    EXPECT_EQ(diagrams.front().GetTheNumberOfDataPoints(0), number_of_data_lines);
+    EXPECT_EQ(diagrams.front().GetDataPoint(1, 1999).GetY(), -499);
+
+    // Only the growth of the data points and the assembled diagram allocate, the receiving and the parsing of the chunks do not
+    RecordProperty("NumberOfChunks", static_cast<int>(number_of_chunks));
+    RecordProperty("NumberOfAllocations", static_cast<int>(number_of_steady_state_allocations));
+    EXPECT_LT(number_of_steady_state_allocations, (number_of_chunks / 100));
+}
@@ -0,0 +1,145 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iterator>
+
+#include <QObject>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/received_data_delivery.hpp"
+#include "test_utilities.hpp"
+
+
+
+// The test thread plays both the I/O thread of the connection and the thread of the connection
+class TestReceivedDataDelivery : public ::testing::Test
+{
+protected:
+    TestReceivedDataDelivery() : received_data_delivery(&context, 16, 0,
+                                                        [this](std::istream& data){deliveries.emplace_back(std::istreambuf_iterator<char>(data), std::istreambuf_iterator<char>());},
+                                                        [this](const std::string& error_message){errors.push_back(error_message);})
+    {
+
+    }
+
+    void Push(const std::string& data)
+    {
+        auto chunk = received_data_delivery.GetFreeChunk();
+        chunk.assign(data.begin(), data.end());
+        received_data_delivery.Push(chunk);
+    }
+
+    QObject context;
+    std::vector<std::string> deliveries;
+    std::vector<std::string> errors;
+    ReceivedDataDelivery received_data_delivery;
+};
+
+TEST_F(TestReceivedDataDelivery, Delivery_AtOnce)
+{
+    // Without coalescing, the complete lines of every processing are delivered at once, the incomplete line waits for its end
+    Push("1,2\n3,");
+    received_data_delivery.ProcessReceivedChunks();
+    Push("4\n");
+    received_data_delivery.ProcessReceivedChunks();
+
+    EXPECT_THAT(deliveries, ::testing::ElementsAre("1,2\n", "3,4\n"));
+    EXPECT_TRUE(errors.empty());
+}
+
+TEST_F(TestReceivedDataDelivery, Delivery_Coalescing)
+{
+    // The lines of several chunks are held back until the latency budget elapses, then the timer delivers them together
+    received_data_delivery.SetDataDeliveryCoalescing(std::chrono::milliseconds(50), (1024 * 1024));
+    Push("1\n");
+    received_data_delivery.ProcessReceivedChunks();
+    Push("2\n");
+    received_data_delivery.ProcessReceivedChunks();
+    EXPECT_TRUE(deliveries.empty());
+
+    EXPECT_TRUE(WaitFor([&](){return (!deliveries.empty());}));
+    EXPECT_THAT(deliveries, ::testing::ElementsAre("1\n2\n"));
+}
+
+TEST_F(TestReceivedDataDelivery, Delivery_SizeThreshold)
+{
+    // The lines are delivered before their latency budget if their size has reached the threshold
+    received_data_delivery.SetDataDeliveryCoalescing(std::chrono::milliseconds(60 * 60 * 1000), 4);
+    Push("1\n");
+    received_data_delivery.ProcessReceivedChunks();
+    EXPECT_TRUE(deliveries.empty());
+    Push("2\n");
+    received_data_delivery.ProcessReceivedChunks();
+
+    EXPECT_THAT(deliveries, ::testing::ElementsAre("1\n2\n"));
+}
+
+TEST_F(TestReceivedDataDelivery, Delivery_Paused)
+{
+    // The chunks wait in the queue during the pause, they are delivered at once when the delivery is resumed
+    received_data_delivery.SetDataDeliveryPaused(true);
+    Push("1\n");
+    received_data_delivery.ProcessReceivedChunks();
+    EXPECT_TRUE(deliveries.empty());
+
+    received_data_delivery.SetDataDeliveryPaused(false);
+    EXPECT_THAT(deliveries, ::testing::ElementsAre("1\n"));
+}
+
+TEST_F(TestReceivedDataDelivery, Clear)
+{
+    // The data of a closed connection is not delivered, not even by the timer of the coalescing
+    received_data_delivery.SetDataDeliveryCoalescing(std::chrono::milliseconds(10), (1024 * 1024));
+    Push("1\n2");
+    received_data_delivery.ProcessReceivedChunks();
+    received_data_delivery.Clear();
+    WaitFor([](){return false;}, std::chrono::seconds(1));
+    EXPECT_TRUE(deliveries.empty());
+
+    received_data_delivery.SetDataDeliveryCoalescing(std::chrono::milliseconds(0), 0);
+    Push("3\n");
+    received_data_delivery.ProcessReceivedChunks();
+    EXPECT_THAT(deliveries, ::testing::ElementsAre("3\n"));
+}
+
+TEST_F(TestReceivedDataDelivery, TooLongLine_Reported)
+{
+    // A sender that does not end its lines can not fill the memory, the too long line is dropped and reported once
+    received_data_delivery.SetConnectionName("test connection");
+    Push(std::string((INGEST_MAX_LINE_LENGTH_IN_BYTES + 1), 'x'));
+    received_data_delivery.ProcessReceivedChunks();
+    EXPECT_EQ(received_data_delivery.GetLineCounters().GetNumberOfDroppedElements(), std::size_t(1));
+    ASSERT_EQ(errors.size(), std::size_t(1));
+    EXPECT_EQ(errors.front(), ("The test connection received a line that is longer than " + std::to_string(INGEST_MAX_LINE_LENGTH_IN_BYTES) + " bytes, 1 line was dropped!"));
+
+    // The lines after the end of the dropped line are delivered again
+    Push("xxx\n1\n");
+    received_data_delivery.ProcessReceivedChunks();
+    EXPECT_THAT(deliveries, ::testing::ElementsAre("1\n"));
+    EXPECT_EQ(errors.size(), std::size_t(1));
+}
@@ -0,0 +1,95 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+
+#include <string>
+#include <chrono>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/search_index.hpp"
+
+
+
+TEST(TestSearchIndex, Tokenize)
+{
+    EXPECT_THAT(SearchIndex<int>::Tokenize("Session 12: i16CurrentSetValue", false), ::testing::ElementsAre("session", "12", "i16currentsetvalue"));
+    EXPECT_THAT(SearchIndex<int>::Tokenize("i16CurrentSetValue", true), ::testing::ElementsAre("16currentsetvalue", "currentsetvalue", "setvalue", "value", "i16currentsetvalue"));
+    EXPECT_THAT(SearchIndex<int>::Tokenize("test_id", true), ::testing::ElementsAre("id", "test_id"));
+    EXPECT_TRUE(SearchIndex<int>::Tokenize(" ,;- ", true).empty());
+}
+
+TEST(TestSearchIndex, AddDocument_RemoveDocument_Search)
+{
+    SearchIndex<int> search_index;
+    search_index.AddDocument(1, {"Session 1", "Time", "i16CurrentSetValue"});
+    search_index.AddDocument(2, {"Session 2", "Time", "u16Voltage"});
+    search_index.AddDocument(3, {"Test T42", "Time", "i16CurrentSetValue", "i16CurrentActualValue"});
+    EXPECT_EQ(search_index.GetNumberOfDocuments(), std::size_t(3));
+
+    EXPECT_THAT(search_index.Search("i16CurrentSetValue"), ::testing::UnorderedElementsAre(1, 3));
+    EXPECT_THAT(search_index.Search("currentset"), ::testing::UnorderedElementsAre(1, 3));
+    EXPECT_THAT(search_index.Search("SESSION"), ::testing::UnorderedElementsAre(1, 2));
+    EXPECT_THAT(search_index.Search("session current"), ::testing::UnorderedElementsAre(1));
+    EXPECT_THAT(search_index.Search("T42"), ::testing::UnorderedElementsAre(3));
+    EXPECT_TRUE(search_index.Search("missing").empty());
+    EXPECT_TRUE(search_index.Search("").empty());
+    EXPECT_TRUE(search_index.IsMatching(3, "actual time"));
+    EXPECT_FALSE(search_index.IsMatching(2, "current"));
+    EXPECT_FALSE(search_index.IsMatching(4, "time"));
+
+    // Adding the document again replaces its texts
+    search_index.AddDocument(1, {"Renamed", "Time"});
+    EXPECT_THAT(search_index.Search("i16CurrentSetValue"), ::testing::UnorderedElementsAre(3));
+    EXPECT_THAT(search_index.Search("renamed"), ::testing::UnorderedElementsAre(1));
+
+    // The tokens that are not used by any document are removed from the index
+    auto number_of_tokens = search_index.GetNumberOfTokens();
+    search_index.RemoveDocument(2);
+    EXPECT_LT(search_index.GetNumberOfTokens(), number_of_tokens);
+    EXPECT_THAT(search_index.Search("time"), ::testing::UnorderedElementsAre(1, 3));
+    search_index.RemoveDocument(2);
+    EXPECT_EQ(search_index.GetNumberOfDocuments(), std::size_t(2));
+
+    search_index.Clear();
+    EXPECT_EQ(search_index.GetNumberOfTokens(), std::size_t(0));
+    EXPECT_TRUE(search_index.Search("time").empty());
+}
+
+TEST(TestSearchIndex, Search_100kDocuments)
+{
+    SearchIndex<int> search_index;
+    constexpr int number_of_documents = 100000;
+    for(int i = 0; i < number_of_documents; i++)
+    {
+        search_index.AddDocument(i, {"Test " + std::to_string(i), "Time", "i16CurrentSetValue", "u16Voltage"});
+    }
+
+    auto start_of_the_search = std::chrono::steady_clock::now();
+    auto result = search_index.Search("test 54321");
+    auto end_of_the_search = std::chrono::steady_clock::now();
+    EXPECT_THAT(result, ::testing::UnorderedElementsAre(54321));
+
+    RecordProperty("SearchTimeInMicroseconds", static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(end_of_the_search - start_of_the_search).count()));
+}
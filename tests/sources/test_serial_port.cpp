@@ -21,14 +21,193 @@
 
 
 
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+#include <QCoreApplication>
+
 #include <gtest/gtest.h>
 #include <gmock/gmock-matchers.h>
 
 #include "../application/sources/serial_port.hpp"
+#include "../application/sources/measurement_data_protocol.hpp"
+#include "test_utilities.hpp"
+#if defined(__linux__)
+#include "pty_serial_simulator.hpp"
+#endif
 
 
 
 TEST(TestSerialPort, Constructor)
 {
-    SerialPort myPort();
+    SerialPort myPort;
+}
+
+#if defined(__linux__)
+
+// Receives the traffic of a PtySerialSimulator with a SerialPort and parses it, like the Backend does with a real device
+// The latency of a diagram is measured from the writing of its end line to the end of its parsing
+class TestSerialPortEndToEnd : public ::testing::Test
+{
+protected:
+    void SetUp(void) override
+    {
+        ASSERT_TRUE(port.Open(simulator.GetSlavePath()));
+        QObject::connect(&port, &SerialPort::DataReceived, [this](std::istream& received_data)
+        {
+            auto diagrams = protocol.ProcessData(received_data);
+            auto parse_time = std::chrono::steady_clock::now();
+            for(const auto& diagram : diagrams)
+            {
+                CheckDiagram(diagram);
+                latencies.push_back(parse_time - simulator.GetWriteTimeOfDiagram(number_of_received_diagrams));
+                ++number_of_received_diagrams;
+            }
+        });
+        ASSERT_TRUE(port.StartListening());
+    }
+
+    void TearDown(void) override
+    {
+        // The port is closed before the simulator, so the pseudo-terminal is not removed while it is open
+        port.Close();
+        simulator.Stop();
+    }
+
+    void CheckDiagram(const DiagramSpecialized& diagram)
+    {
+        // Checking the last sample of every channel is enough to detect the lost and the corrupted lines, because every line changes the values
+        std::size_t last_line_index = options.number_of_lines_per_diagram - 1;
+        bool diagram_is_valid = ((diagram.GetTitle() == ("Simulated diagram " + std::to_string(number_of_received_diagrams))) &&
+                                 (diagram.GetTheNumberOfDataLines() == options.number_of_channels));
+        for(std::size_t channel_index = 0; diagram_is_valid && (channel_index < options.number_of_channels); ++channel_index)
+        {
+            diagram_is_valid = ((diagram.GetTheNumberOfDataPoints(channel_index) == options.number_of_lines_per_diagram) &&
+                                (diagram.GetDataPoint(channel_index, last_line_index).GetX() == static_cast<DataPointType>(last_line_index)) &&
+                                (diagram.GetDataPoint(channel_index, last_line_index).GetY() == static_cast<DataPointType>(PtySerialSimulator::GetExpectedValue(last_line_index, channel_index))));
+        }
+        if(!diagram_is_valid)
+        {
+            ++number_of_invalid_diagrams;
+        }
+        number_of_received_samples += options.number_of_channels * options.number_of_lines_per_diagram;
+    }
+
+    void ReportResults(const std::chrono::steady_clock::duration& duration)
+    {
+        double seconds = std::chrono::duration<double>(duration).count();
+        std::vector<std::chrono::steady_clock::duration> sorted_latencies = latencies;
+        std::sort(sorted_latencies.begin(), sorted_latencies.end());
+        auto latency_percentile = [&](const double& percentile)
+        {
+            std::size_t index = static_cast<std::size_t>(percentile * static_cast<double>(sorted_latencies.size() - 1));
+            return (sorted_latencies.empty() ? 0.0 : std::chrono::duration<double, std::micro>(sorted_latencies[index]).count());
+        };
+        RecordProperty("NumberOfDiagrams", static_cast<int>(number_of_received_diagrams));
+        RecordProperty("SamplesPerSecond", static_cast<int>(static_cast<double>(number_of_received_samples) / seconds));
+        RecordProperty("ThroughputInKilobytesPerSecond", static_cast<int>(static_cast<double>(simulator.GetNumberOfWrittenBytes()) / (1024.0 * seconds)));
+        RecordProperty("MedianLatencyInMicroseconds", static_cast<int>(latency_percentile(0.5)));
+        RecordProperty("Percentile99LatencyInMicroseconds", static_cast<int>(latency_percentile(0.99)));
+        RecordProperty("MaximumLatencyInMicroseconds", static_cast<int>(latency_percentile(1.0)));
+        RecordProperty("ResidentMemoryInKilobytes", static_cast<int>(PtySerialSimulator::GetResidentMemoryInBytes() / 1024));
+    }
+
+    PtySerialSimulator simulator;
+    PtySerialSimulator::Options options;
+    SerialPort port;
+    MeasurementDataProtocol protocol;
+    std::size_t number_of_received_diagrams = 0;
+    std::size_t number_of_received_samples = 0;
+    std::size_t number_of_invalid_diagrams = 0;
+    std::vector<std::chrono::steady_clock::duration> latencies;
+};
+
+TEST_F(TestSerialPortEndToEnd, MaximumSpeed)
+{
+    options.number_of_channels = 8;
+    options.number_of_lines_per_diagram = 2000;
+    options.number_of_diagrams = 50;
+
+    auto start_time = std::chrono::steady_clock::now();
+    simulator.Start(options);
+    EXPECT_TRUE(WaitFor([&](){return (options.number_of_diagrams == number_of_received_diagrams);}, std::chrono::seconds(60)));
+    ReportResults(std::chrono::steady_clock::now() - start_time);
+
+    EXPECT_TRUE(simulator.IsFinished());
+    EXPECT_EQ(number_of_invalid_diagrams, std::size_t(0));
+    EXPECT_EQ(port.GetNumberOfDroppedChunks(), std::size_t(0));
 }
+
+TEST_F(TestSerialPortEndToEnd, Paced)
+{
+    // The traffic of a device that sends 20000 lines per second in short measurements
+    options.number_of_channels = 4;
+    options.number_of_lines_per_diagram = 200;
+    options.number_of_diagrams = 100;
+    options.number_of_lines_per_second = 20000;
+
+    auto start_time = std::chrono::steady_clock::now();
+    simulator.Start(options);
+    EXPECT_TRUE(WaitFor([&](){return (options.number_of_diagrams == number_of_received_diagrams);}, std::chrono::seconds(60)));
+    ReportResults(std::chrono::steady_clock::now() - start_time);
+
+    // The receiving keeps up with this rate, so the diagrams are parsed shortly after they were sent
+    EXPECT_EQ(number_of_invalid_diagrams, std::size_t(0));
+    ASSERT_FALSE(latencies.empty());
+    EXPECT_LT(*std::max_element(latencies.begin(), latencies.end()), std::chrono::seconds(1));
+}
+
+// The soak test runs only if its duration is set in the RDB_SERIAL_PORT_SOAK_DURATION_IN_SECONDS environment variable, it can run for hours
+// The memory is sampled periodically, its growth after the warm-up is reported as a failure, because the parsed diagrams are not kept
+TEST_F(TestSerialPortEndToEnd, Soak)
+{
+    const char* soak_duration_setting = std::getenv("RDB_SERIAL_PORT_SOAK_DURATION_IN_SECONDS");
+    if(nullptr == soak_duration_setting)
+    {
+        GTEST_SKIP() << "Set RDB_SERIAL_PORT_SOAK_DURATION_IN_SECONDS to run the soak test";
+    }
+
+    auto soak_duration = std::chrono::seconds(std::strtoll(soak_duration_setting, nullptr, 10));
+    auto memory_sampling_period = std::max<std::chrono::steady_clock::duration>(std::chrono::seconds(1), (soak_duration / 100));
+    auto warm_up_duration = soak_duration / 10;
+
+    options.number_of_channels = 8;
+    options.number_of_lines_per_diagram = 1000;
+    options.number_of_diagrams = 0;
+    options.number_of_lines_per_second = 10000;
+
+    auto start_time = std::chrono::steady_clock::now();
+    auto next_memory_sample_time = start_time;
+    std::size_t memory_after_warm_up = 0;
+    std::size_t maximum_memory = 0;
+    simulator.Start(options);
+    while(std::chrono::steady_clock::now() < (start_time + soak_duration))
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        if(next_memory_sample_time <= std::chrono::steady_clock::now())
+        {
+            std::size_t memory = PtySerialSimulator::GetResidentMemoryInBytes();
+            if((0 == memory_after_warm_up) && ((start_time + warm_up_duration) <= std::chrono::steady_clock::now()))
+            {
+                memory_after_warm_up = memory;
+            }
+            maximum_memory = std::max(maximum_memory, memory);
+            next_memory_sample_time += memory_sampling_period;
+        }
+    }
+    simulator.Stop();
+    ReportResults(std::chrono::steady_clock::now() - start_time);
+
+    // A small growth is allowed, because the allocator does not return every freed page
+    std::size_t allowed_memory_growth = std::max<std::size_t>((16 * 1024 * 1024), (memory_after_warm_up / 10));
+    RecordProperty("ResidentMemoryAfterTheWarmUpInKilobytes", static_cast<int>(memory_after_warm_up / 1024));
+    RecordProperty("MaximumResidentMemoryInKilobytes", static_cast<int>(maximum_memory / 1024));
+    EXPECT_LE(maximum_memory, (memory_after_warm_up + allowed_memory_growth));
+    EXPECT_EQ(number_of_invalid_diagrams, std::size_t(0));
+    EXPECT_EQ(port.GetNumberOfDroppedChunks(), std::size_t(0));
+}
+
+#endif // __linux__
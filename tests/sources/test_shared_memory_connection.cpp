@@ -0,0 +1,142 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <chrono>
+#include <limits>
+#include <iterator>
+#include <thread>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/shared_memory_connection.hpp"
+#include "test_utilities.hpp"
+
+
+
+// The names of the shared memory objects are unique for the test process, so parallel test runs do not disturb each other
+static std::string CreateRingName(const std::string& test_name)
+{
+    return ("rdb_test_connection_" + test_name + "_" + std::to_string(getpid()));
+}
+
+TEST(TestSharedMemoryConnection, IsSharedMemoryPortName)
+{
+    EXPECT_TRUE(SharedMemoryConnection::IsSharedMemoryPortName("shm://rdb_monitor"));
+    EXPECT_FALSE(SharedMemoryConnection::IsSharedMemoryPortName("shm://"));
+    EXPECT_FALSE(SharedMemoryConnection::IsSharedMemoryPortName("tcp://127.0.0.1:5000"));
+    EXPECT_FALSE(SharedMemoryConnection::IsSharedMemoryPortName("/dev/ttyACM0"));
+}
+
+TEST(TestSharedMemoryConnection, Loopback)
+{
+    std::string name = CreateRingName("loopback");
+    SharedMemoryConnection connection;
+
+    // The ring needs to be created by the producer before the connection can be opened
+    EXPECT_FALSE(connection.Open("shm://" + name));
+    SharedMemoryRing producer;
+    ASSERT_TRUE(producer.Create(name, 4096));
+    ASSERT_TRUE(connection.Open("shm://" + name));
+    ASSERT_TRUE(connection.StartListening());
+    EXPECT_TRUE(producer.IsConsumerAttached());
+
+    std::string received_data;
+    QObject::connect(&connection, &SharedMemoryConnection::DataReceived, [&](std::istream& data)
+    {
+        received_data.append(std::istreambuf_iterator<char>(data), std::istreambuf_iterator<char>());
+    });
+
+    // The lines are split across the writes, only the complete lines are passed on
+    std::string first_part = "<<<START>>>\n<Loop";
+    std::string second_part = "back>\ntime,value,\n1,+2,\n3,+4";
+    producer.TryWrite(first_part.data(), first_part.size());
+    producer.TryWrite(second_part.data(), second_part.size());
+    ASSERT_TRUE(WaitFor([&](){return (std::string("<<<START>>>\n<Loopback>\ntime,value,\n1,+2,\n") == received_data);}));
+    producer.TryWrite(",\n", 2);
+    ASSERT_TRUE(WaitFor([&](){return (std::string("<<<START>>>\n<Loopback>\ntime,value,\n1,+2,\n3,+4,\n") == received_data);}));
+
+    // The data that was written before the producer has detached is still received, then the detaching is reported
+    std::string error_messages;
+    QObject::connect(&connection, &SharedMemoryConnection::ErrorReport, [&](const std::string& error_message){error_messages += error_message;});
+    producer.TryWrite("5,+6,\n", 6);
+    producer.Detach();
+    EXPECT_TRUE(WaitFor([&](){return (std::string("<<<START>>>\n<Loopback>\ntime,value,\n1,+2,\n3,+4,\n5,+6,\n") == received_data);}));
+    EXPECT_TRUE(WaitFor([&](){return (!error_messages.empty());}));
+
+    connection.Close();
+    EXPECT_FALSE(connection.IsOpen());
+}
+
+TEST(TestSharedMemoryConnection, Throughput)
+{
+    // A producer thread streams measurement data as fast as it can, the received data is only collected without parsing
+    constexpr std::size_t total_size_in_bytes = 512 * 1024 * 1024;
+    std::string name = CreateRingName("throughput");
+
+    std::string block;
+    for(int i = 0; block.size() < (64 * 1024); i++)
+    {
+        block += std::to_string(i) + ",+" + std::to_string(i % 1000) + ",-" + std::to_string(i % 500) + ",\n";
+    }
+
+    SharedMemoryRing producer;
+    ASSERT_TRUE(producer.Create(name));
+    SharedMemoryConnection connection;
+    ASSERT_TRUE(connection.Open("shm://" + name));
+    ASSERT_TRUE(connection.StartListening());
+
+    std::size_t number_of_received_bytes = 0;
+    QObject::connect(&connection, &SharedMemoryConnection::DataReceived, [&](std::istream& data)
+    {
+        data.ignore(std::numeric_limits<std::streamsize>::max());
+        number_of_received_bytes += static_cast<std::size_t>(data.gcount());
+    });
+
+    auto start_time = std::chrono::steady_clock::now();
+    std::size_t number_of_written_bytes = 0;
+    std::thread writer([&]()
+    {
+        bool writing_is_successful = true;
+        while(writing_is_successful && (number_of_written_bytes < total_size_in_bytes))
+        {
+            writing_is_successful = producer.Write(block.data(), block.size(), std::chrono::seconds(10));
+            number_of_written_bytes += block.size();
+        }
+    });
+    std::size_t expected_size_in_bytes = ((total_size_in_bytes + block.size() - 1) / block.size()) * block.size();
+    WaitFor([&](){return (expected_size_in_bytes <= number_of_received_bytes);}, std::chrono::seconds(60));
+    auto elapsed_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    writer.join();
+
+    EXPECT_EQ(number_of_written_bytes, expected_size_in_bytes);
+    EXPECT_EQ(number_of_received_bytes, expected_size_in_bytes);
+    EXPECT_EQ(connection.GetNumberOfReceivedBytes(), expected_size_in_bytes);
+    RecordProperty("ThroughputInKilobytesPerSecond", static_cast<int>((static_cast<double>(number_of_received_bytes) / 1024.0) / elapsed_time));
+    RecordProperty("NumberOfWakeUpsOfTheProducer", static_cast<int>(connection.GetNumberOfWakeUps()));
+    RecordProperty("NumberOfWakeUpsOfTheReaderThread", static_cast<int>(producer.GetNumberOfWakeUps()));
+    RecordProperty("HighWaterMarkOfTheReceivedChunks", static_cast<int>(connection.GetReceiveQueueCounters().GetHighWaterMark()));
+}
@@ -0,0 +1,284 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/shared_memory_ring.hpp"
+
+
+
+// The names of the shared memory objects are unique for the test process, so parallel test runs do not disturb each other
+static std::string CreateRingName(const std::string& test_name)
+{
+    return ("rdb_test_" + test_name + "_" + std::to_string(getpid()));
+}
+
+TEST(TestSharedMemoryRing, Create_Attach_Detach)
+{
+    std::string name = CreateRingName("create_attach_detach");
+    SharedMemoryRing producer;
+    SharedMemoryRing consumer;
+
+    // The ring needs to be created before the consumer can attach
+    EXPECT_FALSE(consumer.Attach(name));
+    EXPECT_FALSE(producer.Create(""));
+    EXPECT_FALSE(producer.Create("invalid/name"));
+    ASSERT_TRUE(producer.Create(name, 5000));
+    EXPECT_TRUE(producer.IsProducer());
+    EXPECT_EQ(producer.GetCapacity(), std::size_t(8192));
+    EXPECT_FALSE(producer.IsConsumerAttached());
+
+    ASSERT_TRUE(consumer.Attach(name));
+    EXPECT_FALSE(consumer.IsProducer());
+    EXPECT_EQ(consumer.GetCapacity(), std::size_t(8192));
+    EXPECT_TRUE(consumer.IsProducerAttached());
+    EXPECT_TRUE(producer.IsConsumerAttached());
+
+    // The ring has only one consumer
+    SharedMemoryRing second_consumer;
+    EXPECT_FALSE(second_consumer.Attach(name));
+
+    // The sides can only be used in their own direction
+    char buffer[16];
+    EXPECT_EQ(consumer.TryWrite("data", 4), std::size_t(0));
+    EXPECT_EQ(producer.TryRead(buffer, sizeof(buffer)), std::size_t(0));
+
+    consumer.Detach();
+    EXPECT_FALSE(consumer.IsAttached());
+    EXPECT_FALSE(producer.IsConsumerAttached());
+    EXPECT_TRUE(second_consumer.Attach(name));
+
+    // The object is removed when the producer detaches, the attached consumer keeps its mapping
+    producer.Detach();
+    EXPECT_FALSE(second_consumer.IsProducerAttached());
+    EXPECT_FALSE(consumer.Attach(name));
+}
+
+TEST(TestSharedMemoryRing, TryWrite_TryRead_WrapAround)
+{
+    std::string name = CreateRingName("wrap_around");
+    SharedMemoryRing producer;
+    SharedMemoryRing consumer;
+    ASSERT_TRUE(producer.Create(name, 4096));
+    ASSERT_TRUE(consumer.Attach(name));
+
+    // The sizes of the writes and the reads do not divide the capacity, so the data wraps around at every position
+    std::string written_data;
+    std::string read_data;
+    std::vector<char> buffer(1000);
+    for(std::size_t i = 0; written_data.size() < (20 * 4096); ++i)
+    {
+        std::string block(777, static_cast<char>('a' + (i % 26)));
+        block.back() = '\n';
+        ASSERT_EQ(producer.TryWrite(block.data(), block.size()), block.size());
+        written_data += block;
+
+        std::size_t number_of_read_bytes = consumer.TryRead(buffer.data(), buffer.size());
+        read_data.append(buffer.data(), number_of_read_bytes);
+    }
+    std::size_t number_of_read_bytes;
+    while(0 < (number_of_read_bytes = consumer.TryRead(buffer.data(), buffer.size())))
+    {
+        read_data.append(buffer.data(), number_of_read_bytes);
+    }
+    EXPECT_EQ(read_data, written_data);
+
+    // The producer can not overwrite the data that was not read yet
+    std::string too_long_data(5000, 'x');
+    EXPECT_EQ(producer.TryWrite(too_long_data.data(), too_long_data.size()), std::size_t(4096));
+    EXPECT_EQ(producer.TryWrite(too_long_data.data(), too_long_data.size()), std::size_t(0));
+    EXPECT_FALSE(producer.WaitForSpace(std::chrono::milliseconds(1)));
+    EXPECT_EQ(consumer.TryRead(buffer.data(), buffer.size()), buffer.size());
+    EXPECT_TRUE(producer.WaitForSpace(std::chrono::milliseconds(1)));
+
+    // Nobody was waiting, so the handover did not need a system call
+    EXPECT_EQ(producer.GetNumberOfWakeUps(), std::size_t(0));
+    EXPECT_EQ(consumer.GetNumberOfWakeUps(), std::size_t(0));
+}
+
+TEST(TestSharedMemoryRing, WaitForData_WaitForSpace)
+{
+    std::string name = CreateRingName("wait");
+    SharedMemoryRing producer;
+    SharedMemoryRing consumer;
+    ASSERT_TRUE(producer.Create(name, 4096));
+    ASSERT_TRUE(consumer.Attach(name));
+
+    // The consumer is woken up by the data long before its timeout
+    auto start_time = std::chrono::steady_clock::now();
+    std::thread writer([&producer]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        producer.TryWrite("line\n", 5);
+    });
+    bool data_has_arrived = false;
+    while((!data_has_arrived) && ((std::chrono::steady_clock::now() - start_time) < std::chrono::seconds(10)))
+    {
+        data_has_arrived = consumer.WaitForData(std::chrono::seconds(10));
+    }
+    writer.join();
+    EXPECT_TRUE(data_has_arrived);
+    EXPECT_LT((std::chrono::steady_clock::now() - start_time), std::chrono::seconds(5));
+
+    // The producer waits for the consumer while the ring is full
+    std::string data(4096, 'x');
+    std::vector<char> buffer(4096);
+    EXPECT_EQ(consumer.TryRead(buffer.data(), buffer.size()), std::size_t(5));
+    ASSERT_EQ(producer.TryWrite(data.data(), data.size()), data.size());
+    std::thread reader([&consumer, &buffer]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        consumer.TryRead(buffer.data(), buffer.size());
+    });
+    EXPECT_TRUE(producer.Write(data.data(), data.size(), std::chrono::seconds(10)));
+    reader.join();
+
+    // The waiting can be interrupted by the own process
+    std::thread interrupter([&producer]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        producer.InterruptWaiting();
+    });
+    start_time = std::chrono::steady_clock::now();
+    EXPECT_FALSE(producer.WaitForSpace(std::chrono::seconds(10)));
+    EXPECT_LT((std::chrono::steady_clock::now() - start_time), std::chrono::seconds(5));
+    interrupter.join();
+}
+
+TEST(TestSharedMemoryRing, ProducerDetach)
+{
+    std::string name = CreateRingName("producer_detach");
+    SharedMemoryRing consumer;
+    {
+        SharedMemoryRing producer;
+        ASSERT_TRUE(producer.Create(name, 4096));
+        ASSERT_TRUE(consumer.Attach(name));
+        producer.TryWrite("last line\n", 10);
+    }
+
+    // The data that was written before the detaching can still be read, then the waiting returns at once
+    char buffer[64];
+    EXPECT_FALSE(consumer.IsProducerAttached());
+    EXPECT_TRUE(consumer.WaitForData(std::chrono::seconds(10)));
+    EXPECT_EQ(std::string(buffer, consumer.TryRead(buffer, sizeof(buffer))), "last line\n");
+    auto start_time = std::chrono::steady_clock::now();
+    EXPECT_FALSE(consumer.WaitForData(std::chrono::seconds(10)));
+    EXPECT_LT((std::chrono::steady_clock::now() - start_time), std::chrono::seconds(1));
+}
+
+TEST(TestSharedMemoryRing, CorruptedWritePosition)
+{
+    std::string name = CreateRingName("corrupted");
+    SharedMemoryRing producer;
+    SharedMemoryRing consumer;
+    ASSERT_TRUE(producer.Create(name, 4096));
+    ASSERT_TRUE(consumer.Attach(name));
+    ASSERT_EQ(producer.TryWrite("line\n", 5), std::size_t(5));
+
+    // Another process overwrites the write position of the producer, it is on the second cache line of the header
+    int file_descriptor = shm_open(("/" + name).c_str(), O_RDWR, 0);
+    ASSERT_LE(0, file_descriptor);
+    void* mapping = mmap(nullptr, 4096, (PROT_READ | PROT_WRITE), MAP_SHARED, file_descriptor, 0);
+    close(file_descriptor);
+    ASSERT_NE(mapping, MAP_FAILED);
+    reinterpret_cast<std::atomic<uint64_t>*>(static_cast<char*>(mapping) + 64)->store(1000000);
+    munmap(mapping, 4096);
+
+    // The consumer does not read outside of the ring, it stops reading and releases its side
+    std::vector<char> buffer(1000000);
+    EXPECT_EQ(consumer.TryRead(buffer.data(), buffer.size()), std::size_t(0));
+    EXPECT_TRUE(consumer.IsCorrupted());
+    EXPECT_FALSE(producer.IsConsumerAttached());
+    EXPECT_FALSE(consumer.WaitForData(std::chrono::seconds(10)));
+    EXPECT_EQ(consumer.TryRead(buffer.data(), buffer.size()), std::size_t(0));
+
+    consumer.Detach();
+    EXPECT_FALSE(consumer.IsAttached());
+}
+
+TEST(TestSharedMemoryRing, Throughput)
+{
+    // The producer writes measurement data in batches like the reference producer, the consumer reads it in large chunks
+    constexpr std::size_t total_size_in_bytes = 1024 * 1024 * 1024;
+    std::string name = CreateRingName("throughput");
+    SharedMemoryRing producer;
+    SharedMemoryRing consumer;
+    ASSERT_TRUE(producer.Create(name));
+    ASSERT_TRUE(consumer.Attach(name));
+
+    std::string block;
+    for(int i = 0; block.size() < (64 * 1024); i++)
+    {
+        block += std::to_string(i) + ",+" + std::to_string(i % 1000) + ",-" + std::to_string(i % 500) + ",\n";
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+    std::thread writer([&]()
+    {
+        bool writing_is_successful = true;
+        for(std::size_t number_of_written_bytes = 0; writing_is_successful && (number_of_written_bytes < total_size_in_bytes); number_of_written_bytes += block.size())
+        {
+            writing_is_successful = producer.Write(block.data(), block.size(), std::chrono::seconds(10));
+        }
+    });
+
+    // The content is checked by the number of the line ends, so the checking does not slow down the reading much
+    std::size_t expected_size_in_bytes = ((total_size_in_bytes + block.size() - 1) / block.size()) * block.size();
+    std::size_t number_of_read_bytes = 0;
+    std::size_t number_of_line_ends = 0;
+    std::vector<char> buffer(SHARED_MEMORY_MAX_READ_LENGTH_IN_BYTES);
+    auto timeout = start_time + std::chrono::seconds(60);
+    while((number_of_read_bytes < expected_size_in_bytes) && (std::chrono::steady_clock::now() < timeout))
+    {
+        std::size_t size = consumer.TryRead(buffer.data(), buffer.size());
+        if(0 < size)
+        {
+            number_of_line_ends += static_cast<std::size_t>(std::count(buffer.begin(), (buffer.begin() + static_cast<std::ptrdiff_t>(size)), '\n'));
+            number_of_read_bytes += size;
+        }
+        else
+        {
+            consumer.WaitForData(std::chrono::milliseconds(100));
+        }
+    }
+    auto elapsed_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    writer.join();
+
+    EXPECT_EQ(number_of_read_bytes, expected_size_in_bytes);
+    EXPECT_EQ(number_of_line_ends, (expected_size_in_bytes / block.size()) * static_cast<std::size_t>(std::count(block.begin(), block.end(), '\n')));
+    RecordProperty("ThroughputInKilobytesPerSecond", static_cast<int>((static_cast<double>(number_of_read_bytes) / 1024.0) / elapsed_time));
+    RecordProperty("NumberOfWakeUpsOfTheConsumer", static_cast<int>(producer.GetNumberOfWakeUps()));
+    RecordProperty("NumberOfWakeUpsOfTheProducer", static_cast<int>(consumer.GetNumberOfWakeUps()));
+}
@@ -0,0 +1,73 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/socket_address.hpp"
+
+
+
+TEST(TestSocketAddress, Parse)
+{
+    SocketAddress address;
+
+    ASSERT_TRUE(SocketAddress::Parse("tcp://192.168.1.10:5000", "tcp://", address));
+    EXPECT_EQ(address.GetHost(), "192.168.1.10");
+    EXPECT_EQ(address.GetPort(), 5000);
+
+    ASSERT_TRUE(SocketAddress::Parse("tcp://bench-7.local:65535", "tcp://", address));
+    EXPECT_EQ(address.GetHost(), "bench-7.local");
+    EXPECT_EQ(address.GetPort(), 65535);
+
+    // The empty host means every local address, the port zero lets the operating system choose
+    ASSERT_TRUE(SocketAddress::Parse("udp://:0", "udp://", address));
+    EXPECT_EQ(address.GetHost(), "");
+    EXPECT_EQ(address.GetPort(), 0);
+
+    // The IPv6 hosts are written in brackets
+    ASSERT_TRUE(SocketAddress::Parse("udp://[::1]:6000", "udp://", address));
+    EXPECT_EQ(address.GetHost(), "::1");
+    EXPECT_EQ(address.GetPort(), 6000);
+}
+
+TEST(TestSocketAddress, Parse_Invalid)
+{
+    SocketAddress address("unchanged", 1);
+
+    EXPECT_FALSE(SocketAddress::Parse("/dev/ttyACM0", "tcp://", address));
+    EXPECT_FALSE(SocketAddress::Parse("COM3", "tcp://", address));
+    EXPECT_FALSE(SocketAddress::Parse("udp://127.0.0.1:5000", "tcp://", address));
+    EXPECT_FALSE(SocketAddress::Parse("tcp://127.0.0.1", "tcp://", address));
+    EXPECT_FALSE(SocketAddress::Parse("tcp://127.0.0.1:", "tcp://", address));
+    EXPECT_FALSE(SocketAddress::Parse("tcp://127.0.0.1:50a0", "tcp://", address));
+    EXPECT_FALSE(SocketAddress::Parse("tcp://127.0.0.1:-1", "tcp://", address));
+    EXPECT_FALSE(SocketAddress::Parse("tcp://127.0.0.1:65536", "tcp://", address));
+    EXPECT_FALSE(SocketAddress::Parse("tcp://127.0.0.1:123456", "tcp://", address));
+
+    // The address is only changed by a successful parsing
+    EXPECT_EQ(address.GetHost(), "unchanged");
+    EXPECT_EQ(address.GetPort(), 1);
+}
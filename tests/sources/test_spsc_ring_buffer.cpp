@@ -0,0 +1,117 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <thread>
+#include <chrono>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/spsc_ring_buffer.hpp"
+
+
+
+TEST(TestSpscRingBuffer, TryPush_TryPop)
+{
+    // The capacity is rounded up to a power of two
+    SpscRingBuffer<std::string> ring_buffer(3);
+    EXPECT_EQ(ring_buffer.GetCapacity(), std::size_t(4));
+    EXPECT_EQ(ring_buffer.GetSize(), std::size_t(0));
+
+    std::string element;
+    EXPECT_FALSE(ring_buffer.TryPop(element));
+
+    for(int i = 0; i < 4; i++)
+    {
+        element = "Chunk " + std::to_string(i);
+        EXPECT_TRUE(ring_buffer.TryPush(element));
+    }
+    EXPECT_EQ(ring_buffer.GetSize(), std::size_t(4));
+    EXPECT_EQ(ring_buffer.GetHighWaterMark(), std::size_t(4));
+
+    // A full buffer drops the new element and keeps it untouched
+    element = "Dropped";
+    EXPECT_FALSE(ring_buffer.TryPush(element));
+    EXPECT_EQ(element, "Dropped");
+    EXPECT_EQ(ring_buffer.GetNumberOfDroppedElements(), std::size_t(1));
+
+    // The elements are popped in the order they were pushed, also after wrapping around
+    EXPECT_TRUE(ring_buffer.TryPop(element));
+    EXPECT_EQ(element, "Chunk 0");
+    element = "Chunk 4";
+    EXPECT_TRUE(ring_buffer.TryPush(element));
+    for(int i = 1; i < 5; i++)
+    {
+        EXPECT_TRUE(ring_buffer.TryPop(element));
+        EXPECT_EQ(element, "Chunk " + std::to_string(i));
+    }
+    EXPECT_FALSE(ring_buffer.TryPop(element));
+    EXPECT_EQ(ring_buffer.GetSize(), std::size_t(0));
+    EXPECT_EQ(ring_buffer.GetHighWaterMark(), std::size_t(4));
+    EXPECT_EQ(ring_buffer.GetNumberOfDroppedElements(), std::size_t(1));
+}
+
+TEST(TestSpscRingBuffer, ProducerConsumer_1MElements)
+{
+    constexpr std::size_t number_of_elements = 1000000;
+    SpscRingBuffer<std::size_t> ring_buffer(1024);
+
+    // The producer retries the dropped elements, so every element needs to arrive in order
+    // (The threads yield when they can not proceed, the test machine might have fewer cores than threads)
+    auto start = std::chrono::high_resolution_clock::now();
+    std::thread producer([&]()
+    {
+        for(std::size_t i = 0; i < number_of_elements; i++)
+        {
+            std::size_t element = i;
+            while(!ring_buffer.TryPush(element))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::size_t expected_element = 0;
+    std::size_t element;
+    while(expected_element < number_of_elements)
+    {
+        if(ring_buffer.TryPop(element))
+        {
+            ASSERT_EQ(element, expected_element);
+            expected_element++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    auto elapsed = std::chrono::high_resolution_clock::now() - start;
+
+    EXPECT_EQ(ring_buffer.GetSize(), std::size_t(0));
+    EXPECT_LE(ring_buffer.GetHighWaterMark(), ring_buffer.GetCapacity());
+    RecordProperty("TransferTimeInMilliseconds", static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()));
+    RecordProperty("NumberOfRetriedPushes", static_cast<int>(ring_buffer.GetNumberOfDroppedElements()));
+    RecordProperty("HighWaterMark", static_cast<int>(ring_buffer.GetHighWaterMark()));
+}
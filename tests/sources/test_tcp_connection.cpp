@@ -0,0 +1,167 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <chrono>
+#include <limits>
+#include <iterator>
+
+#include <QCoreApplication>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/tcp_connection.hpp"
+#include "test_utilities.hpp"
+
+
+
+TEST(TestTcpConnection, IsTcpPortName)
+{
+    EXPECT_TRUE(TcpConnection::IsTcpPortName("tcp://127.0.0.1:5000"));
+    EXPECT_TRUE(TcpConnection::IsTcpPortName("tcp-server://:5000"));
+    EXPECT_FALSE(TcpConnection::IsTcpPortName("udp://127.0.0.1:5000"));
+    EXPECT_FALSE(TcpConnection::IsTcpPortName("/dev/ttyACM0"));
+}
+
+TEST(TestTcpConnection, Server_Loopback)
+{
+    TcpConnection connection;
+    EXPECT_FALSE(connection.Open("/dev/ttyACM0"));
+    ASSERT_TRUE(connection.Open("tcp-server://127.0.0.1:0"));
+    ASSERT_NE(connection.GetListeningPort(), 0);
+    ASSERT_TRUE(connection.StartListening());
+
+    std::string received_data;
+    QObject::connect(&connection, &TcpConnection::DataReceived, [&](std::istream& data)
+    {
+        received_data.append(std::istreambuf_iterator<char>(data), std::istreambuf_iterator<char>());
+    });
+
+    // The lines are split across the writes, only the complete lines are passed on
+    QTcpSocket client;
+    client.connectToHost(QHostAddress(QHostAddress::LocalHost), connection.GetListeningPort());
+    ASSERT_TRUE(client.waitForConnected(5000));
+    client.write("<<<START>>>\n<Loop");
+    client.write("back>\ntime,value,\n1,+2,\n3,+4");
+    ASSERT_TRUE(WaitFor([&](){return (std::string("<<<START>>>\n<Loopback>\ntime,value,\n1,+2,\n") == received_data);}));
+    client.write(",\n");
+    ASSERT_TRUE(WaitFor([&](){return (std::string("<<<START>>>\n<Loopback>\ntime,value,\n1,+2,\n3,+4,\n") == received_data);}));
+
+    // After the client has disconnected, the next client is served
+    std::string error_messages;
+    QObject::connect(&connection, &TcpConnection::ErrorReport, [&](const std::string& error_message){error_messages += error_message;});
+    client.disconnectFromHost();
+    ASSERT_TRUE(WaitFor([&](){return (!error_messages.empty());}));
+
+    QTcpSocket next_client;
+    next_client.connectToHost(QHostAddress(QHostAddress::LocalHost), connection.GetListeningPort());
+    ASSERT_TRUE(next_client.waitForConnected(5000));
+    next_client.write("5,+6,\n");
+    EXPECT_TRUE(WaitFor([&](){return (std::string("<<<START>>>\n<Loopback>\ntime,value,\n1,+2,\n3,+4,\n5,+6,\n") == received_data);}));
+
+    connection.Close();
+    EXPECT_FALSE(connection.IsOpen());
+    EXPECT_EQ(connection.GetListeningPort(), 0);
+}
+
+TEST(TestTcpConnection, Client_Loopback)
+{
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress(QHostAddress::LocalHost), 0));
+
+    // The connection is established by the operating system, so the opening does not need the event loop of the server
+    TcpConnection connection;
+    ASSERT_TRUE(connection.Open("tcp://127.0.0.1:" + std::to_string(server.serverPort())));
+    EXPECT_EQ(connection.GetListeningPort(), 0);
+    ASSERT_TRUE(connection.StartListening());
+    ASSERT_TRUE(server.waitForNewConnection(5000));
+    QTcpSocket* server_socket = server.nextPendingConnection();
+    ASSERT_NE(server_socket, nullptr);
+
+    std::string received_data;
+    QObject::connect(&connection, &TcpConnection::DataReceived, [&](std::istream& data)
+    {
+        received_data.append(std::istreambuf_iterator<char>(data), std::istreambuf_iterator<char>());
+    });
+
+    server_socket->write("first line\nsecond line\n");
+    EXPECT_TRUE(WaitFor([&](){return (std::string("first line\nsecond line\n") == received_data);}));
+
+    // Nobody listens on the port anymore
+    auto port = server.serverPort();
+    connection.Close();
+    server.close();
+    EXPECT_FALSE(connection.Open("tcp://127.0.0.1:" + std::to_string(port)));
+}
+
+TEST(TestTcpConnection, Throughput)
+{
+    // A local generator streams measurement data as fast as it can, the received data is only collected without parsing
+    constexpr std::size_t total_size_in_bytes = 128 * 1024 * 1024;
+    constexpr std::size_t maximum_bytes_waiting_for_write = 4 * 1024 * 1024;
+
+    std::string block;
+    for(int i = 0; block.size() < (64 * 1024); i++)
+    {
+        block += std::to_string(i) + ",+" + std::to_string(i % 1000) + ",-" + std::to_string(i % 500) + ",\n";
+    }
+
+    TcpConnection connection;
+    ASSERT_TRUE(connection.Open("tcp-server://127.0.0.1:0"));
+    ASSERT_TRUE(connection.StartListening());
+
+    std::size_t number_of_received_bytes = 0;
+    QObject::connect(&connection, &TcpConnection::DataReceived, [&](std::istream& data)
+    {
+        data.ignore(std::numeric_limits<std::streamsize>::max());
+        number_of_received_bytes += static_cast<std::size_t>(data.gcount());
+    });
+
+    QTcpSocket generator;
+    generator.connectToHost(QHostAddress(QHostAddress::LocalHost), connection.GetListeningPort());
+    ASSERT_TRUE(generator.waitForConnected(5000));
+
+    auto start_time = std::chrono::steady_clock::now();
+    std::size_t number_of_written_bytes = 0;
+    auto timeout = start_time + std::chrono::seconds(60);
+    while(((number_of_received_bytes < number_of_written_bytes) || (number_of_written_bytes < total_size_in_bytes)) && (std::chrono::steady_clock::now() < timeout))
+    {
+        // The generator is kept a few megabytes ahead, so its buffer does not grow with the whole stream
+        while((number_of_written_bytes < total_size_in_bytes) && (static_cast<std::size_t>(generator.bytesToWrite()) < maximum_bytes_waiting_for_write))
+        {
+            generator.write(block.data(), static_cast<qint64>(block.size()));
+            number_of_written_bytes += block.size();
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+    }
+    auto elapsed_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    EXPECT_EQ(number_of_received_bytes, number_of_written_bytes);
+    EXPECT_EQ(connection.GetNumberOfDroppedChunks(), std::size_t(0));
+    RecordProperty("ThroughputInKilobytesPerSecond", static_cast<int>((static_cast<double>(number_of_received_bytes) / 1024.0) / elapsed_time));
+    RecordProperty("HighWaterMarkOfTheReceivedChunks", static_cast<int>(connection.GetHighWaterMarkOfReceivedChunks()));
+}
@@ -0,0 +1,74 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <string>
+#include <chrono>
+#include <iterator>
+
+#include <QUdpSocket>
+#include <QHostAddress>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/udp_connection.hpp"
+#include "test_utilities.hpp"
+
+
+
+TEST(TestUdpConnection, IsUdpPortName)
+{
+    EXPECT_TRUE(UdpConnection::IsUdpPortName("udp://127.0.0.1:5000"));
+    EXPECT_TRUE(UdpConnection::IsUdpPortName("udp://:5000"));
+    EXPECT_FALSE(UdpConnection::IsUdpPortName("tcp://127.0.0.1:5000"));
+    EXPECT_FALSE(UdpConnection::IsUdpPortName("COM3"));
+}
+
+TEST(TestUdpConnection, Loopback)
+{
+    UdpConnection connection;
+    ASSERT_TRUE(connection.Open("udp://127.0.0.1:0"));
+    ASSERT_NE(connection.GetListeningPort(), 0);
+    ASSERT_TRUE(connection.StartListening());
+
+    std::string received_data;
+    QObject::connect(&connection, &UdpConnection::DataReceived, [&](std::istream& data)
+    {
+        received_data.append(std::istreambuf_iterator<char>(data), std::istreambuf_iterator<char>());
+    });
+
+    // The content of the datagrams is one stream, so a line can be split across the datagrams
+    QUdpSocket sender;
+    QHostAddress local_host(QHostAddress::LocalHost);
+    sender.writeDatagram(QByteArray("<<<START>>>\n<Data"), local_host, connection.GetListeningPort());
+    sender.writeDatagram(QByteArray("gram>\ntime,value,\n"), local_host, connection.GetListeningPort());
+    sender.writeDatagram(QByteArray("1,+2,\n"), local_host, connection.GetListeningPort());
+    EXPECT_TRUE(WaitFor([&](){return (std::string("<<<START>>>\n<Datagram>\ntime,value,\n1,+2,\n") == received_data);}));
+
+    // The same port can not be bound twice
+    UdpConnection other_connection;
+    EXPECT_FALSE(other_connection.Open("udp://127.0.0.1:" + std::to_string(connection.GetListeningPort())));
+
+    connection.Close();
+    EXPECT_FALSE(connection.IsOpen());
+}
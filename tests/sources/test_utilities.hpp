@@ -0,0 +1,40 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <chrono>
+#include <functional>
+
+
+
+#ifndef TEST_UTILITIES_HPP
+#define TEST_UTILITIES_HPP
+
+
+
+// Runs the event loop of the test thread until the condition is met or the timeout has elapsed, returns the final state of the condition
+// The connections deliver their data through this event loop, so the tests of the connections wait with this for the received data
+bool WaitFor(std::function<bool(void)> condition, const std::chrono::seconds& timeout = std::chrono::seconds(10));
+
+
+
+#endif // TEST_UTILITIES_HPP
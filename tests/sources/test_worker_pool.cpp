@@ -0,0 +1,139 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+#include "../application/sources/worker_pool.hpp"
+
+
+
+TEST(TestWorkerPool, Constructor)
+{
+    WorkerPool default_worker_pool;
+    EXPECT_GE(default_worker_pool.GetNumberOfWorkers(), std::size_t(1));
+
+    WorkerPool worker_pool(3);
+    EXPECT_EQ(worker_pool.GetNumberOfWorkers(), std::size_t(3));
+
+    EXPECT_ANY_THROW(worker_pool.Run(WorkerPool::task_type()));
+}
+
+TEST(TestWorkerPool, Run_TasksAreFinishedBeforeDestruction)
+{
+    constexpr int number_of_tasks = 10000;
+    std::atomic<int> number_of_executed_tasks(0);
+
+    {
+        WorkerPool worker_pool(4);
+        for(int i = 0; i < number_of_tasks; i++)
+        {
+            worker_pool.Run([&](){number_of_executed_tasks++;});
+        }
+    }
+
+    EXPECT_EQ(number_of_executed_tasks.load(), number_of_tasks);
+}
+
+TEST(TestWorkerPool, Run_TasksRunInParallel)
+{
+    // Every task waits until all of them have started, this only finishes if they are executed at the same time
+    constexpr int number_of_workers = 8;
+    std::atomic<int> number_of_started_tasks(0);
+    std::atomic<bool> every_task_has_started(false);
+
+    {
+        WorkerPool worker_pool(number_of_workers);
+        for(int i = 0; i < number_of_workers; i++)
+        {
+            worker_pool.Run([&]()
+            {
+                number_of_started_tasks++;
+                auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+                while((number_of_workers > number_of_started_tasks.load()) && (std::chrono::steady_clock::now() < timeout))
+                {
+                    std::this_thread::yield();
+                }
+                if(number_of_workers == number_of_started_tasks.load())
+                {
+                    every_task_has_started = true;
+                }
+            });
+        }
+    }
+
+    EXPECT_TRUE(every_task_has_started.load());
+}
+
+TEST(TestWorkerPool, Run_FromTask)
+{
+    // A task can submit the next part of its work, like the parsing of the data that arrived during the parsing
+    std::atomic<int> number_of_executed_parts(0);
+    std::mutex mutex;
+    std::vector<int> order_of_parts;
+
+    {
+        WorkerPool worker_pool(2);
+        std::function<void(int)> execute_part = [&](int part)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                order_of_parts.push_back(part);
+            }
+            number_of_executed_parts++;
+            if(part < 4)
+            {
+                worker_pool.Run([&, part](){execute_part(part + 1);});
+            }
+        };
+        worker_pool.Run([&](){execute_part(0);});
+
+        auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while((5 > number_of_executed_parts.load()) && (std::chrono::steady_clock::now() < timeout))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    EXPECT_THAT(order_of_parts, ::testing::ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST(TestWorkerPool, Run_ThrowingTask)
+{
+    // An exception that escapes a task must not terminate the application, the worker continues with the next task
+    std::atomic<int> number_of_executed_tasks(0);
+
+    {
+        WorkerPool worker_pool(1);
+        worker_pool.Run([](){throw std::string("Error");});
+        worker_pool.Run([&](){number_of_executed_tasks++;});
+    }
+
+    EXPECT_EQ(number_of_executed_tasks.load(), 1);
+}
@@ -35,6 +35,7 @@ CONFIG +=   \
 QT += core        \
       gui         \
       charts      \
+      network     \
       serialport
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -46,18 +47,81 @@ QMAKE_LFLAGS += --coverage
 
 # Source files of the target
 SOURCES +=                                                  \
+    ../application/sources/binary_data_protocol.cpp         \
+    ../application/sources/capture_journal.cpp              \
+    ../application/sources/chart_series_builder.cpp         \
     ../application/sources/configuration.cpp                \
+    ../application/sources/diagram_cache.cpp                \
+    ../application/sources/diagram_container.cpp            \
+    ../application/sources/display_update_queue.cpp         \
+    ../application/sources/file_replay_connection.cpp       \
     ../application/sources/measurement_data_protocol.cpp    \
+    ../application/sources/network_handler.cpp              \
+    ../application/sources/published_diagram_queue.cpp      \
+    ../application/sources/received_chunk_queue.cpp         \
+    ../application/sources/received_data_buffer.cpp         \
+    ../application/sources/received_data_delivery.cpp       \
+    ../application/sources/serial_port.cpp                  \
+    ../application/sources/socket_address.cpp               \
+    ../application/sources/tcp_connection.cpp               \
+    ../application/sources/udp_connection.cpp               \
+    ../application/sources/worker_pool.cpp                  \
+    sources/allocation_counter.cpp                          \
+    sources/test_utilities.cpp                              \
     sources/test_main.cpp                                   \
     sources/test_data_point.cpp                             \
     sources/test_data_line.cpp                              \
     sources/test_diagram.cpp                                \
+    sources/test_diagram_cache.cpp                          \
+    sources/test_chart_series_builder.cpp                   \
     sources/test_configuration.cpp                          \
     sources/test_diagram_container.cpp                      \
+    sources/test_search_index.cpp                           \
+    sources/test_published_diagram_queue.cpp                \
+    sources/test_spsc_ring_buffer.cpp                       \
+    sources/test_ingest_queue_counters.cpp                  \
+    sources/test_latency_histogram.cpp                      \
+    sources/test_capture_journal.cpp                        \
+    sources/test_received_chunk_queue.cpp                   \
+    sources/test_received_data_buffer.cpp                   \
+    sources/test_received_data_delivery.cpp                 \
+    sources/test_display_update_queue.cpp                   \
+    sources/test_worker_pool.cpp                            \
+    sources/test_network_handler.cpp                        \
     sources/test_measurement_data_protocol.cpp              \
+    sources/test_binary_data_protocol.cpp                   \
     sources/test_serial_port.cpp                            \
+    sources/test_file_replay_connection.cpp                 \
+    sources/test_socket_address.cpp                         \
+    sources/test_tcp_connection.cpp                         \
+    sources/test_udp_connection.cpp                         \
     sources/test_backend.cpp
 
+# Header files of the tested classes that need to be processed by the moc and of the test helpers
+HEADERS +=                                                  \
+    ../application/sources/diagram_container.hpp            \
+    ../application/sources/file_replay_connection.hpp       \
+    ../application/sources/network_handler.hpp              \
+    ../application/sources/serial_port.hpp                  \
+    ../application/sources/tcp_connection.hpp               \
+    ../application/sources/udp_connection.hpp               \
+    sources/allocation_counter.hpp                          \
+    sources/fake_network_connection.hpp                     \
+    sources/test_utilities.hpp
+
+# The end-to-end tests of the serial port simulate the device with a pseudo-terminal pair
+# The shared memory connection uses the futexes of Linux
+linux {
+    SOURCES += ../application/sources/shared_memory_connection.cpp  \
+               ../application/sources/shared_memory_ring.cpp        \
+               sources/pty_serial_simulator.cpp                     \
+               sources/test_shared_memory_ring.cpp                  \
+               sources/test_shared_memory_connection.cpp
+    HEADERS += ../application/sources/shared_memory_connection.hpp  \
+               sources/pty_serial_simulator.hpp
+    LIBS += -lrt
+}
+
 DISTFILES +=                                        \
     gtest_dendency.pri                              \
     test_files/TEST_1C_0E_MDP.mdp                   \
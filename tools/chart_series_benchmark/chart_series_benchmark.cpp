@@ -0,0 +1,152 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <cmath>
+#include <cstdlib>
+
+#include <QApplication>
+#include <QtCharts>
+
+#include "chart_series_builder.hpp"
+
+
+
+// Measures the construction of a chart from a data line like the MainWindow::DisplayDiagram does, with and without the bulk loading and the decimation of the series
+// The first painting of the chart is measured separately, because it depends on the number of the points in the series
+// Usage: RDB_Diplomaterv_Monitor_Chart_Series_Benchmark [--all] [-platform offscreen]
+//     all: the points are also appended one by one for the 10M points, this takes long
+
+static constexpr int chart_view_width = 1500;
+static constexpr int chart_view_height = 800;
+// Above this number of points the appending one by one is only measured if it was requested
+static constexpr std::size_t maximum_number_of_points_for_appending = 1000000;
+
+enum class SeriesLoading
+{
+    AppendOneByOne,
+    ReplaceAll,
+    ReplaceDecimated
+};
+
+static double MeasureMilliseconds(const std::function<void(void)>& function)
+{
+    auto start_time = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+static DataLineSpecialized CreateDataLine(const std::size_t& number_of_points)
+{
+    // A noisy sine wave, so the painted path is not trivial
+    std::vector<DataPointSpecialized> data_points;
+    data_points.reserve(number_of_points);
+    for(std::size_t i = 0; i < number_of_points; ++i)
+    {
+        double x = static_cast<double>(i);
+        data_points.emplace_back(x, ((1000.0 * std::sin(x / 1000.0)) + static_cast<double>(i % 17)));
+    }
+    DataLineSpecialized result("Benchmark");
+    result.SetDataPoints(std::move(data_points));
+
+    return result;
+}
+
+static QChart* CreateChart(QLineSeries* line_series, const std::size_t& number_of_points)
+{
+    auto result = new QChart();
+    result->legend()->hide();
+    result->addSeries(line_series);
+    auto x_axis = new QValueAxis;
+    x_axis->setRange(0.0, static_cast<qreal>(number_of_points));
+    result->addAxis(x_axis, Qt::AlignBottom);
+    auto y_axis = new QValueAxis;
+    y_axis->setRange(-1100.0, 1100.0);
+    result->addAxis(y_axis, Qt::AlignLeft);
+    line_series->attachAxis(x_axis);
+    line_series->attachAxis(y_axis);
+
+    return result;
+}
+
+// Returns the milliseconds of the construction and of the first painting
+static std::pair<double, double> MeasureChart(const DataLineSpecialized& data_line, const SeriesLoading& series_loading)
+{
+    QChartView chart_view;
+    chart_view.resize(chart_view_width, chart_view_height);
+    QChart* chart = nullptr;
+
+    double construction_time = MeasureMilliseconds([&]()
+    {
+        auto line_series = new QLineSeries();
+        if(SeriesLoading::AppendOneByOne == series_loading)
+        {
+            for(const auto& i : data_line.GetDataPoints())
+            {
+                line_series->append(i.GetX(), i.GetY());
+            }
+        }
+        else if(SeriesLoading::ReplaceAll == series_loading)
+        {
+            line_series->replace(ChartSeriesBuilder::CreatePoints(data_line));
+        }
+        else
+        {
+            line_series->replace(ChartSeriesBuilder::CreateDecimatedPoints(data_line, data_line.GetDataPoints().front().GetX(),
+                                                                           data_line.GetDataPoints().back().GetX(), static_cast<std::size_t>(chart_view_width)));
+        }
+        chart = CreateChart(line_series, data_line.GetTheNumberOfDataPoints());
+        chart_view.setChart(chart);
+    });
+    double painting_time = MeasureMilliseconds([&](){chart_view.grab();});
+
+    return std::make_pair(construction_time, painting_time);
+}
+
+int main(int argc, char *argv[])
+{
+    QApplication application(argc, argv);
+    bool every_appending_is_measured = application.arguments().contains("--all");
+
+    std::cout << "points;append one by one [ms];first paint after append [ms];bulk replace [ms];first paint after replace [ms];decimated replace [ms];first paint after decimated replace [ms]" << std::endl;
+    for(std::size_t number_of_points : {std::size_t(10000), std::size_t(1000000), std::size_t(10000000)})
+    {
+        auto data_line = CreateDataLine(number_of_points);
+        std::string appending_result = "skipped;skipped";
+        if(every_appending_is_measured || (number_of_points <= maximum_number_of_points_for_appending))
+        {
+            auto appending_times = MeasureChart(data_line, SeriesLoading::AppendOneByOne);
+            appending_result = std::to_string(appending_times.first) + ";" + std::to_string(appending_times.second);
+        }
+        auto replacing_times = MeasureChart(data_line, SeriesLoading::ReplaceAll);
+        auto decimating_times = MeasureChart(data_line, SeriesLoading::ReplaceDecimated);
+        std::cout << number_of_points << ";" << appending_result << ";" << replacing_times.first << ";" << replacing_times.second << ";"
+                  << decimating_times.first << ";" << decimating_times.second << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
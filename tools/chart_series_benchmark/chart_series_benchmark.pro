@@ -0,0 +1,50 @@
+#===============================================================================#
+#                                                                               #
+#    RDB Diplomaterv Monitor                                                    #
+#       A monitor program for the RDB Diplomaterv project                       #
+#    Copyright (C) 2018  András Gergő Kocsis                                    #
+#                                                                               #
+#    This program is free software: you can redistribute it and/or modify       #
+#    it under the terms of the GNU General Public License as published by       #
+#    the Free Software Foundation, either version 3 of the License, or          #
+#    (at your option) any later version.                                        #
+#                                                                               #
+#    This program is distributed in the hope that it will be useful,            #
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of             #
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              #
+#    GNU General Public License for more details.                               #
+#                                                                               #
+#    You should have received a copy of the GNU General Public License          #
+#    along with this program.  If not, see <https://www.gnu.org/licenses/>.     #
+#                                                                               #
+#===============================================================================#
+
+
+
+TEMPLATE = app
+
+# The used Qt components
+QT += core        \
+      gui         \
+      widgets     \
+      charts
+
+CONFIG +=   \
+    console
+
+# Compiler flags
+QMAKE_CXXFLAGS += -std=c++17
+
+# The builder of the series is shared with the application
+INCLUDEPATH += ../../application/sources
+
+# Source files of the target
+SOURCES +=                                              \
+    ../../application/sources/chart_series_builder.cpp  \
+    chart_series_benchmark.cpp
+
+# Header files of the target
+HEADERS +=                                              \
+    ../../application/sources/chart_series_builder.hpp
+
+TARGET = RDB_Diplomaterv_Monitor_Chart_Series_Benchmark
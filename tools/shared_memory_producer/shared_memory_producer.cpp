@@ -0,0 +1,231 @@
+//==============================================================================//
+//                                                                              //
+//    RDB Diplomaterv Monitor                                                   //
+//    A monitor program for the RDB Diplomaterv project                         //
+//    Copyright (C) 2018  András Gergő Kocsis                                   //
+//                                                                              //
+//    This program is free software: you can redistribute it and/or modify      //
+//    it under the terms of the GNU General Public License as published by      //
+//    the Free Software Foundation, either version 3 of the License, or         //
+//    (at your option) any later version.                                       //
+//                                                                              //
+//    This program is distributed in the hope that it will be useful,           //
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of            //
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             //
+//    GNU General Public License for more details.                              //
+//                                                                              //
+//    You should have received a copy of the GNU General Public License         //
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.    //
+//                                                                              //
+//==============================================================================//
+
+
+
+#include <iostream>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <csignal>
+
+#include "shared_memory_ring.hpp"
+
+
+
+// A reference producer for the shared memory connection of the monitor, it also measures the throughput of the ring
+// It creates the ring and writes simulated measurement data into it in the Measurement Data Protocol, the monitor reads it with the port name shm://<name>
+// Usage: RDB_Diplomaterv_Monitor_Shared_Memory_Producer <name> [--channels=N] [--lines=N] [--diagrams=N] [--rate=N] [--capacity=N]
+//     channels: the number of channels of a diagram, the default is 8
+//     lines:    the number of data lines of a diagram, the default is 1000
+//     diagrams: the number of diagrams, zero means that the diagrams are written until the producer is interrupted, the default is 1000
+//     rate:     the number of data lines per second, zero means as fast as the consumer can take them, this is the default
+//     capacity: the size of the ring in bytes, it is rounded up to a power of two, the default is 16 MiB
+
+struct Options
+{
+    std::string name;
+    std::size_t number_of_channels = 8;
+    std::size_t number_of_lines_per_diagram = 1000;
+    std::size_t number_of_diagrams = 1000;
+    std::size_t number_of_lines_per_second = 0;
+    std::size_t capacity_in_bytes = SHARED_MEMORY_DEFAULT_CAPACITY_IN_BYTES;
+};
+
+// The data is written in batches of this size, so the consumer is woken up once for many lines
+static constexpr std::size_t write_batch_size_in_bytes = 64 * 1024;
+static constexpr std::chrono::milliseconds maximum_waiting_step = std::chrono::milliseconds(100);
+
+static std::atomic<bool> production_needs_to_stop(false);
+
+static void HandleInterrupt(int signal_number)
+{
+    (void) signal_number;
+    production_needs_to_stop = true;
+}
+
+static bool ParseArguments(int argc, char *argv[], Options& options)
+{
+    bool result = (1 < argc);
+
+    if(result)
+    {
+        options.name = argv[1];
+    }
+
+    for(int i = 2; result && (i < argc); ++i)
+    {
+        std::string argument = argv[i];
+        auto value_separator = argument.find('=');
+        std::string key = argument.substr(0, value_separator);
+        std::string value = (std::string::npos != value_separator) ? argument.substr(value_separator + 1) : std::string();
+        result = ((!value.empty()) && (std::string::npos == value.find_first_not_of("0123456789")));
+
+        if(result)
+        {
+            std::size_t number = static_cast<std::size_t>(std::strtoull(value.c_str(), nullptr, 10));
+            if("--channels" == key)
+            {
+                options.number_of_channels = number;
+            }
+            else if("--lines" == key)
+            {
+                options.number_of_lines_per_diagram = number;
+            }
+            else if("--diagrams" == key)
+            {
+                options.number_of_diagrams = number;
+            }
+            else if("--rate" == key)
+            {
+                options.number_of_lines_per_second = number;
+            }
+            else if("--capacity" == key)
+            {
+                options.capacity_in_bytes = number;
+            }
+            else
+            {
+                result = false;
+            }
+        }
+    }
+
+    return result;
+}
+
+static void AppendDiagramBegin(std::string& batch, const std::size_t& diagram_index, const std::size_t& number_of_channels)
+{
+    batch += "<<<START>>>\n<Shared memory diagram " + std::to_string(diagram_index) + ">\nTime,";
+    for(std::size_t channel_index = 0; channel_index < number_of_channels; ++channel_index)
+    {
+        batch += "Channel" + std::to_string(channel_index) + ",";
+    }
+    batch += "\n";
+}
+
+static void AppendDataLine(std::string& batch, const std::size_t& line_index, const std::size_t& number_of_channels)
+{
+    // The values are signed and have different lengths, like the values of a real measurement
+    batch += std::to_string(line_index) + ",";
+    for(std::size_t channel_index = 0; channel_index < number_of_channels; ++channel_index)
+    {
+        batch += std::to_string(static_cast<long long>((line_index * (channel_index + 1)) % 20001) - 10000) + ",";
+    }
+    batch += "\n";
+}
+
+// Writes the whole batch, the writing waits for the consumer while the ring is full
+static void WriteBatch(SharedMemoryRing& ring, std::string& batch)
+{
+    std::size_t number_of_written_bytes = 0;
+    while((!production_needs_to_stop) && (number_of_written_bytes < batch.size()))
+    {
+        number_of_written_bytes += ring.TryWrite((batch.data() + number_of_written_bytes), (batch.size() - number_of_written_bytes));
+        if(number_of_written_bytes < batch.size())
+        {
+            ring.WaitForSpace(maximum_waiting_step);
+        }
+    }
+    batch.clear();
+}
+
+int main(int argc, char *argv[])
+{
+    int result = EXIT_SUCCESS;
+    Options options;
+    SharedMemoryRing ring;
+
+    if(!ParseArguments(argc, argv, options))
+    {
+        std::cerr << "Usage: " << argv[0] << " <name> [--channels=N] [--lines=N] [--diagrams=N] [--rate=N] [--capacity=N]" << std::endl;
+        result = EXIT_FAILURE;
+    }
+    else if(!ring.Create(options.name, options.capacity_in_bytes))
+    {
+        std::cerr << "The shared memory ring \"" << options.name << "\" could not be created!" << std::endl;
+        result = EXIT_FAILURE;
+    }
+    else
+    {
+        std::signal(SIGINT, HandleInterrupt);
+        std::signal(SIGTERM, HandleInterrupt);
+
+        // The throughput is measured from the attaching of the consumer
+        std::cout << "Waiting for the monitor to open shm://" << options.name << " (" << ring.GetCapacity() << " bytes)..." << std::endl;
+        while((!production_needs_to_stop) && (!ring.IsConsumerAttached()))
+        {
+            std::this_thread::sleep_for(maximum_waiting_step);
+        }
+
+        auto start_time = std::chrono::steady_clock::now();
+        std::size_t number_of_written_bytes = 0;
+        std::size_t number_of_written_lines = 0;
+        std::size_t diagram_index = 0;
+        std::string batch;
+        while((!production_needs_to_stop) && ((0 == options.number_of_diagrams) || (diagram_index < options.number_of_diagrams)))
+        {
+            AppendDiagramBegin(batch, diagram_index, options.number_of_channels);
+            for(std::size_t line_index = 0; (!production_needs_to_stop) && (line_index < options.number_of_lines_per_diagram); ++line_index)
+            {
+                // The paced lines are written when they are due, the batch is written before the waiting so the consumer gets the earlier lines on time
+                if(0 < options.number_of_lines_per_second)
+                {
+                    auto due_time = start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                    std::chrono::duration<double>(static_cast<double>(number_of_written_lines) / static_cast<double>(options.number_of_lines_per_second)));
+                    if(std::chrono::steady_clock::now() < due_time)
+                    {
+                        number_of_written_bytes += batch.size();
+                        WriteBatch(ring, batch);
+                        std::this_thread::sleep_until(due_time);
+                    }
+                }
+
+                AppendDataLine(batch, line_index, options.number_of_channels);
+                ++number_of_written_lines;
+                if(write_batch_size_in_bytes <= batch.size())
+                {
+                    number_of_written_bytes += batch.size();
+                    WriteBatch(ring, batch);
+                }
+            }
+            batch += "<<<END>>>\n";
+            ++diagram_index;
+        }
+        number_of_written_bytes += batch.size();
+        WriteBatch(ring, batch);
+
+        // The wake-ups show how many system calls the handover needed, a busy consumer does not need any
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        double megabytes = static_cast<double>(number_of_written_bytes) / (1024.0 * 1024.0);
+        std::cout << "Written " << diagram_index << " diagrams, " << number_of_written_lines << " lines, " << number_of_written_bytes << " bytes in "
+                  << seconds << " s (" << ((0.0 < seconds) ? (megabytes / seconds) : 0.0) << " MB/s, "
+                  << ((0.0 < seconds) ? (static_cast<double>(number_of_written_lines) / seconds) : 0.0) << " lines/s), "
+                  << ring.GetNumberOfWakeUps() << " wake-ups of the consumer" << std::endl;
+
+        // The consumer reads the rest of the ring even after the producer has detached
+        ring.Detach();
+    }
+
+    return result;
+}
@@ -0,0 +1,48 @@
+#===============================================================================#
+#                                                                               #
+#    RDB Diplomaterv Monitor                                                    #
+#       A monitor program for the RDB Diplomaterv project                       #
+#    Copyright (C) 2018  András Gergő Kocsis                                    #
+#                                                                               #
+#    This program is free software: you can redistribute it and/or modify       #
+#    it under the terms of the GNU General Public License as published by       #
+#    the Free Software Foundation, either version 3 of the License, or          #
+#    (at your option) any later version.                                        #
+#                                                                               #
+#    This program is distributed in the hope that it will be useful,            #
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of             #
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              #
+#    GNU General Public License for more details.                               #
+#                                                                               #
+#    You should have received a copy of the GNU General Public License          #
+#    along with this program.  If not, see <https://www.gnu.org/licenses/>.     #
+#                                                                               #
+#===============================================================================#
+
+
+
+TEMPLATE = app
+
+CONFIG +=   \
+    console \
+    thread
+CONFIG -= qt
+
+# Compiler flags
+QMAKE_CXXFLAGS += -std=c++17
+
+# The ring is shared with the application
+INCLUDEPATH += ../../application/sources
+
+# Source files of the target
+SOURCES +=                                              \
+    ../../application/sources/shared_memory_ring.cpp    \
+    shared_memory_producer.cpp
+
+# Header files of the target
+HEADERS +=                                              \
+    ../../application/sources/shared_memory_ring.hpp
+
+LIBS += -lrt
+
+TARGET = RDB_Diplomaterv_Monitor_Shared_Memory_Producer
@@ -0,0 +1,35 @@
+#===============================================================================#
+#                                                                               #
+#    RDB Diplomaterv Monitor                                                    #
+#       A monitor program for the RDB Diplomaterv project                       #
+#    Copyright (C) 2018  András Gergő Kocsis                                    #
+#                                                                               #
+#    This program is free software: you can redistribute it and/or modify       #
+#    it under the terms of the GNU General Public License as published by       #
+#    the Free Software Foundation, either version 3 of the License, or          #
+#    (at your option) any later version.                                        #
+#                                                                               #
+#    This program is distributed in the hope that it will be useful,            #
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of             #
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the              #
+#    GNU General Public License for more details.                               #
+#                                                                               #
+#    You should have received a copy of the GNU General Public License          #
+#    along with this program.  If not, see <https://www.gnu.org/licenses/>.     #
+#                                                                               #
+#===============================================================================#
+
+
+
+TEMPLATE = subdirs
+
+message(===============================)
+message(============ Tools ============)
+message(===============================)
+
+SUBDIRS += chart_series_benchmark
+
+# The shared memory producer uses the futexes of Linux
+linux {
+    SUBDIRS += shared_memory_producer
+}